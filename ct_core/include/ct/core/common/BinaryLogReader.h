@@ -0,0 +1,106 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "BinaryLogger.h"
+
+namespace ct {
+namespace core {
+
+//! Reads the files written by BinaryLogger
+/*!
+ * The records are sorted by channel and keep the order in which they were logged. A record which is still being
+ * written, i.e. the last record of a file which is still open, is ignored, such that a file can be read at any time.
+ */
+class BinaryLogReader
+{
+public:
+    //! a logged matrix and the iteration it was logged at
+    struct Record
+    {
+        size_t iteration;
+        Eigen::MatrixXd data;
+    };
+
+    BinaryLogReader() {}
+    //! read the file
+    BinaryLogReader(const std::string& filename) { read(filename); }
+    //! read the file, replacing all previously read records
+    void read(const std::string& filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.good())
+            throw std::runtime_error("BinaryLogReader: cannot open " + filename + " for reading.");
+
+        char magic[8];
+        file.read(magic, 8);
+        if (!file.good() || std::memcmp(magic, BinaryLogger::MAGIC, 8) != 0)
+            throw std::runtime_error("BinaryLogReader: " + filename + " is not a binary log.");
+
+        const uint64_t nChannels = readWord(file);
+        channels_.resize(nChannels);
+        for (std::string& name : channels_)
+        {
+            const uint64_t length = readWord(file);
+            name.resize(length);
+            file.read(&name[0], length);
+            file.ignore((8 - length % 8) % 8);
+        }
+
+        if (!file.good())
+            throw std::runtime_error("BinaryLogReader: the header of " + filename + " is truncated.");
+
+        records_.assign(nChannels, std::vector<Record>());
+
+        BinaryLogger::RecordHeader header;
+        while (file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        {
+            if (header.channel >= nChannels)
+                throw std::runtime_error("BinaryLogReader: " + filename + " is corrupted.");
+
+            Record record;
+            record.iteration = header.iteration;
+            record.data.resize(header.rows, header.cols);
+            if (!file.read(reinterpret_cast<char*>(record.data.data()), record.data.size() * sizeof(double)))
+                break;
+
+            records_[header.channel].push_back(record);
+        }
+    }
+
+    //! names of the channels
+    const std::vector<std::string>& channels() const { return channels_; }
+    //! index of the channel with the given name
+    size_t channel(const std::string& name) const
+    {
+        for (size_t i = 0; i < channels_.size(); i++)
+            if (channels_[i] == name)
+                return i;
+        throw std::runtime_error("BinaryLogReader: unknown channel " + name + ".");
+    }
+
+    //! the records of a channel
+    const std::vector<Record>& records(size_t channel) const { return records_.at(channel); }
+    const std::vector<Record>& records(const std::string& name) const { return records_[channel(name)]; }
+private:
+    static uint64_t readWord(std::ifstream& file)
+    {
+        uint64_t word = 0;
+        file.read(reinterpret_cast<char*>(&word), sizeof(uint64_t));
+        return word;
+    }
+
+    std::vector<std::string> channels_;
+    std::vector<std::vector<Record>> records_;
+};
+
+}  // namespace core
+}  // namespace ct
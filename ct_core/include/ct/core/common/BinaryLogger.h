@@ -0,0 +1,262 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ct {
+namespace core {
+
+//! Asynchronous logger streaming matrices to an append-only binary file
+/*!
+ * The logging thread, e.g. a solver, copies every record into a lock-free single-producer single-consumer ring
+ * buffer and returns immediately. A background thread streams the ring buffer to the file. If the ring buffer is
+ * full, the record is dropped and counted instead of blocking the logging thread, such that the overhead of logging
+ * is bounded by copying the data.
+ *
+ * File format, all fields are 8-byte aligned and stored in native byte order:
+ * - header: the magic "CTLOG001", the number of channels and per channel the length of its name followed by the
+ *   name, padded with zeros to a multiple of 8 bytes.
+ * - records, one after another: the channel index (uint32), rows (uint32), cols (uint32), a reserved field (uint32),
+ *   the iteration (uint64) and rows * cols doubles in column-major order.
+ *
+ * Since the records are appended only, the file can be read, or memory-mapped, while it is being written, see
+ * BinaryLogReader. All channels need to be added before the file is opened. All log functions need to be called from
+ * the same thread.
+ */
+class BinaryLogger
+{
+public:
+    static constexpr const char* MAGIC = "CTLOG001";
+
+    //! the header of a record
+    struct RecordHeader
+    {
+        uint32_t channel;
+        uint32_t rows;
+        uint32_t cols;
+        uint32_t reserved;
+        uint64_t iteration;
+    };
+
+    /*!
+	 * @param bufferSize size of the ring buffer in bytes, rounded up to a power of two
+	 * @param writePeriod time the writing thread sleeps if the ring buffer is empty
+	 */
+    BinaryLogger(size_t bufferSize = 1 << 24,
+        const std::chrono::microseconds& writePeriod = std::chrono::microseconds(1000))
+        : writePeriod_(writePeriod), pending_(0), head_(0), tail_(0), stop_(false), dropped_(0)
+    {
+        size_t nWords = 1;
+        while (nWords * sizeof(uint64_t) < bufferSize)
+            nWords *= 2;
+        ring_.resize(nWords);
+        mask_ = nWords - 1;
+    }
+
+    ~BinaryLogger() { close(); }
+    BinaryLogger(const BinaryLogger&) = delete;
+    BinaryLogger& operator=(const BinaryLogger&) = delete;
+
+    //! add a channel before opening the file, returns its index
+    size_t addChannel(const std::string& name)
+    {
+        if (isOpen())
+            throw std::runtime_error("BinaryLogger: channels need to be added before opening the file.");
+        channels_.push_back(name);
+        return channels_.size() - 1;
+    }
+
+    //! open the file, write the header and start the writing thread
+    void open(const std::string& filename)
+    {
+        if (isOpen())
+            throw std::runtime_error("BinaryLogger: file is already open.");
+
+        file_.open(filename, std::ios::binary | std::ios::trunc);
+        if (!file_.good())
+            throw std::runtime_error("BinaryLogger: cannot open " + filename + " for writing.");
+
+        file_.write(MAGIC, 8);
+        writeWord(channels_.size());
+        for (const std::string& name : channels_)
+        {
+            writeWord(name.size());
+            file_.write(name.data(), name.size());
+            const size_t padding = (8 - name.size() % 8) % 8;
+            file_.write("\0\0\0\0\0\0\0", padding);
+        }
+        file_.flush();
+
+        stop_ = false;
+        writer_ = std::thread(&BinaryLogger::writeLoop, this);
+    }
+
+    //! write all pending records, stop the writing thread and close the file
+    void close()
+    {
+        if (!isOpen())
+            return;
+
+        stop_ = true;
+        writer_.join();
+        file_.close();
+    }
+
+    bool isOpen() const { return writer_.joinable(); }
+    //! block until all records logged so far are written to the file
+    void flush() const
+    {
+        while (isOpen() && tail_.load(std::memory_order_acquire) != head_.load(std::memory_order_relaxed))
+            std::this_thread::sleep_for(writePeriod_);
+    }
+
+    //! number of records dropped because the ring buffer was full
+    size_t droppedRecords() const { return dropped_; }
+    //! log a matrix or vector
+    template <typename Derived>
+    bool log(size_t channel, size_t iteration, const Eigen::MatrixBase<Derived>& data)
+    {
+        if (!beginRecord(channel, iteration, data.rows(), data.cols()))
+            return false;
+        pushElement(data);
+        commitRecord();
+        return true;
+    }
+
+    //! log a scalar
+    bool log(size_t channel, size_t iteration, double data)
+    {
+        if (!beginRecord(channel, iteration, 1, 1))
+            return false;
+        pushValue(data);
+        commitRecord();
+        return true;
+    }
+
+    //! log an array of scalars, vectors or matrices, such as a DiscreteArray, with one column per element
+    /*!
+	 * Matrices are stored column-major within their column.
+	 */
+    template <typename ARRAY>
+    bool logArray(size_t channel, size_t iteration, const ARRAY& data)
+    {
+        const size_t rows = data.size() == 0 ? 0 : elementSize(data[0]);
+        if (!beginRecord(channel, iteration, rows, data.size()))
+            return false;
+        for (size_t i = 0; i < data.size(); i++)
+            pushElement(data[i]);
+        commitRecord();
+        return true;
+    }
+
+private:
+    //! reserve space for the record in the ring buffer, returns false and counts the record as dropped if it is full
+    bool beginRecord(size_t channel, size_t iteration, size_t rows, size_t cols)
+    {
+        if (!isOpen())
+            return false;
+        if (channel >= channels_.size())
+            throw std::runtime_error("BinaryLogger: unknown channel " + std::to_string(channel) + ".");
+
+        const uint64_t nWords = HEADER_WORDS + rows * cols;
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head + nWords - tail_.load(std::memory_order_acquire) > ring_.size())
+        {
+            dropped_++;
+            return false;
+        }
+
+        RecordHeader header;
+        header.channel = channel;
+        header.rows = rows;
+        header.cols = cols;
+        header.reserved = 0;
+        header.iteration = iteration;
+
+        uint64_t words[HEADER_WORDS];
+        std::memcpy(words, &header, sizeof(RecordHeader));
+
+        pending_ = head;
+        for (size_t i = 0; i < HEADER_WORDS; i++)
+            ring_[pending_++ & mask_] = words[i];
+
+        return true;
+    }
+
+    //! publish the record to the writing thread
+    void commitRecord() { head_.store(pending_, std::memory_order_release); }
+    void pushValue(double value) { std::memcpy(&ring_[pending_++ & mask_], &value, sizeof(double)); }
+    template <typename Derived>
+    void pushElement(const Eigen::MatrixBase<Derived>& data)
+    {
+        for (int j = 0; j < data.cols(); j++)
+            for (int i = 0; i < data.rows(); i++)
+                pushValue(static_cast<double>(data(i, j)));
+    }
+
+    void pushElement(double data) { pushValue(data); }
+    template <typename Derived>
+    static size_t elementSize(const Eigen::MatrixBase<Derived>& data)
+    {
+        return data.size();
+    }
+
+    static size_t elementSize(double data) { return 1; }
+    void writeWord(uint64_t word) { file_.write(reinterpret_cast<const char*>(&word), sizeof(uint64_t)); }
+    //! the writing thread, streams the ring buffer to the file until stopped and the ring buffer is empty
+    void writeLoop()
+    {
+        while (true)
+        {
+            const bool stop = stop_;
+            const uint64_t tail = tail_.load(std::memory_order_relaxed);
+            const uint64_t head = head_.load(std::memory_order_acquire);
+
+            if (head == tail)
+            {
+                if (stop)
+                    break;
+                std::this_thread::sleep_for(writePeriod_);
+                continue;
+            }
+
+            // the pending words may wrap around the end of the ring buffer
+            const uint64_t begin = tail & mask_;
+            const uint64_t firstChunk = std::min<uint64_t>(head - tail, ring_.size() - begin);
+            file_.write(reinterpret_cast<const char*>(&ring_[begin]), firstChunk * sizeof(uint64_t));
+            file_.write(reinterpret_cast<const char*>(&ring_[0]), (head - tail - firstChunk) * sizeof(uint64_t));
+            file_.flush();
+
+            tail_.store(head, std::memory_order_release);
+        }
+    }
+
+    static const size_t HEADER_WORDS = sizeof(RecordHeader) / sizeof(uint64_t);
+
+    std::vector<std::string> channels_;
+    std::ofstream file_;
+    std::thread writer_;
+    std::chrono::microseconds writePeriod_;
+
+    std::vector<uint64_t> ring_;
+    uint64_t mask_;
+    uint64_t pending_;            //!< write position of the record in progress, only used by the logging thread
+    std::atomic<uint64_t> head_;  //!< end of the published records, written by the logging thread
+    std::atomic<uint64_t> tail_;  //!< end of the records written to the file, written by the writing thread
+    std::atomic<bool> stop_;
+    std::atomic<size_t> dropped_;
+};
+
+}  // namespace core
+}  // namespace ct
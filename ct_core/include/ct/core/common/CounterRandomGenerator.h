@@ -0,0 +1,61 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace ct {
+namespace core {
+
+//! Counter-based pseudo random number generator
+/*!
+ * The n-th number of a stream is computed directly by hashing the key of the stream and n with the SplitMix64
+ * finalizer, instead of advancing a hidden state. Hence, the numbers of a stream only depend on the seed and on the
+ * stream indices, e.g. the index of a Monte-Carlo sample, and not on the order or the thread in which the streams are
+ * used. Streams are cheap to create and satisfy the UniformRandomBitGenerator requirements, such that they can be
+ * used with the distributions of the standard library.
+ */
+class CounterRandomGenerator
+{
+public:
+    typedef uint64_t result_type;
+
+    /*!
+	 * @param seed the global seed
+	 * @param stream index of the stream, e.g. a sample index
+	 * @param subStream index of a sub stream, e.g. for initial state, parameters and noise of a sample
+	 */
+    CounterRandomGenerator(uint64_t seed = 0, uint64_t stream = 0, uint64_t subStream = 0)
+        : key_(mix(mix(mix(seed) + stream) + subStream)), counter_(0)
+    {
+    }
+
+    //! the next number of the stream
+    result_type operator()() { return mix(key_ + (++counter_) * GOLDEN_GAMMA); }
+    //! skip n numbers of the stream in constant time
+    void discard(uint64_t n) { counter_ += n; }
+    //! the number of values drawn so far
+    uint64_t counter() const { return counter_; }
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+private:
+    static constexpr uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ull;
+
+    //! the SplitMix64 finalizer
+    static uint64_t mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t key_;
+    uint64_t counter_;
+};
+
+}  // namespace core
+}  // namespace ct
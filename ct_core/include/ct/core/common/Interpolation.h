@@ -5,6 +5,9 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+
 #include <ct/core/types/arrays/DiscreteArray.h>
 #include <ct/core/types/arrays/TimeArray.h>
 
@@ -85,30 +88,45 @@ public:
             index_ = greatestLessTimeStampIndex;
         }
 
-        if (enquiryTime < timeArray.front())
-        {
-            enquiryData = dataArray.front();
-            return;
-        }
+        interpolateAtIndex(timeArray, dataArray, enquiryTime, ind, enquiryData);
+    }
 
-        if (ind == (int)timeArray.size() - 1)
+    //! This method performs the interpolation for many enquiry times at once
+    /*!
+	 * The arrays are checked only once and each index search starts at the index found for the previous enquiry, hence
+	 * resampling a trajectory at sorted enquiry times takes constant time per enquiry on evenly spaced time arrays.
+	 *
+	 * @param timeArray timing information of the data points
+	 * @param dataArray	the data points in form of a DiscreteArray
+	 * @param enquiryTimes the times where to evaluate the interpolation, in any order
+	 * @param enquiryData the results of the interpolation, resized to the number of enquiry times
+	 */
+    void interpolateMany(const tpl::TimeArray<SCALAR>& timeArray,
+        const DiscreteArray_t& dataArray,
+        const tpl::TimeArray<SCALAR>& enquiryTimes,
+        DiscreteArray_t& enquiryData)
+    {
+        if (timeArray.size() == 0)
+            throw std::runtime_error("Interpolation.h : TimeArray is size 0.");
+
+        if (timeArray.size() != dataArray.size())
+            throw std::runtime_error("Interpolation.h : The size of timeStamp vector (=" +
+                                     std::to_string(timeArray.size()) + ") is not equal to the size of data vector (=" +
+                                     std::to_string(dataArray.size()) + ").");
+
+        enquiryData.resize(enquiryTimes.size());
+
+        if (dataArray.size() == 1)
         {
-            enquiryData = dataArray.back();
+            enquiryData.setConstant(dataArray.front());
             return;
         }
 
-        SCALAR alpha = (enquiryTime - timeArray.at(ind + 1)) / (timeArray.at(ind) - timeArray.at(ind + 1));
-
-
-        if (type_ == InterpolationType::LIN)
-            enquiryData = alpha * dataArray.at(ind) + (1 - alpha) * dataArray.at(ind + 1);
-        else if (type_ == InterpolationType::ZOH)
-            enquiryData = dataArray.at(ind);
-        else
-            throw std::runtime_error("Unknown Interpolation type!");
+        for (size_t i = 0; i < enquiryTimes.size(); i++)
+            interpolateAtIndex(
+                timeArray, dataArray, enquiryTimes[i], findIndex(timeArray, enquiryTimes[i]), enquiryData[i]);
     }
 
-
     //! access the greatest index which is smaller than the inquired interpolation time
     int getGreatestLessTimeStampIndex() { return index_; }
     //! get the employed interpolation type
@@ -116,47 +134,87 @@ public:
     //! change the interpolation type
     void changeInterpolationType(const InterpolationType& type) { type_ = type; }
     //! find an index corresponding to a certain inquiry time
+    /*!
+	 * Returns the greatest index whose time stamp is not larger than the enquiry time, or zero if there is none.
+	 * The search first tries the index of the previous enquiry and its successor, which covers evaluating a trajectory
+	 * along time, then the index computed from the average spacing, which is exact for evenly spaced time arrays. Only
+	 * if both fail, i.e. for large jumps on unevenly spaced time arrays, a binary search is performed.
+	 */
     int findIndex(const tpl::TimeArray<SCALAR>& timeArray, const SCALAR& enquiryTime)
     {
-        int index = -1;
+        const int N = (int)timeArray.size();
 
-        index_ = std::min(index_, (int)timeArray.size() - 1);
+        if (N == 0)
+            throw std::runtime_error("Interpolation.h : cannot find an index in an empty TimeArray.");
 
-        if (timeArray.at(index_) > enquiryTime)
-        {
-            for (int i = index_; i >= 0; i--)
-            {
-                index = i;
-                if (timeArray.at(i) <= enquiryTime)
-                    break;
-            }
-        }
-        else
+        index_ = std::max(0, std::min(index_, N - 1));
+
+        if (isGreatestLessIndex(timeArray, index_, enquiryTime))
+            return index_;
+
+        if (index_ + 1 < N && isGreatestLessIndex(timeArray, index_ + 1, enquiryTime))
+            return ++index_;
+
+        if (timeArray.back() > timeArray.front())
         {
-            for (int i = index_; i < (int)timeArray.size(); i++)
+            const SCALAR guess = (enquiryTime - timeArray.front()) * (N - 1) / (timeArray.back() - timeArray.front());
+
+            // the guess may be off by one due to round-off
+            const int i = (int)std::max(SCALAR(0), std::min(std::floor(guess), SCALAR(N - 1)));
+            for (int j = std::max(0, i - 1); j <= std::min(i + 1, N - 1); j++)
             {
-                index = i;
-                if (timeArray.at(i) > enquiryTime)
+                if (isGreatestLessIndex(timeArray, j, enquiryTime))
                 {
-                    index = i - 1;
-                    break;
+                    index_ = j;
+                    return index_;
                 }
             }
         }
 
-        // throw error if index is wrong
-        if (index < 0)
-            throw std::runtime_error(
-                "Interpolation.h : index in protected member findIndex((const SCALAR& enquiryTime) not computed "
-                "properly");
+        index_ = std::max(0,
+            (int)(std::upper_bound(timeArray.begin(), timeArray.end(), enquiryTime) - timeArray.begin()) - 1);
 
-        index_ = index;
-
-        return index;
+        return index_;
     }
 
 
 protected:
+    //! true if index is the greatest one with a time stamp not larger than the enquiry time (or zero if there is none)
+    static bool isGreatestLessIndex(const tpl::TimeArray<SCALAR>& timeArray, const int index, const SCALAR& enquiryTime)
+    {
+        return (index == 0 || timeArray[index] <= enquiryTime) &&
+               (index + 1 == (int)timeArray.size() || timeArray[index + 1] > enquiryTime);
+    }
+
+    //! evaluate the interpolation between the data points index and index + 1
+    void interpolateAtIndex(const tpl::TimeArray<SCALAR>& timeArray,
+        const DiscreteArray_t& dataArray,
+        const SCALAR& enquiryTime,
+        const int ind,
+        Data_T& enquiryData) const
+    {
+        if (enquiryTime < timeArray.front())
+        {
+            enquiryData = dataArray.front();
+            return;
+        }
+
+        if (ind == (int)timeArray.size() - 1)
+        {
+            enquiryData = dataArray.back();
+            return;
+        }
+
+        SCALAR alpha = (enquiryTime - timeArray[ind + 1]) / (timeArray[ind] - timeArray[ind + 1]);
+
+        if (type_ == InterpolationType::LIN)
+            enquiryData = alpha * dataArray[ind] + (1 - alpha) * dataArray[ind + 1];
+        else if (type_ == InterpolationType::ZOH)
+            enquiryData = dataArray[ind];
+        else
+            throw std::runtime_error("Unknown Interpolation type!");
+    }
+
     int index_;
 
     InterpolationType type_;
@@ -0,0 +1,134 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ct {
+namespace core {
+
+//! A fixed set of worker threads which repeatedly process batches of independent tasks
+/*!
+ * The threads are started once and sleep between the batches, which avoids spawning threads for every batch.
+ * The calling thread takes part in the work, hence a pool of nThreads starts nThreads - 1 threads.
+ * A pool processes one batch at a time and is neither copyable nor thread-safe itself.
+ */
+class WorkerPool
+{
+public:
+    //! constructor
+    /*!
+     * @param nThreads number of threads working on a batch, including the calling thread
+     */
+    explicit WorkerPool(const size_t nThreads) : nThreads_(std::max(nThreads, size_t(1)))
+    {
+        for (size_t i = 1; i < nThreads_; i++)
+            threads_.emplace_back(&WorkerPool::workerLoop, this);
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    //! destructor, joins the threads
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            shutdown_ = true;
+        }
+        wakeUp_.notify_all();
+
+        for (auto& thread : threads_)
+            thread.join();
+    }
+
+    //! number of threads working on a batch, including the calling thread
+    size_t nThreads() const { return nThreads_; }
+
+    //! call task(0), ..., task(nTasks - 1) in parallel and return once all calls are done
+    /*!
+     * @param nTasks number of tasks
+     * @param task the task, must not throw
+     */
+    void run(const size_t nTasks, const std::function<void(size_t)>& task)
+    {
+        if (threads_.empty() || nTasks < 2)
+        {
+            for (size_t i = 0; i < nTasks; i++)
+                task(i);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            nTasks_ = nTasks;
+            nextTask_ = 0;
+            busyThreads_ = threads_.size();
+            batch_++;
+        }
+        wakeUp_.notify_all();
+
+        work();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        batchDone_.wait(lock, [this] { return busyThreads_ == 0; });
+        task_ = nullptr;
+    }
+
+private:
+    void workerLoop()
+    {
+        size_t lastBatch = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            wakeUp_.wait(lock, [&] { return shutdown_ || batch_ != lastBatch; });
+            if (shutdown_)
+                return;
+
+            lastBatch = batch_;
+
+            lock.unlock();
+            work();
+            lock.lock();
+
+            if (--busyThreads_ == 0)
+                batchDone_.notify_one();
+        }
+    }
+
+    //! process tasks of the current batch until none are left
+    void work()
+    {
+        for (size_t i = nextTask_++; i < nTasks_; i = nextTask_++)
+            (*task_)(i);
+    }
+
+    const size_t nThreads_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::condition_variable batchDone_;
+
+    // state of the current batch, written under the mutex before the threads are woken up
+    const std::function<void(size_t)>* task_ = nullptr;
+    size_t nTasks_ = 0;
+    std::atomic<size_t> nextTask_{0};
+    size_t busyThreads_ = 0;
+    size_t batch_ = 0;
+    bool shutdown_ = false;
+};
+
+}  // namespace core
+}  // namespace ct
@@ -13,6 +13,7 @@ namespace core {
 //! Estimates a Plane from a number of 3D points using least squares
 /*!
  * Given a set of measurements, a plane is fitted to them using least squares.
+ * For points arriving one by one, see RecursivePlaneEstimator.
  */
 class PlaneEstimator
 {
@@ -0,0 +1,230 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <deque>
+#include <vector>
+
+#include "Plane.h"
+
+namespace ct {
+namespace core {
+
+//! Estimates a Plane from a stream of 3D points using recursive least squares
+/*!
+ * In contrast to PlaneEstimator, the points are not stored. Instead, the estimator maintains their sufficient
+ * statistics, i.e. the sum of weights, the centroid and the scatter matrix around the centroid. Adding and removing a
+ * point updates them in constant time (Welford's algorithm), independent of the number of points seen so far.
+ *
+ * The plane passes through the centroid and its normal is the direction of least scatter, i.e. the fit minimizes the
+ * orthogonal distances of the points (total least squares). The normal is oriented to have a non-negative z component
+ * and the returned coefficients satisfy \f$ a^2 + b^2 + c^2 = 1 \f$.
+ *
+ * Old points can be discounted
+ * - with an exponential forgetting factor \f$ \lambda \in (0, 1] \f$, which scales the weights of all previous points
+ *   with every new point,
+ * - and / or with a sliding window over the last points, the oldest point is removed when the window is full.
+ */
+class RecursivePlaneEstimator
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d>> point_measurements_t;
+    typedef std::vector<RecursivePlaneEstimator, Eigen::aligned_allocator<RecursivePlaneEstimator>> patches_t;
+    typedef std::vector<Plane, Eigen::aligned_allocator<Plane>> planes_t;
+
+    //! constructor
+    /*!
+	 * @param forgettingFactor the factor \f$ \lambda \in (0, 1] \f$ the weights of the previous points are scaled with
+	 * for every new point, 1 keeps all points with equal weight
+	 * @param windowSize the number of most recent points to keep, 0 for an unbounded window
+	 */
+    RecursivePlaneEstimator(double forgettingFactor = 1.0, size_t windowSize = 0)
+        : forgettingFactor_(forgettingFactor), windowSize_(windowSize)
+    {
+        if (forgettingFactor_ <= 0.0 || forgettingFactor_ > 1.0)
+            throw std::runtime_error("Forgetting factor needs to be in (0, 1]");
+
+        windowDecay_ = std::pow(forgettingFactor_, static_cast<double>(windowSize_));
+        reset();
+    }
+
+    //! destructor
+    ~RecursivePlaneEstimator() {}
+    //! removes all points
+    void reset()
+    {
+        weight_ = 0.0;
+        numPoints_ = 0;
+        centroid_.setZero();
+        scatter_.setZero();
+        window_.clear();
+    }
+
+    //! adds a point
+    /*!
+	 * Discounts the previous points by the forgetting factor and, if the window is full, removes the oldest point.
+	 * @param point the new point
+	 * @param weight the weight of the point
+	 */
+    void addPoint(const Eigen::Vector3d& point, double weight = 1.0)
+    {
+        weight_ *= forgettingFactor_;
+        scatter_ *= forgettingFactor_;
+
+        if (windowSize_ > 0 && window_.size() == windowSize_)
+        {
+            // the oldest point has been discounted windowSize times by now
+            removeStatistics(window_.front().first, window_.front().second * windowDecay_);
+            window_.pop_front();
+        }
+
+        addStatistics(point, weight);
+
+        if (windowSize_ > 0)
+            window_.push_back(std::make_pair(point, weight));
+    }
+
+    //! adds several points
+    void addPoints(const point_measurements_t& points)
+    {
+        for (const Eigen::Vector3d& point : points)
+            addPoint(point);
+    }
+
+    //! removes a point that has been added before
+    /*!
+	 * Use this to maintain a custom window of points. When a forgetting factor is used, the weight has to be the
+	 * current, i.e. discounted, weight of the point.
+	 * @param point the point to remove
+	 * @param weight the current weight of the point
+	 */
+    void removePoint(const Eigen::Vector3d& point, double weight = 1.0) { removeStatistics(point, weight); }
+    //! estimate the plane
+    /*!
+	 * Fits a plane to the points
+	 *
+	 * \warning Throws an exception if not at least three points are contained.
+	 *
+	 * @return the estimated plane
+	 */
+    Plane estimate() const
+    {
+        Plane plane;
+        if (!estimate(plane))
+            throw std::runtime_error("Plane estimator should contain at least 3 points!");
+        return plane;
+    }
+
+    //! estimate the plane
+    /*!
+	 * @param plane the estimated plane, unchanged if not at least three points are contained
+	 * @return true if the plane could be estimated
+	 */
+    bool estimate(Plane& plane) const
+    {
+        if (numPoints_ < 3 || weight_ <= 0.0)
+            return false;
+
+        // the eigenvalues of the closed form solver are sorted in increasing order
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigenSolver;
+        eigenSolver.computeDirect(scatter_);
+        Eigen::Vector3d normal = eigenSolver.eigenvectors().col(0).normalized();
+        if (normal(2) < 0.0)
+            normal = -normal;
+
+        Eigen::Matrix<double, 4, 1> coefficients;
+        coefficients << normal, normal.dot(centroid_);
+        plane = Plane(coefficients);
+        return true;
+    }
+
+    //! estimate the planes of many patches at once, e.g. the cells of a terrain grid
+    /*!
+	 * @param patches the estimators of the patches
+	 * @param planes the estimated planes, zero for patches with less than three points
+	 * @param valid true for the patches whose plane could be estimated
+	 * @return the number of estimated planes
+	 */
+    static size_t estimate(const patches_t& patches, planes_t& planes, std::vector<bool>& valid)
+    {
+        planes.assign(patches.size(), Plane());
+        valid.assign(patches.size(), false);
+
+        size_t numValid = 0;
+        for (size_t i = 0; i < patches.size(); i++)
+        {
+            valid[i] = patches[i].estimate(planes[i]);
+            numValid += valid[i];
+        }
+        return numValid;
+    }
+
+    //! the number of points contained
+    size_t getNumPoints() const { return numPoints_; }
+    //! the sum of the current weights of the points
+    double getWeight() const { return weight_; }
+    //! the weighted centroid of the points
+    const Eigen::Vector3d& getCentroid() const { return centroid_; }
+    //! the weighted covariance of the points
+    Eigen::Matrix3d getCovariance() const
+    {
+        return weight_ > 0.0 ? Eigen::Matrix3d(scatter_ / weight_) : Eigen::Matrix3d::Zero();
+    }
+
+    double getForgettingFactor() const { return forgettingFactor_; }
+    size_t getWindowSize() const { return windowSize_; }
+private:
+    //! weighted Welford update
+    void addStatistics(const Eigen::Vector3d& point, double weight)
+    {
+        const double newWeight = weight_ + weight;
+        const Eigen::Vector3d delta = point - centroid_;
+        centroid_ += (weight / newWeight) * delta;
+        scatter_ += (weight * weight_ / newWeight) * delta * delta.transpose();
+        weight_ = newWeight;
+        numPoints_++;
+    }
+
+    //! reverse of the weighted Welford update
+    void removeStatistics(const Eigen::Vector3d& point, double weight)
+    {
+        if (numPoints_ == 0)
+            throw std::runtime_error("Cannot remove a point from an empty plane estimator");
+
+        const double newWeight = weight_ - weight;
+        numPoints_--;
+        if (numPoints_ == 0 || newWeight <= 0.0)
+        {
+            // restart from scratch instead of accumulating round-off errors
+            weight_ = 0.0;
+            centroid_.setZero();
+            scatter_.setZero();
+            return;
+        }
+
+        const Eigen::Vector3d delta = point - centroid_;
+        centroid_ -= (weight / newWeight) * delta;
+        scatter_ -= (weight * weight_ / newWeight) * delta * delta.transpose();
+        weight_ = newWeight;
+    }
+
+    double forgettingFactor_;  //! scales the previous weights with every new point
+    size_t windowSize_;        //! number of points kept, 0 for unbounded
+    double windowDecay_;       //! discount of the oldest point in a full window
+
+    double weight_;              //! sum of the current weights
+    size_t numPoints_;           //! number of points contained
+    Eigen::Vector3d centroid_;   //! weighted centroid
+    Eigen::Matrix3d scatter_;    //! weighted scatter matrix around the centroid
+    std::deque<std::pair<Eigen::Vector3d, double>, Eigen::aligned_allocator<std::pair<Eigen::Vector3d, double>>>
+        window_;  //! the points in the window and their weights when they were added
+};
+
+}  // namespace core
+}  // namespace ct
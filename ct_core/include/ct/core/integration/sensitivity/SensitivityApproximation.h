@@ -5,7 +5,12 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #pragma once
 
-#include <unsupported/Eigen/MatrixFunctions>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <ct/core/common/WorkerPool.h>
+#include <ct/core/math/MatrixExponential.h>
 
 #define SYMPLECTIC_ENABLED        \
     template <size_t V, size_t P> \
@@ -127,14 +132,151 @@ public:
                 forwardEuler(x, u, n, A, B);
                 break;
             }
+            case SensitivityApproximationSettings::APPROXIMATION::SYMPLECTIC_EULER:
+            {
+                symplecticEuler<V_DIM, P_DIM>(x, u, x_next, n, A, B);
+                break;
+            }
             case SensitivityApproximationSettings::APPROXIMATION::BACKWARD_EULER:
+            case SensitivityApproximationSettings::APPROXIMATION::TUSTIN:
+            case SensitivityApproximationSettings::APPROXIMATION::MATRIX_EXPONENTIAL:
             {
-                backwardEuler(x, u, n + 1, A, B);
+                state_matrix_t Ac, Ac_back;
+                state_control_matrix_t Bc;
+                getContinuousDerivatives(x, u, x_next, n, Ac, Bc, Ac_back);
+                discretize(Ac, Bc, Ac_back, A, B);
                 break;
             }
-            case SensitivityApproximationSettings::APPROXIMATION::SYMPLECTIC_EULER:
+            default:
+                throw std::runtime_error("Unknown Approximation type in SensitivityApproximation.");
+        }  // end switch
+    }
+
+
+    //! get A and B matrices for a range of stages of a horizon
+    /*!
+     * Equivalent to calling getAandB() for the stages firstIndex, ..., lastIndex, with the time index of a stage equal
+     * to its index in the arrays, but with the dense approximations (BACKWARD_EULER, TUSTIN and MATRIX_EXPONENTIAL)
+     * split into two phases: the continuous-time linearizations are evaluated sequentially, as the linear system is
+     * not required to be thread-safe, and then discretized in parallel. The worker threads are started on the first
+     * call and kept for later ones. A stage whose linearization is identical to the one of the previous stage, e.g.
+     * for a linear time-invariant system, reuses the previous discretization.
+     *
+     * @param x the state setpoints
+     * @param u the control setpoints
+     * @param x_next the states at the end of the intervals
+     * @param firstIndex first stage
+     * @param lastIndex last stage
+     * @param A the resulting linear system matrices A, only the range of stages is written
+     * @param B the resulting linear system matrices B, only the range of stages is written
+     * @param nThreads number of threads used for the discretization
+     */
+    void getAandBBatch(const StateVectorArray<STATE_DIM, SCALAR>& x,
+        const ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+        const StateVectorArray<STATE_DIM, SCALAR>& x_next,
+        const size_t firstIndex,
+        const size_t lastIndex,
+        StateMatrixArray<STATE_DIM, SCALAR>& A,
+        StateControlMatrixArray<STATE_DIM, CONTROL_DIM, SCALAR>& B,
+        size_t nThreads = 1)
+    {
+        if (linearSystem_ == nullptr)
+            throw std::runtime_error("Error in SensitivityApproximation: linearSystem not properly set.");
+
+        if (lastIndex < firstIndex || lastIndex >= x.size() || lastIndex >= u.size() || lastIndex >= x_next.size())
+            throw std::runtime_error("SensitivityApproximation: batch range exceeds the inputs.");
+
+        if (A.size() <= lastIndex)
+            A.resize(lastIndex + 1);
+        if (B.size() <= lastIndex)
+            B.resize(lastIndex + 1);
+
+        if (settings_.approximation_ == SensitivityApproximationSettings::APPROXIMATION::FORWARD_EULER ||
+            settings_.approximation_ == SensitivityApproximationSettings::APPROXIMATION::SYMPLECTIC_EULER)
+        {
+            // no dense kernel involved, the linearization dominates
+            for (size_t k = firstIndex; k <= lastIndex; k++)
+                getAandB(x[k], u[k], x_next[k], static_cast<int>(k), 1, A[k], B[k]);
+            return;
+        }
+
+        // the continuous-time linearizations are indexed relative to the first stage
+        const size_t N = lastIndex - firstIndex + 1;
+        Ac_batch_.resize(N);
+        Bc_batch_.resize(N);
+        AcBack_batch_.resize(N);
+
+        // stages which need to be discretized, the others copy the result of the previous stage
+        unique_batch_.clear();
+
+        for (size_t i = 0; i < N; i++)
+        {
+            const size_t k = firstIndex + i;
+            getContinuousDerivatives(
+                x[k], u[k], x_next[k], static_cast<int>(k), Ac_batch_[i], Bc_batch_[i], AcBack_batch_[i]);
+
+            if (i == 0 || Ac_batch_[i] != Ac_batch_[i - 1] || Bc_batch_[i] != Bc_batch_[i - 1] ||
+                AcBack_batch_[i] != AcBack_batch_[i - 1])
+                unique_batch_.push_back(i);
+        }
+
+        nThreads = std::max(nThreads, size_t(1));
+        if (nThreads > 1 && (workerPool_ == nullptr || workerPool_->nThreads() != nThreads))
+            workerPool_.reset(new WorkerPool(nThreads));
+
+        auto discretizeStage = [&](size_t j) {
+            const size_t i = unique_batch_[j];
+            discretize(Ac_batch_[i], Bc_batch_[i], AcBack_batch_[i], A[firstIndex + i], B[firstIndex + i]);
+        };
+
+        if (nThreads > 1)
+            workerPool_->run(unique_batch_.size(), discretizeStage);
+        else
+            for (size_t j = 0; j < unique_batch_.size(); j++)
+                discretizeStage(j);
+
+        for (size_t j = 0; j < unique_batch_.size(); j++)
+        {
+            const size_t source = firstIndex + unique_batch_[j];
+            const size_t end = firstIndex + ((j + 1 < unique_batch_.size()) ? unique_batch_[j + 1] : N);
+            for (size_t k = source + 1; k < end; k++)
             {
-                symplecticEuler<V_DIM, P_DIM>(x, u, x_next, n, A, B);
+                A[k] = A[source];
+                B[k] = B[source];
+            }
+        }
+    }
+
+
+    //! discretize continuous-time linearizations with one of the dense approximations
+    /*!
+     * Only operates on its arguments and the settings, hence can be called concurrently.
+     *
+     * @param Ac continuous-time A matrix
+     * @param Bc continuous-time B matrix
+     * @param Ac_back continuous-time A matrix at the end of the interval, only used by TUSTIN
+     * @param A_discr resulting discrete-time A matrix
+     * @param B_discr resulting discrete-time B matrix
+     */
+    void discretize(const state_matrix_t& Ac,
+        const state_control_matrix_t& Bc,
+        const state_matrix_t& Ac_back,
+        state_matrix_t& A_discr,
+        state_control_matrix_t& B_discr) const
+    {
+        const SCALAR& dt = settings_.dt_;
+
+        switch (settings_.approximation_)
+        {
+            case SensitivityApproximationSettings::APPROXIMATION::BACKWARD_EULER:
+            {
+                /*!
+                 * the Backward Euler approximation uses the linearization at the *end* of the ZOH interval to
+                 * generate linear approximations A and B.
+                 */
+                Eigen::PartialPivLU<Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM>> lu(state_matrix_t::Identity() - dt * Ac);
+                A_discr = lu.inverse();
+                B_discr = dt * (A_discr * Bc);
                 break;
             }
             case SensitivityApproximationSettings::APPROXIMATION::TUSTIN:
@@ -143,38 +285,31 @@ public:
                  * the Tustin (also known as 'Heun') approximation uses the state and control at the *start* and at the *end*
                  * of the ZOH interval to generate linear approximations A and B in a trapezoidal fashion.
                  */
-
-                //! continuous-time A and B matrices
-                state_matrix_t Ac_front;
-                state_control_matrix_t Bc_front;
-
-                // front derivatives
-                linearSystem_->getDerivatives(Ac_front, Bc_front, x, u, n * settings_.dt_);
-                Ac_front *= settings_.dt_;
-
-                state_matrix_t Ac_back =
-                    settings_.dt_ * linearSystem_->getDerivativeState(x_next, u, (n + 1) * settings_.dt_);
-
-
-                //! tustin approximation
-                state_matrix_t aNewInv;
-                aNewInv.template topLeftCorner<STATE_DIM, STATE_DIM>() =
-                    (state_matrix_t::Identity() - Ac_back).colPivHouseholderQr().inverse();
-                A = aNewInv * (state_matrix_t::Identity() + Ac_front);
-                B = aNewInv * settings_.dt_ * Bc_front;
+                Eigen::PartialPivLU<Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM>> lu(state_matrix_t::Identity() - dt * Ac_back);
+                A_discr = lu.solve(state_matrix_t::Identity() + dt * Ac);
+                B_discr = dt * lu.solve(Bc);
                 break;
             }
             case SensitivityApproximationSettings::APPROXIMATION::MATRIX_EXPONENTIAL:
             {
-                matrixExponential(x, u, n, A, B);
+                /*!
+                 * exp([Ac Bc; 0 0] * dt) = [A_discr B_discr; 0 I], which does not require Ac to be invertible
+                 */
+                Eigen::Matrix<SCALAR, STATE_DIM + CONTROL_DIM, STATE_DIM + CONTROL_DIM> M, expM;
+                M.setZero();
+                M.template topLeftCorner<STATE_DIM, STATE_DIM>() = dt * Ac;
+                M.template topRightCorner<STATE_DIM, CONTROL_DIM>() = dt * Bc;
+                padeExponential<STATE_DIM + CONTROL_DIM, SCALAR>(M, expM);
+
+                A_discr = expM.template topLeftCorner<STATE_DIM, STATE_DIM>();
+                B_discr = expM.template topRightCorner<STATE_DIM, CONTROL_DIM>();
                 break;
             }
             default:
-                throw std::runtime_error("Unknown Approximation type in SensitivityApproximation.");
-        }  // end switch
+                throw std::runtime_error("SensitivityApproximation: approximation has no dense discretization.");
+        }
     }
 
-
 private:
     void forwardEuler(const StateVector<STATE_DIM, SCALAR>& x_n,
         const ControlVector<CONTROL_DIM, SCALAR>& u_n,
@@ -194,44 +329,47 @@ private:
         B_discr = settings_.dt_ * B_cont;
     }
 
-    void backwardEuler(const StateVector<STATE_DIM, SCALAR>& x_n,
-        const ControlVector<CONTROL_DIM, SCALAR>& u_n,
-        const int& n,
-        state_matrix_t& A_discr,
-        state_control_matrix_t& B_discr)
-    {
-        /*!
-		 * the Backward Euler approximation uses the state and control at the *end* of the ZOH interval to
-		 * generate linear approximations A and B.
-		 */
-        state_matrix_t A_cont;
-        state_control_matrix_t B_cont;
-        linearSystem_->getDerivatives(A_cont, B_cont, x_n, u_n, n * settings_.dt_);
-
-        state_matrix_t aNew = settings_.dt_ * A_cont;
-        A_discr.setZero();
-        A_discr.template topLeftCorner<STATE_DIM, STATE_DIM>() =
-            (state_matrix_t::Identity() - aNew).colPivHouseholderQr().inverse();
-
-        B_discr = A_discr * settings_.dt_ * B_cont;
-    }
-
-
-    void matrixExponential(const StateVector<STATE_DIM, SCALAR>& x_n,
-        const ControlVector<CONTROL_DIM, SCALAR>& u_n,
-        const int& n,
-        state_matrix_t& A_discr,
-        state_control_matrix_t& B_discr)
+    //! evaluate the continuous-time linearizations required by the dense approximations
+    /*!
+     * @param x	state at start of interval
+     * @param u control at start of interval
+     * @param x_next state at end of interval
+     * @param n time index
+     * @param Ac continuous-time A matrix, at the end of the interval for BACKWARD_EULER
+     * @param Bc continuous-time B matrix, at the end of the interval for BACKWARD_EULER
+     * @param Ac_back continuous-time A matrix at the end of the interval, only used by TUSTIN
+     */
+    void getContinuousDerivatives(const StateVector<STATE_DIM, SCALAR>& x,
+        const ControlVector<CONTROL_DIM, SCALAR>& u,
+        const StateVector<STATE_DIM, SCALAR>& x_next,
+        const int n,
+        state_matrix_t& Ac,
+        state_control_matrix_t& Bc,
+        state_matrix_t& Ac_back)
     {
-        state_matrix_t Ac;
-        state_control_matrix_t Bc;
-        linearSystem_->getDerivatives(Ac, Bc, x_n, u_n, n * settings_.dt_);
-
-        state_matrix_t Adt = settings_.dt_ * Ac;
+        const SCALAR& dt = settings_.dt_;
 
-        A_discr.template topLeftCorner<STATE_DIM, STATE_DIM>() = Adt.exp();
-        B_discr.template topLeftCorner<STATE_DIM, CONTROL_DIM>() =
-            Ac.inverse() * (A_discr - state_matrix_t::Identity()) * Bc;
+        switch (settings_.approximation_)
+        {
+            case SensitivityApproximationSettings::APPROXIMATION::BACKWARD_EULER:
+            {
+                linearSystem_->getDerivatives(Ac, Bc, x, u, (n + 1) * dt);
+                Ac_back.setZero();
+                break;
+            }
+            case SensitivityApproximationSettings::APPROXIMATION::TUSTIN:
+            {
+                linearSystem_->getDerivatives(Ac, Bc, x, u, n * dt);
+                Ac_back = linearSystem_->getDerivativeState(x_next, u, (n + 1) * dt);
+                break;
+            }
+            default:
+            {
+                linearSystem_->getDerivatives(Ac, Bc, x, u, n * dt);
+                Ac_back.setZero();
+                break;
+            }
+        }
     }
 
 
@@ -381,6 +519,15 @@ private:
 
     //! discretization settings
     SensitivityApproximationSettings settings_;
+
+    //! continuous-time linearizations of the last batch
+    StateMatrixArray<STATE_DIM, SCALAR> Ac_batch_;
+    StateControlMatrixArray<STATE_DIM, CONTROL_DIM, SCALAR> Bc_batch_;
+    StateMatrixArray<STATE_DIM, SCALAR> AcBack_batch_;
+    std::vector<size_t> unique_batch_;
+
+    //! threads discretizing the batches, not shared with copies
+    std::unique_ptr<WorkerPool> workerPool_;
 };
 
 
@@ -160,6 +160,36 @@ Eigen::VectorXd DerivativesCppadJIT<IN_DIM, OUT_DIM>::sparseJacobianValues(const
         throw std::runtime_error("Error: Compile the library first by calling compileJIT(..)");
 }
 
+template <int IN_DIM, int OUT_DIM>
+void DerivativesCppadJIT<IN_DIM, OUT_DIM>::forwardZero(const Eigen::Ref<const Eigen::VectorXd>& x,
+    Eigen::Ref<Eigen::VectorXd> y)
+{
+    if (!compiled_)
+        throw std::runtime_error("Error: Compile the library first by calling compileJIT(..)");
+
+    assert(model_->isForwardZeroAvailable() == true);
+    assert(y.size() == outputDim_);
+    model_->ForwardZero(
+        CppAD::cg::ArrayView<const double>(x.data(), x.size()), CppAD::cg::ArrayView<double>(y.data(), y.size()));
+}
+
+template <int IN_DIM, int OUT_DIM>
+void DerivativesCppadJIT<IN_DIM, OUT_DIM>::sparseJacobianValues(const Eigen::Ref<const Eigen::VectorXd>& x,
+    Eigen::Ref<Eigen::VectorXd> jac)
+{
+    if (!compiled_)
+        throw std::runtime_error("Error: Compile the library first by calling compileJIT(..)");
+
+    assert(model_->isSparseJacobianAvailable() == true);
+    assert(jac.size() == static_cast<int>(sparsityRowsJacobian_.size()));
+
+    // the model returns pointers to its internal sparsity pattern, which matches sparsityRowsJacobian_
+    size_t const* rows;
+    size_t const* cols;
+    model_->SparseJacobian(CppAD::cg::ArrayView<const double>(x.data(), x.size()),
+        CppAD::cg::ArrayView<double>(jac.data(), jac.size()), &rows, &cols);
+}
+
 template <int IN_DIM, int OUT_DIM>
 auto DerivativesCppadJIT<IN_DIM, OUT_DIM>::hessian(const Eigen::VectorXd& x, const Eigen::VectorXd& lambda)
     -> HES_TYPE_D
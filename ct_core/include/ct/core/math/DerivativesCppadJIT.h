@@ -104,6 +104,16 @@ public:
 
     virtual Eigen::VectorXd sparseJacobianValues(const Eigen::VectorXd& x);
 
+    //! evaluates the function into a preallocated vector of size outputDim, does not allocate memory
+    void forwardZero(const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> y);
+
+    //! evaluates the non-zeros of the Jacobian into a preallocated vector of size getNumNonZerosJacobian()
+    /*!
+     * The values are ordered as the sparsity pattern returned by getSparsityPatternJacobian(rows, columns).
+     * Does not allocate memory.
+     */
+    void sparseJacobianValues(const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> jac);
+
 
     virtual HES_TYPE_D hessian(const Eigen::VectorXd& x, const Eigen::VectorXd& lambda);
 
@@ -0,0 +1,56 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace ct {
+namespace core {
+
+/***
+ * Matrix exponential exp(M) by scaling and squaring with a diagonal (6,6) Pade approximant.
+ *
+ * M is scaled by 2^-s such that its infinity norm is at most 1/2, which bounds the relative error of the approximant
+ * by about 3.4e-16 (Golub & Van Loan, Matrix Computations, Algorithm 11.3.1). The result is squared s times.
+ * In contrast to Eigen's MatrixFunctions module, all temporaries are of the fixed size DIM, such that the kernel does
+ * not allocate and can be called concurrently on small matrices.
+ */
+template <int DIM, typename SCALAR>
+void padeExponential(const Eigen::Matrix<SCALAR, DIM, DIM>& M, Eigen::Matrix<SCALAR, DIM, DIM>& expM)
+{
+    typedef Eigen::Matrix<SCALAR, DIM, DIM> matrix_t;
+
+    // Pade coefficients c_k = (2p-k)! p! / ((2p)! k! (p-k)!) for p = 6
+    const SCALAR c1 = 1.0 / 2.0;
+    const SCALAR c2 = 5.0 / 44.0;
+    const SCALAR c3 = 1.0 / 66.0;
+    const SCALAR c4 = 1.0 / 792.0;
+    const SCALAR c5 = 1.0 / 15840.0;
+    const SCALAR c6 = 1.0 / 665280.0;
+
+    const SCALAR norm = M.cwiseAbs().rowwise().sum().maxCoeff();
+    int s = 0;
+    if (norm > SCALAR(0.5))
+        s = std::max(0, static_cast<int>(std::ceil(std::log2(norm / SCALAR(0.5)))));
+
+    const matrix_t A = M * std::ldexp(SCALAR(1.0), -s);
+    const matrix_t A2 = A * A;
+    const matrix_t A4 = A2 * A2;
+    const matrix_t A6 = A4 * A2;
+
+    // split the approximant into its even part V and odd part U, such that exp(A) ~ (V-U)^-1 (V+U)
+    matrix_t U = A * (c1 * matrix_t::Identity() + c3 * A2 + c5 * A4);
+    matrix_t V = matrix_t::Identity() + c2 * A2 + c4 * A4 + c6 * A6;
+
+    expM = (V - U).partialPivLu().solve(V + U);
+
+    for (int i = 0; i < s; i++)
+        expM = (expM * expM).eval();
+}
+
+}  // namespace core
+}  // namespace ct
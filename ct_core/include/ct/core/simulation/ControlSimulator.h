@@ -12,6 +12,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <ct/core/types/Time.h>
 #include <ct/core/types/StateVector.h>
+#include <ct/core/types/trajectories/MatrixTrajectories.h>
 #include <ct/core/integration/Integrator.h>
 #include <ct/core/control/continuous_time/Controller.h>
 
@@ -20,8 +21,12 @@ namespace core {
 
 //! A class for simulating controlled systems in a general way
 /*!
- * This runs two threads - one that integrates the controlled system by applying the defined control,
- * and one that updates the control if needed.
+ * In real-time mode (simulate()), this runs two threads - one that integrates the controlled system by applying the
+ * defined control, and one that updates the control if needed.
+ *
+ * In lock-step mode (simulateLockStep()), controller and system advance alternately on simulated time in the calling
+ * thread. This runs as fast as the computations allow and is reproducible. The computation time of the controller can
+ * be modelled by a compute delay, see setComputeDelay().
  *
  * @tparam CONTROLLED_SYSTEM the controlled system that we wish to simulate
  */
@@ -44,7 +49,13 @@ public:
         const StateVector<STATE_DIM>& x0,
         std::shared_ptr<CONTROLLED_SYSTEM> controlled_system,
         bool verbose = false)
-        : sim_dt_(sim_dt), control_dt_(control_dt), x0_(x0), system_(controlled_system), stop_(false), verbose_(verbose)
+        : sim_dt_(sim_dt),
+          control_dt_(control_dt),
+          compute_delay_(0.0),
+          system_(controlled_system),
+          x0_(x0),
+          stop_(false),
+          verbose_(verbose)
     {
         system_->getController(controller_);
         if (sim_dt_ <= 0 || control_dt_ <= 0)
@@ -55,7 +66,12 @@ public:
 
     //! copy constructor
     ControlSimulator(const ControlSimulator& arg)
-        : sim_dt_(arg.sim_dt_), control_dt_(arg.control_dt_), x0_(arg.x0_), stop_(arg.stop_)
+        : sim_dt_(arg.sim_dt_),
+          control_dt_(arg.control_dt_),
+          compute_delay_(arg.compute_delay_),
+          x0_(arg.x0_),
+          stop_(arg.stop_.load()),
+          verbose_(arg.verbose_)
     {
         if (!arg.system_)
             return;
@@ -96,7 +112,69 @@ public:
 
     //! stops the simulation
     void stop() { stop_ = true; }
+    //! simulates in lock-step on simulated time, blocks until the simulation is done
+    /*!
+     * Every control_dt, the controller iteration is run on the current state. The resulting control becomes active
+     * after the compute delay, in finishSystemIteration(), i.e. the system is integrated over the compute delay with
+     * the previous control.
+     */
+    void simulateLockStep(Time duration, const IntegrationType& intType = IntegrationType::EULERCT)
+    {
+        try
+        {
+            stop_ = false;
+            x_ = x0_;
+            state_trajectory_.clear();
+
+            Integrator<STATE_DIM> integrator(system_, intType);
+
+            // use the step count to avoid accumulating round-off in the simulated time
+            const size_t nControlSteps = size_t(duration / control_dt_ + 1e-9);
+            for (size_t k = 0; k < nControlSteps && !stop_; k++)
+            {
+                const Time sim_time = k * control_dt_;
+                state_trajectory_.push_back(x_, sim_time, true);
+
+                prepareControllerIteration(sim_time);
+                finishControllerIteration(sim_time);
+
+                integrateInterval(integrator, sim_time, compute_delay_);
+                finishSystemIteration(sim_time + compute_delay_);
+                integrateInterval(integrator, sim_time + compute_delay_, control_dt_ - compute_delay_);
+            }
+
+            state_trajectory_.push_back(x_, nControlSteps * control_dt_, true);
+        } catch (std::exception& e)
+        {
+            throw(std::runtime_error(std::string("Control Simulator failed: ") + e.what()));
+        }
+    }
+
+    //! set the modelled computation time of the controller in lock-step mode, needs to be within [0, control_dt]
+    void setComputeDelay(Time compute_delay)
+    {
+        if (compute_delay < 0 || compute_delay > control_dt_)
+            throw std::runtime_error("The compute delay must be within [0, control_dt].");
+        compute_delay_ = compute_delay;
+    }
+
+    //! get the modelled computation time of the controller in lock-step mode
+    Time getComputeDelay() const { return compute_delay_; }
+    //! the state at every controller iteration and at the end of the last lock-step simulation
+    const StateTrajectory<STATE_DIM>& getStateTrajectory() const { return state_trajectory_; }
 protected:
+    //! integrates the state x_ over an interval of the given length, with steps of at most sim_dt
+    void integrateInterval(Integrator<STATE_DIM>& integrator, Time start_time, Time length)
+    {
+        const size_t nSteps = size_t(length / sim_dt_ + 1e-9);
+        if (nSteps > 0)
+            integrator.integrate_n_steps(x_, start_time, nSteps, sim_dt_);
+
+        const Time residue = length - nSteps * sim_dt_;
+        if (residue > 1e-9)
+            integrator.integrate_n_steps(x_, start_time + nSteps * sim_dt_, 1, residue);
+    }
+
     //! run by the thread that simulates the system
     virtual void simulateSystem(Time duration, const IntegrationType& intType = IntegrationType::EULERCT)
     {
@@ -138,8 +216,7 @@ protected:
             }
         } catch (std::exception& e)
         {
-            std::cout << e.what() << std::endl;
-            throw(std::runtime_error("Control Simulator failed."));
+            throw(std::runtime_error(std::string("Control Simulator failed: ") + e.what()));
         }
     }
 
@@ -163,13 +240,13 @@ protected:
             }
         } catch (std::exception& e)
         {
-            std::cout << e.what() << std::endl;
-            throw(std::runtime_error("Control Simulator failed."));
+            throw(std::runtime_error(std::string("Control Simulator failed: ") + e.what()));
         }
     }
 
     Time sim_dt_;
     Time control_dt_;
+    Time compute_delay_;
     std::shared_ptr<CONTROLLED_SYSTEM> system_;
     std::shared_ptr<Controller<STATE_DIM, CONTROL_DIM, SCALAR>> controller_;
     std::chrono::time_point<std::chrono::high_resolution_clock> sim_start_time_;
@@ -181,6 +258,7 @@ protected:
     std::mutex control_mtx_;
     std::atomic<bool> stop_;
     bool verbose_;
+    StateTrajectory<STATE_DIM> state_trajectory_;
 };
 
 }  // namespace core
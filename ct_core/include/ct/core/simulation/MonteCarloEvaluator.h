@@ -0,0 +1,298 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <ct/core/common/CounterRandomGenerator.h>
+#include <ct/core/integration/Integrator.h>
+
+namespace ct {
+namespace core {
+
+//! Evaluates a closed loop, e.g. a StateFeedbackController policy, over many randomly perturbed rollouts in parallel
+/*!
+ * Every sample is created by a factory, which returns the controlled system (including its controller) with sampled
+ * parameters and samples the initial state. Optionally, Gaussian process noise is added to the state after every
+ * integration step. All random numbers are drawn from counter-based streams (see CounterRandomGenerator), which only
+ * depend on the seed and on the sample index, such that the results are reproducible and independent of the number
+ * of threads.
+ *
+ * The rollouts are not stored. The cost, the constraint violations and the terminal error are evaluated while
+ * integrating, such that only a few numbers per sample are kept to compute the statistics and percentiles. The
+ * factory and the evaluation functions are called concurrently from the worker threads, hence need to be thread-safe.
+ *
+ * @tparam CONTROLLED_SYSTEM the controlled system that we wish to evaluate
+ */
+template <class CONTROLLED_SYSTEM>
+class MonteCarloEvaluator
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    static const size_t STATE_DIM = CONTROLLED_SYSTEM::STATE_DIM;
+    static const size_t CONTROL_DIM = CONTROLLED_SYSTEM::CONTROL_DIM;
+
+    using SCALAR = typename CONTROLLED_SYSTEM::SCALAR;
+    using state_vector_t = StateVector<STATE_DIM, SCALAR>;
+    using control_vector_t = ControlVector<CONTROL_DIM, SCALAR>;
+
+    //! the random streams of a sample
+    struct SampleGenerators
+    {
+        SampleGenerators(uint64_t seed, size_t sample)
+            : initialState(seed, sample, 0), parameters(seed, sample, 1), noise(seed, sample, 2)
+        {
+        }
+
+        CounterRandomGenerator initialState;  //!< for sampling the initial state
+        CounterRandomGenerator parameters;    //!< for sampling the system parameters
+        CounterRandomGenerator noise;         //!< for the process noise
+    };
+
+    //! creates the closed-loop system of a sample and samples its initial state
+    using SampleFactory_t =
+        std::function<std::shared_ptr<CONTROLLED_SYSTEM>(size_t sample, SampleGenerators& rng, state_vector_t& x0)>;
+
+    //! cost of a stage, integrated over time
+    using StageCost_t = std::function<SCALAR(const state_vector_t& x, const control_vector_t& u, const Time& t)>;
+    //! cost of the final state
+    using TerminalCost_t = std::function<SCALAR(const state_vector_t& x)>;
+    //! returns true if the constraints are satisfied at the given stage
+    using Constraint_t = std::function<bool(const state_vector_t& x, const control_vector_t& u, const Time& t)>;
+
+    //! the statistics over all samples
+    struct Statistics
+    {
+        size_t nSamples = 0;  //!< number of evaluated samples
+        size_t nFailed = 0;   //!< number of samples which threw an exception or diverged
+
+        SCALAR costMean = 0.0;
+        SCALAR costStdDev = 0.0;
+
+        //! fraction of successful samples which violated a constraint at least once
+        SCALAR violationRate = 0.0;
+        //! fraction of all stages of the successful samples at which a constraint was violated
+        SCALAR stageViolationRate = 0.0;
+
+        std::vector<SCALAR> costs;           //!< cost of the successful samples, sorted
+        std::vector<SCALAR> terminalErrors;  //!< terminal error of the successful samples, sorted
+
+        //! percentile p in [0, 100] of the cost
+        SCALAR costPercentile(double p) const { return percentile(costs, p); }
+        //! percentile p in [0, 100] of the terminal error
+        SCALAR terminalErrorPercentile(double p) const { return percentile(terminalErrors, p); }
+    };
+
+    /*!
+     * @brief constructor
+     * @param factory creates the closed-loop system and the initial state of a sample
+     * @param dt integration and evaluation step size
+     * @param nThreads number of worker threads
+     */
+    MonteCarloEvaluator(const SampleFactory_t& factory,
+        const Time& dt,
+        size_t nThreads = std::max(1u, std::thread::hardware_concurrency()))
+        : factory_(factory), dt_(dt), nThreads_(nThreads), seed_(0), intType_(IntegrationType::RK4)
+    {
+        if (dt_ <= 0)
+            throw std::runtime_error("MonteCarloEvaluator: step size needs to be positive.");
+        if (nThreads_ < 1)
+            throw std::runtime_error("MonteCarloEvaluator: number of threads needs to be positive.");
+
+        noiseStdDev_.setZero();
+        terminalReference_.setZero();
+    }
+
+    //! set the seed of the random streams
+    void setSeed(uint64_t seed) { seed_ = seed; }
+    //! set the integration type
+    void setIntegrationType(const IntegrationType& intType) { intType_ = intType; }
+    //! set the cost, the terminal cost is optional
+    void setCost(const StageCost_t& stageCost, const TerminalCost_t& terminalCost = TerminalCost_t())
+    {
+        stageCost_ = stageCost;
+        terminalCost_ = terminalCost;
+    }
+    //! set the constraints to be checked at every stage
+    void setConstraint(const Constraint_t& constraint) { constraint_ = constraint; }
+    //! set the state the terminal error is measured to (2-norm), zero by default
+    void setTerminalReference(const state_vector_t& x_ref) { terminalReference_ = x_ref; }
+    //! set the standard deviation of the Gaussian noise added to the state after every step, zero by default
+    void setProcessNoise(const state_vector_t& stdDev) { noiseStdDev_ = stdDev; }
+    /*!
+     * @brief evaluate samples 0, ..., nSamples-1
+     * @param nSamples number of samples
+     * @param duration simulated time of every sample
+     * @return the statistics over the samples
+     */
+    Statistics run(size_t nSamples, const Time& duration)
+    {
+        const size_t nSteps = std::max<size_t>(1, std::lround(duration / dt_));
+
+        std::vector<SampleResult> results(nSamples);
+        std::atomic<size_t> nextSample(0);
+
+        auto worker = [&]() {
+            for (size_t i = nextSample++; i < nSamples; i = nextSample++)
+            {
+                try
+                {
+                    results[i] = evaluateSample(i, nSteps);
+                } catch (std::exception&)
+                {
+                    results[i].success = false;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < std::min(nThreads_, nSamples); t++)
+            threads.emplace_back(worker);
+
+        for (auto& thread : threads)
+            thread.join();
+
+        // reduce in the order of the samples, such that the statistics do not depend on the threading
+        Statistics statistics;
+        statistics.nSamples = nSamples;
+
+        size_t nViolatingSamples = 0;
+        size_t nViolatedStages = 0;
+        SCALAR m2 = 0.0;
+
+        for (const SampleResult& result : results)
+        {
+            if (!result.success)
+            {
+                statistics.nFailed++;
+                continue;
+            }
+
+            statistics.costs.push_back(result.cost);
+            statistics.terminalErrors.push_back(result.terminalError);
+            nViolatingSamples += (result.violatedStages > 0);
+            nViolatedStages += result.violatedStages;
+
+            // Welford's update of mean and variance
+            const SCALAR delta = result.cost - statistics.costMean;
+            statistics.costMean += delta / statistics.costs.size();
+            m2 += delta * (result.cost - statistics.costMean);
+        }
+
+        const size_t nSuccessful = statistics.costs.size();
+        if (nSuccessful > 0)
+        {
+            statistics.costStdDev = nSuccessful > 1 ? std::sqrt(m2 / (nSuccessful - 1)) : SCALAR(0.0);
+            statistics.violationRate = SCALAR(nViolatingSamples) / nSuccessful;
+            statistics.stageViolationRate = SCALAR(nViolatedStages) / (nSuccessful * (nSteps + 1));
+        }
+
+        std::sort(statistics.costs.begin(), statistics.costs.end());
+        std::sort(statistics.terminalErrors.begin(), statistics.terminalErrors.end());
+
+        return statistics;
+    }
+
+    //! percentile p in [0, 100] of sorted values, linearly interpolated
+    static SCALAR percentile(const std::vector<SCALAR>& sorted, double p)
+    {
+        if (sorted.empty())
+            return std::numeric_limits<SCALAR>::quiet_NaN();
+
+        const double pos = std::max(0.0, std::min(p, 100.0)) / 100.0 * (sorted.size() - 1);
+        const size_t i = std::min((size_t)pos, sorted.size() - 1);
+        const size_t j = std::min(i + 1, sorted.size() - 1);
+        return sorted[i] + (pos - i) * (sorted[j] - sorted[i]);
+    }
+
+private:
+    //! the outcome of a sample
+    struct SampleResult
+    {
+        bool success = false;
+        SCALAR cost = 0.0;
+        SCALAR terminalError = 0.0;
+        size_t violatedStages = 0;
+    };
+
+    SampleResult evaluateSample(size_t sample, size_t nSteps) const
+    {
+        SampleGenerators rng(seed_, sample);
+
+        state_vector_t x;
+        x.setZero();
+        std::shared_ptr<CONTROLLED_SYSTEM> system = factory_(sample, rng, x);
+        if (!system)
+            throw std::runtime_error("MonteCarloEvaluator: factory returned no system.");
+
+        auto controller = system->getController();
+        Integrator<STATE_DIM, SCALAR> integrator(system, intType_);
+        std::normal_distribution<SCALAR> normal;
+        const bool noisy = !noiseStdDev_.isZero();
+
+        SampleResult result;
+        control_vector_t u;
+
+        for (size_t k = 0; k <= nSteps; k++)
+        {
+            const Time t = k * dt_;
+
+            if (controller)
+                controller->computeControl(x, t, u);
+            else
+                u.setZero();
+
+            if (constraint_ && !constraint_(x, u, t))
+                result.violatedStages++;
+
+            if (k == nSteps)
+                break;
+
+            if (stageCost_)
+                result.cost += stageCost_(x, u, t) * dt_;
+
+            integrator.integrate_n_steps(x, t, 1, dt_);
+
+            if (noisy)
+                for (size_t j = 0; j < STATE_DIM; j++)
+                    x(j) += noiseStdDev_(j) * normal(rng.noise);
+
+            if (!x.allFinite())
+                return result;
+        }
+
+        if (terminalCost_)
+            result.cost += terminalCost_(x);
+
+        result.terminalError = (x - terminalReference_).norm();
+        result.success = std::isfinite(result.cost);
+        return result;
+    }
+
+    SampleFactory_t factory_;
+    StageCost_t stageCost_;
+    TerminalCost_t terminalCost_;
+    Constraint_t constraint_;
+
+    Time dt_;
+    size_t nThreads_;
+    uint64_t seed_;
+    IntegrationType intType_;
+
+    state_vector_t terminalReference_;
+    state_vector_t noiseStdDev_;
+};
+
+}  // namespace core
+}  // namespace ct
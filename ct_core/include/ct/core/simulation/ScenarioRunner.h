@@ -0,0 +1,127 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ct/core/common/Timer.h>
+#include "ControlSimulator.h"
+
+namespace ct {
+namespace core {
+
+//! Runs many closed-loop simulations in parallel
+/*!
+ * Every scenario is simulated by its own ControlSimulator in lock-step mode (see ControlSimulator::simulateLockStep()),
+ * such that the results are reproducible and independent of the number of threads. The simulators are created by a
+ * factory, which sets up the scenario, e.g. the initial state, disturbances or system parameters. The factory and the
+ * callback are called concurrently from the worker threads, hence need to be thread-safe.
+ *
+ * @tparam CONTROLLED_SYSTEM the controlled system that we wish to simulate
+ */
+template <class CONTROLLED_SYSTEM>
+class ScenarioRunner
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    static const size_t STATE_DIM = CONTROLLED_SYSTEM::STATE_DIM;
+
+    using Simulator_t = ControlSimulator<CONTROLLED_SYSTEM>;
+    using SimulatorPtr_t = std::shared_ptr<Simulator_t>;
+
+    //! creates the simulator for a scenario
+    using SimulatorFactory_t = std::function<SimulatorPtr_t(size_t scenario)>;
+
+    //! called after a scenario has been simulated successfully, e.g. to evaluate it
+    using ScenarioCallback_t = std::function<void(size_t scenario, Simulator_t& simulator)>;
+
+    //! the outcome of a scenario
+    struct Result
+    {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        bool success = false;                         //!< false if the simulation threw an exception
+        std::string error;                            //!< the exception message if not successful
+        StateTrajectory<STATE_DIM> stateTrajectory;  //!< the state at every controller iteration
+        double wallTime = 0.0;                        //!< the wall clock time of the scenario [s]
+    };
+
+    /*!
+     * @brief constructor
+     * @param factory creates the simulator for a scenario
+     * @param nThreads number of worker threads
+     */
+    ScenarioRunner(const SimulatorFactory_t& factory, size_t nThreads = std::max(1u, std::thread::hardware_concurrency()))
+        : factory_(factory), nThreads_(nThreads)
+    {
+        if (nThreads_ < 1)
+            throw std::runtime_error("ScenarioRunner: number of threads needs to be positive.");
+    }
+
+    //! set a callback which is called for every successful scenario
+    void setCallback(const ScenarioCallback_t& callback) { callback_ = callback; }
+    /*!
+     * @brief simulate scenarios 0, ..., nScenarios-1
+     * @param nScenarios number of scenarios
+     * @param duration simulated time of every scenario
+     * @param intType integration type
+     * @return the results, in the order of the scenarios
+     */
+    std::vector<Result> run(size_t nScenarios,
+        Time duration,
+        const IntegrationType& intType = IntegrationType::EULERCT)
+    {
+        std::vector<Result> results(nScenarios);
+        std::atomic<size_t> nextScenario(0);
+
+        auto worker = [&]() {
+            Timer timer;
+            for (size_t i = nextScenario++; i < nScenarios; i = nextScenario++)
+            {
+                timer.start();
+                try
+                {
+                    SimulatorPtr_t simulator = factory_(i);
+                    simulator->simulateLockStep(duration, intType);
+                    results[i].stateTrajectory = simulator->getStateTrajectory();
+
+                    if (callback_)
+                        callback_(i, *simulator);
+
+                    results[i].success = true;
+                } catch (std::exception& e)
+                {
+                    results[i].error = e.what();
+                }
+                timer.stop();
+                results[i].wallTime = timer.getElapsedTime();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < std::min(nThreads_, nScenarios); t++)
+            threads.emplace_back(worker);
+
+        for (auto& thread : threads)
+            thread.join();
+
+        return results;
+    }
+
+private:
+    SimulatorFactory_t factory_;
+    ScenarioCallback_t callback_;
+    size_t nThreads_;
+};
+
+}  // namespace core
+}  // namespace ct
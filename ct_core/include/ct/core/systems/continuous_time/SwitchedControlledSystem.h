@@ -107,6 +107,10 @@ public:
         switchedSystems_[mode]->computeControlledDynamics(state, t, control, derivative);
     };
 
+    //! get the subsystems, indexed by their mode
+    const SwitchedSystems& getSwitchedSystems() const { return switchedSystems_; }
+    //! get the prespecified mode sequence
+    const ContinuousModeSequence& getModeSequence() const { return continuousModeSequence_; }
 protected:
     SwitchedSystems switchedSystems_;                //!< switched system container
     ContinuousModeSequence continuousModeSequence_;  //!< the prespecified mode sequence
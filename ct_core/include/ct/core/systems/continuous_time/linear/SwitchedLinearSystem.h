@@ -87,6 +87,10 @@ public:
         return switchedLinearSystems_[mode]->getDerivativeControl(x, u, t);
     };
 
+    //! get the linear subsystems, indexed by their mode
+    const SwitchedLinearSystems& getSwitchedLinearSystems() const { return switchedLinearSystems_; }
+    //! get the prespecified mode sequence
+    const ContinuousModeSequence& getModeSequence() const { return continuousModeSequence_; }
 private:
     SwitchedLinearSystems switchedLinearSystems_;    //!< Switched linear system container
     ContinuousModeSequence continuousModeSequence_;  //!< the prespecified mode sequence
@@ -119,6 +119,10 @@ public:
         switchedSystems_[mode]->propagateControlledDynamics(state, n, control, stateNext);
     };
 
+    //! get the subsystems, indexed by their mode
+    const SwitchedSystems& getSwitchedSystems() const { return switchedSystems_; }
+    //! get the prespecified mode sequence
+    const DiscreteModeSequence& getModeSequence() const { return discreteModeSequence_; }
 protected:
     SwitchedSystems switchedSystems_;            //!< switched system container
     DiscreteModeSequence discreteModeSequence_;  //!< the prespecified mode sequence
@@ -117,6 +117,10 @@ public:
 
     using DiscreteLinearSystem<STATE_DIM, CONTROL_DIM, SCALAR>::getAandB;
 
+    //! get the linear subsystems, indexed by their mode
+    const SwitchedLinearSystems& getSwitchedLinearSystems() const { return switchedLinearSystems_; }
+    //! get the prespecified mode sequence
+    const DiscreteModeSequence& getModeSequence() const { return discreteModeSequence_; }
 protected:
     SwitchedLinearSystems switchedLinearSystems_;  //!< Switched linear system container
     DiscreteModeSequence discreteModeSequence_;    //!< the prespecified mode sequence
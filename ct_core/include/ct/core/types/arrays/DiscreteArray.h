@@ -5,6 +5,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <iostream>
 
@@ -162,6 +163,16 @@ public:
     const Base& toImplementation() const { return *this; }
     //! erase an element from the front
     void eraseFront(const size_t N) { this->erase(this->begin(), this->begin() + N); }
+    //! moves all elements N positions to the front and fills the back with copies of the last element, in place
+    void shiftFront(const size_t N)
+    {
+        if (N == 0 || this->size() == 0)
+            return;
+
+        const size_t n = std::min(N, this->size() - 1);
+        std::move(this->begin() + n, this->end(), this->begin());
+        std::fill(this->end() - n, this->end(), *(this->end() - n - 1));
+    }
     //! sets all elements to a constant.
     void setConstant(const T& data) { std::fill(this->begin(), this->end(), data); }
     //! add an offset to each element
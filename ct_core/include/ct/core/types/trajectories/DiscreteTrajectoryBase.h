@@ -139,6 +139,20 @@ public:
         return result;
     }
 
+    //! evaluate the trajectory at many times
+    /*!
+	 * Equivalent to calling eval() for each time, but checks the trajectory only once. On evenly spaced time stamps,
+	 * each evaluation takes constant time, e.g. for plotting or resampling.
+	 * @param evalTimes time stamps at which to evaluate the trajectory
+	 * @return trajectory values
+	 */
+    DiscreteArray<T, Alloc> evalMany(const tpl::TimeArray<SCALAR>& evalTimes)
+    {
+        DiscreteArray<T, Alloc> result;
+        interp_.interpolateMany(time_, data_, evalTimes, result);
+        return result;
+    }
+
     //! returns the size of the trajectory
     /*!
 	 * @return size of trajectory
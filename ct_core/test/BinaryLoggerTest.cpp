@@ -0,0 +1,128 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <cstdio>
+
+#include <ct/core/core.h>
+
+// Bring in gtest
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+
+TEST(BinaryLoggerTest, LogAndReadTest)
+{
+    const std::string filename = "binaryLoggerTest.ctlog";
+
+    BinaryLogger logger;
+    const size_t stateChannel = logger.addChannel("x");
+    const size_t costChannel = logger.addChannel("cost");
+    const size_t gainChannel = logger.addChannel("some/feedback gains");
+    logger.open(filename);
+    ASSERT_THROW(logger.addChannel("late"), std::runtime_error);
+
+    StateVectorArray<2> x(4);
+    FeedbackArray<2, 3> L(3);
+    for (size_t iteration = 0; iteration < 10; iteration++)
+    {
+        for (size_t k = 0; k < x.size(); k++)
+            x[k] << iteration, k;
+        for (size_t k = 0; k < L.size(); k++)
+            L[k].setConstant(iteration + 0.1 * k);
+
+        ASSERT_TRUE(logger.logArray(stateChannel, iteration, x));
+        ASSERT_TRUE(logger.log(costChannel, iteration, 1.0 / (iteration + 1)));
+        ASSERT_TRUE(logger.logArray(gainChannel, iteration, L));
+    }
+
+    // the file can be read while it is open
+    logger.flush();
+    BinaryLogReader reader(filename);
+    ASSERT_EQ(reader.records("cost").size(), 10u);
+
+    ASSERT_TRUE(logger.log(gainChannel, 10, Eigen::Matrix3d::Identity()));
+    logger.close();
+    ASSERT_FALSE(logger.log(gainChannel, 11, Eigen::Matrix3d::Identity()));
+    ASSERT_EQ(logger.droppedRecords(), 0u);
+
+    reader.read(filename);
+    ASSERT_EQ(reader.channels().size(), 3u);
+    ASSERT_EQ(reader.channels()[2], "some/feedback gains");
+    ASSERT_EQ(reader.channel("x"), stateChannel);
+    ASSERT_THROW(reader.channel("y"), std::runtime_error);
+
+    ASSERT_EQ(reader.records(stateChannel).size(), 10u);
+    ASSERT_EQ(reader.records(costChannel).size(), 10u);
+    ASSERT_EQ(reader.records(gainChannel).size(), 11u);
+
+    for (size_t iteration = 0; iteration < 10; iteration++)
+    {
+        const BinaryLogReader::Record& state = reader.records(stateChannel)[iteration];
+        ASSERT_EQ(state.iteration, iteration);
+        ASSERT_EQ(state.data.rows(), 2);
+        ASSERT_EQ(state.data.cols(), 4);
+        for (size_t k = 0; k < 4; k++)
+        {
+            ASSERT_EQ(state.data(0, k), iteration);
+            ASSERT_EQ(state.data(1, k), k);
+        }
+
+        ASSERT_EQ(reader.records(costChannel)[iteration].data(0, 0), 1.0 / (iteration + 1));
+
+        const BinaryLogReader::Record& gains = reader.records(gainChannel)[iteration];
+        ASSERT_EQ(gains.data.rows(), 6);
+        ASSERT_EQ(gains.data.cols(), 3);
+        for (size_t k = 0; k < 3; k++)
+            ASSERT_EQ(gains.data.col(k), Eigen::VectorXd::Constant(6, iteration + 0.1 * k));
+    }
+    ASSERT_EQ(reader.records(gainChannel)[10].data, Eigen::MatrixXd::Identity(3, 3));
+
+    std::remove(filename.c_str());
+}
+
+TEST(BinaryLoggerTest, RingBufferTest)
+{
+    const std::string filename = "binaryLoggerRingTest.ctlog";
+
+    // a ring buffer of 32 words holds four records of 3 + 4 words
+    BinaryLogger logger(256, std::chrono::microseconds(100));
+    logger.addChannel("v");
+    logger.open(filename);
+
+    // the records wrap around the end of the ring buffer
+    for (size_t i = 0; i < 100; i++)
+    {
+        ASSERT_TRUE(logger.log(0, i, Eigen::Vector4d::Constant(i)));
+        logger.flush();
+    }
+
+    // if the writing thread falls behind, records are dropped instead of blocking
+    size_t nLogged = 0;
+    for (size_t i = 100; i < 1100; i++)
+        nLogged += logger.log(0, i, Eigen::Vector4d::Constant(i));
+    logger.close();
+
+    ASSERT_EQ(nLogged + logger.droppedRecords(), 1000u);
+
+    BinaryLogReader reader(filename);
+    const std::vector<BinaryLogReader::Record>& records = reader.records(0);
+    ASSERT_EQ(records.size(), 100 + nLogged);
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        ASSERT_EQ(records[i].data, Eigen::MatrixXd::Constant(4, 1, records[i].iteration));
+        if (i > 0)
+        {
+            ASSERT_GT(records[i].iteration, records[i - 1].iteration);
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -46,6 +46,65 @@ TEST(InterplationTest, Linear)
 }
 
 
+TEST(InterplationTest, FindIndex)
+{
+    const size_t N = 50;
+
+    // evenly and unevenly spaced time stamps, the latter with a repeated time stamp
+    TimeArray evenTime(0.1, N, -1.0);
+    TimeArray unevenTime(N);
+    unevenTime[0] = -1.0;
+    for (size_t i = 1; i < N; i++)
+        unevenTime[i] = (i == N / 2) ? unevenTime[i - 1] : unevenTime[i - 1] + 0.01 + 0.2 * std::rand() / RAND_MAX;
+
+    for (const TimeArray& timeStamp : {evenTime, unevenTime})
+    {
+        DiscreteArray<double> data(N);
+        for (size_t i = 0; i < N; i++)
+            data[i] = std::sin(3.0 * i);
+
+        ct::core::Interpolation<double> interpolation(InterpolationType::LIN);
+
+        // sorted, random and exact enquiry times, including ones outside of the time stamps
+        const double duration = timeStamp.back() - timeStamp.front();
+        TimeArray enquiryTimes;
+        for (size_t i = 0; i < 200; i++)
+            enquiryTimes.push_back(timeStamp.front() - 0.5 + (duration + 1.0) * i / 199.0);
+        for (size_t i = 0; i < 200; i++)
+            enquiryTimes.push_back(timeStamp.front() - 0.5 + (duration + 1.0) * std::rand() / RAND_MAX);
+        for (size_t i = 0; i < N; i++)
+            enquiryTimes.push_back(timeStamp[N - 1 - i]);
+
+        for (size_t j = 0; j < enquiryTimes.size(); j++)
+        {
+            // greatest index with a time stamp not larger than the enquiry time, by linear search
+            int index = 0;
+            for (size_t i = 0; i < N; i++)
+                if (timeStamp[i] <= enquiryTimes[j])
+                    index = i;
+
+            ASSERT_EQ(interpolation.findIndex(timeStamp, enquiryTimes[j]), index);
+        }
+
+        DiscreteArray<double> results;
+        interpolation.interpolateMany(timeStamp, data, enquiryTimes, results);
+        ASSERT_EQ(results.size(), enquiryTimes.size());
+
+        DiscreteTrajectoryBase<double> trajectory(timeStamp, data, InterpolationType::LIN);
+        DiscreteArray<double> trajectoryResults = trajectory.evalMany(enquiryTimes);
+
+        for (size_t j = 0; j < enquiryTimes.size(); j++)
+        {
+            double result;
+            ct::core::Interpolation<double> reference(InterpolationType::LIN);
+            reference.interpolate(timeStamp, data, enquiryTimes[j], result);
+
+            ASSERT_EQ(results[j], result);
+            ASSERT_EQ(trajectoryResults[j], result);
+        }
+    }
+}
+
 /*!
  *  \example InterpolationTest.cpp
  *
@@ -0,0 +1,46 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ct/core/core.h>
+
+
+using namespace ct::core;
+
+
+TEST(WorkerPoolTest, WorkerPoolTest)
+{
+    for (size_t nThreads : {1, 2, 4})
+    {
+        WorkerPool pool(nThreads);
+        ASSERT_EQ(pool.nThreads(), nThreads);
+
+        // the same threads process many batches of different sizes, every task is run exactly once per batch
+        for (size_t batch = 0; batch < 200; batch++)
+        {
+            const size_t nTasks = batch % 13;
+            std::vector<std::atomic<int>> calls(nTasks);
+            for (auto& c : calls)
+                c = 0;
+
+            pool.run(nTasks, [&](size_t i) { calls[i]++; });
+
+            for (size_t i = 0; i < nTasks; i++)
+            {
+                ASSERT_EQ(calls[i].load(), 1);
+            }
+        }
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
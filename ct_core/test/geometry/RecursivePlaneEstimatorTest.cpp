@@ -0,0 +1,130 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/core/core.h>
+#include <ct/core/geometry/RecursivePlaneEstimator.h>
+
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+
+//! noisy points around the plane z = 0.1 x - 0.2 y + 3, far from the origin
+RecursivePlaneEstimator::point_measurements_t generatePoints(size_t n, double noise)
+{
+    RecursivePlaneEstimator::point_measurements_t points(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        Eigen::Vector2d xy = 100.0 * Eigen::Vector2d::Ones() + 5.0 * Eigen::Vector2d::Random();
+        points[i] << xy, 0.1 * xy(0) - 0.2 * xy(1) + 3.0 + noise * Eigen::Matrix<double, 1, 1>::Random()(0);
+    }
+    return points;
+}
+
+//! the total least squares plane of weighted points, computed from scratch
+Eigen::Vector4d batchFit(const RecursivePlaneEstimator::point_measurements_t& points, const Eigen::VectorXd& weights)
+{
+    Eigen::Vector3d centroid = Eigen::Vector3d::Zero();
+    for (size_t i = 0; i < points.size(); i++)
+        centroid += weights(i) * points[i];
+    centroid /= weights.sum();
+
+    Eigen::Matrix3d scatter = Eigen::Matrix3d::Zero();
+    for (size_t i = 0; i < points.size(); i++)
+        scatter += weights(i) * (points[i] - centroid) * (points[i] - centroid).transpose();
+
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigenSolver(scatter);
+    Eigen::Vector3d normal = eigenSolver.eigenvectors().col(0);
+    if (normal(2) < 0.0)
+        normal = -normal;
+
+    Eigen::Vector4d coefficients;
+    coefficients << normal, normal.dot(centroid);
+    return coefficients;
+}
+
+TEST(RecursivePlaneEstimatorTest, RecoversPlane)
+{
+    RecursivePlaneEstimator estimator;
+    ASSERT_ANY_THROW(estimator.estimate());
+
+    estimator.addPoints(generatePoints(50, 0.0));
+    Eigen::Vector4d coefficients = estimator.estimate().getCoefficients();
+
+    // z = 0.1 x - 0.2 y + 3 normalized
+    Eigen::Vector4d expected(-0.1, 0.2, 1.0, 3.0);
+    expected /= expected.head<3>().norm();
+    ASSERT_LT((coefficients - expected).norm(), 1e-8);
+}
+
+TEST(RecursivePlaneEstimatorTest, ForgettingMatchesWeightedFit)
+{
+    const double lambda = 0.9;
+    const size_t n = 30;
+    RecursivePlaneEstimator::point_measurements_t points = generatePoints(n, 0.5);
+
+    RecursivePlaneEstimator estimator(lambda);
+    estimator.addPoints(points);
+
+    Eigen::VectorXd weights(n);
+    for (size_t i = 0; i < n; i++)
+        weights(i) = std::pow(lambda, n - 1 - i);
+
+    ASSERT_NEAR(estimator.getWeight(), weights.sum(), 1e-10);
+    ASSERT_LT((estimator.estimate().getCoefficients() - batchFit(points, weights)).norm(), 1e-8);
+}
+
+TEST(RecursivePlaneEstimatorTest, SlidingWindow)
+{
+    const size_t n = 200;
+    const size_t window = 10;
+    RecursivePlaneEstimator::point_measurements_t points = generatePoints(n, 0.5);
+    RecursivePlaneEstimator::point_measurements_t lastPoints(points.end() - window, points.end());
+
+    for (double lambda : {1.0, 0.95})
+    {
+        RecursivePlaneEstimator estimator(lambda, window);
+        estimator.addPoints(points);
+        ASSERT_EQ(estimator.getNumPoints(), window);
+
+        Eigen::VectorXd weights(window);
+        for (size_t i = 0; i < window; i++)
+            weights(i) = std::pow(lambda, window - 1 - i);
+
+        ASSERT_NEAR(estimator.getWeight(), weights.sum(), 1e-10);
+        ASSERT_LT((estimator.estimate().getCoefficients() - batchFit(lastPoints, weights)).norm(), 1e-8);
+    }
+
+    // removing points manually gives the same result
+    RecursivePlaneEstimator estimator;
+    estimator.addPoints(points);
+    for (size_t i = 0; i < n - window; i++)
+        estimator.removePoint(points[i]);
+    ASSERT_EQ(estimator.getNumPoints(), window);
+    ASSERT_LT((estimator.estimate().getCoefficients() - batchFit(lastPoints, Eigen::VectorXd::Ones(window))).norm(),
+        1e-8);
+}
+
+TEST(RecursivePlaneEstimatorTest, BatchedPatches)
+{
+    RecursivePlaneEstimator::patches_t patches(4);
+    patches[0].addPoints(generatePoints(10, 0.1));
+    patches[1].addPoints(generatePoints(2, 0.1));
+    patches[3].addPoints(generatePoints(20, 0.1));
+
+    RecursivePlaneEstimator::planes_t planes;
+    std::vector<bool> valid;
+    ASSERT_EQ(RecursivePlaneEstimator::estimate(patches, planes, valid), 2u);
+
+    ASSERT_EQ(planes.size(), patches.size());
+    ASSERT_TRUE(valid[0] && !valid[1] && !valid[2] && valid[3]);
+    ASSERT_TRUE(planes[0].getCoefficients().isApprox(patches[0].estimate().getCoefficients()));
+    ASSERT_TRUE(planes[1].getCoefficients().isZero());
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
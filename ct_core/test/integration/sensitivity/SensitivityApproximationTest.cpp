@@ -0,0 +1,147 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/core/core.h>
+
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+
+const size_t state_dim = 4;
+const size_t control_dim = 2;
+
+//! a linear system which is time-varying until t_switch and time-invariant afterwards
+class PiecewiseTimeVaryingSystem : public LinearSystem<state_dim, control_dim>
+{
+public:
+    PiecewiseTimeVaryingSystem(double t_switch) : t_switch_(t_switch)
+    {
+        A0_.setRandom();
+        A1_.setRandom();
+        B_.setRandom();
+
+        // the first state is an integrator of the second one, hence A is singular
+        A0_.row(0).setZero();
+        A0_(0, 1) = 1.0;
+        A1_.row(0).setZero();
+    }
+
+    PiecewiseTimeVaryingSystem* clone() const override { return new PiecewiseTimeVaryingSystem(*this); }
+    const state_matrix_t& getDerivativeState(const state_vector_t& x,
+        const control_vector_t& u,
+        const ct::core::Time t = 0.0) override
+    {
+        A_ = A0_ + std::sin(std::min(t, t_switch_)) * A1_;
+        return A_;
+    }
+
+    const state_control_matrix_t& getDerivativeControl(const state_vector_t& x,
+        const control_vector_t& u,
+        const ct::core::Time t = 0.0) override
+    {
+        return B_;
+    }
+
+private:
+    double t_switch_;
+    state_matrix_t A0_, A1_, A_;
+    state_control_matrix_t B_;
+};
+
+
+TEST(SensitivityApproximationTest, PadeExponentialTest)
+{
+    for (double scale : {1e-3, 0.3, 1.0, 10.0, 100.0})
+    {
+        Eigen::Matrix<double, 6, 6> M = scale * Eigen::Matrix<double, 6, 6>::Random();
+        Eigen::Matrix<double, 6, 6> expM;
+        padeExponential<6, double>(M, expM);
+
+        Eigen::Matrix<double, 6, 6> expM_ref = M.exp();
+        ASSERT_LT((expM - expM_ref).norm(), 1e-12 * std::max(1.0, expM_ref.norm()));
+    }
+}
+
+
+TEST(SensitivityApproximationTest, BatchDiscretizationTest)
+{
+    typedef SensitivityApproximationSettings::APPROXIMATION APPROXIMATION;
+
+    const double dt = 0.05;
+    const size_t N = 40;
+
+    std::shared_ptr<PiecewiseTimeVaryingSystem> system(new PiecewiseTimeVaryingSystem(N * dt / 2));
+
+    StateVectorArray<state_dim> x(N), x_next(N);
+    ControlVectorArray<control_dim> u(N);
+    for (size_t k = 0; k < N; k++)
+    {
+        x[k].setRandom();
+        x_next[k].setRandom();
+        u[k].setRandom();
+    }
+
+    for (APPROXIMATION approx : {APPROXIMATION::FORWARD_EULER, APPROXIMATION::BACKWARD_EULER, APPROXIMATION::TUSTIN,
+             APPROXIMATION::MATRIX_EXPONENTIAL})
+    {
+        SensitivityApproximation<state_dim, control_dim> sensitivity(dt, system, approx);
+
+        // the second batch with 4 threads reuses the worker threads of the first one
+        for (size_t nThreads : {1, 4, 4})
+        {
+            // the batch only writes its range of stages
+            const size_t firstIndex = 3;
+            StateMatrixArray<state_dim> A(N, StateMatrix<state_dim>::Zero());
+            StateControlMatrixArray<state_dim, control_dim> B(N, StateControlMatrix<state_dim, control_dim>::Zero());
+            sensitivity.getAandBBatch(x, u, x_next, firstIndex, N - 1, A, B, nThreads);
+
+            ASSERT_EQ(A.size(), N);
+            ASSERT_EQ(B.size(), N);
+
+            for (size_t k = 0; k < firstIndex; k++)
+            {
+                ASSERT_TRUE(A[k].isZero());
+                ASSERT_TRUE(B[k].isZero());
+            }
+
+            // the batch is identical to the discretization stage by stage
+            for (size_t k = firstIndex; k < N; k++)
+            {
+                StateMatrix<state_dim> A_k;
+                StateControlMatrix<state_dim, control_dim> B_k;
+                sensitivity.getAandB(x[k], u[k], x_next[k], k, 1, A_k, B_k);
+
+                ASSERT_LT((A[k] - A_k).norm(), 1e-14);
+                ASSERT_LT((B[k] - B_k).norm(), 1e-14);
+            }
+        }
+    }
+
+    // the matrix exponential is exact for the zero-order hold, although A is singular
+    SensitivityApproximation<state_dim, control_dim> sensitivity(dt, system, APPROXIMATION::MATRIX_EXPONENTIAL);
+    for (int n : {0, 30})
+    {
+        StateMatrix<state_dim> A;
+        StateControlMatrix<state_dim, control_dim> B;
+        sensitivity.getAandB(x[0], u[0], x_next[0], n, 1, A, B);
+
+        Eigen::Matrix<double, state_dim + control_dim, state_dim + control_dim> M;
+        M.setZero();
+        M.topLeftCorner<state_dim, state_dim>() = dt * system->getDerivativeState(x[0], u[0], n * dt);
+        M.topRightCorner<state_dim, control_dim>() = dt * system->getDerivativeControl(x[0], u[0], n * dt);
+        Eigen::Matrix<double, state_dim + control_dim, state_dim + control_dim> expM = M.exp();
+
+        ASSERT_LT((A - expM.topLeftCorner<state_dim, state_dim>()).norm(), 1e-12);
+        ASSERT_LT((B - expM.topRightCorner<state_dim, control_dim>()).norm(), 1e-12);
+        ASSERT_TRUE(A.allFinite() && B.allFinite());
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
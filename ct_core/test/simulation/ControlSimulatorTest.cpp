@@ -0,0 +1,193 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/core/core.h>
+
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+
+//! the oscillator with the scalar type required by the ControlSimulator
+class Oscillator : public SecondOrderSystem
+{
+public:
+    using SCALAR = double;
+
+    Oscillator(double w_n, double zeta) : SecondOrderSystem(w_n, zeta) {}
+    Oscillator* clone() const override { return new Oscillator(*this); }
+};
+
+//! applies a sampled state feedback with zero-order hold
+class SampledFeedbackSimulator : public ControlSimulator<Oscillator>
+{
+public:
+    SampledFeedbackSimulator(Time sim_dt,
+        Time control_dt,
+        const StateVector<2>& x0,
+        std::shared_ptr<Oscillator> system,
+        const FeedbackMatrix<2, 1>& K)
+        : ControlSimulator<Oscillator>(sim_dt, control_dt, x0, system), K_(K)
+    {
+        u_.setZero();
+    }
+
+    void finishControllerIteration(Time sim_time) override { u_ = K_ * x_; }
+    void finishSystemIteration(Time sim_time) override
+    {
+        system_->setController(std::shared_ptr<ConstantController<2, 1>>(new ConstantController<2, 1>(u_)));
+    }
+
+private:
+    FeedbackMatrix<2, 1> K_;
+    ControlVector<1> u_;
+};
+
+
+const double sim_dt = 0.001;
+const double control_dt = 0.01;
+const double duration = 1.0;
+
+FeedbackMatrix<2, 1> feedbackGain()
+{
+    FeedbackMatrix<2, 1> K;
+    K << -2.0, -1.0;
+    return K;
+}
+
+//! integrates the sampled closed loop step by step
+StateVector<2> sampledReference(const StateVector<2>& x0, double delay)
+{
+    std::shared_ptr<Oscillator> system(new Oscillator(5.0, 0.1));
+    Integrator<2> integrator(system, IntegrationType::EULERCT);
+
+    StateVector<2> x = x0;
+    ControlVector<1> u = ControlVector<1>::Zero();
+    const size_t nSteps = size_t(delay / sim_dt + 1e-9);
+
+    for (size_t k = 0; k < size_t(duration / control_dt + 1e-9); k++)
+    {
+        const Time t = k * control_dt;
+        const ControlVector<1> u_new = feedbackGain() * x;
+
+        // the previous control is active until the compute delay has passed
+        system->setController(std::shared_ptr<ConstantController<2, 1>>(new ConstantController<2, 1>(u)));
+        if (nSteps > 0)
+            integrator.integrate_n_steps(x, t, nSteps, sim_dt);
+
+        u = u_new;
+        system->setController(std::shared_ptr<ConstantController<2, 1>>(new ConstantController<2, 1>(u)));
+        integrator.integrate_n_steps(x, t + nSteps * sim_dt, size_t(control_dt / sim_dt + 1e-9) - nSteps, sim_dt);
+    }
+    return x;
+}
+
+std::shared_ptr<SampledFeedbackSimulator> makeSimulator(const StateVector<2>& x0)
+{
+    std::shared_ptr<Oscillator> system(new Oscillator(5.0, 0.1));
+    system->setController(std::shared_ptr<ConstantController<2, 1>>(new ConstantController<2, 1>()));
+    return std::shared_ptr<SampledFeedbackSimulator>(
+        new SampledFeedbackSimulator(sim_dt, control_dt, x0, system, feedbackGain()));
+}
+
+
+TEST(ControlSimulatorTest, LockStepTest)
+{
+    StateVector<2> x0;
+    x0 << 1.0, 0.0;
+
+    for (double delay : {0.0, 0.003, control_dt})
+    {
+        std::shared_ptr<SampledFeedbackSimulator> simulator = makeSimulator(x0);
+        simulator->setComputeDelay(delay);
+        simulator->simulateLockStep(duration);
+
+        const StateTrajectory<2>& x = simulator->getStateTrajectory();
+        ASSERT_EQ(x.size(), size_t(duration / control_dt + 1e-9) + 1);
+        ASSERT_NEAR(x.getTimeArray().back(), duration, 1e-12);
+
+        StateVector<2> x_ref = sampledReference(x0, delay);
+        ASSERT_LT((x.back() - x_ref).norm(), 1e-12);
+
+        // the simulation is reproducible
+        simulator->simulateLockStep(duration);
+        ASSERT_EQ(simulator->getStateTrajectory().back(), x.back());
+    }
+
+    ASSERT_ANY_THROW(makeSimulator(x0)->setComputeDelay(2 * control_dt));
+}
+
+
+TEST(ControlSimulatorTest, ScenarioRunnerTest)
+{
+    const size_t nScenarios = 20;
+
+    auto factory = [](size_t scenario) -> ScenarioRunner<Oscillator>::SimulatorPtr_t {
+        StateVector<2> x0;
+        x0 << 0.1 * scenario, -0.05 * scenario;
+        auto simulator = makeSimulator(x0);
+        simulator->setComputeDelay(0.002);
+        return simulator;
+    };
+
+    std::atomic<size_t> nCallbacks(0);
+
+    ScenarioRunner<Oscillator> parallelRunner(factory, 4);
+    parallelRunner.setCallback([&nCallbacks](size_t, ControlSimulator<Oscillator>&) { nCallbacks++; });
+    auto parallelResults = parallelRunner.run(nScenarios, duration);
+
+    ScenarioRunner<Oscillator> serialRunner(factory, 1);
+    auto serialResults = serialRunner.run(nScenarios, duration);
+
+    ASSERT_EQ(nCallbacks, nScenarios);
+    ASSERT_EQ(parallelResults.size(), nScenarios);
+
+    for (size_t i = 0; i < nScenarios; i++)
+    {
+        ASSERT_TRUE(parallelResults[i].success);
+        ASSERT_TRUE(serialResults[i].success);
+        ASSERT_EQ(parallelResults[i].stateTrajectory.size(), serialResults[i].stateTrajectory.size());
+
+        for (size_t k = 0; k < serialResults[i].stateTrajectory.size(); k++)
+            ASSERT_EQ(parallelResults[i].stateTrajectory[k], serialResults[i].stateTrajectory[k]);
+    }
+}
+
+
+//! a controller that fails in its first iteration
+class FailingSimulator : public SampledFeedbackSimulator
+{
+public:
+    using SampledFeedbackSimulator::SampledFeedbackSimulator;
+
+    void finishControllerIteration(Time sim_time) override { throw std::runtime_error("controller diverged"); }
+};
+
+
+TEST(ControlSimulatorTest, ScenarioRunnerFailureTest)
+{
+    auto factory = [](size_t scenario) -> ScenarioRunner<Oscillator>::SimulatorPtr_t {
+        StateVector<2> x0 = StateVector<2>::Zero();
+        if (scenario != 1)
+            return makeSimulator(x0);
+
+        std::shared_ptr<Oscillator> system(new Oscillator(5.0, 0.1));
+        system->setController(std::shared_ptr<ConstantController<2, 1>>(new ConstantController<2, 1>()));
+        return std::shared_ptr<FailingSimulator>(new FailingSimulator(sim_dt, control_dt, x0, system, feedbackGain()));
+    };
+
+    ScenarioRunner<Oscillator> runner(factory, 2);
+    auto results = runner.run(3, duration);
+
+    ASSERT_TRUE(results[0].success && !results[1].success && results[2].success);
+
+    // the cause of the failure is not lost
+    ASSERT_NE(results[1].error.find("controller diverged"), std::string::npos);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,109 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/core/core.h>
+
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+
+//! the oscillator with the scalar type required by the ControlSimulator
+class Oscillator : public SecondOrderSystem
+{
+public:
+    using SCALAR = double;
+
+    Oscillator(double w_n, double zeta) : SecondOrderSystem(w_n, zeta) {}
+    Oscillator* clone() const override { return new Oscillator(*this); }
+};
+
+
+const double control_dt = 0.01;
+const double duration = 1.0;
+
+FeedbackMatrix<2, 1> feedbackGain()
+{
+    FeedbackMatrix<2, 1> K;
+    K << -2.0, -1.0;
+    return K;
+}
+
+TEST(MonteCarloEvaluatorTest, StatisticsTest)
+{
+    typedef MonteCarloEvaluator<Oscillator> Evaluator;
+
+    // the policy is a time-varying state feedback controller with a constant gain
+    const size_t N = size_t(duration / control_dt + 1e-9);
+    StateFeedbackController<2, 1> policy(StateVectorArray<2>(N + 1, StateVector<2>::Zero()),
+        ControlVectorArray<1>(N, ControlVector<1>::Zero()), FeedbackArray<2, 1>(N, feedbackGain()), control_dt);
+
+    auto factory = [&policy](size_t sample, Evaluator::SampleGenerators& rng, StateVector<2>& x0) {
+        std::normal_distribution<double> normal;
+        std::uniform_real_distribution<double> uniform(4.0, 6.0);
+
+        x0 << normal(rng.initialState), normal(rng.initialState);
+
+        std::shared_ptr<Oscillator> system(new Oscillator(uniform(rng.parameters), 0.1));
+        system->setController(std::shared_ptr<StateFeedbackController<2, 1>>(policy.clone()));
+        return system;
+    };
+
+    auto evaluate = [&](size_t nThreads, uint64_t seed) {
+        Evaluator evaluator(factory, control_dt, nThreads);
+        evaluator.setSeed(seed);
+        evaluator.setCost([](const StateVector<2>& x, const ControlVector<1>& u, const Time&) {
+            return x.squaredNorm() + u.squaredNorm();
+        });
+        evaluator.setConstraint([](const StateVector<2>& x, const ControlVector<1>&, const Time&) {
+            return std::abs(x(0)) < 1.0;
+        });
+        evaluator.setProcessNoise(StateVector<2>::Constant(1e-3));
+        return evaluator.run(200, duration);
+    };
+
+    Evaluator::Statistics serial = evaluate(1, 42);
+    Evaluator::Statistics parallel = evaluate(4, 42);
+    Evaluator::Statistics otherSeed = evaluate(4, 43);
+
+    ASSERT_EQ(serial.nSamples, 200);
+    ASSERT_EQ(serial.nFailed, 0);
+    ASSERT_EQ(serial.costs.size(), 200);
+
+    // the results do not depend on the number of threads, but on the seed
+    ASSERT_EQ(serial.costs, parallel.costs);
+    ASSERT_EQ(serial.terminalErrors, parallel.terminalErrors);
+    ASSERT_EQ(serial.costMean, parallel.costMean);
+    ASSERT_EQ(serial.violationRate, parallel.violationRate);
+    ASSERT_NE(serial.costMean, otherSeed.costMean);
+
+    // standard normal initial states exceed the constraint in about a third of the samples
+    ASSERT_GT(serial.violationRate, 0.1);
+    ASSERT_LT(serial.violationRate, 0.6);
+    ASSERT_LE(serial.stageViolationRate, serial.violationRate);
+
+    ASSERT_GT(serial.costStdDev, 0.0);
+    ASSERT_LE(serial.costPercentile(0), serial.costPercentile(50));
+    ASSERT_LE(serial.costPercentile(50), serial.costPercentile(100));
+    ASSERT_EQ(serial.costPercentile(100), serial.costs.back());
+
+    // the damped closed loop converges
+    ASSERT_LT(serial.terminalErrorPercentile(90), 0.5);
+}
+
+TEST(MonteCarloEvaluatorTest, CounterRandomGeneratorTest)
+{
+    // the random streams are counter based
+    CounterRandomGenerator a(1, 2, 3), b(1, 2, 3);
+    b.discard(5);
+    for (size_t i = 0; i < 5; i++)
+        a();
+    ASSERT_EQ(a(), b());
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
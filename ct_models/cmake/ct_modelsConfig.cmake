@@ -4,6 +4,9 @@ find_package(ct_rbd REQUIRED)
 
 include(${CMAKE_CURRENT_LIST_DIR}/ct_models_export.cmake)
 
+# URDF to codegen pipeline, provides ct_models_add_robot()
+include(${CMAKE_CURRENT_LIST_DIR}/ct_models_codegen.cmake)
+
 #define includes in legacy mode
 get_target_property(ct_models_INCLUDE_DIRS ct_models INTERFACE_INCLUDE_DIRECTORIES)
 
@@ -0,0 +1,167 @@
+
+# Build pipeline from a URDF to auto-diff codegen kernels of the linearized robot dynamics.
+#
+# ct_models_add_robot(<name>
+#     URDF <file>                       URDF or xacro file of the robot
+#     [FLOATING_BASE]                   the root link of the URDF is a floating base
+#     [NO_CONTACT_MODEL]                do not include the EEContactModel in the floating base linearization
+#     [END_EFFECTORS <link> ...]        URDF links which are end-effectors
+#     [ROBCOGEN_COMMAND <arg> ...]      command running RobCoGen, defaults to CT_ROBCOGEN_COMMAND
+#     [OUTPUT_DIR <dir>]                defaults to ${CMAKE_CURRENT_BINARY_DIR}/<name>
+# )
+#
+# The pipeline consists of three build steps, each re-run only if its inputs change:
+#  1. urdf2robcogen.py converts the URDF into the RobCoGen model files <name>/model/ct_<name>.kindsl,
+#     ct_<name>.dtdsl and the robot header <name>/<name>.h.
+#  2. RobCoGen generates the C++ dynamics into <name>/generated. RobCoGen is an external tool, hence the command needs
+#     to be supplied. The placeholders @KINDSL@, @DTDSL@ and @OUTPUT_DIR@ are replaced by the model files and the
+#     directory RobCoGen needs to write the sources of the "generated" folder to.
+#  3. If CPPADCG is enabled, the generic RbdLinearizationCodegen driver is built for the robot and writes the forward
+#     and reverse mode linearization kernels <name>LinearizedForward/Reverse (and the inverse dynamics Jacobians for
+#     fixed base robots). The kernels are compiled into the library <name>Linearization.
+#
+# Targets: <name>_robcogen (steps 1 and 2), <name>LinearizationCodegen and <name>Linearization (step 3).
+# The robot header is included via #include <<name>.h>, the kernels via #include <<name>LinearizedForward.h> etc.
+
+set(CT_MODELS_CODEGEN_DIR ${CMAKE_CURRENT_LIST_DIR})
+set(CT_ROBCOGEN_COMMAND "" CACHE STRING "command running RobCoGen, see ct_models_add_robot()")
+
+# locate the converter script and codegen driver both in the source tree and in an installed ct_models
+if(EXISTS ${CT_MODELS_CODEGEN_DIR}/../scripts/urdf2robcogen.py)
+    set(CT_MODELS_URDF2ROBCOGEN ${CT_MODELS_CODEGEN_DIR}/../scripts/urdf2robcogen.py)
+    set(CT_MODELS_CODEGEN_DRIVER ${CT_MODELS_CODEGEN_DIR}/../src/codegen/RbdLinearizationCodegen.cpp)
+else()
+    set(CT_MODELS_URDF2ROBCOGEN ${CT_MODELS_CODEGEN_DIR}/urdf2robcogen.py)
+    set(CT_MODELS_CODEGEN_DRIVER ${CT_MODELS_CODEGEN_DIR}/RbdLinearizationCodegen.cpp)
+endif()
+
+
+function(ct_models_add_robot name)
+    cmake_parse_arguments(ROBOT "FLOATING_BASE;NO_CONTACT_MODEL" "URDF;OUTPUT_DIR" "END_EFFECTORS;ROBCOGEN_COMMAND" ${ARGN})
+
+    if(NOT ROBOT_URDF)
+        message(FATAL_ERROR "ct_models_add_robot(${name}): URDF is required.")
+    endif()
+    get_filename_component(ROBOT_URDF ${ROBOT_URDF} ABSOLUTE)
+
+    if(NOT ROBOT_OUTPUT_DIR)
+        set(ROBOT_OUTPUT_DIR ${CMAKE_CURRENT_BINARY_DIR}/${name})
+    endif()
+    if(NOT ROBOT_ROBCOGEN_COMMAND)
+        set(ROBOT_ROBCOGEN_COMMAND ${CT_ROBCOGEN_COMMAND})
+    endif()
+
+    if(CMAKE_VERSION VERSION_LESS 3.12)
+        message(FATAL_ERROR "ct_models_add_robot(${name}): CMake 3.12 or newer is required to locate Python.")
+    endif()
+    find_package(Python COMPONENTS Interpreter REQUIRED)
+
+    set(model_dir ${ROBOT_OUTPUT_DIR}/model)
+    set(kindsl ${model_dir}/ct_${name}.kindsl)
+    set(dtdsl ${model_dir}/ct_${name}.dtdsl)
+    set(header ${ROBOT_OUTPUT_DIR}/${name}.h)
+
+    ## expand xacro files first
+    set(urdf ${ROBOT_URDF})
+    if(ROBOT_URDF MATCHES "\\.xacro$")
+        find_program(XACRO_EXECUTABLE xacro)
+        if(NOT XACRO_EXECUTABLE)
+            message(FATAL_ERROR "ct_models_add_robot(${name}): xacro is required to expand ${ROBOT_URDF}.")
+        endif()
+        set(urdf ${model_dir}/${name}.urdf)
+        add_custom_command(
+            OUTPUT ${urdf}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${model_dir}
+            COMMAND ${XACRO_EXECUTABLE} ${ROBOT_URDF} -o ${urdf}
+            DEPENDS ${ROBOT_URDF}
+            COMMENT "Expanding xacro file for robot ${name}")
+    endif()
+
+    ## step 1: URDF to RobCoGen model files and robot header
+    set(converter_args ${urdf} --name ${name} --output-dir ${ROBOT_OUTPUT_DIR})
+    if(ROBOT_FLOATING_BASE)
+        list(APPEND converter_args --floating-base)
+    endif()
+    if(ROBOT_END_EFFECTORS)
+        list(APPEND converter_args --ee ${ROBOT_END_EFFECTORS})
+    endif()
+
+    add_custom_command(
+        OUTPUT ${kindsl} ${dtdsl} ${header}
+        COMMAND ${Python_EXECUTABLE} ${CT_MODELS_URDF2ROBCOGEN} ${converter_args}
+        DEPENDS ${urdf} ${CT_MODELS_URDF2ROBCOGEN}
+        COMMENT "Converting URDF of robot ${name} to RobCoGen model files")
+
+    ## step 2: RobCoGen
+    set(generated_dir ${ROBOT_OUTPUT_DIR}/generated)
+    set(robcogen_outputs ${generated_dir}/traits.h)
+    if(ROBOT_ROBCOGEN_COMMAND)
+        set(robcogen_command "")
+        foreach(arg ${ROBOT_ROBCOGEN_COMMAND})
+            string(REPLACE "@KINDSL@" ${kindsl} arg ${arg})
+            string(REPLACE "@DTDSL@" ${dtdsl} arg ${arg})
+            string(REPLACE "@OUTPUT_DIR@" ${generated_dir} arg ${arg})
+            list(APPEND robcogen_command ${arg})
+        endforeach()
+
+        add_custom_command(
+            OUTPUT ${robcogen_outputs}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${generated_dir}
+            COMMAND ${robcogen_command}
+            DEPENDS ${kindsl} ${dtdsl}
+            WORKING_DIRECTORY ${ROBOT_OUTPUT_DIR}
+            COMMENT "Running RobCoGen for robot ${name}")
+    elseif(NOT EXISTS ${robcogen_outputs})
+        message(WARNING "ct_models_add_robot(${name}): no ROBCOGEN_COMMAND given and ${generated_dir} does not exist. "
+            "Only the RobCoGen model files will be generated, run RobCoGen on them to continue.")
+        add_custom_target(${name}_robcogen ALL DEPENDS ${kindsl} ${dtdsl} ${header})
+        return()
+    endif()
+
+    add_custom_target(${name}_robcogen ALL DEPENDS ${kindsl} ${dtdsl} ${header} ${robcogen_outputs})
+
+    ## step 3: auto-diff codegen of the linearized dynamics
+    if(NOT CPPADCG)
+        message(STATUS "ct_models_add_robot(${name}): CPPADCG not enabled, skipping the linearization codegen.")
+        return()
+    endif()
+
+    set(codegen_dir ${ROBOT_OUTPUT_DIR}/codegen)
+    set(kernel_names ${name}LinearizedForward ${name}LinearizedReverse)
+    if(NOT ROBOT_FLOATING_BASE)
+        list(APPEND kernel_names ${name}InverseDynJacForward ${name}InverseDynJacReverse)
+    endif()
+    set(kernel_sources "")
+    foreach(kernel ${kernel_names})
+        list(APPEND kernel_sources ${codegen_dir}/${kernel}.cpp)
+    endforeach()
+
+    add_executable(${name}LinearizationCodegen ${CT_MODELS_CODEGEN_DRIVER})
+    add_dependencies(${name}LinearizationCodegen ${name}_robcogen)
+    target_include_directories(${name}LinearizationCodegen PRIVATE ${ROBOT_OUTPUT_DIR})
+    target_compile_definitions(${name}LinearizationCodegen PRIVATE
+        CT_CODEGEN_ROBOT_HEADER=<${name}.h>
+        CT_CODEGEN_ROBOT_NS=${name}
+        CT_CODEGEN_ROBOT_NAME="${name}"
+        CT_CODEGEN_OUTPUT_DIR="${codegen_dir}")
+    if(ROBOT_FLOATING_BASE)
+        target_compile_definitions(${name}LinearizationCodegen PRIVATE CT_CODEGEN_FLOATING_BASE)
+    endif()
+    target_link_libraries(${name}LinearizationCodegen ct_rbd)
+
+    set(codegen_args "")
+    if(ROBOT_NO_CONTACT_MODEL)
+        set(codegen_args nocontact)
+    endif()
+
+    add_custom_command(
+        OUTPUT ${kernel_sources}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${codegen_dir}
+        COMMAND ${name}LinearizationCodegen ${codegen_args}
+        DEPENDS ${name}LinearizationCodegen
+        COMMENT "Generating linearization kernels for robot ${name}")
+
+    add_library(${name}Linearization ${kernel_sources})
+    target_include_directories(${name}Linearization PUBLIC ${ROBOT_OUTPUT_DIR} ${codegen_dir})
+    target_link_libraries(${name}Linearization ct_rbd)
+endfunction()
@@ -18,7 +18,7 @@ namespace ct {
 namespace rbd {
 
 template <typename SCALAR = double>
-class Irb4600InverseKinematics : InverseKinematicsBase<6, SCALAR>
+class Irb4600InverseKinematics : public InverseKinematicsBase<6, SCALAR>
 {
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
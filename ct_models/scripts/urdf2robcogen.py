@@ -0,0 +1,415 @@
+#!/usr/bin/env python3
+"""
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+
+Converts a URDF into the RobCoGen model description (.kindsl and .dtdsl) and generates the ct_models robot header
+which defines the CT_* macros required by ct/rbd/robot/robcogen/robcogenHelpers.h.
+
+RobCoGen requires every joint to rotate (or translate) about the z-axis of its reference frame. The converter therefore
+attaches to every link a frame whose z-axis is aligned with the joint axis, and expresses all inertial properties and
+child joint frames in this aligned frame. Links connected by fixed joints are lumped into their parent, their frames
+are kept as additional frames of the parent (e.g. for end-effectors).
+
+Usage:
+    urdf2robcogen.py robot.urdf --name MyRobot --output-dir <dir> [--floating-base] [--ee foot_1 foot_2 ...]
+"""
+
+import argparse
+import math
+import os
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+
+# ---------------------------------------------------------------------------------------------------------------------
+# small linear algebra helpers (3x3 matrices as nested lists, no external dependencies)
+# ---------------------------------------------------------------------------------------------------------------------
+
+def mat_mul(A, B):
+    return [[sum(A[i][k] * B[k][j] for k in range(3)) for j in range(3)] for i in range(3)]
+
+
+def mat_vec(A, v):
+    return [sum(A[i][k] * v[k] for k in range(3)) for i in range(3)]
+
+
+def transpose(A):
+    return [[A[j][i] for j in range(3)] for i in range(3)]
+
+
+def identity():
+    return [[1.0, 0.0, 0.0], [0.0, 1.0, 0.0], [0.0, 0.0, 1.0]]
+
+
+def rot_x(a):
+    c, s = math.cos(a), math.sin(a)
+    return [[1.0, 0.0, 0.0], [0.0, c, -s], [0.0, s, c]]
+
+
+def rot_y(a):
+    c, s = math.cos(a), math.sin(a)
+    return [[c, 0.0, s], [0.0, 1.0, 0.0], [-s, 0.0, c]]
+
+
+def rot_z(a):
+    c, s = math.cos(a), math.sin(a)
+    return [[c, -s, 0.0], [s, c, 0.0], [0.0, 0.0, 1.0]]
+
+
+def rpy_to_matrix(rpy):
+    """URDF convention: fixed-axis roll, pitch, yaw, i.e. R = Rz(yaw) Ry(pitch) Rx(roll)."""
+    return mat_mul(mat_mul(rot_z(rpy[2]), rot_y(rpy[1])), rot_x(rpy[0]))
+
+
+def matrix_to_robcogen(R):
+    """RobCoGen convention: moving-axis rotations about x, y', z'', i.e. R = Rx(a) Ry(b) Rz(c)."""
+    b = math.asin(max(-1.0, min(1.0, R[0][2])))
+    if abs(abs(R[0][2]) - 1.0) < 1e-9:
+        # gimbal lock, attribute the full remaining rotation to the first angle
+        a = math.atan2(R[2][1], R[1][1])
+        c = 0.0
+    else:
+        a = math.atan2(-R[1][2], R[2][2])
+        c = math.atan2(-R[0][1], R[0][0])
+    return [a, b, c]
+
+
+def axis_alignment(axis):
+    """Returns a rotation R with R * e_z = axis."""
+    n = math.sqrt(sum(x * x for x in axis))
+    z = [x / n for x in axis]
+    # pick the coordinate axis least aligned with z as helper
+    helper = [1.0, 0.0, 0.0] if abs(z[0]) < 0.9 else [0.0, 1.0, 0.0]
+    # Gram-Schmidt, such that the alignment is the identity for joints that already rotate about z
+    d = sum(h * v for h, v in zip(helper, z))
+    x = [h - d * v for h, v in zip(helper, z)]
+    nx = math.sqrt(sum(v * v for v in x))
+    x = [v / nx for v in x]
+    y = [z[1] * x[2] - z[2] * x[1], z[2] * x[0] - z[0] * x[2], z[0] * x[1] - z[1] * x[0]]
+    # snap to exact unit axes to keep the generated transforms free of round-off
+    R = [[x[i], y[i], z[i]] for i in range(3)]
+    return [[round(v) if abs(v - round(v)) < 1e-12 else v for v in row] for row in R]
+
+
+def parse_vector(string, default):
+    if string is None:
+        return list(default)
+    return [float(v) for v in string.split()]
+
+
+def format_scalar(v):
+    # express multiples of PI/2 the way the hand-written models do
+    for k, name in [(1, "PI/2.0"), (2, "PI"), (-1, "-PI/2.0"), (-2, "-PI")]:
+        if abs(v - k * math.pi / 2.0) < 1e-9:
+            return name
+    if abs(v) < 1e-12:
+        return "0.0"
+    return repr(round(v, 12))
+
+
+def format_triple(v):
+    return "(" + ", ".join(format_scalar(x) for x in v) + ")"
+
+
+def sanitize(name):
+    return re.sub(r"[^A-Za-z0-9_]", "_", name)
+
+
+# ---------------------------------------------------------------------------------------------------------------------
+# URDF model
+# ---------------------------------------------------------------------------------------------------------------------
+
+class Body(object):
+    """Rigid body inertia expressed in some frame: mass, center of mass and inertia tensor about the center of mass."""
+
+    def __init__(self, mass=0.0, com=None, inertia=None):
+        self.mass = mass
+        self.com = com if com is not None else [0.0, 0.0, 0.0]
+        self.inertia = inertia if inertia is not None else [[0.0] * 3 for _ in range(3)]
+
+    def transformed(self, R, p):
+        """express the body in a frame in which the current frame has orientation R and origin p"""
+        com = [a + b for a, b in zip(mat_vec(R, self.com), p)]
+        return Body(self.mass, com, mat_mul(mat_mul(R, self.inertia), transpose(R)))
+
+    @staticmethod
+    def combine(bodies):
+        mass = sum(b.mass for b in bodies)
+        if mass <= 0.0:
+            return Body()
+        com = [sum(b.mass * b.com[i] for b in bodies) / mass for i in range(3)]
+        inertia = [[0.0] * 3 for _ in range(3)]
+        for b in bodies:
+            d = [b.com[i] - com[i] for i in range(3)]
+            dd = sum(v * v for v in d)
+            for i in range(3):
+                for j in range(3):
+                    inertia[i][j] += b.inertia[i][j] + b.mass * ((dd if i == j else 0.0) - d[i] * d[j])
+        return Body(mass, com, inertia)
+
+
+class Link(object):
+    def __init__(self, element):
+        self.name = element.get("name")
+        self.body = Body()
+        inertial = element.find("inertial")
+        if inertial is not None:
+            origin = inertial.find("origin")
+            xyz = parse_vector(origin.get("xyz") if origin is not None else None, [0.0, 0.0, 0.0])
+            rpy = parse_vector(origin.get("rpy") if origin is not None else None, [0.0, 0.0, 0.0])
+            mass = float(inertial.find("mass").get("value"))
+            i = inertial.find("inertia")
+            get = lambda key: float(i.get(key, "0.0")) if i is not None else 0.0
+            I = [[get("ixx"), get("ixy"), get("ixz")], [get("ixy"), get("iyy"), get("iyz")],
+                 [get("ixz"), get("iyz"), get("izz")]]
+            self.body = Body(mass, [0.0, 0.0, 0.0], I).transformed(rpy_to_matrix(rpy), xyz)
+
+
+class Joint(object):
+    def __init__(self, element):
+        self.name = element.get("name")
+        self.type = element.get("type")
+        self.parent = element.find("parent").get("link")
+        self.child = element.find("child").get("link")
+        origin = element.find("origin")
+        self.xyz = parse_vector(origin.get("xyz") if origin is not None else None, [0.0, 0.0, 0.0])
+        self.R = rpy_to_matrix(parse_vector(origin.get("rpy") if origin is not None else None, [0.0, 0.0, 0.0]))
+        axis = element.find("axis")
+        self.axis = parse_vector(axis.get("xyz") if axis is not None else None, [1.0, 0.0, 0.0])
+
+
+class RobCoGenModel(object):
+    def __init__(self, urdf_file, name, floating_base, end_effectors):
+        tree = ET.parse(urdf_file)
+        root = tree.getroot()
+        self.name = name
+        self.floating_base = floating_base
+        self.links = dict((l.get("name"), Link(l)) for l in root.findall("link"))
+        self.joints = [Joint(j) for j in root.findall("joint")]
+
+        for j in self.joints:
+            if j.type not in ("revolute", "continuous", "prismatic", "fixed"):
+                raise RuntimeError("joint " + j.name + " has unsupported type " + j.type)
+            if j.parent not in self.links or j.child not in self.links:
+                raise RuntimeError("joint " + j.name + " references an unknown link")
+
+        children = set(j.child for j in self.joints)
+        roots = [l for l in self.links if l not in children]
+        if len(roots) != 1:
+            raise RuntimeError("URDF needs to have exactly one root link, found: " + ", ".join(roots))
+        self.root = roots[0]
+
+        self.build(end_effectors)
+
+    def child_joints(self, link):
+        return [j for j in self.joints if j.parent == link]
+
+    def build(self, end_effectors):
+        # kindsl links, in depth-first order (RobCoGen ids must be consistent with the tree structure)
+        self.movable = []  # list of (joint, child link) pairs, index + 1 is the RobCoGen link id
+        # per kindsl link: lumped bodies, additional frames and kindsl children
+        self.bodies = {}
+        self.frames = {}
+        self.kin_children = {}
+        # map from every URDF link to (kindsl link, rotation, translation) of its frame in the kindsl link frame
+        self.owner = {self.root: (self.root, identity(), [0.0, 0.0, 0.0])}
+
+        def visit(link):
+            owner, R_owner, p_owner = self.owner[link]
+            if owner == link:
+                self.bodies[link] = []
+                self.frames[link] = []
+                self.kin_children[link] = []
+            self.bodies[owner].append(self.links[link].body.transformed(R_owner, p_owner))
+
+            for j in self.child_joints(link):
+                R_joint = mat_mul(R_owner, j.R)
+                p_joint = [a + b for a, b in zip(mat_vec(R_owner, j.xyz), p_owner)]
+                if j.type == "fixed":
+                    # lumped into the owner, the child link frame becomes a frame of the owner
+                    self.owner[j.child] = (owner, R_joint, p_joint)
+                    self.frames[owner].append((j.child, R_joint, p_joint))
+                else:
+                    A = axis_alignment(j.axis)
+                    # the URDF child frame expressed in its own kindsl frame
+                    self.owner[j.child] = (j.child, transpose(A), [0.0, 0.0, 0.0])
+                    self.movable.append((j, j.child, mat_mul(R_joint, A), p_joint))
+                    self.kin_children[owner].append((j.child, j.name))
+                visit(j.child)
+
+        visit(self.root)
+
+        self.ids = dict((child, i + 1) for i, (j, child, R, p) in enumerate(self.movable))
+
+        self.end_effectors = []
+        for ee in end_effectors:
+            if ee not in self.owner:
+                raise RuntimeError("end-effector " + ee + " is not a link of the URDF")
+            owner = self.owner[ee][0]
+            if owner == self.root:
+                raise RuntimeError("end-effector " + ee + " is rigidly attached to the base")
+            if ee == owner:
+                # the end-effector is a movable link itself, add a frame at its origin
+                self.frames[owner].append((ee + "_ee", identity(), [0.0, 0.0, 0.0]))
+                ee_frame = ee + "_ee"
+            else:
+                ee_frame = ee
+            # joints along the chain from base to end-effector
+            chain = []
+            link = owner
+            while link != self.root:
+                chain.append(self.ids[link] - 1)
+                link = next(j.parent for j in self.joints if j.child == link)
+                link = self.owner[link][0]
+            chain.sort()
+            if chain != list(range(chain[0], chain[-1] + 1)):
+                raise RuntimeError("the joints from base to end-effector " + ee + " are not contiguous")
+            self.end_effectors.append((sanitize(ee_frame), self.ids[owner], chain[0], chain[-1]))
+
+    def link_name(self, link):
+        return sanitize(link)
+
+    def write_inertia(self, out, link, ref_frame):
+        body = Body.combine(self.bodies[link])
+        I = body.inertia
+        out.append("\tinertia_params {")
+        out.append("\t\tmass = " + repr(body.mass))
+        out.append("\t\tCoM = (0.0, 0.0, 0.0)")
+        out.append("\t\tIx=%r  Iy=%r  Iz=%r  Ixy=%r  Ixz=%r  Iyz=%r" % (I[0][0], I[1][1], I[2][2], I[0][1], I[0][2],
+                                                                      I[1][2]))
+        out.append("\t\tref_frame = " + ref_frame)
+        out.append("\t}")
+        return body
+
+    def kindsl(self):
+        out = ["Robot ct_" + self.name + " {", ""]
+
+        base = self.link_name(self.root)
+        out.append(("RobotBase " + base + " floating {") if self.floating_base else ("RobotBase " + base + " {"))
+        body = self.write_inertia(out, self.root, "fr_" + base + "_COM")
+        self.write_children(out, self.root)
+        self.write_frames(out, self.root, body)
+        out.append("}")
+        out.append("")
+
+        for joint, link, R, p in self.movable:
+            name = self.link_name(link)
+            out.append("link " + name + " {")
+            out.append("\tid = " + str(self.ids[link]))
+            body = self.write_inertia(out, link, "fr_" + name + "_COM")
+            self.write_children(out, link)
+            self.write_frames(out, link, body)
+            out.append("}")
+            out.append("")
+
+        for joint, link, R, p in self.movable:
+            # R and p already express the joint frame in the kindsl frame of the parent
+            out.append(("p_joint " if joint.type == "prismatic" else "r_joint ") + sanitize(joint.name) + " {")
+            out.append("\tref_frame {")
+            out.append("\t\ttranslation = " + format_triple(p))
+            out.append("\t\trotation = " + format_triple(matrix_to_robcogen(R)))
+            out.append("\t}")
+            out.append("}")
+            out.append("")
+
+        out.append("}")
+        return "\n".join(out) + "\n"
+
+    def write_children(self, out, link):
+        children = self.kin_children[link]
+        if not children:
+            out.append("\tchildren {}")
+            return
+        out.append("\tchildren {")
+        for child, joint in children:
+            out.append("\t\t" + self.link_name(child) + " via " + sanitize(joint))
+        out.append("\t}")
+
+    def write_frames(self, out, link, body):
+        # all frames are already expressed in the kindsl frame of the link
+        frames = list(self.frames[link]) + [(link + "_COM", identity(), body.com)]
+        out.append("\tframes {")
+        for name, R, p in frames:
+            out.append("\t\tfr_" + sanitize(name) + " {")
+            out.append("\t\t\ttranslation = " + format_triple(p))
+            out.append("\t\t\trotation = " + format_triple(matrix_to_robcogen(R)))
+            out.append("\t\t}")
+        out.append("\t}")
+
+    def all_frames(self):
+        frames = ["fr_" + self.link_name(self.root)]
+        frames += ["fr_" + self.link_name(link) for joint, link, R, p in self.movable]
+        frames += ["fr_" + ee for ee, on_link, first, last in self.end_effectors]
+        return frames
+
+    def dtdsl(self):
+        base = "fr_" + self.link_name(self.root)
+        targets = self.all_frames()[1:]
+        out = ["Robot ct_" + self.name, "", "Frames {", "    " + ", ".join(self.all_frames()), "}", "",
+               "Transforms {"]
+        out += ["\tbase=" + base + ", target=" + t for t in targets]
+        out += ["\tbase=" + t + ", target=" + base for t in targets]
+        out += ["}", "", "Jacobians {"]
+        out += ["\tbase=" + base + ", target=" + t for t in targets]
+        out += ["}"]
+        return "\n".join(out) + "\n"
+
+    def header(self):
+        out = ["/" + "*" * 117,
+               "This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by "
+               "ETH Zurich.",
+               "Licensed under the BSD-2 license (see LICENSE file in main directory)",
+               "*" * 117 + "/", "",
+               "// This file has been generated by urdf2robcogen.py. Do not edit.", "",
+               "#pragma once", "",
+               "#include <Eigen/Core>", "#include <Eigen/StdVector>", ""]
+        for h in ["declarations", "forward_dynamics", "inertia_properties", "inverse_dynamics", "jacobians", "jsim",
+                  "transforms", "link_data_map", "traits"]:
+            out.append("#include \"generated/" + h + ".h\"")
+        out += ["", "#include <ct/rbd/rbd.h>", "",
+                "#define ROBCOGEN_NS ct_" + self.name,
+                "#define TARGET_NS " + self.name, "",
+                "#define CT_BASE fr_" + self.link_name(self.root)]
+        for i, (joint, link, R, p) in enumerate(self.movable):
+            out.append("#define CT_L" + str(i) + " fr_" + self.link_name(link))
+        out += ["", "#define CT_N_EE " + str(len(self.end_effectors))]
+        for i, (ee, on_link, first, last) in enumerate(self.end_effectors):
+            prefix = "#define CT_EE" + str(i)
+            out += [prefix + " fr_" + ee, prefix + "_IS_ON_LINK " + str(on_link),
+                    prefix + "_FIRST_JOINT " + str(first), prefix + "_LAST_JOINT " + str(last)]
+        out += ["", "#include <ct/rbd/robot/robcogen/robcogenHelpers.h>", ""]
+        return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a URDF into RobCoGen model files and a ct_models header.")
+    parser.add_argument("urdf", help="the URDF file (xacro files need to be expanded beforehand)")
+    parser.add_argument("--name", required=True, help="robot name, used for namespaces and file names")
+    parser.add_argument("--output-dir", required=True, help="directory in which the robot folder is created")
+    parser.add_argument("--floating-base", action="store_true", help="declare the root link as floating base")
+    parser.add_argument("--ee", nargs="*", default=[], help="URDF links which are end-effectors")
+    args = parser.parse_args()
+
+    try:
+        model = RobCoGenModel(args.urdf, args.name, args.floating_base, args.ee)
+    except RuntimeError as e:
+        sys.stderr.write("urdf2robcogen: " + str(e) + "\n")
+        return 1
+
+    model_dir = os.path.join(args.output_dir, "model")
+    if not os.path.isdir(model_dir):
+        os.makedirs(model_dir)
+
+    with open(os.path.join(model_dir, "ct_" + args.name + ".kindsl"), "w") as f:
+        f.write(model.kindsl())
+    with open(os.path.join(model_dir, "ct_" + args.name + ".dtdsl"), "w") as f:
+        f.write(model.dtdsl())
+    with open(os.path.join(args.output_dir, args.name + ".h"), "w") as f:
+        f.write(model.header())
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
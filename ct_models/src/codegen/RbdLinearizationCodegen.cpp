@@ -0,0 +1,133 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Generic code generator for the linearized dynamics of a RobCoGen robot.
+ *
+ * This file is not meant to be compiled by hand. The function ct_models_add_robot() (see
+ * cmake/ct_models_codegen.cmake) builds it once per robot, with the following compile definitions:
+ *
+ * - CT_CODEGEN_ROBOT_HEADER  the robot header, e.g. generated by urdf2robcogen.py
+ * - CT_CODEGEN_ROBOT_NS      the namespace of the robot in ct::rbd, i.e. TARGET_NS of the robot header
+ * - CT_CODEGEN_ROBOT_NAME    the (string) prefix of the generated classes and the second namespace layer
+ * - CT_CODEGEN_OUTPUT_DIR    the (string) directory to write the generated sources to
+ * - CT_CODEGEN_FLOATING_BASE defined for floating base robots
+ *
+ * For fixed base robots, it generates <NAME>LinearizedForward, <NAME>LinearizedReverse and the inverse dynamics
+ * Jacobians <NAME>InverseDynJacForward, <NAME>InverseDynJacReverse. For floating base robots, it generates
+ * <NAME>LinearizedForward and <NAME>LinearizedReverse, including an EEContactModel acting on all end-effectors
+ * (pass "nocontact" as first argument to generate the bare model instead).
+ */
+
+#include <ct/core/core.h>
+#include <ct/rbd/rbd.h>
+
+#include CT_CODEGEN_ROBOT_HEADER
+
+// shortcut for the auto-diff codegen scalar
+typedef CppAD::AD<CppAD::cg::CG<double>> SCALAR;
+
+typedef ct::rbd::CT_CODEGEN_ROBOT_NS::tpl::Dynamics<SCALAR> RobotDynamicsAD;
+
+#ifdef CT_CODEGEN_FLOATING_BASE
+typedef ct::rbd::FloatingBaseFDSystem<RobotDynamicsAD, false> RobotSystemAD;
+#else
+typedef ct::rbd::FixBaseFDSystem<RobotDynamicsAD> RobotSystemAD;
+#endif
+
+const size_t state_dim = RobotSystemAD::STATE_DIM;
+const size_t control_dim = RobotSystemAD::CONTROL_DIM;
+const size_t njoints = RobotDynamicsAD::NJOINTS;
+
+const std::string robotName = CT_CODEGEN_ROBOT_NAME;
+const std::string outputDir = CT_CODEGEN_OUTPUT_DIR;
+
+
+#ifndef CT_CODEGEN_FLOATING_BASE
+// Computes the joint torques required for a given state and joint acceleration, without external forces
+Eigen::Matrix<SCALAR, njoints, 1> inverseDynamics(const Eigen::Matrix<SCALAR, state_dim + njoints, 1>& x)
+{
+    RobotDynamicsAD dynamics;
+    ct::rbd::JointState<njoints, SCALAR> jointState(x.template head<state_dim>());
+    ct::rbd::JointAcceleration<njoints, SCALAR> qdd(x.template tail<njoints>());
+    typename RobotDynamicsAD::ExtLinkForces_t fext(Eigen::Matrix<SCALAR, njoints, 1>::Zero());
+    typename RobotDynamicsAD::control_vector_t tau;
+    dynamics.FixBaseID(jointState, qdd, fext, tau);
+    return tau;
+}
+
+void generateInverseDynamics()
+{
+    typedef ct::core::DerivativesCppadCG<state_dim + njoints, njoints> JacCG;
+    typename JacCG::FUN_TYPE_CG f = inverseDynamics;
+    JacCG jacCG(f);
+
+    try
+    {
+        std::cout << "Generating Jacobian of Inverse Dynamics using forward mode... " << std::endl;
+        jacCG.generateJacobianSource(robotName + "InverseDynJacForward", outputDir, ct::core::CODEGEN_TEMPLATE_DIR,
+            "models", robotName, JacCG::Sparsity::Ones(), false);
+
+        std::cout << "Generating Jacobian of Inverse Dynamics using reverse mode... " << std::endl;
+        jacCG.generateJacobianSource(robotName + "InverseDynJacReverse", outputDir, ct::core::CODEGEN_TEMPLATE_DIR,
+            "models", robotName, JacCG::Sparsity::Ones(), true);
+    } catch (const std::runtime_error& e)
+    {
+        std::cout << "inverse dynamics code generation failed: " << e.what() << std::endl;
+        std::exit(1);
+    }
+}
+#endif
+
+
+void generateFDLinearization(bool useContactModel)
+{
+    std::shared_ptr<RobotSystemAD> adSystem(new RobotSystemAD);
+
+#ifdef CT_CODEGEN_FLOATING_BASE
+    typedef ct::rbd::EEContactModel<typename RobotSystemAD::Kinematics> ContactModel;
+
+    // share the kinematics instance between system and contact model to allow the AD codegen to fully optimize
+    std::shared_ptr<ContactModel> contactModel(new ContactModel(SCALAR(5000.0), SCALAR(1000.0), SCALAR(100.0),
+        SCALAR(100.0), SCALAR(-0.02), ContactModel::VELOCITY_SMOOTHING::SIGMOID,
+        adSystem->dynamics().kinematicsPtr()));
+
+    std::cout << std::boolalpha << "using contact model: " << useContactModel << std::endl;
+    if (useContactModel)
+        adSystem->setContactModel(contactModel);
+#endif
+
+    ct::core::ADCodegenLinearizer<state_dim, control_dim> adLinearizer(adSystem);
+
+    try
+    {
+        std::cout << "generating using forward mode" << std::endl;
+        adLinearizer.generateCode(robotName + "LinearizedForward", outputDir, ct::core::CODEGEN_TEMPLATE_DIR,
+            "models", robotName, false);
+
+        std::cout << "generating using reverse mode" << std::endl;
+        adLinearizer.generateCode(robotName + "LinearizedReverse", outputDir, ct::core::CODEGEN_TEMPLATE_DIR,
+            "models", robotName, true);
+    } catch (const std::runtime_error& e)
+    {
+        std::cout << "forward dynamics code generation failed: " << e.what() << std::endl;
+        std::exit(1);
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    const bool useContactModel = (argc <= 1 || std::string(argv[1]).compare("nocontact") != 0);
+
+    generateFDLinearization(useContactModel);
+
+#ifndef CT_CODEGEN_FLOATING_BASE
+    generateInverseDynamics();
+#endif
+
+    std::cout << "... done!" << std::endl;
+    return 0;
+}
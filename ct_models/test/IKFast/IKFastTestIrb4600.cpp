@@ -38,6 +38,52 @@ TEST(Irb4600IKTest, IKFastTest)
     }
 }
 
+TEST(Irb4600IKTest, BatchIKFastTest)
+{
+    using BatchIK = ct::rbd::BatchInverseKinematics<6, double>;
+
+    ct::rbd::BatchInverseKinematicsSettings settings;
+    settings.nThreads = 4;
+    settings.chunkSize = 8;
+
+    BatchIK batchIK([]() { return std::make_shared<ct::rbd::Irb4600InverseKinematics<double>>(); }, settings);
+
+    // targets along a smooth joint space trajectory
+    const size_t nQueries = 200;
+    typename BatchIK::RigidBodyPoseVector_t poses(nQueries);
+    typename ct::rbd::JointState<6, double>::Position pos0, pos1;
+    pos0.setRandom();
+    pos1.setRandom();
+    for (size_t i = 0; i < nQueries; ++i)
+    {
+        typename ct::rbd::JointState<6, double>::Position pos = pos0 + (pos1 - pos0) * double(i) / nQueries;
+
+        Eigen::Vector3d ee_pos;
+        Eigen::Matrix<double, 3, 3, Eigen::RowMajor> ee_rot;
+        irb4600_ik::ComputeFk(pos.data(), ee_pos.data(), ee_rot.data());
+
+        poses[i].position().toImplementation() = ee_pos;
+        poses[i].setFromRotationMatrix(kindr::RotationMatrix<double>(ee_rot));
+    }
+
+    BatchIK::Result result = batchIK.solve(poses, pos0);
+
+    ASSERT_EQ(result.nSolved, nQueries);
+    ASSERT_EQ(result.solutions.size(), nQueries);
+    ASSERT_GE(result.maxSolveTime, result.meanSolveTime);
+
+    for (size_t i = 0; i < nQueries; ++i)
+    {
+        ASSERT_TRUE(result.success[i]);
+
+        Eigen::Vector3d ee_pos;
+        Eigen::Matrix<double, 3, 3, Eigen::RowMajor> ee_rot;
+        irb4600_ik::ComputeFk(result.solutions[i].data(), ee_pos.data(), ee_rot.data());
+        ASSERT_LT((ee_pos - poses[i].position().toImplementation()).norm(), 1e-3);
+        ASSERT_LT((ee_rot - poses[i].getRotationMatrix().toImplementation()).norm(), 1e-3);
+    }
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
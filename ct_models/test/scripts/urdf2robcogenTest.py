@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+
+Smoke test of urdf2robcogen.py, the first step of ct_models_add_robot(). Converts the HyA URDF and a small floating
+base robot and checks the RobCoGen model files and the robot header against the URDF and the hand-written HyA model.
+"""
+
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import unittest
+
+TEST_DIR = os.path.dirname(os.path.abspath(__file__))
+MODELS_DIR = os.path.join(TEST_DIR, "..", "..")
+CONVERTER = os.path.join(MODELS_DIR, "scripts", "urdf2robcogen.py")
+HYA_URDF = os.path.join(MODELS_DIR, "urdf", "HyA", "HyA.urdf")
+HYA_HEADER = os.path.join(MODELS_DIR, "include", "ct", "models", "HyA", "HyA.h")
+
+# a trunk with two single joint legs, one of them with a fixed foot frame
+FLOATING_BASE_URDF = """<robot name="Biped">
+  <link name="trunk">
+    <inertial><origin xyz="0 0 0"/><mass value="10.0"/>
+      <inertia ixx="0.1" ixy="0" ixz="0" iyy="0.2" iyz="0" izz="0.3"/></inertial>
+  </link>
+  <link name="left_leg">
+    <inertial><origin xyz="0 0 -0.2"/><mass value="1.0"/>
+      <inertia ixx="0.01" ixy="0" ixz="0" iyy="0.01" iyz="0" izz="0.001"/></inertial>
+  </link>
+  <link name="right_leg">
+    <inertial><origin xyz="0 0 -0.2"/><mass value="1.0"/>
+      <inertia ixx="0.01" ixy="0" ixz="0" iyy="0.01" iyz="0" izz="0.001"/></inertial>
+  </link>
+  <link name="left_foot"/>
+  <link name="right_foot"/>
+  <joint name="left_hip" type="revolute">
+    <parent link="trunk"/><child link="left_leg"/>
+    <origin xyz="0 0.1 0"/><axis xyz="0 1 0"/>
+  </joint>
+  <joint name="right_hip" type="revolute">
+    <parent link="trunk"/><child link="right_leg"/>
+    <origin xyz="0 -0.1 0"/><axis xyz="0 1 0"/>
+  </joint>
+  <joint name="left_ankle" type="fixed">
+    <parent link="left_leg"/><child link="left_foot"/><origin xyz="0 0 -0.4"/>
+  </joint>
+  <joint name="right_ankle" type="fixed">
+    <parent link="right_leg"/><child link="right_foot"/><origin xyz="0 0 -0.4"/>
+  </joint>
+</robot>
+"""
+
+
+def macros(header):
+    """the CT_* macros of a robot header"""
+    with open(header) as f:
+        return dict(re.findall(r"^#define (CT_\w+) (\S+)", f.read(), re.MULTILINE))
+
+
+class Urdf2RobcogenTest(unittest.TestCase):
+    def setUp(self):
+        self.output_dir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.output_dir)
+
+    def convert(self, urdf, name, *args):
+        return subprocess.call([sys.executable, CONVERTER, urdf, "--name", name, "--output-dir", self.output_dir] +
+                               list(args))
+
+    def read(self, *path):
+        with open(os.path.join(self.output_dir, *path)) as f:
+            return f.read()
+
+    def test_fixed_base(self):
+        self.assertEqual(self.convert(HYA_URDF, "HyA", "--ee", "hya_ee0"), 0)
+
+        kindsl = self.read("model", "ct_HyA.kindsl")
+        dtdsl = self.read("model", "ct_HyA.dtdsl")
+        generated = macros(os.path.join(self.output_dir, "HyA.h"))
+        reference = macros(HYA_HEADER)
+
+        # the frame names differ, the topology has to match the hand-written model
+        self.assertEqual(sorted(generated.keys()), sorted(reference.keys()))
+        for key in ["CT_N_EE", "CT_EE0_IS_ON_LINK", "CT_EE0_FIRST_JOINT", "CT_EE0_LAST_JOINT"]:
+            self.assertEqual(generated[key], reference[key], key)
+
+        # every revolute joint of the URDF connects two links, the fixed end-effector joint is lumped
+        self.assertTrue(kindsl.startswith("Robot ct_HyA"))
+        self.assertEqual(len(re.findall(r"^link ", kindsl, re.MULTILINE)), 6)
+        self.assertEqual(len(re.findall(r"^r_joint ", kindsl, re.MULTILINE)), 6)
+        self.assertNotIn("hya_ee0_joint", kindsl)
+        self.assertIn("mass = 2.6888738", kindsl)
+        self.assertIn("base=fr_hya_base_link, target=fr_hya_ee0", dtdsl)
+
+    def test_floating_base(self):
+        urdf = os.path.join(self.output_dir, "Biped.urdf")
+        with open(urdf, "w") as f:
+            f.write(FLOATING_BASE_URDF)
+
+        self.assertEqual(self.convert(urdf, "Biped", "--floating-base", "--ee", "left_foot", "right_foot"), 0)
+
+        kindsl = self.read("model", "ct_Biped.kindsl")
+        generated = macros(os.path.join(self.output_dir, "Biped.h"))
+
+        self.assertIn("floating", kindsl)
+        self.assertEqual(generated["CT_N_EE"], "2")
+        self.assertEqual(generated["CT_EE0_IS_ON_LINK"], "1")
+        self.assertEqual(generated["CT_EE1_IS_ON_LINK"], "2")
+        self.assertEqual(generated["CT_EE1_FIRST_JOINT"], generated["CT_EE1_LAST_JOINT"])
+
+    def test_invalid_end_effector(self):
+        self.assertNotEqual(self.convert(HYA_URDF, "HyA", "--ee", "no_such_link"), 0)
+        self.assertFalse(os.path.exists(os.path.join(self.output_dir, "HyA.h")))
+
+
+if __name__ == "__main__":
+    unittest.main()
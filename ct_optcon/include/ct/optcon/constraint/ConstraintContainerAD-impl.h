@@ -47,15 +47,19 @@ ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::ConstraintContainerAD(con
       fIntermediate_(arg.fIntermediate_),
       fTerminal_(arg.fTerminal_),
       sparsityIntermediateRows_(arg.sparsityIntermediateRows_),
+      sparsityIntermediateCols_(arg.sparsityIntermediateCols_),
       sparsityStateIntermediateRows_(arg.sparsityStateIntermediateRows_),
       sparsityStateIntermediateCols_(arg.sparsityStateIntermediateCols_),
       sparsityInputIntermediateRows_(arg.sparsityInputIntermediateRows_),
       sparsityInputIntermediateCols_(arg.sparsityInputIntermediateCols_),
       sparsityTerminalRows_(arg.sparsityTerminalRows_),
+      sparsityTerminalCols_(arg.sparsityTerminalCols_),
       sparsityStateTerminalRows_(arg.sparsityStateTerminalRows_),
       sparsityStateTerminalCols_(arg.sparsityStateTerminalCols_),
       sparsityInputTerminalRows_(arg.sparsityInputTerminalRows_),
       sparsityInputTerminalCols_(arg.sparsityInputTerminalCols_),
+      jacSparseIntermediate_(arg.jacSparseIntermediate_),
+      jacSparseTerminal_(arg.jacSparseTerminal_),
       stateControlD_(arg.stateControlD_)
 {
     constraintsIntermediate_.resize(arg.constraintsIntermediate_.size());
@@ -303,6 +307,52 @@ ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianInputTerminal()
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::linearizeIntermediate(Eigen::Ref<VectorXs> g,
+    Eigen::Ref<MatrixXs> C,
+    Eigen::Ref<MatrixXs> D)
+{
+    if (!this->initializedIntermediate_)
+        throw std::runtime_error("Constraints not initialized yet. Call 'initialize()' before");
+
+    intermediateCodegen_->forwardZero(stateControlD_, g);
+    intermediateCodegen_->sparseJacobianValues(stateControlD_, jacSparseIntermediate_);
+
+    C.setZero();
+    D.setZero();
+    for (int i = 0; i < jacSparseIntermediate_.rows(); ++i)
+    {
+        if (sparsityIntermediateCols_(i) < static_cast<int>(STATE_DIM))
+            C(sparsityIntermediateRows_(i), sparsityIntermediateCols_(i)) = jacSparseIntermediate_(i);
+        else
+            D(sparsityIntermediateRows_(i), sparsityIntermediateCols_(i) - STATE_DIM) = jacSparseIntermediate_(i);
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::linearizeTerminal(Eigen::Ref<VectorXs> g,
+    Eigen::Ref<MatrixXs> C,
+    Eigen::Ref<MatrixXs> D)
+{
+    if (!this->initializedTerminal_)
+        throw std::runtime_error("Constraints not initialized yet. Call 'initialize()' before");
+
+    terminalCodegen_->forwardZero(stateControlD_, g);
+    terminalCodegen_->sparseJacobianValues(stateControlD_, jacSparseTerminal_);
+
+    C.setZero();
+    D.setZero();
+    for (int i = 0; i < jacSparseTerminal_.rows(); ++i)
+    {
+        if (sparsityTerminalCols_(i) < static_cast<int>(STATE_DIM))
+            C(sparsityTerminalRows_(i), sparsityTerminalCols_(i)) = jacSparseTerminal_(i);
+        else
+            D(sparsityTerminalRows_(i), sparsityTerminalCols_(i) - STATE_DIM) = jacSparseTerminal_(i);
+    }
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::sparsityPatternStateIntermediate(Eigen::VectorXi& iRows,
     Eigen::VectorXi& jCols)
@@ -406,6 +456,9 @@ bool ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::initializeIntermedia
 
         intermediateCodegen_->compileJIT(settings, "intermediateConstraints");
         intermediateCodegen_->getSparsityPatternJacobian(sparsityRows, sparsityCols);
+        sparsityIntermediateRows_ = sparsityRows;
+        sparsityIntermediateCols_ = sparsityCols;
+        jacSparseIntermediate_.resize(sparsityRows.rows());
 
         std::cout << "sparsityPattern Intermediate: " << std::endl
                   << intermediateCodegen_->getSparsityPatternJacobian() << std::endl;
@@ -471,6 +524,9 @@ bool ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::initializeTerminal()
 
         terminalCodegen_->compileJIT(settings, "terminalConstraints");
         terminalCodegen_->getSparsityPatternJacobian(sparsityRows, sparsityCols);
+        sparsityTerminalRows_ = sparsityRows;
+        sparsityTerminalCols_ = sparsityCols;
+        jacSparseTerminal_.resize(sparsityRows.rows());
 
         std::cout << "sparsityPattern Terminal: " << std::endl
                   << terminalCodegen_->getSparsityPatternJacobian() << std::endl;
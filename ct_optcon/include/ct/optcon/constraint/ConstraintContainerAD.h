@@ -112,6 +112,16 @@ public:
 
     virtual MatrixXs jacobianInputTerminal() override;
 
+    /**
+	 * @brief      Evaluates the intermediate constraints and their jacobians into preallocated buffers
+	 *
+	 *             The jacobian is evaluated once by the sparse codegen kernel and its non-zeros are
+	 *             scattered into C and D, no memory is allocated.
+	 */
+    virtual void linearizeIntermediate(Eigen::Ref<VectorXs> g, Eigen::Ref<MatrixXs> C, Eigen::Ref<MatrixXs> D) override;
+
+    virtual void linearizeTerminal(Eigen::Ref<VectorXs> g, Eigen::Ref<MatrixXs> C, Eigen::Ref<MatrixXs> D) override;
+
     virtual void sparsityPatternStateIntermediate(Eigen::VectorXi& iRows, Eigen::VectorXi& jCols) override;
 
     virtual void sparsityPatternStateTerminal(Eigen::VectorXi& iRows, Eigen::VectorXi& jCols) override;
@@ -169,17 +179,22 @@ private:
     typename JacCG::FUN_TYPE_CG fTerminal_;
 
     Eigen::VectorXi sparsityIntermediateRows_;
+    Eigen::VectorXi sparsityIntermediateCols_;
     Eigen::VectorXi sparsityStateIntermediateRows_;
     Eigen::VectorXi sparsityStateIntermediateCols_;
     Eigen::VectorXi sparsityInputIntermediateRows_;
     Eigen::VectorXi sparsityInputIntermediateCols_;
 
     Eigen::VectorXi sparsityTerminalRows_;
+    Eigen::VectorXi sparsityTerminalCols_;
     Eigen::VectorXi sparsityStateTerminalRows_;
     Eigen::VectorXi sparsityStateTerminalCols_;
     Eigen::VectorXi sparsityInputTerminalRows_;
     Eigen::VectorXi sparsityInputTerminalCols_;
 
+    VectorXs jacSparseIntermediate_; /** non-zeros of the stacked jacobian, sized on initialization */
+    VectorXs jacSparseTerminal_;
+
 
     Eigen::Matrix<SCALAR, STATE_DIM + CONTROL_DIM, 1> stateControlD_; /** contains x, u in stacked form */
 };
@@ -303,6 +303,43 @@ ConstraintContainerAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianInputTerm
     return evalJacDenseInputTerminal_;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void ConstraintContainerAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::linearizeIntermediate(Eigen::Ref<VectorXs> g,
+    Eigen::Ref<MatrixXs> C,
+    Eigen::Ref<MatrixXs> D)
+{
+    checkIntermediateConstraints();
+
+    // write the terms directly into the caller's buffers, skipping the container-owned copies
+    size_t count = 0;
+    for (auto constraint : constraintsIntermediate_)
+    {
+        size_t constraint_dim = constraint->getConstraintSize();
+        g.segment(count, constraint_dim) = constraint->evaluate(this->x_, this->u_, this->t_);
+        C.block(count, 0, constraint_dim, STATE_DIM) = constraint->jacobianState(this->x_, this->u_, this->t_);
+        D.block(count, 0, constraint_dim, CONTROL_DIM) = constraint->jacobianInput(this->x_, this->u_, this->t_);
+        count += constraint_dim;
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void ConstraintContainerAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::linearizeTerminal(Eigen::Ref<VectorXs> g,
+    Eigen::Ref<MatrixXs> C,
+    Eigen::Ref<MatrixXs> D)
+{
+    checkTerminalConstraints();
+
+    size_t count = 0;
+    for (auto constraint : constraintsTerminal_)
+    {
+        size_t constraint_dim = constraint->getConstraintSize();
+        g.segment(count, constraint_dim) = constraint->evaluate(this->x_, this->u_, this->t_);
+        C.block(count, 0, constraint_dim, STATE_DIM) = constraint->jacobianState(this->x_, this->u_, this->t_);
+        D.block(count, 0, constraint_dim, CONTROL_DIM) = constraint->jacobianInput(this->x_, this->u_, this->t_);
+        count += constraint_dim;
+    }
+}
+
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void ConstraintContainerAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::sparsityPatternStateIntermediate(
@@ -108,6 +108,10 @@ public:
 
     virtual MatrixXs jacobianInputTerminal() override;
 
+    virtual void linearizeIntermediate(Eigen::Ref<VectorXs> g, Eigen::Ref<MatrixXs> C, Eigen::Ref<MatrixXs> D) override;
+
+    virtual void linearizeTerminal(Eigen::Ref<VectorXs> g, Eigen::Ref<MatrixXs> C, Eigen::Ref<MatrixXs> D) override;
+
     virtual void sparsityPatternStateIntermediate(Eigen::VectorXi& iRows, Eigen::VectorXi& jCols) override;
 
     virtual void sparsityPatternStateTerminal(Eigen::VectorXi& iRows, Eigen::VectorXi& jCols) override;
@@ -49,28 +49,28 @@ size_t ConstraintContainerBase<STATE_DIM, CONTROL_DIM, SCALAR>::getConstraintsCo
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
-typename ConstraintContainerBase<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs
+const typename ConstraintContainerBase<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs&
 ConstraintContainerBase<STATE_DIM, CONTROL_DIM, SCALAR>::getLowerBoundsIntermediate() const
 {
     return lowerBoundsIntermediate_;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
-typename ConstraintContainerBase<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs
+const typename ConstraintContainerBase<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs&
 ConstraintContainerBase<STATE_DIM, CONTROL_DIM, SCALAR>::getLowerBoundsTerminal() const
 {
     return lowerBoundsTerminal_;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
-typename ConstraintContainerBase<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs
+const typename ConstraintContainerBase<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs&
 ConstraintContainerBase<STATE_DIM, CONTROL_DIM, SCALAR>::getUpperBoundsIntermediate() const
 {
     return upperBoundsIntermediate_;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
-typename ConstraintContainerBase<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs
+const typename ConstraintContainerBase<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs&
 ConstraintContainerBase<STATE_DIM, CONTROL_DIM, SCALAR>::getUpperBoundsTerminal() const
 {
     return upperBoundsTerminal_;
@@ -119,7 +119,7 @@ public:
 	 *
 	 * @return     The lower bound on the intermediate constraints
 	 */
-    VectorXs getLowerBoundsIntermediate() const;
+    const VectorXs& getLowerBoundsIntermediate() const;
 
     /**
 	 * @brief      Retrieves the lower constraint bound on the terminal
@@ -127,7 +127,7 @@ public:
 	 *
 	 * @return     The lower bound on the terminal constraints
 	 */
-    VectorXs getLowerBoundsTerminal() const;
+    const VectorXs& getLowerBoundsTerminal() const;
 
     /**
 	 * @brief      Retrieves the upper constraint bound on the intermediate
@@ -135,7 +135,7 @@ public:
 	 *
 	 * @return     The upper bound on the intermediate constraints
 	 */
-    VectorXs getUpperBoundsIntermediate() const;
+    const VectorXs& getUpperBoundsIntermediate() const;
 
     /**
 	 * @brief      Retrieves the upper constraint bound on the terminal
@@ -143,7 +143,7 @@ public:
 	 *
 	 * @return     The upper bound on the terminal constraints
 	 */
-    VectorXs getUpperBoundsTerminal() const;
+    const VectorXs& getUpperBoundsTerminal() const;
 
     /**
 	 * @brief      Retrieves the violation of the upper constraint bound on the intermediate constraints
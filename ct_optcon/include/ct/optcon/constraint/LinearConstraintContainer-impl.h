@@ -28,6 +28,26 @@ LinearConstraintContainer<STATE_DIM, CONTROL_DIM, SCALAR>::~LinearConstraintCont
 {
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void LinearConstraintContainer<STATE_DIM, CONTROL_DIM, SCALAR>::linearizeIntermediate(Eigen::Ref<VectorXs> g,
+    Eigen::Ref<MatrixXs> C,
+    Eigen::Ref<MatrixXs> D)
+{
+    g = this->evaluateIntermediate();
+    C = jacobianStateIntermediate();
+    D = jacobianInputIntermediate();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void LinearConstraintContainer<STATE_DIM, CONTROL_DIM, SCALAR>::linearizeTerminal(Eigen::Ref<VectorXs> g,
+    Eigen::Ref<MatrixXs> C,
+    Eigen::Ref<MatrixXs> D)
+{
+    g = this->evaluateTerminal();
+    C = jacobianStateTerminal();
+    D = jacobianInputTerminal();
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 size_t LinearConstraintContainer<STATE_DIM, CONTROL_DIM, SCALAR>::getJacNonZeroCount()
 {
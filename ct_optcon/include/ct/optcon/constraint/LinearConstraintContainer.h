@@ -120,6 +120,29 @@ public:
 	 */
     virtual MatrixXs jacobianInputTerminal() = 0;
 
+    /**
+	 * @brief      Evaluates the intermediate constraints and their jacobians into preallocated buffers
+	 *
+	 *             The buffers are owned by the caller and need to be sized once after initialization, i.e.
+	 *             g to getIntermediateConstraintsCount() and C, D to getIntermediateConstraintsCount() rows
+	 *             and STATE_DIM, CONTROL_DIM columns. The default implementation falls back to the by-value
+	 *             evaluation, derived containers override it to avoid temporaries.
+	 *
+	 * @param[out] g     The constraint evaluation
+	 * @param[out] C     The jacobian wrt state
+	 * @param[out] D     The jacobian wrt control
+	 */
+    virtual void linearizeIntermediate(Eigen::Ref<VectorXs> g, Eigen::Ref<MatrixXs> C, Eigen::Ref<MatrixXs> D);
+
+    /**
+	 * @brief      Evaluates the terminal constraints and their jacobians into preallocated buffers
+	 *
+	 * @param[out] g     The constraint evaluation, of size getTerminalConstraintsCount()
+	 * @param[out] C     The jacobian wrt state
+	 * @param[out] D     The jacobian wrt control
+	 */
+    virtual void linearizeTerminal(Eigen::Ref<VectorXs> g, Eigen::Ref<MatrixXs> C, Eigen::Ref<MatrixXs> D);
+
     /**
 	 * @brief      Returns the sparsity pattern for the jacobian wrt state
 	 *
@@ -10,6 +10,7 @@ namespace optcon {
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::CostFunctionQuadratic()
+    : lastStage_(0), activationsOutdated_(false)
 {
     eps_ = sqrt(Eigen::NumTraits<SCALAR>::epsilon());
 }
@@ -18,7 +19,13 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::CostFunctionQuadratic(const CostFunctionQuadratic& arg)
     : CostFunction<STATE_DIM, CONTROL_DIM, SCALAR>(arg),
       eps_(arg.eps_),
-      doubleSidedDerivative_(arg.doubleSidedDerivative_)
+      doubleSidedDerivative_(arg.doubleSidedDerivative_),
+      stageTimes_(arg.stageTimes_),
+      shiftedStageTimes_(arg.shiftedStageTimes_),
+      stageTerms_(arg.stageTerms_),
+      stageOffsets_(arg.stageOffsets_),
+      lastStage_(arg.lastStage_),
+      activationsOutdated_(arg.activationsOutdated_)
 {
     intermediateCostAnalytical_.resize(arg.intermediateCostAnalytical_.size());
     finalCostAnalytical_.resize(arg.finalCostAnalytical_.size());
@@ -273,6 +280,89 @@ void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::initialize()
 	 */
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::precomputeActivations(
+    const core::tpl::TimeArray<SCALAR>& stageTimes)
+{
+    for (size_t k = 1; k < stageTimes.size(); k++)
+        if (stageTimes[k] < stageTimes[k - 1])
+            throw std::runtime_error("CostFunctionQuadratic: stage times need to be in ascending order.");
+
+    stageTimes_.assign(stageTimes.begin(), stageTimes.end());
+    updateActivations();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::shiftTime(const SCALAR t)
+{
+    BASE::shiftTime(t);
+
+    if (!stageTimes_.empty())
+        updateActivations();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::updateActivations()
+{
+    shiftedStageTimes_.resize(stageTimes_.size());
+    stageTerms_.clear();
+    stageOffsets_.assign(1, 0);
+
+    for (size_t k = 0; k < stageTimes_.size(); k++)
+    {
+        // same operation as in setCurrentStateAndControl(), such that the times compare equal
+        shiftedStageTimes_[k] = stageTimes_[k] + this->t_shift_;
+
+        for (size_t i = 0; i < intermediateCostAnalytical_.size(); i++)
+        {
+            if (intermediateCostAnalytical_[i]->isActiveAtTime(shiftedStageTimes_[k]))
+                stageTerms_.push_back({i, intermediateCostAnalytical_[i]->computeActivation(shiftedStageTimes_[k])});
+        }
+        stageOffsets_.push_back(stageTerms_.size());
+    }
+
+    lastStage_ = 0;
+    activationsOutdated_ = false;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+typename CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::ActiveTermRange
+CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::activeIntermediateTerms()
+{
+    if (activationsOutdated_)
+        updateActivations();
+
+    const size_t nStages = shiftedStageTimes_.size();
+    if (nStages > 0)
+    {
+        // stages are usually evaluated in order, hence try the last and the next stage before searching
+        size_t k = lastStage_;
+        if (shiftedStageTimes_[k] != this->t_)
+        {
+            if (k + 1 < nStages && shiftedStageTimes_[k + 1] == this->t_)
+                k++;
+            else
+                k = std::lower_bound(shiftedStageTimes_.begin(), shiftedStageTimes_.end(), this->t_) -
+                    shiftedStageTimes_.begin();
+        }
+
+        if (k < nStages && shiftedStageTimes_[k] == this->t_)
+        {
+            lastStage_ = k;
+            return {stageTerms_.data() + stageOffsets_[k], stageTerms_.data() + stageOffsets_[k + 1]};
+        }
+    }
+
+    activeTerms_.clear();
+    for (size_t i = 0; i < intermediateCostAnalytical_.size(); i++)
+    {
+        if (intermediateCostAnalytical_[i]->isActiveAtTime(this->t_))
+            activeTerms_.push_back({i, intermediateCostAnalytical_[i]->computeActivation(this->t_)});
+    }
+
+    return {activeTerms_.data(), activeTerms_.data() + activeTerms_.size()};
+}
+
 
 // add terms
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
@@ -281,6 +371,7 @@ size_t CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::addIntermediateTer
     bool verbose)
 {
     intermediateCostAnalytical_.push_back(term);
+    activationsOutdated_ = true;
     if (verbose)
     {
         std::string name = term->getName();
@@ -311,14 +402,8 @@ SCALAR CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateIntermedia
 {
     SCALAR y = SCALAR(0.0);
 
-    for (auto it : this->intermediateCostAnalytical_)
-    {
-        if (!it->isActiveAtTime(this->t_))
-        {
-            continue;
-        }
-        y += it->computeActivation(this->t_) * it->eval(this->x_, this->u_, this->t_);
-    }
+    for (const ActiveTerm& term : activeIntermediateTerms())
+        y += term.activation * intermediateCostAnalytical_[term.index]->evaluate(this->x_, this->u_, this->t_);
 
     return y;
 }
@@ -343,14 +428,9 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateDerivativeIntermedia
     state_vector_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
-    {
-        if (!it->isActiveAtTime(this->t_))
-        {
-            continue;
-        }
-        derivative += it->computeActivation(this->t_) * it->stateDerivative(this->x_, this->u_, this->t_);
-    }
+    for (const ActiveTerm& term : activeIntermediateTerms())
+        derivative += term.activation *
+                      intermediateCostAnalytical_[term.index]->stateDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
 }
@@ -376,14 +456,9 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateSecondDerivativeInte
     state_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
-    {
-        if (!it->isActiveAtTime(this->t_))
-        {
-            continue;
-        }
-        derivative += it->computeActivation(this->t_) * it->stateSecondDerivative(this->x_, this->u_, this->t_);
-    }
+    for (const ActiveTerm& term : activeIntermediateTerms())
+        derivative += term.activation *
+                      intermediateCostAnalytical_[term.index]->stateSecondDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
 }
@@ -409,14 +484,9 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::controlDerivativeIntermed
     control_vector_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
-    {
-        if (!it->isActiveAtTime(this->t_))
-        {
-            continue;
-        }
-        derivative += it->computeActivation(this->t_) * it->controlDerivative(this->x_, this->u_, this->t_);
-    }
+    for (const ActiveTerm& term : activeIntermediateTerms())
+        derivative += term.activation *
+                      intermediateCostAnalytical_[term.index]->controlDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
 }
@@ -442,14 +512,9 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::controlSecondDerivativeIn
     control_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
-    {
-        if (!it->isActiveAtTime(this->t_))
-        {
-            continue;
-        }
-        derivative += it->computeActivation(this->t_) * it->controlSecondDerivative(this->x_, this->u_, this->t_);
-    }
+    for (const ActiveTerm& term : activeIntermediateTerms())
+        derivative += term.activation *
+                      intermediateCostAnalytical_[term.index]->controlSecondDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
 }
@@ -475,14 +540,9 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateControlDerivativeInt
     control_state_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
-    {
-        if (!it->isActiveAtTime(this->t_))
-        {
-            continue;
-        }
-        derivative += it->computeActivation(this->t_) * it->stateControlDerivative(this->x_, this->u_, this->t_);
-    }
+    for (const ActiveTerm& term : activeIntermediateTerms())
+        derivative += term.activation *
+                      intermediateCostAnalytical_[term.index]->stateControlDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
 }
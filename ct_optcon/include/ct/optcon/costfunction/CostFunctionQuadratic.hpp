@@ -185,7 +185,43 @@ public:
     //! initialize the cost function (e.g. to be used in CostFunctionAD)
     virtual void initialize();
 
+    /**
+	 * \brief Precomputes the active intermediate terms and their activations at fixed stage times
+	 *
+	 * When the cost function is evaluated at one of the stage times, the inactive terms are skipped without evaluating
+	 * their activations, and the activations of the active terms are looked up. At all other times, the activations are
+	 * evaluated as usual. The precomputation is repeated when terms are added or the time is shifted, but needs to be
+	 * triggered by calling this method again if the activations of existing terms are changed.
+	 * @param stageTimes the stage times in ascending order, an empty array removes the precomputed activations
+	 */
+    void precomputeActivations(const core::tpl::TimeArray<SCALAR>& stageTimes);
+
+    //! shift the time and the precomputed activations
+    virtual void shiftTime(const SCALAR t) override;
+
 protected:
+    //! an intermediate term which is active at the current time and its activation
+    struct ActiveTerm
+    {
+        size_t index;
+        SCALAR activation;
+    };
+
+    //! the active intermediate terms at the current time
+    struct ActiveTermRange
+    {
+        const ActiveTerm* begin() const { return begin_; }
+        const ActiveTerm* end() const { return end_; }
+        const ActiveTerm* begin_;
+        const ActiveTerm* end_;
+    };
+
+    //! get the active intermediate terms at the current time, from the precomputed activations if available
+    ActiveTermRange activeIntermediateTerms();
+
+    //! evaluate the activations at the stage times
+    void updateActivations();
+
     //! evaluate intermediate analytical cost terms
     SCALAR evaluateIntermediateBase();
 
@@ -239,6 +275,14 @@ protected:
 
     /** list of final cost terms for which analytic derivatives are available */
     std::vector<std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR>>> finalCostAnalytical_;
+
+    std::vector<SCALAR> stageTimes_;         //!< stage times the activations are precomputed at, excluding the shift
+    std::vector<SCALAR> shiftedStageTimes_;  //!< stage times including the shift, as set by setCurrentStateAndControl()
+    std::vector<ActiveTerm> stageTerms_;     //!< active terms of all stages, stored consecutively
+    std::vector<size_t> stageOffsets_;       //!< index of the first active term of every stage in stageTerms_
+    size_t lastStage_;                       //!< stage found in the last lookup
+    bool activationsOutdated_;               //!< terms have been added since the activations were precomputed
+    std::vector<ActiveTerm> activeTerms_;    //!< active terms at times without precomputed activations
 };
 
 
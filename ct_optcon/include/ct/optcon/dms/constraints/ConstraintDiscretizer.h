@@ -331,6 +331,8 @@ public:
     }
 
     size_t getConstraintSize() override { return constraintsCount_; }
+    //! the number of intermediate constraints at every pair
+    size_t getIntermediateConstraintsCount() const { return constraintsIntermediateCount_ / (N_ + 1); }
 private:
     std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> w_;
     std::shared_ptr<SplinerBase<control_vector_t, SCALAR>> controlSpliner_;
@@ -86,8 +86,8 @@ public:
             }
         }
 
-        // if(settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
-        // 	nr += STATE_DIM;
+        if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+            nr += STATE_DIM;
         jacLocal_.resize(nr);
     }
 
@@ -103,8 +103,8 @@ public:
                 computeXblock();  // add the big block (derivative w.r.t. state s_i)
                 computeUblock();  // add the smaller block (derivative w.r.t. control q_i)
                 computeIblock();  // add the diagonal (derivative w.r.t. state s_(i+1))
-                // if(settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
-                // 	computeHblock();
+                if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+                    computeHblock();
                 break;
             }
             case DmsSettings::PIECEWISE_LINEAR:
@@ -113,8 +113,8 @@ public:
                 computeUblock();    // add the smaller block (derivative w.r.t. control q_i)
                 computeIblock();    // add the diagonal (derivative w.r.t. state s_(i+1))
                 computeUblock_2();  // add the smaller block (derivative w.r.t. control q_(i+1))
-                // if(settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
-                // 	computeHblock();
+                if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+                    computeHblock();
                 break;
             }
             default:
@@ -147,10 +147,8 @@ public:
         }
 
         /* the derivatives w.r.t. the time optimization variable (h_i) */
-        // if(settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
-        // {
-        // 	no += STATE_DIM;
-        // }
+        if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+            no += STATE_DIM;
 
         return no;
     }
@@ -202,12 +200,10 @@ public:
             }
         }
 
-        /* for the derivatives w.r.t. the time optimization variables (t_i) */
-        // if(settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
-        // {
-        // 	indexNumber += BASE::genBlockIndices(w_->getTimeSegmentIndex(shotIndex_),
-        // 		STATE_DIM, 1, iRow_vec, jCol_vec, indexNumber);
-        // }
+        /* for the derivatives w.r.t. the time optimization variables (h_i) */
+        if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+            indexNumber += BASE::genBlockIndices(
+                w_->getTimeSegmentIndex(shotIndex_), STATE_DIM, 1, iRow_vec, jCol_vec, indexNumber);
     }
 
     VectorXs getLowerBound() override { return lb_; }
@@ -256,41 +252,6 @@ private:
 };
 
 
-// template <size_t STATE_DIM, size_t CONTROL_DIM>
-// void ContinuityConstraint<STATE_DIM, CONTROL_DIM>::computeHblock()
-// {
-// 	// take last elements of state and time
-// 	state_vector_t state = shotContainer_->getStateIntegrated();
-// 	ct::core::Time time = shotContainer_->getIntegrationTimeFinal();
-
-// 	// compute derivative
-// 	state_vector_t mat;
-// 	state_vector_t dynamics;
-// 	shotContainer_->getControlledSystemPtr()->computeDynamics(state, time, dynamics);
-
-// 	switch (settings_.splineType_)
-// 	{
-// 		case DmsSettings::ZERO_ORDER_HOLD:
-// 		{
-// 			mat = - dynamics;
-// 			break;
-// 		}
-// 		case DmsSettings::PIECEWISE_LINEAR:
-// 		{
-// 			mat = -dynamics - shotContainer_->getdXdHiIntegrated();
-// 			break;
-// 		}
-// 		default:
-// 		{
-// 			throw(std::runtime_error("specified invalid spliner type in ContinuityConstraint-class"));
-// 		}
-// 	}
-
-// 	jacLocal_.segment(count_local_, STATE_DIM) = mat;
-// 	count_local_ += STATE_DIM;
-// }
-
-
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void ContinuityConstraint<STATE_DIM, CONTROL_DIM, SCALAR>::computeXblock()
 {
@@ -338,5 +299,13 @@ void ContinuityConstraint<STATE_DIM, CONTROL_DIM, SCALAR>::computeIblock()
     count_local_ += STATE_DIM;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void ContinuityConstraint<STATE_DIM, CONTROL_DIM, SCALAR>::computeHblock()
+{
+    // fill into value vector with correct indexing
+    jacLocal_.segment(count_local_, STATE_DIM) = -shotContainer_->getdXdHiIntegrated();
+    count_local_ += STATE_DIM;
+}
+
 }  // namespace optcon
 }  // namespace ct
@@ -0,0 +1,84 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <ct/optcon/nlp/DiscreteConstraintBase.h>
+#include <ct/optcon/dms/dms_core/OptVectorDms.h>
+#include <ct/optcon/dms/dms_core/DmsSettings.h>
+
+namespace ct {
+namespace optcon {
+
+/**
+ * @ingroup    DMS
+ *
+ * @brief      The implementation of the DMS time horizon constraint, used when
+ *             the time grid is optimized. The sum of the shot durations lies
+ *             between N * h_min and the time horizon T, i.e. T is the maximum
+ *             time horizon.
+ *
+ * @tparam     STATE_DIM    The state dimension
+ * @tparam     CONTROL_DIM  The input dimension
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
+class TimeHorizonConstraint : public tpl::DiscreteConstraintBase<SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef tpl::DiscreteConstraintBase<SCALAR> BASE;
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> VectorXs;
+
+    /**
+	 * @brief      Default constructor
+	 */
+    TimeHorizonConstraint() = default;
+    /**
+	 * @brief      Custom constructor
+	 *
+	 * @param[in]  w         The optimization variables
+	 * @param[in]  settings  The dms settings
+	 */
+    TimeHorizonConstraint(std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> w,
+        const DmsSettings& settings)
+        : w_(w), settings_(settings)
+    {
+        lb_.resize(1);
+        ub_.resize(1);
+        lb_ << SCALAR(settings_.N_ * settings_.h_min_ - settings_.T_);
+        ub_ << SCALAR(0.0);
+    }
+
+    VectorXs eval() override
+    {
+        VectorXs val(1);
+        val << w_->getOptimizedTimeSegments().sum() - SCALAR(settings_.T_);
+        return val;
+    }
+
+    VectorXs evalSparseJacobian() override { return VectorXs::Ones(settings_.N_); }
+    size_t getNumNonZerosJacobian() override { return settings_.N_; }
+    void genSparsityPattern(Eigen::VectorXi& iRow_vec, Eigen::VectorXi& jCol_vec) override
+    {
+        size_t indexNumber = 0;
+        indexNumber +=
+            BASE::genBlockIndices(w_->getTimeSegmentIndex(0), 1, settings_.N_, iRow_vec, jCol_vec, indexNumber);
+    }
+
+    VectorXs getLowerBound() override { return lb_; }
+    VectorXs getUpperBound() override { return ub_; }
+    size_t getConstraintSize() override { return 1; }
+private:
+    std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> w_;
+    const DmsSettings settings_;
+
+    //Constraint bounds
+    VectorXs lb_;  // lower bound
+    VectorXs ub_;  // upper bound
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -32,6 +32,16 @@ ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>::ConstraintsContainerDms
         std::cout << "Adding discretized constraints" << std::endl;
         this->constraints_.push_back(discretizedConstraints);
     }
+
+    // appended last, such that the layout of the other constraints does not depend on the objective type
+    if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+    {
+        std::shared_ptr<TimeHorizonConstraint<STATE_DIM, CONTROL_DIM, SCALAR>> c_horizon =
+            std::shared_ptr<TimeHorizonConstraint<STATE_DIM, CONTROL_DIM, SCALAR>>(
+                new TimeHorizonConstraint<STATE_DIM, CONTROL_DIM, SCALAR>(w, settings));
+
+        this->constraints_.push_back(c_horizon);
+    }
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
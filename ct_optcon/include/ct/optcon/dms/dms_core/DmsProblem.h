@@ -95,11 +95,10 @@ public:
         }
 
 
+        // with an optimized time grid, the shot durations are appended to the pairs
         size_t wLength = (settings.N_ + 1) * (STATE_DIM + CONTROL_DIM);
         if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
-        {
-            throw std::runtime_error("We do not support adaptive time gridding");
-        }
+            wLength += settings_.N_;
 
         this->optVariables_ = std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>>(
             new OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>(wLength, settings));
@@ -161,9 +160,10 @@ public:
                 throw(std::runtime_error("Unknown cost evaluation type"));
         }
 
-        this->constraints_ = std::shared_ptr<ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>>(
+        constraintsDms_ = std::shared_ptr<ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>>(
             new ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>(
                 optVariablesDms_, timeGrid_, shotContainers_, discretizedConstraints_, x0, settings_));
+        this->constraints_ = constraintsDms_;
 
         this->optVariables_->resizeConstraintVars(this->getConstraintsCount());
     }
@@ -176,6 +176,9 @@ public:
 
     void updateProblem() override
     {
+        if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+            timeGrid_->updateTimeGrid(optVariablesDms_->getOptimizedTimeSegments());
+
         controlSpliner_->computeSpline(optVariablesDms_->getOptimizedInputs().toImplementation());
         for (auto shotContainer : shotContainers_)
             shotContainer->reset();
@@ -256,10 +259,25 @@ public:
 	 */
     void changeInitialState(const state_vector_t& x0)
     {
-        // constraints_->changeInitialConstraint(x0);
+        constraintsDms_->changeInitialConstraint(x0);
         optVariablesDms_->changeInitialState(x0);
     }
 
+    /**
+	 * @brief      Shifts the last solution and its multipliers about numShots
+	 *             shots to the front, as warm start for the next solve. The
+	 *             structure of the problem is unchanged, such that the NLP
+	 *             solver can reuse it.
+	 *
+	 * @param[in]  numShots  The number of shots to shift
+	 */
+    void shiftSolution(const size_t numShots)
+    {
+        const size_t numPathConstraints =
+            discretizedConstraints_ ? discretizedConstraints_->getIntermediateConstraintsCount() : 0;
+        optVariablesDms_->shiftSolution(numShots, numPathConstraints);
+    }
+
     /**
 	 * @brief      Prints the solution trajectories
 	 */
@@ -269,6 +287,7 @@ private:
     DmsSettings settings_;
 
     std::shared_ptr<ConstraintDiscretizer<STATE_DIM, CONTROL_DIM, SCALAR>> discretizedConstraints_;
+    std::shared_ptr<ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>> constraintsDms_;
 
     std::vector<std::shared_ptr<ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>>> shotContainers_;
     std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> optVariablesDms_;
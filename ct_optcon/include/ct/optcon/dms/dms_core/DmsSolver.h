@@ -158,6 +158,41 @@ public:
         dmsProblem_->setInitialGuess(initialGuess.xSolution_, initialGuess.uSolution_);
     }
 
+    /**
+	 * @brief      Shifts the last solution about dt_shift to the front. The
+	 *             NLP solver keeps the structure of the problem and is warm
+	 *             started from the shifted optimization variables and
+	 *             multipliers, hence only the new initial state has to be set
+	 *             before the next solve.
+	 *
+	 * @param[in]  dt_shift  The time to shift, needs to coincide with the
+	 *                       start of a shot
+	 *
+	 * @return     false if dt_shift does not coincide with the start of a
+	 *             shot, then the solution is left unchanged
+	 */
+    bool shiftHorizon(const SCALAR& dt_shift) override
+    {
+        const time_array_t& t = dmsProblem_->getTimeArray();
+        const SCALAR tolerance = 1e-9 * t.back();
+
+        size_t numShots = 0;
+        while (numShots < settings_.N_ && t[numShots] < dt_shift - tolerance)
+            numShots++;
+
+        if (numShots == settings_.N_ || std::abs(t[numShots] - dt_shift) > tolerance)
+            return false;
+
+        dmsProblem_->shiftSolution(numShots);
+
+        const NlpSolverSettings& solverSettings = settings_.solverSettings_;
+        if (solverSettings.solverType_ == NlpSolverType::SNOPT)
+            nlpSolver_->prepareWarmStart(solverSettings.snoptSettings_.major_iteration_limit_param_);
+        else
+            nlpSolver_->prepareWarmStart(solverSettings.ipoptSettings_.max_iter_);
+        return true;
+    }
+
     SCALAR getTimeHorizon() const override { return dmsProblem_->getTimeHorizon(); }
     void changeTimeHorizon(const SCALAR& tf) override
     {
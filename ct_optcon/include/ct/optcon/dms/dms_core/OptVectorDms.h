@@ -41,6 +41,7 @@ public:
 
     typedef DmsDimensions<STATE_DIM, CONTROL_DIM, SCALAR> DIMENSIONS;
     typedef tpl::OptVector<SCALAR> Base;
+    typedef typename Base::VectorXs VectorXs;
 
     typedef typename DIMENSIONS::state_vector_t state_vector_t;
     typedef typename DIMENSIONS::control_vector_t control_vector_t;
@@ -82,6 +83,14 @@ public:
     */
     control_vector_t getOptimizedControl(const size_t pairNum) const;
 
+    /**
+     * @brief      Returns the optimized durations of all shots. Only available
+     *             when the time grid is optimized
+     *
+     * @return     The optimized shot durations
+    */
+    VectorXs getOptimizedTimeSegments() const;
+
     /**
      * @brief      Returns the optimized state for all shots
      *
@@ -116,6 +125,17 @@ public:
      */
     size_t getControlIndex(const size_t pairNum) const;
 
+    /**
+     * @brief      Returns the index of the duration of shot shotNr inside the
+     *             optimization vector. Only available when the time grid is
+     *             optimized
+     *
+     * @param[in]  shotNr  The shot number
+     *
+     * @return     The time segment index.
+     */
+    size_t getTimeSegmentIndex(const size_t shotNr) const;
+
     /**
      * @brief      Sets an initial guess for the optimal solution. The optimal
      *             solution is set as a linear interpolation between inital
@@ -150,6 +170,18 @@ public:
      */
     void changeDesiredState(const state_vector_t& xF);
 
+    /**
+     * @brief      Shifts the last solution about numShots shots to the front and
+     *             uses it as initial guess for the next solve, together with the
+     *             equally shifted bound and constraint multipliers. The pairs and
+     *             shot durations at the end of the horizon repeat the last ones.
+     *
+     * @param[in]  numShots            The number of shots to shift
+     * @param[in]  numPathConstraints  The number of discretized intermediate
+     *                                 constraints per pair
+     */
+    void shiftSolution(size_t numShots, const size_t numPathConstraints);
+
     /**
      * @brief      Returns the number of pairs 
      *
@@ -162,6 +194,16 @@ public:
     void printoutSolution();
 
 private:
+    /**
+     * @brief      Moves numBlocks consecutive blocks of v about numShots blocks
+     *             to the front, the last block fills up the end
+     */
+    static void shiftBlocks(VectorXs& v,
+        const size_t start,
+        const size_t blockSize,
+        const size_t numBlocks,
+        const size_t numShots);
+
     DmsSettings settings_;
 
     const size_t numPairs_;
@@ -13,7 +13,15 @@ namespace optcon {
 /**
  * @brief      This class can integrate a controlled system and a costfunction.
  *             Furthermore, it provides first order derivatives with respect to
- *             initial state and control
+ *             initial state, control and the duration of the integration
+ *             interval.
+ *
+ *             All sensitivities are integrated in one augmented ODE
+ *             \f$ \dot{S} = A S + [0, B \frac{\partial u}{\partial q_i}, B \frac{\partial u}{\partial q_{i+1}},
+ *             \frac{f}{h}] \f$ with \f$ S(0) = [I, 0, 0, 0] \f$, stepped with the same scheme as the state, such
+ *             that they are the exact derivatives of the discrete integration. The derivative with respect to the
+ *             interval duration h assumes that the integration time step scales with h and that the controller only
+ *             depends on the relative time within the interval.
  *
  * @tparam     STATE_DIM    The state dimension
  * @tparam     CONTROL_DIM  The control dimension
@@ -24,11 +32,18 @@ class SensitivityIntegratorCT
 {
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    //! number of columns of the augmented sensitivity, [x0, u0, uf, h]
+    static const size_t SENSITIVITY_DIM = STATE_DIM + 2 * CONTROL_DIM + 1;
+
     typedef ct::core::StateVector<STATE_DIM, SCALAR> state_vector;
     typedef ct::core::ControlVector<CONTROL_DIM, SCALAR> control_vector;
     typedef Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM> state_matrix;
     typedef Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM> control_matrix;
     typedef Eigen::Matrix<SCALAR, STATE_DIM, CONTROL_DIM> state_control_matrix;
+    typedef Eigen::Matrix<SCALAR, STATE_DIM, SENSITIVITY_DIM> sensitivity_matrix;
+    typedef Eigen::Matrix<SCALAR, SENSITIVITY_DIM, 1> cost_sensitivity_vector;
+    typedef std::vector<sensitivity_matrix, Eigen::aligned_allocator<sensitivity_matrix>> sensitivity_matrix_array;
 
 
     /**
@@ -62,16 +77,13 @@ public:
             {
                 stepperState_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>>(
                     new ct::core::internal::StepperEulerCT<state_vector, SCALAR>());
-                stepperDX0_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_matrix, SCALAR>>(
-                    new ct::core::internal::StepperEulerCT<state_matrix, SCALAR>());
-                stepperDU0_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_control_matrix, SCALAR>>(
-                    new ct::core::internal::StepperEulerCT<state_control_matrix, SCALAR>());
+                stepperSensitivity_ = std::shared_ptr<ct::core::internal::StepperCTBase<sensitivity_matrix, SCALAR>>(
+                    new ct::core::internal::StepperEulerCT<sensitivity_matrix, SCALAR>());
                 stepperCost_ = std::shared_ptr<ct::core::internal::StepperCTBase<SCALAR, SCALAR>>(
                     new ct::core::internal::StepperEulerCT<SCALAR, SCALAR>());
-                stepperCostDX0_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>>(
-                    new ct::core::internal::StepperEulerCT<state_vector, SCALAR>());
-                stepperCostDU0_ = std::shared_ptr<ct::core::internal::StepperCTBase<control_vector, SCALAR>>(
-                    new ct::core::internal::StepperEulerCT<control_vector, SCALAR>());
+                stepperCostSensitivity_ =
+                    std::shared_ptr<ct::core::internal::StepperCTBase<cost_sensitivity_vector, SCALAR>>(
+                        new ct::core::internal::StepperEulerCT<cost_sensitivity_vector, SCALAR>());
                 break;
             }
 
@@ -79,16 +91,13 @@ public:
             {
                 stepperState_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>>(
                     new ct::core::internal::StepperRK4CT<state_vector, SCALAR>());
-                stepperDX0_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_matrix, SCALAR>>(
-                    new ct::core::internal::StepperRK4CT<state_matrix, SCALAR>());
-                stepperDU0_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_control_matrix, SCALAR>>(
-                    new ct::core::internal::StepperRK4CT<state_control_matrix, SCALAR>());
+                stepperSensitivity_ = std::shared_ptr<ct::core::internal::StepperCTBase<sensitivity_matrix, SCALAR>>(
+                    new ct::core::internal::StepperRK4CT<sensitivity_matrix, SCALAR>());
                 stepperCost_ = std::shared_ptr<ct::core::internal::StepperCTBase<SCALAR, SCALAR>>(
                     new ct::core::internal::StepperRK4CT<SCALAR, SCALAR>());
-                stepperCostDX0_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>>(
-                    new ct::core::internal::StepperRK4CT<state_vector, SCALAR>());
-                stepperCostDU0_ = std::shared_ptr<ct::core::internal::StepperCTBase<control_vector, SCALAR>>(
-                    new ct::core::internal::StepperRK4CT<control_vector, SCALAR>());
+                stepperCostSensitivity_ =
+                    std::shared_ptr<ct::core::internal::StepperCTBase<cost_sensitivity_vector, SCALAR>>(
+                        new ct::core::internal::StepperRK4CT<cost_sensitivity_vector, SCALAR>());
                 break;
             }
 
@@ -109,34 +118,19 @@ public:
         linearSystem_ = linearSystem;
         cacheData_ = true;
 
-        dX0dot_ = [this](const state_matrix& dX0In, state_matrix& dX0dt, const SCALAR t) {
-            if (cacheSensitivities_)
-                arraydX0_.push_back(dX0In);
-
-            dX0dt = arrayA_[dX0Index_] * dX0In;
-            dX0Index_++;
-        };
-
-        dU0dot_ = [this](const state_control_matrix& dU0In, state_control_matrix& dU0dt, const SCALAR t) {
-            if (cacheSensitivities_)
-                arraydU0_.push_back(dU0In);
-
-            dU0dt = arrayA_[dU0Index_] * dU0In +
-                    arrayB_[dU0Index_] *
-                        controlledSystem_->getController()->getDerivativeU0(
-                            statesCached_[dU0Index_], timesCached_[dU0Index_]);
-            dU0Index_++;
-        };
-
-        dUfdot_ = [this](const state_control_matrix& dUfIn, state_control_matrix& dUfdt, const SCALAR t) {
+        dXdWdot_ = [this](const sensitivity_matrix& dXdWIn, sensitivity_matrix& dXdWdt, const SCALAR t) {
             if (cacheSensitivities_)
-                arraydUf_.push_back(dUfIn);
-
-            dUfdt = arrayA_[dU0Index_] * dUfIn +
-                    arrayB_[dU0Index_] *
-                        controlledSystem_->getController()->getDerivativeUf(
-                            statesCached_[dU0Index_], timesCached_[dU0Index_]);
-            dU0Index_++;
+                arraydXdW_.push_back(dXdWIn);
+
+            dXdWdt.noalias() = arrayA_[sensIndex_] * dXdWIn;
+            dXdWdt.template block<STATE_DIM, CONTROL_DIM>(0, STATE_DIM).noalias() +=
+                arrayB_[sensIndex_] * controlledSystem_->getController()->getDerivativeU0(
+                                          statesCached_[sensIndex_], timesCached_[sensIndex_]);
+            dXdWdt.template block<STATE_DIM, CONTROL_DIM>(0, STATE_DIM + CONTROL_DIM).noalias() +=
+                arrayB_[sensIndex_] * controlledSystem_->getController()->getDerivativeUf(
+                                          statesCached_[sensIndex_], timesCached_[sensIndex_]);
+            dXdWdt.col(SENSITIVITY_DIM - 1) += derivativesCached_[sensIndex_] / duration_;
+            sensIndex_++;
         };
     }
 
@@ -153,14 +147,15 @@ public:
             control_vector controlAction;
             controlledSystem_->getController()->computeControl(x, t, controlAction);
 
+            controlledSystem_->computeControlledDynamics(x, t, controlAction, dxdt);
+
             if (cacheData_)
             {
                 statesCached_.push_back(x);
                 controlsCached_.push_back(controlAction);
                 timesCached_.push_back(t);
+                derivativesCached_.push_back(dxdt);
             }
-
-            controlledSystem_->computeControlledDynamics(x, t, controlAction, dxdt);
         };
     }
 
@@ -182,30 +177,24 @@ public:
             costIndex_++;
         };
 
-        costdX0dot_ = [this](const state_vector& costdX0In, state_vector& costdX0dt, const SCALAR t) {
+        costdWdot_ = [this](
+            const cost_sensitivity_vector& costdWIn, cost_sensitivity_vector& costdWdt, const SCALAR t) {
             costFunction_->setCurrentStateAndControl(
                 statesCached_[costIndex_], controlsCached_[costIndex_], timesCached_[costIndex_]);
-            costdX0dt = arraydX0_[costIndex_].transpose() * costFunction_->stateDerivativeIntermediate();
-            costIndex_++;
-        };
-
-        costdU0dot_ = [this](const control_vector& costdU0In, control_vector& costdU0dt, const SCALAR t) {
-            costFunction_->setCurrentStateAndControl(
-                statesCached_[costIndex_], controlsCached_[costIndex_], timesCached_[costIndex_]);
-            costdU0dt = arraydU0_[costIndex_].transpose() * costFunction_->stateDerivativeIntermediate() +
-                        controlledSystem_->getController()->getDerivativeU0(
-                            statesCached_[costIndex_], timesCached_[costIndex_]) *
-                            costFunction_->controlDerivativeIntermediate();
-            costIndex_++;
-        };
-
-        costdUfdot_ = [this](const control_vector& costdUfIn, control_vector& costdUfdt, const SCALAR t) {
-            costFunction_->setCurrentStateAndControl(
-                statesCached_[costIndex_], controlsCached_[costIndex_], timesCached_[costIndex_]);
-            costdUfdt = arraydUf_[costIndex_].transpose() * costFunction_->stateDerivativeIntermediate() +
-                        controlledSystem_->getController()->getDerivativeUf(
-                            statesCached_[costIndex_], timesCached_[costIndex_]) *
-                            costFunction_->controlDerivativeIntermediate();
+            const control_vector dLdu = costFunction_->controlDerivativeIntermediate();
+
+            costdWdt.noalias() = arraydXdW_[costIndex_].transpose() * costFunction_->stateDerivativeIntermediate();
+            costdWdt.template segment<CONTROL_DIM>(STATE_DIM).noalias() +=
+                controlledSystem_->getController()
+                    ->getDerivativeU0(statesCached_[costIndex_], timesCached_[costIndex_])
+                    .transpose() *
+                dLdu;
+            costdWdt.template segment<CONTROL_DIM>(STATE_DIM + CONTROL_DIM).noalias() +=
+                controlledSystem_->getController()
+                    ->getDerivativeUf(statesCached_[costIndex_], timesCached_[costIndex_])
+                    .transpose() *
+                dLdu;
+            costdWdt(SENSITIVITY_DIM - 1) += costFunction_->evaluateIntermediate() / duration_;
             costIndex_++;
         };
     }
@@ -271,70 +260,30 @@ public:
 
 
     /**
-     * @brief          Integrates the sensitivity ODE of the integrator with
-     *                 respec to the initial state x0
+     * @brief          Integrates the augmented sensitivity ODE of the
+     *                 integrator with respect to the initial state x0, the
+     *                 initial and final control inputs u0 and uf and the
+     *                 interval duration numSteps * dt
      *
-     * @param[in, out] dX0        The sensitivity matrix wrt x0
+     * @param[out]     dXdW       The sensitivity matrix [dX0, dU0, dUf, dH]
      * @param[in]      startTime  The start time
      * @param[in]      numSteps   The number of integration steps
      * @param[in]      dt         The integration timestep
      */
-    void integrateSensitivityDX0(state_matrix& dX0, const SCALAR startTime, const size_t numSteps, const SCALAR dt)
-    {
-        dX0Index_ = 0;
-        SCALAR time = startTime;
-        dX0.setIdentity();
-        for (size_t i = 0; i < numSteps; ++i)
-        {
-            stepperDX0_->do_step(dX0dot_, dX0, time, dt);
-            time += dt;
-        }
-    }
-
-    /**
-     * @brief          Integrates the sensitivity ODE of the integrator with
-     *                 respec to the initial control input u0
-     *
-     * @param[in, out] dU0        The sensitivity matrix wrt u0
-     * @param[in]      startTime  The start time
-     * @param[in]      numSteps   The number of integration steps
-     * @param[in]      dt         The integration timestep
-     */
-    void integrateSensitivityDU0(state_control_matrix& dU0,
+    void integrateSensitivities(sensitivity_matrix& dXdW,
         const SCALAR startTime,
         const size_t numSteps,
         const SCALAR dt)
     {
-        dU0Index_ = 0;
+        sensIndex_ = 0;
+        duration_ = SCALAR(numSteps) * dt;
+        arraydXdW_.clear();
         SCALAR time = startTime;
-        dU0.setZero();
+        dXdW.setZero();
+        dXdW.template leftCols<STATE_DIM>().setIdentity();
         for (size_t i = 0; i < numSteps; ++i)
         {
-            stepperDU0_->do_step(dU0dot_, dU0, time, dt);
-            time += dt;
-        }
-    }
-
-    /**
-     * @brief          Integrates the sensitivity ODE of the integrator with
-     *                 respec to the final control input uf
-     *
-     * @param[in, out] dUF        The sensitivity matrix wrt uF
-     * @param[in]      startTime  The start time
-     * @param[in]      numSteps   The number of integration steps
-     * @param[in]      dt         The integration timestep
-     */
-    void integrateSensitivityDUf(state_control_matrix& dUf,
-        const SCALAR startTime,
-        const size_t numSteps,
-        const SCALAR dt)
-    {
-        dU0Index_ = 0;
-        SCALAR time = startTime;
-        dUf.setZero();
-        for (size_t i = 0; i < numSteps; ++i)
-        {
-            stepperDU0_->do_step(dUfdot_, dUf, time, dt);
+            stepperSensitivity_->do_step(dXdWdot_, dXdW, time, dt);
             time += dt;
         }
     }
@@ -365,69 +314,27 @@ public:
 
     /**
      * @brief          Integrates the sensitivity of the cost with respect to
-     *                 the initial state x0
-     *
-     * @param[in, out] dX0        The initial cost sensitivity vector
-     * @param[in]      startTime  The start time
-     * @param[in]      numSteps   The number of integration steps
-     * @param[in]      dt         The integration time step
-     */
-    void integrateCostSensitivityDX0(state_vector& dX0, const SCALAR startTime, const size_t numSteps, const SCALAR dt)
-    {
-        costIndex_ = 0;
-        SCALAR time = startTime;
-        dX0.setZero();
-        for (size_t i = 0; i < numSteps; ++i)
-        {
-            stepperCostDX0_->do_step(costdX0dot_, dX0, time, dt);
-            time += dt;
-        }
-    }
-
-    /**
-     * @brief          Integrates the sensitivity of the cost with respect to
-     *                 the initial control input u0
+     *                 the initial state x0, the initial and final control
+     *                 inputs u0 and uf and the interval duration. Requires the
+     *                 sensitivities of the same interval to be integrated
      *
-     * @param[in, out] dU0        The initial cost sensitivity vector
+     * @param[out]     dLdW       The cost sensitivity vector [dX0, dU0, dUf, dH]
      * @param[in]      startTime  The start time
      * @param[in]      numSteps   The number of integration steps
      * @param[in]      dt         The integration time step
      */
-    void integrateCostSensitivityDU0(control_vector& dU0,
+    void integrateCostSensitivities(cost_sensitivity_vector& dLdW,
         const SCALAR startTime,
         const size_t numSteps,
         const SCALAR dt)
     {
         costIndex_ = 0;
+        duration_ = SCALAR(numSteps) * dt;
         SCALAR time = startTime;
-        dU0.setZero();
-        for (size_t i = 0; i < numSteps; ++i)
-        {
-            stepperCostDU0_->do_step(costdU0dot_, dU0, time, dt);
-            time += dt;
-        }
-    }
-
-    /**
-     * @brief          Integrates the sensitivity of the cost with respect to
-     *                 the final control input uF
-     *
-     * @param[in, out] dUf        The initial cost sensitivity vector
-     * @param[in]      startTime  The start time
-     * @param[in]      numSteps   The number of integration steps
-     * @param[in]      dt         The integration time step
-     */
-    void integrateCostSensitivityDUf(control_vector& dUf,
-        const SCALAR& startTime,
-        const size_t numSteps,
-        const SCALAR dt)
-    {
-        costIndex_ = 0;
-        SCALAR time = startTime;
-        dUf.setZero();
+        dLdW.setZero();
         for (size_t i = 0; i < numSteps; ++i)
         {
-            stepperCostDU0_->do_step(costdUfdot_, dUf, time, dt);
+            stepperCostSensitivity_->do_step(costdWdot_, dLdW, time, dt);
             time += dt;
         }
     }
@@ -454,6 +361,7 @@ public:
         statesCached_.clear();
         controlsCached_.clear();
         timesCached_.clear();
+        derivativesCached_.clear();
     }
 
 
@@ -462,9 +370,7 @@ public:
      */
     void clearSensitivities()
     {
-        arraydX0_.clear();
-        arraydU0_.clear();
-        arraydUf_.clear();
+        arraydXdW_.clear();
     }
 
 
@@ -484,14 +390,10 @@ private:
 
     // Integrate the function
     std::function<void(const SCALAR, SCALAR&, const SCALAR)> costDot_;
-    std::function<void(const state_vector&, state_vector&, const SCALAR)> costdX0dot_;
-    std::function<void(const control_vector&, control_vector&, const SCALAR)> costdU0dot_;
-    std::function<void(const control_vector&, control_vector&, const SCALAR)> costdUfdot_;
+    std::function<void(const cost_sensitivity_vector&, cost_sensitivity_vector&, const SCALAR)> costdWdot_;
 
     // Sensitivities
-    std::function<void(const state_matrix&, state_matrix&, const SCALAR)> dX0dot_;
-    std::function<void(const state_control_matrix&, state_control_matrix&, const SCALAR)> dU0dot_;
-    std::function<void(const state_control_matrix&, state_control_matrix&, const SCALAR)> dUfdot_;
+    std::function<void(const sensitivity_matrix&, sensitivity_matrix&, const SCALAR)> dXdWdot_;
 
     // Cache
     bool cacheData_;
@@ -499,25 +401,22 @@ private:
     ct::core::StateVectorArray<STATE_DIM, SCALAR> statesCached_;
     ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> controlsCached_;
     ct::core::tpl::TimeArray<SCALAR> timesCached_;
+    ct::core::StateVectorArray<STATE_DIM, SCALAR> derivativesCached_;
 
     ct::core::StateMatrixArray<STATE_DIM, SCALAR> arrayA_;
     ct::core::StateControlMatrixArray<STATE_DIM, CONTROL_DIM, SCALAR> arrayB_;
 
-    ct::core::StateMatrixArray<STATE_DIM, SCALAR> arraydX0_;
-    ct::core::StateControlMatrixArray<STATE_DIM, CONTROL_DIM, SCALAR> arraydU0_;
-    ct::core::StateControlMatrixArray<STATE_DIM, CONTROL_DIM, SCALAR> arraydUf_;
+    sensitivity_matrix_array arraydXdW_;
 
     std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>> stepperState_;
-    std::shared_ptr<ct::core::internal::StepperCTBase<state_matrix, SCALAR>> stepperDX0_;
-    std::shared_ptr<ct::core::internal::StepperCTBase<state_control_matrix, SCALAR>> stepperDU0_;
+    std::shared_ptr<ct::core::internal::StepperCTBase<sensitivity_matrix, SCALAR>> stepperSensitivity_;
 
     std::shared_ptr<ct::core::internal::StepperCTBase<SCALAR, SCALAR>> stepperCost_;
-    std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>> stepperCostDX0_;
-    std::shared_ptr<ct::core::internal::StepperCTBase<control_vector, SCALAR>> stepperCostDU0_;
+    std::shared_ptr<ct::core::internal::StepperCTBase<cost_sensitivity_vector, SCALAR>> stepperCostSensitivity_;
 
     size_t costIndex_;
-    size_t dX0Index_;
-    size_t dU0Index_;
+    size_t sensIndex_;
+    SCALAR duration_;  // the duration of the integrated interval
 
     std::function<void(const state_vector&, state_vector&, const SCALAR)> xDot_;
 };
@@ -48,6 +48,10 @@ public:
     typedef typename DIMENSIONS::state_matrix_array_t state_matrix_array_t;
     typedef typename DIMENSIONS::state_control_matrix_array_t state_control_matrix_array_t;
 
+    typedef SensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR> SensitivityIntegrator_t;
+    typedef typename SensitivityIntegrator_t::sensitivity_matrix sensitivity_matrix_t;
+    typedef typename SensitivityIntegrator_t::cost_sensitivity_vector cost_sensitivity_vector_t;
+
     ShotContainer() = delete;
 
     /**
@@ -83,10 +87,12 @@ public:
           costIntegrationCount_(0),
           sensIntegrationCount_(0),
           costSensIntegrationCount_(0),
+          dXdHi_(state_vector_t::Zero()),
           cost_(SCALAR(0.0)),
           discreteQ_(state_vector_t::Zero()),
           discreteR_(control_vector_t::Zero()),
-          discreteRNext_(control_vector_t::Zero())
+          discreteRNext_(control_vector_t::Zero()),
+          costGradientHi_(SCALAR(0.0))
     {
         if (shotNr_ >= settings.N_)
             throw std::runtime_error("Dms Shot Integrator: shot index >= settings.N_ - check your settings.");
@@ -126,6 +132,7 @@ public:
 
         // +0.5 needed to avoid rounding errors from double to size_t
         nSteps_ = nIntegrationSteps;
+        dt_ = SCALAR(settings_.dt_sim_);
         // std::cout << "shotNr_: " << shotNr_ << "\t nSteps: " << nSteps_ << std::endl;
 
         integratorCT_->setLinearSystem(linearSystem_);
@@ -142,9 +149,16 @@ public:
         if ((w_->getUpdateCount() != integrationCount_))
         {
             integrationCount_ = w_->getUpdateCount();
+
+            // with an optimized grid, the shot keeps its number of steps and their length scales with the shot
+            if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+            {
+                tStart_ = timeGrid_->getShotStartTime(shotNr_);
+                dt_ = timeGrid_->getShotDuration(shotNr_) / SCALAR(nSteps_);
+            }
+
             state_vector_t initState = w_->getOptimizedState(shotNr_);
-            integratorCT_->integrate(
-                initState, tStart_, nSteps_, SCALAR(settings_.dt_sim_), stateSubsteps_, timeSubsteps_);
+            integratorCT_->integrate(initState, tStart_, nSteps_, dt_, stateSubsteps_, timeSubsteps_);
         }
     }
 
@@ -155,7 +169,7 @@ public:
             costIntegrationCount_ = w_->getUpdateCount();
             integrateShot();
             cost_ = SCALAR(0.0);
-            integratorCT_->integrateCost(cost_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
+            integratorCT_->integrateCost(cost_, tStart_, nSteps_, dt_);
         }
     }
 
@@ -168,17 +182,13 @@ public:
         {
             sensIntegrationCount_ = w_->getUpdateCount();
             integrateShot();
-            discreteA_.setIdentity();
-            discreteB_.setZero();
             integratorCT_->linearize();
-            integratorCT_->integrateSensitivityDX0(discreteA_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
-            integratorCT_->integrateSensitivityDU0(discreteB_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
+            integratorCT_->integrateSensitivities(dXdW_, tStart_, nSteps_, dt_);
 
-            if (settings_.splineType_ == DmsSettings::PIECEWISE_LINEAR)
-            {
-                discreteBNext_.setZero();
-                integratorCT_->integrateSensitivityDUf(discreteBNext_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
-            }
+            discreteA_ = dXdW_.template leftCols<STATE_DIM>();
+            discreteB_ = dXdW_.template block<STATE_DIM, CONTROL_DIM>(0, STATE_DIM);
+            discreteBNext_ = dXdW_.template block<STATE_DIM, CONTROL_DIM>(0, STATE_DIM + CONTROL_DIM);
+            dXdHi_ = dXdW_.col(SensitivityIntegrator_t::SENSITIVITY_DIM - 1);
         }
     }
 
@@ -188,16 +198,12 @@ public:
         {
             costSensIntegrationCount_ = w_->getUpdateCount();
             integrateSensitivities();
-            discreteQ_.setZero();
-            discreteR_.setZero();
-            integratorCT_->integrateCostSensitivityDX0(discreteQ_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
-            integratorCT_->integrateCostSensitivityDU0(discreteR_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
+            integratorCT_->integrateCostSensitivities(dLdW_, tStart_, nSteps_, dt_);
 
-            if (settings_.splineType_ == DmsSettings::PIECEWISE_LINEAR)
-            {
-                discreteRNext_.setZero();
-                integratorCT_->integrateCostSensitivityDUf(discreteRNext_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
-            }
+            discreteQ_ = dLdW_.template head<STATE_DIM>();
+            discreteR_ = dLdW_.template segment<CONTROL_DIM>(STATE_DIM);
+            discreteRNext_ = dLdW_.template segment<CONTROL_DIM>(STATE_DIM + CONTROL_DIM);
+            costGradientHi_ = dLdW_(SensitivityIntegrator_t::SENSITIVITY_DIM - 1);
         }
     }
 
@@ -247,10 +253,7 @@ public:
 	 *
 	 * @return     The integrated sensitivity
 	 */
-    // const state_vector_t getdXdHiIntegrated()
-    // {
-    // 	return dXdHi_history_.back();
-    // }
+    const state_vector_t& getdXdHiIntegrated() const { return dXdHi_; }
 
     /**
 	 * @brief      Gets the full integrated state trajectory.
@@ -312,11 +315,7 @@ public:
 	 *
 	 * @return     The cost gradient
 	 */
-    // const double getdLdHiIntegrated() const
-    // {
-    // 	return costGradientHi_;
-    // }
-
+    const SCALAR getdLdHiIntegrated() const { return costGradientHi_; }
 
 private:
     std::shared_ptr<ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>> controlledSystem_;
@@ -343,16 +342,21 @@ private:
     state_matrix_t discreteA_;
     state_control_matrix_t discreteB_;
     state_control_matrix_t discreteBNext_;
+    state_vector_t dXdHi_;
+    sensitivity_matrix_t dXdW_;
 
     //Cost and cost gradient
     SCALAR cost_;
     state_vector_t discreteQ_;
     control_vector_t discreteR_;
     control_vector_t discreteRNext_;
+    SCALAR costGradientHi_;
+    cost_sensitivity_vector_t dLdW_;
 
     std::shared_ptr<SensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>> integratorCT_;
     size_t nSteps_;
     SCALAR tStart_;
+    SCALAR dt_;
 };
 
 }  // namespace optcon
@@ -124,13 +124,9 @@ public:
                         " cost gradient not yet implemented for this type of interpolation. Exiting"));
             }
 
-            // H-part.
-            // if(settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
-            // {
-            // 	costFct_->setCurrentStateAndControl(shotContainers_[shotNr]->getStateIntegrated(),
-            // 										controlSpliner_->evalSpline(shotContainers_[shotNr]->getIntegrationTimeFinal(), shotNr));
-            // 	grad(w_->getTimeSegmentIndex(shotNr)) = costFct_->evaluateIntermediate() + shotContainers_[shotNr]->getdLdHiIntegrated();
-            // }
+            // H-part, integrated together with the other sensitivities
+            if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+                grad(w_->getTimeSegmentIndex(shotNr)) = shotContainers_[shotNr]->getdLdHiIntegrated();
         }
 
         /* gradient of terminal cost */
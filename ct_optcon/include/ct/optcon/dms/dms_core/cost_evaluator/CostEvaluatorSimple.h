@@ -57,7 +57,6 @@ public:
         : costFct_(costFct), w_(w), timeGrid_(timeGrid), settings_(settings)
     {
         phi_.resize(settings_.N_ + 1);
-        // phi_diff_h_ = Eigen::VectorXd::Ones(settings_.N_+1, 1);
         updatePhi();
     }
 
@@ -77,14 +76,15 @@ private:
     std::shared_ptr<tpl::TimeGrid<SCALAR>> timeGrid_;
     const DmsSettings settings_;
     Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> phi_; /* the summation weights */
-    // Eigen::VectorXd phi_diff_h_; /* the summation weights for derivative w.r.t h */
 };
 
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 SCALAR CostEvaluatorSimple<STATE_DIM, CONTROL_DIM, SCALAR>::eval()
 {
-    // updatePhi();
+    if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+        updatePhi();
+
     SCALAR cost = SCALAR(0.0);
 
     for (size_t i = 0; i < settings_.N_ + 1; ++i)
@@ -105,7 +105,12 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void CostEvaluatorSimple<STATE_DIM, CONTROL_DIM, SCALAR>::evalGradient(size_t grad_length,
     Eigen::Map<Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>>& grad)
 {
-    // updatePhi();
+    const bool optimizeGrid = (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID);
+    if (optimizeGrid)
+        updatePhi();
+
+    Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> intermediateCost(settings_.N_ + 1);
+
     grad.setZero();
     for (size_t i = 0; i < settings_.N_ + 1; ++i)
     {
@@ -113,6 +118,21 @@ void CostEvaluatorSimple<STATE_DIM, CONTROL_DIM, SCALAR>::evalGradient(size_t gr
             w_->getOptimizedState(i), w_->getOptimizedControl(i), timeGrid_->getShotStartTime(i));
         grad.segment(w_->getStateIndex(i), STATE_DIM) += phi_(i) * costFct_->stateDerivativeIntermediate();
         grad.segment(w_->getControlIndex(i), CONTROL_DIM) += phi_(i) * costFct_->controlDerivativeIntermediate();
+
+        if (optimizeGrid)
+            intermediateCost(i) = costFct_->evaluateIntermediate();
+    }
+
+    /* gradient w.r.t. the shot durations, which only enter through the summation weights */
+    if (optimizeGrid)
+    {
+        for (size_t i = 0; i < settings_.N_; ++i)
+        {
+            if (settings_.splineType_ == DmsSettings::ZERO_ORDER_HOLD)
+                grad(w_->getTimeSegmentIndex(i)) = intermediateCost(i);
+            else
+                grad(w_->getTimeSegmentIndex(i)) = SCALAR(0.5) * (intermediateCost(i) + intermediateCost(i + 1));
+        }
     }
 
     /* gradient of terminal cost */
@@ -141,7 +161,7 @@ void CostEvaluatorSimple<STATE_DIM, CONTROL_DIM, SCALAR>::updatePhi()
             for (size_t i = 1; i < settings_.N_; i++)
                 phi_(i) = SCALAR(0.5) * (timeGrid_->getShotEndTime(i) - timeGrid_->getShotStartTime(i - 1));
 
-            phi_(settings_.N_) = SCALAR(0.5) * (timeGrid_->getShotDuration(settings_.N_));
+            phi_(settings_.N_) = SCALAR(0.5) * (timeGrid_->getShotDuration(settings_.N_ - 1));
             break;
         }
         default:
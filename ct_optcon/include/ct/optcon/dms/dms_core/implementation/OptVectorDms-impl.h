@@ -20,6 +20,15 @@ OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::OptVectorDms(size_t n, const DmsSe
         pairNumToControlIdx_.insert(std::make_pair(i, currIndex));
         currIndex += CONTROL_DIM;
     }
+
+    // the shot durations follow the pairs, starting from a uniform grid
+    if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+    {
+        const SCALAR h0 = SCALAR(settings_.T_ / settings_.N_);
+        this->x_.tail(settings_.N_).setConstant(h0);
+        this->xInit_.tail(settings_.N_).setConstant(h0);
+        this->xLb_.tail(settings_.N_).setConstant(SCALAR(settings_.h_min_));
+    }
     stateSolution_.resize(numPairs_);
     inputSolution_.resize(numPairs_);
 }
@@ -40,6 +49,13 @@ OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::getOptimizedControl(const size_t p
     return (this->x_.segment(index, CONTROL_DIM));
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+typename OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs
+OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::getOptimizedTimeSegments() const
+{
+    return this->x_.segment(getTimeSegmentIndex(0), settings_.N_);
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 const typename DmsDimensions<STATE_DIM, CONTROL_DIM, SCALAR>::state_vector_array_t&
 OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::getOptimizedStates()
@@ -75,11 +91,20 @@ size_t OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::getControlIndex(const size_
     return pairNumToControlIdx_.find(pairNum)->second;
 }
 
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+size_t OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::getTimeSegmentIndex(const size_t shotNr) const
+{
+    assert(settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID);
+    return numPairs_ * (STATE_DIM + CONTROL_DIM) + shotNr;
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::changeInitialState(const state_vector_t& x0)
 {
     size_t s_index = getStateIndex(0);
     this->x_.segment(s_index, STATE_DIM) = x0;
+    this->xInit_.segment(s_index, STATE_DIM) = x0;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
@@ -138,6 +163,54 @@ void OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::setInitGuess(const state_vect
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::shiftSolution(size_t numShots, const size_t numPathConstraints)
+{
+    numShots = std::min(numShots, settings_.N_);
+    if (numShots == 0)
+        return;
+
+    // the optimization variables and their multipliers (IPOPT and SNOPT) are ordered pair by pair, followed by the
+    // shot durations if the time grid is optimized
+    const size_t pairSize = STATE_DIM + CONTROL_DIM;
+    for (VectorXs* v : {&this->x_, &this->zLow_, &this->zUpper_, &this->xMul_})
+    {
+        shiftBlocks(*v, 0, pairSize, numPairs_, numShots);
+        if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+            shiftBlocks(*v, getTimeSegmentIndex(0), 1, settings_.N_, numShots);
+    }
+    this->xInit_ = this->x_;
+
+    // the constraints are ordered as initial state, continuity of every shot, path constraints of every pair and
+    // terminal constraints. The new initial state constraint takes over the multiplier of the continuity constraint
+    // ending in the new first pair. The SNOPT multipliers start with the objective row.
+    const size_t N = settings_.N_;
+    auto shiftConstraintMultipliers = [&](VectorXs& mult, const size_t offset) {
+        if (static_cast<size_t>(mult.size()) < offset + STATE_DIM + N * STATE_DIM + (N + 1) * numPathConstraints)
+            return;
+
+        mult.segment(offset, STATE_DIM) = mult.segment(offset + numShots * STATE_DIM, STATE_DIM);
+        shiftBlocks(mult, offset + STATE_DIM, STATE_DIM, N, numShots);
+        shiftBlocks(mult, offset + (N + 1) * STATE_DIM, numPathConstraints, N + 1, numShots);
+    };
+    shiftConstraintMultipliers(this->lambda_, 0);
+    shiftConstraintMultipliers(this->zMul_, 1);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::shiftBlocks(VectorXs& v,
+    const size_t start,
+    const size_t blockSize,
+    const size_t numBlocks,
+    const size_t numShots)
+{
+    for (size_t i = 0; i < numBlocks; i++)
+        v.segment(start + i * blockSize, blockSize) =
+            v.segment(start + std::min(i + numShots, numBlocks - 1) * blockSize, blockSize);
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::printoutSolution()
 {
@@ -7,6 +7,8 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <boost/property_tree/info_parser.hpp>
 
+#include <ct/optcon/solver/NLOptConSettings.hpp>
+
 namespace ct {
 namespace optcon {
 
@@ -226,5 +228,73 @@ struct UnscentedKalmanFilterSettings
     }
 };
 
+//! Settings for setting up a MovingHorizonEstimator
+/*!
+ * \ingroup
+ *
+ * The MovingHorizonEstimator settings are designed to make the initialization smoother and possible through a file
+ * configuration.
+ *
+ */
+template <size_t STATE_DIM, typename SCALAR = double>
+struct MovingHorizonEstimatorSettings
+{
+    ct::core::StateVector<STATE_DIM> x0;            /*!< Initial state estimate. */
+    ct::core::StateMatrix<STATE_DIM, SCALAR> P0;    /*!< Initial covariance matrix (arrival cost). */
+    size_t horizonLength;                           /*!< Number of transitions in the estimation window. */
+    int maxIterations;                              /*!< Max number of Gauss-Newton iterations per update. */
+    SCALAR stepTolerance;                           /*!< Stop iterating once the max. state step is below this. */
+    NLOptConSettings::LQOCP_SOLVER lqocp_solver;    /*!< Solver for the LQ sub-problems. */
+
+    //! default constructor
+    MovingHorizonEstimatorSettings()
+        : x0(ct::core::StateVector<STATE_DIM>::Zero()),
+          P0(ct::core::StateMatrix<STATE_DIM, SCALAR>::Identity()),
+          horizonLength(10),
+          maxIterations(5),
+          stepTolerance(1e-6),
+          lqocp_solver(NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER)
+    {
+    }
+    //! print the current settings
+    void print() const
+    {
+        std::cout << "Moving Horizon Estimator Settings: " << std::endl;
+        std::cout << "=====================" << std::endl;
+        std::cout << "x0:\n" << x0 << std::endl;
+        std::cout << "P0:\n" << P0 << std::endl;
+        std::cout << "horizonLength:\t" << horizonLength << std::endl;
+        std::cout << "maxIterations:\t" << maxIterations << std::endl;
+        std::cout << "stepTolerance:\t" << stepTolerance << std::endl;
+        std::cout << "lqocp_solver:\t" << lqocp_solver << std::endl;
+        std::cout << "              =======" << std::endl;
+        std::cout << std::endl;
+    }
+
+    //! load settings from file
+    void load(const std::string& filename, bool verbose, const std::string& ns)
+    {
+        if (verbose)
+            std::cout << "Trying to load MHE settings from " << filename << ": " << std::endl;
+
+        boost::property_tree::ptree pt;
+        boost::property_tree::read_info(filename, pt);
+
+        ct::core::loadMatrix(filename, "x0", x0, ns);
+        ct::core::loadMatrix(filename, "P0", P0, ns);
+        horizonLength = pt.get<size_t>(ns + ".horizonLength", 10);
+        maxIterations = pt.get<int>(ns + ".maxIterations", 5);
+        stepTolerance = pt.get<SCALAR>(ns + ".stepTolerance", 1e-6);
+        lqocp_solver = static_cast<NLOptConSettings::LQOCP_SOLVER>(
+            pt.get<int>(ns + ".lqocp_solver", NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER));
+
+        if (verbose)
+        {
+            std::cout << "Loaded MHE settings from " << filename << ": " << std::endl;
+            print();
+        }
+    }
+};
+
 }  // namespace optcon
 }  // namespace ct
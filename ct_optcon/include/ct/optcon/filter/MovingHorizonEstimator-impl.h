@@ -0,0 +1,247 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+MovingHorizonEstimator<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::MovingHorizonEstimator(
+    std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
+    std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
+    const state_matrix_t& Q,
+    const output_matrix_t& R,
+    const MovingHorizonEstimatorSettings<STATE_DIM, SCALAR>& mhe_settings)
+    : Base(f, h, mhe_settings.x0),
+      Q_(Q),
+      R_(R),
+      P_(mhe_settings.P0),
+      xPrior_(mhe_settings.x0),
+      N_(mhe_settings.horizonLength),
+      maxIterations_(mhe_settings.maxIterations),
+      stepTolerance_(mhe_settings.stepTolerance),
+      lqocp_solver_(mhe_settings.lqocp_solver),
+      iterations_(0),
+      nbx_(0),
+      lqocProblem_(new LQOCProblem_t())
+{
+    if (N_ < 1)
+        throw std::runtime_error("MovingHorizonEstimator: the horizon length needs to be at least 1.");
+
+    if (lqocp_solver_ == NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER)
+    {
+        lqocSolver_ = std::shared_ptr<GNRiccatiSolver<STATE_DIM, STATE_DIM, SCALAR>>(
+            new GNRiccatiSolver<STATE_DIM, STATE_DIM, SCALAR>());
+    }
+    else if (lqocp_solver_ == NLOptConSettings::LQOCP_SOLVER::HPIPM_SOLVER)
+    {
+#ifdef HPIPM
+        lqocSolver_ = std::shared_ptr<HPIPMInterface<STATE_DIM, STATE_DIM>>(new HPIPMInterface<STATE_DIM, STATE_DIM>());
+#else
+        throw std::runtime_error("HPIPM selected but not built.");
+#endif
+    }
+    else
+        throw std::runtime_error("Solver for Linear Quadratic Optimal Control Problem wrongly specified.");
+
+    NLOptConSettings lqocSettings;
+    lqocSettings.lqocp_solver = lqocp_solver_;
+    lqocSettings.nThreadsEigen = 1;
+    lqocSolver_->configure(lqocSettings);
+
+    // the window initially consists of a single node without measurement
+    x_.push_back(mhe_settings.x0);
+    w_.push_back(state_vector_t::Zero());
+    y_.push_back(output_vector_t::Zero());
+    ty_.push_back(SCALAR(0.0));
+    hasMeasurement_.push_back(false);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto MovingHorizonEstimator<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::predict(const control_vector_t& u,
+    const ct::core::Time& dt,
+    const ct::core::Time& t) -> const state_vector_t&
+{
+    // append a new node, warm-started by forward propagation of the newest node
+    this->x_est_ = this->f_->computeDynamics(x_.back(), u, dt, t);
+
+    x_.push_back(this->x_est_);
+    w_.push_back(state_vector_t::Zero());
+    u_.push_back(u);
+    dt_.push_back(dt);
+    tu_.push_back(t);
+    y_.push_back(output_vector_t::Zero());
+    ty_.push_back(t + dt);
+    hasMeasurement_.push_back(false);
+
+    if (x_.size() > N_ + 1)
+        shiftWindow();
+
+    return this->x_est_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto MovingHorizonEstimator<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::update(const output_vector_t& y,
+    const ct::core::Time& dt,
+    const ct::core::Time& t) -> const state_vector_t&
+{
+    y_.back() = y;
+    ty_.back() = t;
+    hasMeasurement_.back() = true;
+
+    solveWindow();
+
+    this->x_est_ = x_.back();
+
+    return this->x_est_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void MovingHorizonEstimator<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setStateBoxConstraints(const int nConstr,
+    const constr_vec_t& x_lb,
+    const constr_vec_t& x_ub,
+    const Eigen::VectorXi& sp)
+{
+    if (lqocp_solver_ != NLOptConSettings::LQOCP_SOLVER::HPIPM_SOLVER)
+        throw std::runtime_error("MovingHorizonEstimator: state box constraints require the HPIPM solver.");
+
+    nbx_ = nConstr;
+    x_lb_ = x_lb;
+    x_ub_ = x_ub;
+    x_I_ = sp;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void MovingHorizonEstimator<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::shiftWindow()
+{
+    // STEP 1 - EKF measurement update of the arrival cost with the measurement of the dropped node
+    state_vector_t x_filtered = xPrior_;
+    state_matrix_t P_filtered = P_;
+
+    if (hasMeasurement_.front())
+    {
+        ct::core::OutputStateMatrix<OUTPUT_DIM, STATE_DIM, SCALAR> dHdx =
+            this->h_->computeDerivativeState(xPrior_, ty_.front());
+        output_matrix_t dHdw = this->h_->computeDerivativeNoise(xPrior_, ty_.front());
+
+        const Eigen::Matrix<SCALAR, STATE_DIM, OUTPUT_DIM> K =
+            P_ * dHdx.transpose() * (dHdx * P_ * dHdx.transpose() + dHdw * R_ * dHdw.transpose()).inverse();
+
+        x_filtered += K * (y_.front() - this->h_->computeMeasurement(xPrior_));
+        P_filtered -= (K * dHdx * P_).eval();
+    }
+
+    // STEP 2 - EKF prediction of the arrival cost to the second node
+    const state_matrix_t dFdx = this->f_->computeDerivativeState(x_filtered, u_.front(), dt_.front(), tu_.front());
+    const state_matrix_t dFdv = this->f_->computeDerivativeNoise(x_filtered, u_.front(), dt_.front(), tu_.front());
+
+    P_ = (dFdx * P_filtered * dFdx.transpose()) + dFdv * (dt_.front() * Q_) * dFdv.transpose();
+    P_ = (0.5 * (P_ + P_.transpose())).eval();
+    xPrior_ = this->f_->computeDynamics(x_filtered, u_.front(), dt_.front(), tu_.front());
+
+    // STEP 3 - drop the oldest node, the remaining nodes serve as warm-start
+    x_.eraseFront(1);
+    w_.eraseFront(1);
+    w_.front() = x_.front() - xPrior_;
+    u_.eraseFront(1);
+    dt_.erase(dt_.begin());
+    tu_.erase(tu_.begin());
+    y_.eraseFront(1);
+    ty_.erase(ty_.begin());
+    hasMeasurement_.erase(hasMeasurement_.begin());
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void MovingHorizonEstimator<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setupLQOCProblem()
+{
+    LQOCProblem_t& p = *lqocProblem_;
+    const int M = x_.size();
+
+    if (p.getNumberOfStages() != M)
+        p.changeNumStages(M);
+
+    p.setZero();
+
+    // the virtual first stage maps the arrival cost mean to the first node: x_0 = xPrior + w_{-1}
+    const state_matrix_t P_inverse = P_.inverse();
+    p.A_[0].setIdentity();
+    p.B_[0].setIdentity();
+    p.b_[0] = xPrior_ + w_[0] - x_[0];
+    p.R_[0] = P_inverse;
+    p.rv_[0] = P_inverse * w_[0];
+    p.q_[0] = 0.5 * w_[0].dot(P_inverse * w_[0]);
+
+    // process model, with the process noise as control input
+    for (int k = 0; k < M - 1; k++)
+    {
+        const state_matrix_t dFdv = this->f_->computeDerivativeNoise(x_[k], u_[k], dt_[k], tu_[k]);
+        const state_matrix_t Q_inverse = (dt_[k] * Q_).inverse();
+
+        p.A_[k + 1] = this->f_->computeDerivativeState(x_[k], u_[k], dt_[k], tu_[k]);
+        p.B_[k + 1] = dFdv;
+        p.b_[k + 1] = this->f_->computeDynamics(x_[k], u_[k], dt_[k], tu_[k]) + dFdv * w_[k + 1] - x_[k + 1];
+        p.R_[k + 1] = Q_inverse;
+        p.rv_[k + 1] = Q_inverse * w_[k + 1];
+        p.q_[k + 1] = 0.5 * w_[k + 1].dot(Q_inverse * w_[k + 1]);
+    }
+
+    // Gauss-Newton approximation of the measurement residuals
+    for (int k = 0; k < M; k++)
+    {
+        if (!hasMeasurement_[k])
+            continue;
+
+        const ct::core::OutputStateMatrix<OUTPUT_DIM, STATE_DIM, SCALAR> dHdx =
+            this->h_->computeDerivativeState(x_[k], ty_[k]);
+        const output_matrix_t dHdw = this->h_->computeDerivativeNoise(x_[k], ty_[k]);
+        const output_matrix_t W = (dHdw * R_ * dHdw.transpose()).inverse();
+        const output_vector_t r = y_[k] - this->h_->computeMeasurement(x_[k], ty_[k]);
+
+        p.Q_[k + 1].noalias() = dHdx.transpose() * W * dHdx;
+        p.qv_[k + 1].noalias() = -dHdx.transpose() * W * r;
+        p.q_[k + 1] += 0.5 * r.dot(W * r);
+    }
+
+    if (nbx_ > 0)
+    {
+        for (int k = 0; k < M - 1; k++)
+            p.setIntermediateStateBoxConstraint(k + 1, nbx_, x_lb_, x_ub_, x_I_, x_[k]);
+        p.setTerminalBoxConstraints(nbx_, x_lb_, x_ub_, x_I_, x_.back());
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void MovingHorizonEstimator<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::solveWindow()
+{
+    for (iterations_ = 1; iterations_ <= maxIterations_; iterations_++)
+    {
+        setupLQOCProblem();
+
+        lqocSolver_->setProblem(lqocProblem_);
+        lqocSolver_->solve();
+        lqocSolver_->computeStatesAndControls();
+
+        const ct::core::StateVectorArray<STATE_DIM, SCALAR>& dx = lqocSolver_->getSolutionState();
+        const ct::core::ControlVectorArray<STATE_DIM, SCALAR>& dw = lqocSolver_->getSolutionControl();
+
+        // full Gauss-Newton step, the state increment of the virtual first stage is zero by construction
+        SCALAR maxStep = 0.0;
+        for (size_t k = 0; k < x_.size(); k++)
+        {
+            x_[k] += dx[k + 1];
+            w_[k] += dw[k];
+            maxStep = std::max(maxStep, dx[k + 1].cwiseAbs().maxCoeff());
+        }
+
+        if (maxStep < stepTolerance_)
+            break;
+    }
+
+    iterations_ = std::min(iterations_, maxIterations_);
+}
+
+}  // namespace optcon
+}  // namespace ct
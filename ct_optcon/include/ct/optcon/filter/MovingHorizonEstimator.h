@@ -0,0 +1,168 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include "EstimatorBase.h"
+
+#include <ct/optcon/problem/LQOCProblem.hpp>
+#include <ct/optcon/solver/lqp/GNRiccatiSolver.hpp>
+#include <ct/optcon/solver/lqp/HPIPMInterface.hpp>
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, typename SCALAR>
+struct MovingHorizonEstimatorSettings;
+
+/*!
+ * \ingroup Filter
+ *
+ * \brief Moving Horizon Estimator (MHE) implementation.
+ *
+ * The estimator keeps a window of the last N+1 state nodes and solves the windowed least-squares problem
+ * \f[
+ * \min_{\mathbf x, \mathbf w}
+ * \frac{1}{2} \| \mathbf w_{-1} \|^2_{\mathbf P^{-1}}
+ * + \sum_{k=0}^{N-1} \frac{1}{2} \| \mathbf w_k \|^2_{(dt \mathbf Q)^{-1}}
+ * + \sum_{k=0}^{N} \frac{1}{2} \| \mathbf y_k - h(\mathbf x_k) \|^2_{\mathbf W_k}
+ * \f]
+ * subject to \f$ \mathbf x_0 = \bar \mathbf x_0 + \mathbf w_{-1} \f$ and
+ * \f$ \mathbf x_{k+1} = f(\mathbf x_k, \mathbf u_k) + \frac{\partial f}{\partial \mathbf v} \mathbf w_k \f$,
+ * with \f$ \mathbf W_k = (\frac{\partial h}{\partial \mathbf w} \mathbf R \frac{\partial h}{\partial \mathbf w}^\top)^{-1} \f$.
+ *
+ * The problem is solved by Gauss-Newton multiple shooting: at every iteration it is approximated by an LQOCProblem,
+ * in which the process noise takes the role of the control input, and handed to an LQOCSolver (GNRiccatiSolver,
+ * or HPIPMInterface if state box constraints are set). The arrival cost is the (virtual) first stage of the LQOCP.
+ *
+ * When the window is full, the oldest node is dropped and the arrival cost is updated in EKF fashion. For linear
+ * systems without constraints, the estimate is hence identical to the one of the ExtendedKalmanFilter.
+ * The remaining nodes are kept as warm-start for the next solve.
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR = double>
+class MovingHorizonEstimator final : public EstimatorBase<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    using Base = EstimatorBase<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>;
+    using typename Base::control_vector_t;
+    using typename Base::output_matrix_t;
+    using typename Base::output_vector_t;
+    using typename Base::state_matrix_t;
+    using typename Base::state_vector_t;
+
+    //! the process noise takes the role of the control input in the LQ sub-problems
+    using LQOCProblem_t = LQOCProblem<STATE_DIM, STATE_DIM, SCALAR>;
+    using LQOCSolver_t = LQOCSolver<STATE_DIM, STATE_DIM, SCALAR>;
+
+    using constr_vec_t = typename LQOCProblem_t::constr_vec_t;
+
+    //! Constructor.
+    MovingHorizonEstimator(std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
+        std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
+        const state_matrix_t& Q,
+        const output_matrix_t& R,
+        const MovingHorizonEstimatorSettings<STATE_DIM, SCALAR>& mhe_settings);
+
+    //! Estimator predict method. Appends a node to the estimation window.
+    const state_vector_t& predict(const control_vector_t& u,
+        const ct::core::Time& dt,
+        const ct::core::Time& t) override;
+
+    //! Estimator update method. Attaches the measurement to the newest node and solves the window.
+    const state_vector_t& update(const output_vector_t& y, const ct::core::Time& dt, const ct::core::Time& t) override;
+
+    /*!
+     * \brief set state box constraints, applied to all nodes in the window
+     * @param nConstr the number of constraints
+     * @param x_lb state lower bound in absolute coordinates
+     * @param x_ub state upper bound in absolute coordinates
+     * @param sp the sparsity vector, with strictly increasing indices, e.g. [0 1 4 7]
+     *
+     * \note requires the HPIPM solver to be selected in the settings.
+     */
+    void setStateBoxConstraints(const int nConstr,
+        const constr_vec_t& x_lb,
+        const constr_vec_t& x_ub,
+        const Eigen::VectorXi& sp);
+
+    //! remove all state box constraints
+    void clearStateBoxConstraints() { nbx_ = 0; }
+    //! the smoothed state trajectory over the current window
+    const ct::core::StateVectorArray<STATE_DIM, SCALAR>& getStateTrajectory() const { return x_; }
+    //! the process noise estimates over the current window
+    const ct::core::StateVectorArray<STATE_DIM, SCALAR>& getNoiseTrajectory() const { return w_; }
+    //! the prior (arrival cost mean) for the first node in the window
+    const state_vector_t& getArrivalState() const { return xPrior_; }
+    //! the arrival cost covariance for the first node in the window
+    const state_matrix_t& getArrivalCovariance() const { return P_; }
+    //! number of Gauss-Newton iterations performed in the last update
+    int getNumberOfIterations() const { return iterations_; }
+    //! update Q matrix
+    void setQ(const state_matrix_t& Q) { Q_ = Q; }
+    //! update R matrix
+    void setR(const output_matrix_t& R) { R_ = R; }
+protected:
+    //! drop the oldest node from the window and update the arrival cost
+    void shiftWindow();
+
+    //! run the Gauss-Newton iterations over the current window
+    void solveWindow();
+
+    //! build the LQ approximation of the windowed estimation problem around the current iterate
+    void setupLQOCProblem();
+
+    //! Filter Q matrix.
+    state_matrix_t Q_;
+
+    //! Filter R matrix.
+    output_matrix_t R_;
+
+    //! Arrival cost covariance.
+    state_matrix_t P_;
+
+    //! Arrival cost mean.
+    state_vector_t xPrior_;
+
+    //! window size (number of transitions)
+    size_t N_;
+
+    int maxIterations_;
+
+    SCALAR stepTolerance_;
+
+    NLOptConSettings::LQOCP_SOLVER lqocp_solver_;
+
+    int iterations_;
+
+    //! state iterate at every node in the window
+    ct::core::StateVectorArray<STATE_DIM, SCALAR> x_;
+
+    //! process noise iterate for every transition (first element belongs to the arrival cost)
+    ct::core::StateVectorArray<STATE_DIM, SCALAR> w_;
+
+    //! control inputs, sampling times and start times of every transition
+    ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> u_;
+    std::vector<SCALAR> dt_;
+    std::vector<SCALAR> tu_;
+
+    //! measurements and measurement times at every node
+    ct::core::OutputVectorArray<OUTPUT_DIM, SCALAR> y_;
+    std::vector<SCALAR> ty_;
+    std::vector<bool> hasMeasurement_;
+
+    //! state box constraints in absolute coordinates
+    int nbx_;
+    constr_vec_t x_lb_;
+    constr_vec_t x_ub_;
+    Eigen::VectorXi x_I_;
+
+    std::shared_ptr<LQOCProblem_t> lqocProblem_;
+    std::shared_ptr<LQOCSolver_t> lqocSolver_;
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -11,5 +11,6 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "DisturbedSystemController-impl.h"
 #include "LTIMeasurementModel-impl.h"
 #include "ExtendedKalmanFilter-impl.h"
+#include "MovingHorizonEstimator-impl.h"
 #include "SteadyStateKalmanFilter-impl.h"
 #include "UnscentedKalmanFilter-impl.h"
@@ -15,6 +15,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "LinearMeasurementModel.h"
 #include "LTIMeasurementModel.h"
 #include "MeasurementModelBase.h"
+#include "MovingHorizonEstimator.h"
 #include "SteadyStateKalmanFilter.h"
 #include "SystemModelBase.h"
 #include "UnscentedKalmanFilter.h"
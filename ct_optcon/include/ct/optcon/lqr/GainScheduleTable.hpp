@@ -0,0 +1,237 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \ingroup LQR
+ *
+ * \brief table of linear feedback laws at a set of operating points
+ *
+ * Every entry holds the scheduling coordinates s of the operating point, the operating point (x_op, u_op) and the
+ * feedback gain K of the control law
+ * \f[
+ * u = u_{op} + K \cdot (x - x_{op})
+ * \f]
+ * which is the convention of ct::core::ConstantStateFeedbackController, i.e. K is the negative LQR gain.
+ *
+ * The operating points either form a full grid over the scheduling coordinates, given by one sorted axis per
+ * coordinate and stored with the last coordinate running fastest, or are scattered. All entries are stored in one
+ * contiguous array, and the binary file written by save() consists of a fixed-size header, the grid axes and this
+ * array, such that a file can be loaded with a single read or memory-mapped.
+ *
+ * @tparam STATE_DIM system state dimension
+ * @tparam CONTROL_DIM system control input dimension
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
+class GainScheduleTable
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> schedule_vector_t;
+    typedef Eigen::Matrix<SCALAR, STATE_DIM, 1> state_vector_t;
+    typedef Eigen::Matrix<SCALAR, CONTROL_DIM, 1> control_vector_t;
+    typedef Eigen::Matrix<SCALAR, CONTROL_DIM, STATE_DIM> feedback_matrix_t;
+
+    //! empty table
+    GainScheduleTable() : scheduleDim_(0), nEntries_(0) {}
+    //! table of scattered operating points, given by their scheduling coordinates
+    GainScheduleTable(const std::vector<schedule_vector_t, Eigen::aligned_allocator<schedule_vector_t>>& points)
+        : scheduleDim_(points.empty() ? 0 : points.front().size()), nEntries_(points.size())
+    {
+        data_.assign(nEntries_ * stride(), SCALAR(0.0));
+
+        for (size_t i = 0; i < nEntries_; i++)
+        {
+            if ((size_t)points[i].size() != scheduleDim_)
+                throw std::runtime_error("GainScheduleTable: all points need to have the same dimension.");
+            schedule(i) = points[i];
+        }
+    }
+
+    //! table on the full grid spanned by the axes, each axis needs to be strictly increasing
+    GainScheduleTable(const std::vector<std::vector<SCALAR>>& axes) : scheduleDim_(axes.size()), axes_(axes)
+    {
+        nEntries_ = axes.empty() ? 0 : 1;
+        for (const std::vector<SCALAR>& axis : axes_)
+        {
+            if (axis.empty())
+                throw std::runtime_error("GainScheduleTable: grid axes must not be empty.");
+            for (size_t j = 1; j < axis.size(); j++)
+                if (!(axis[j] > axis[j - 1]))
+                    throw std::runtime_error("GainScheduleTable: grid axes need to be strictly increasing.");
+            nEntries_ *= axis.size();
+        }
+
+        data_.assign(nEntries_ * stride(), SCALAR(0.0));
+
+        std::vector<size_t> subscripts(scheduleDim_, 0);
+        for (size_t i = 0; i < nEntries_; i++)
+        {
+            for (size_t d = 0; d < scheduleDim_; d++)
+                schedule(i)(d) = axes_[d][subscripts[d]];
+
+            // increment the subscripts, the last coordinate running fastest
+            for (int d = (int)scheduleDim_ - 1; d >= 0; d--)
+            {
+                if (++subscripts[d] < axes_[d].size())
+                    break;
+                subscripts[d] = 0;
+            }
+        }
+    }
+
+    //! number of entries
+    size_t size() const { return nEntries_; }
+    //! dimension of the scheduling coordinates
+    size_t scheduleDim() const { return scheduleDim_; }
+    //! true if the entries form a grid
+    bool isGrid() const { return !axes_.empty(); }
+    //! the grid axes, empty for scattered points
+    const std::vector<std::vector<SCALAR>>& axes() const { return axes_; }
+    //! index of the grid entry with the given subscripts, one per axis
+    size_t gridIndex(const std::vector<size_t>& subscripts) const
+    {
+        size_t index = 0;
+        for (size_t d = 0; d < scheduleDim_; d++)
+            index = index * axes_[d].size() + subscripts[d];
+        return index;
+    }
+
+    //! scheduling coordinates of entry i
+    Eigen::Map<schedule_vector_t> schedule(size_t i) { return Eigen::Map<schedule_vector_t>(entry(i), scheduleDim_); }
+    Eigen::Map<const schedule_vector_t> schedule(size_t i) const
+    {
+        return Eigen::Map<const schedule_vector_t>(entry(i), scheduleDim_);
+    }
+    //! operating point state of entry i
+    Eigen::Map<state_vector_t> x(size_t i) { return Eigen::Map<state_vector_t>(entry(i) + scheduleDim_); }
+    Eigen::Map<const state_vector_t> x(size_t i) const
+    {
+        return Eigen::Map<const state_vector_t>(entry(i) + scheduleDim_);
+    }
+    //! operating point control of entry i
+    Eigen::Map<control_vector_t> u(size_t i)
+    {
+        return Eigen::Map<control_vector_t>(entry(i) + scheduleDim_ + STATE_DIM);
+    }
+    Eigen::Map<const control_vector_t> u(size_t i) const
+    {
+        return Eigen::Map<const control_vector_t>(entry(i) + scheduleDim_ + STATE_DIM);
+    }
+    //! feedback gain of entry i
+    Eigen::Map<feedback_matrix_t> K(size_t i)
+    {
+        return Eigen::Map<feedback_matrix_t>(entry(i) + scheduleDim_ + STATE_DIM + CONTROL_DIM);
+    }
+    Eigen::Map<const feedback_matrix_t> K(size_t i) const
+    {
+        return Eigen::Map<const feedback_matrix_t>(entry(i) + scheduleDim_ + STATE_DIM + CONTROL_DIM);
+    }
+
+    //! write the table to a binary file
+    void save(const std::string& filename) const
+    {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.good())
+            throw std::runtime_error("GainScheduleTable: cannot open " + filename + " for writing.");
+
+        Header header = makeHeader();
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+        for (const std::vector<SCALAR>& axis : axes_)
+        {
+            const uint64_t axisSize = axis.size();
+            file.write(reinterpret_cast<const char*>(&axisSize), sizeof(uint64_t));
+            file.write(reinterpret_cast<const char*>(axis.data()), axis.size() * sizeof(SCALAR));
+        }
+
+        file.write(reinterpret_cast<const char*>(data_.data()), data_.size() * sizeof(SCALAR));
+
+        if (!file.good())
+            throw std::runtime_error("GainScheduleTable: failed to write " + filename + ".");
+    }
+
+    //! read a table written by save(), the dimensions need to match the template arguments
+    void load(const std::string& filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.good())
+            throw std::runtime_error("GainScheduleTable: cannot open " + filename + " for reading.");
+
+        Header header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(Header));
+        const Header expected = makeHeader();
+        if (!file.good() || std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+            header.stateDim != STATE_DIM || header.controlDim != CONTROL_DIM || header.scalarSize != sizeof(SCALAR))
+            throw std::runtime_error("GainScheduleTable: " + filename + " does not hold a table of this type.");
+
+        scheduleDim_ = header.scheduleDim;
+        nEntries_ = header.nEntries;
+
+        axes_.resize(header.isGrid ? scheduleDim_ : 0);
+        for (std::vector<SCALAR>& axis : axes_)
+        {
+            uint64_t axisSize = 0;
+            file.read(reinterpret_cast<char*>(&axisSize), sizeof(uint64_t));
+            axis.resize(axisSize);
+            file.read(reinterpret_cast<char*>(axis.data()), axisSize * sizeof(SCALAR));
+        }
+
+        data_.resize(nEntries_ * stride());
+        file.read(reinterpret_cast<char*>(data_.data()), data_.size() * sizeof(SCALAR));
+
+        if (!file.good())
+            throw std::runtime_error("GainScheduleTable: " + filename + " is truncated.");
+    }
+
+private:
+    //! fixed-size file header
+    struct Header
+    {
+        char magic[8];
+        uint64_t stateDim;
+        uint64_t controlDim;
+        uint64_t scalarSize;
+        uint64_t scheduleDim;
+        uint64_t nEntries;
+        uint64_t isGrid;
+    };
+
+    Header makeHeader() const
+    {
+        Header header;
+        std::memcpy(header.magic, "CTGAINS1", sizeof(header.magic));
+        header.stateDim = STATE_DIM;
+        header.controlDim = CONTROL_DIM;
+        header.scalarSize = sizeof(SCALAR);
+        header.scheduleDim = scheduleDim_;
+        header.nEntries = nEntries_;
+        header.isGrid = isGrid();
+        return header;
+    }
+
+    //! number of scalars per entry
+    size_t stride() const { return scheduleDim_ + STATE_DIM + CONTROL_DIM + CONTROL_DIM * STATE_DIM; }
+    SCALAR* entry(size_t i) { return data_.data() + i * stride(); }
+    const SCALAR* entry(size_t i) const { return data_.data() + i * stride(); }
+
+    size_t scheduleDim_;
+    size_t nEntries_;
+    std::vector<std::vector<SCALAR>> axes_;
+    std::vector<SCALAR> data_;
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,242 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "GainScheduleTable.hpp"
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \ingroup LQR
+ *
+ * \brief state feedback controller interpolating the feedback laws of a GainScheduleTable
+ *
+ * The scheduling coordinates are computed from the state as s = S x with a selection matrix S, e.g. picking the
+ * components the operating points vary in. The control law is a weighted sum of the feedback laws of the table
+ * \f[
+ * u = \sum_i w_i(s) \left( u_{op,i} + K_i \cdot (x - x_{op,i}) \right)
+ * \f]
+ * with the weights given by the interpolation type:
+ * - NEAREST: the nearest entry only. O(d log n) on grids, linear in the number of entries otherwise
+ * - MULTILINEAR: the 2^d corners of the enclosing grid cell, O(d log n + 2^d), grids only. Outside the grid, the
+ *   coordinates are clamped to it.
+ * - RBF: normalized Gaussian radial basis functions exp(-|s - s_i|^2 / (2 sigma^2)) over all entries
+ *
+ * All memory is allocated on construction, hence computeControl() does not allocate. The table is shared between
+ * clones of the controller and must not be modified while the controller is in use.
+ *
+ * @tparam STATE_DIM system state dimension
+ * @tparam CONTROL_DIM system control input dimension
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM>
+class GainScheduledController : public ct::core::Controller<STATE_DIM, CONTROL_DIM, double>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    enum InterpolationType
+    {
+        NEAREST = 0,
+        MULTILINEAR,
+        RBF
+    };
+
+    typedef GainScheduleTable<STATE_DIM, CONTROL_DIM, double> GainScheduleTable_t;
+    typedef Eigen::Matrix<double, Eigen::Dynamic, STATE_DIM> selection_matrix_t;
+    typedef typename GainScheduleTable_t::schedule_vector_t schedule_vector_t;
+
+    /*!
+	 * @param table the table of feedback laws
+	 * @param S selection matrix, mapping the state to the scheduling coordinates
+	 * @param type interpolation type
+	 * @param sigma width of the radial basis functions, only used for RBF interpolation
+	 */
+    GainScheduledController(const std::shared_ptr<const GainScheduleTable_t>& table,
+        const selection_matrix_t& S,
+        InterpolationType type = MULTILINEAR,
+        double sigma = 1.0)
+        : table_(table), S_(S), type_(type), sigma2inv_(-1.0 / (2.0 * sigma * sigma))
+    {
+        if (!table_ || table_->size() == 0)
+            throw std::runtime_error("GainScheduledController: table must not be empty.");
+        if ((size_t)S_.rows() != table_->scheduleDim())
+            throw std::runtime_error("GainScheduledController: selection matrix does not match the table.");
+        if (type_ == MULTILINEAR && !table_->isGrid())
+            throw std::runtime_error("GainScheduledController: multilinear interpolation requires a grid.");
+        if (type_ == RBF && !(sigma > 0.0))
+            throw std::runtime_error("GainScheduledController: RBF width needs to be positive.");
+
+        const size_t d = table_->scheduleDim();
+        s_.resize(d);
+        lower_.resize(d);
+        fraction_.resize(d);
+        subscripts_.resize(d);
+        weights_.resize(type_ == MULTILINEAR ? (size_t(1) << d) : (type_ == RBF ? table_->size() : 1));
+    }
+
+    GainScheduledController(const GainScheduledController& other)
+        : ct::core::Controller<STATE_DIM, CONTROL_DIM, double>(other),
+          table_(other.table_),
+          S_(other.S_),
+          type_(other.type_),
+          sigma2inv_(other.sigma2inv_),
+          s_(other.s_),
+          lower_(other.lower_),
+          fraction_(other.fraction_),
+          subscripts_(other.subscripts_),
+          weights_(other.weights_)
+    {
+    }
+
+    GainScheduledController* clone() const override { return new GainScheduledController(*this); }
+    void computeControl(const ct::core::StateVector<STATE_DIM>& x,
+        const double& t,
+        ct::core::ControlVector<CONTROL_DIM>& u) override
+    {
+        s_.noalias() = S_ * x;
+        const size_t nWeights = computeWeights();
+
+        u.setZero();
+        for (size_t j = 0; j < nWeights; j++)
+        {
+            const size_t i = weights_[j].first;
+            u += weights_[j].second * (table_->u(i) + table_->K(i) * (x - table_->x(i)));
+        }
+    }
+
+    //! the underlying table
+    const GainScheduleTable_t& getTable() const { return *table_; }
+private:
+    //! compute the weights of the entries, returns the number of weights
+    size_t computeWeights()
+    {
+        switch (type_)
+        {
+            case NEAREST:
+            {
+                weights_[0] = std::make_pair(table_->isGrid() ? nearestGridEntry() : nearestEntry(), 1.0);
+                return 1;
+            }
+            case MULTILINEAR:
+            {
+                return cornerWeights();
+            }
+            case RBF:
+            {
+                return rbfWeights();
+            }
+            default:
+                throw std::runtime_error("GainScheduledController: unknown interpolation type.");
+        }
+    }
+
+    //! for every axis, find the lower index of the enclosing interval and the clamped fraction within it
+    void locateInGrid()
+    {
+        for (size_t d = 0; d < table_->scheduleDim(); d++)
+        {
+            const std::vector<double>& axis = table_->axes()[d];
+            if (axis.size() == 1)
+            {
+                lower_[d] = 0;
+                fraction_[d] = 0.0;
+                continue;
+            }
+
+            const size_t upper = std::upper_bound(axis.begin(), axis.end(), s_(d)) - axis.begin();
+            lower_[d] = std::min(std::max<size_t>(upper, 1), axis.size() - 1) - 1;
+            fraction_[d] = (s_(d) - axis[lower_[d]]) / (axis[lower_[d] + 1] - axis[lower_[d]]);
+            fraction_[d] = std::max(0.0, std::min(fraction_[d], 1.0));
+        }
+    }
+
+    size_t nearestGridEntry()
+    {
+        locateInGrid();
+        for (size_t d = 0; d < table_->scheduleDim(); d++)
+            subscripts_[d] = lower_[d] + (fraction_[d] > 0.5 ? 1 : 0);
+        return table_->gridIndex(subscripts_);
+    }
+
+    size_t nearestEntry() const
+    {
+        size_t nearest = 0;
+        double minDistance = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < table_->size(); i++)
+        {
+            const double distance = (table_->schedule(i) - s_).squaredNorm();
+            if (distance < minDistance)
+            {
+                minDistance = distance;
+                nearest = i;
+            }
+        }
+        return nearest;
+    }
+
+    size_t cornerWeights()
+    {
+        locateInGrid();
+
+        const size_t d = table_->scheduleDim();
+        for (size_t corner = 0; corner < weights_.size(); corner++)
+        {
+            double weight = 1.0;
+            for (size_t k = 0; k < d; k++)
+            {
+                const bool upper = (corner >> k) & 1;
+                subscripts_[k] = std::min(lower_[k] + upper, table_->axes()[k].size() - 1);
+                weight *= upper ? fraction_[k] : 1.0 - fraction_[k];
+            }
+            weights_[corner] = std::make_pair(table_->gridIndex(subscripts_), weight);
+        }
+        return weights_.size();
+    }
+
+    size_t rbfWeights()
+    {
+        // subtract the minimum squared distance before exponentiating, such that far away points do not underflow
+        double minDistance = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < table_->size(); i++)
+        {
+            weights_[i].first = i;
+            weights_[i].second = (table_->schedule(i) - s_).squaredNorm();
+            minDistance = std::min(minDistance, weights_[i].second);
+        }
+
+        double sum = 0.0;
+        for (auto& weight : weights_)
+        {
+            weight.second = std::exp((weight.second - minDistance) * sigma2inv_);
+            sum += weight.second;
+        }
+
+        for (auto& weight : weights_)
+            weight.second /= sum;
+
+        return weights_.size();
+    }
+
+    std::shared_ptr<const GainScheduleTable_t> table_;
+    selection_matrix_t S_;
+    InterpolationType type_;
+    double sigma2inv_;
+
+    // workspace
+    schedule_vector_t s_;
+    std::vector<size_t> lower_;
+    std::vector<double> fraction_;
+    std::vector<size_t> subscripts_;
+    std::vector<std::pair<size_t, double>> weights_;
+};
+
+}  // namespace optcon
+}  // namespace ct
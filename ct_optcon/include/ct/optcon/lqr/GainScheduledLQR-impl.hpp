@@ -0,0 +1,126 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM>
+GainScheduledLQR<STATE_DIM, CONTROL_DIM>::GainScheduledLQR(const std::shared_ptr<LinearSystem_t>& linearSystem,
+    const state_matrix_t& Q,
+    const control_matrix_t& R,
+    size_t nThreads)
+    : linearSystem_(linearSystem), Q_(Q), R_(R), nThreads_(nThreads), dt_(0.0)
+{
+    if (!linearSystem_)
+        throw std::runtime_error("GainScheduledLQR: linear system must not be empty.");
+    if (nThreads_ < 1)
+        throw std::runtime_error("GainScheduledLQR: number of threads needs to be positive.");
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM>
+void GainScheduledLQR<STATE_DIM, CONTROL_DIM>::setSamplingTime(double dt)
+{
+    if (dt < 0.0)
+        throw std::runtime_error("GainScheduledLQR: sampling time must not be negative.");
+    dt_ = dt;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM>
+bool GainScheduledLQR<STATE_DIM, CONTROL_DIM>::compute(GainScheduleTable_t& table) const
+{
+    std::atomic<size_t> nextEntry(0);
+
+    // the reason an entry failed, empty on success. Every entry is written by a single thread only.
+    std::vector<std::string> errors(table.size());
+
+    // shared by all threads, the discretization only operates on its arguments
+    const Discretizer_t discretizer(
+        dt_, nullptr, ct::core::SensitivityApproximationSettings::APPROXIMATION::MATRIX_EXPONENTIAL);
+
+    // every thread works on its own entries, clone of the linear system and LQR
+    auto worker = [&]() {
+        std::shared_ptr<LinearSystem_t> linearSystem(linearSystem_->clone());
+        LQR<STATE_DIM, CONTROL_DIM> lqr;
+
+        for (size_t i = nextEntry++; i < table.size(); i = nextEntry++)
+        {
+            try
+            {
+                if (!computeEntry(*linearSystem, lqr, discretizer, table, i))
+                    errors[i] = "no stabilizing solution found";
+            } catch (std::exception& e)
+            {
+                errors[i] = e.what();
+            }
+
+            if (!errors[i].empty())
+                table.K(i).setZero();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < std::min(nThreads_, table.size()); t++)
+        threads.emplace_back(worker);
+
+    for (auto& thread : threads)
+        thread.join();
+
+    const size_t nFailed = table.size() - std::count(errors.begin(), errors.end(), std::string());
+    if (nFailed > 0)
+    {
+        std::cout << "GainScheduledLQR: design failed for " << nFailed << " out of " << table.size() << " entries:"
+                  << std::endl;
+        for (size_t i = 0; i < table.size(); i++)
+            if (!errors[i].empty())
+                std::cout << "  entry " << i << ": " << errors[i] << std::endl;
+    }
+
+    return nFailed == 0;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM>
+bool GainScheduledLQR<STATE_DIM, CONTROL_DIM>::computeEntry(LinearSystem_t& linearSystem,
+    LQR<STATE_DIM, CONTROL_DIM>& lqr,
+    const Discretizer_t& discretizer,
+    GainScheduleTable_t& table,
+    size_t i) const
+{
+    const ct::core::StateVector<STATE_DIM> x = table.x(i);
+    const ct::core::ControlVector<CONTROL_DIM> u = table.u(i);
+
+    state_matrix_t A = linearSystem.getDerivativeState(x, u, 0.0);
+    control_gain_matrix_t B = linearSystem.getDerivativeControl(x, u, 0.0);
+
+    control_feedback_t K;
+    bool success;
+
+    if (dt_ > 0.0)
+    {
+        // zero-order hold discretization
+        typename Discretizer_t::state_matrix_t Ad;
+        typename Discretizer_t::state_control_matrix_t Bd;
+        discretizer.discretize(A, B, A, Ad, Bd);
+
+        success = lqr.computeDiscrete(Q_, R_, Ad, Bd, K);
+    }
+    else
+        success = lqr.compute(Q_, R_, A, B, K);
+
+    success = success && K.allFinite();
+
+    // the table stores the gain in the convention u = u_op + K (x - x_op)
+    if (success)
+        table.K(i) = -K;
+
+    return success;
+}
+
+}  // namespace optcon
+}  // namespace ct
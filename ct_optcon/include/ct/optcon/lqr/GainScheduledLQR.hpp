@@ -0,0 +1,85 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <thread>
+
+#include "LQR.hpp"
+#include "GainScheduleTable.hpp"
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \ingroup LQR
+ *
+ * \brief designs infinite-horizon LQR controllers for all operating points of a GainScheduleTable in parallel
+ *
+ * The operating points (x_op, u_op) of the table, e.g. the trim states of the system, need to be set beforehand.
+ * For every entry, the system is linearized at its operating point and the LQR gain is stored in the table. The
+ * entries are distributed over worker threads, each of which works on its own clone of the linear system, such that
+ * the linearizer, e.g. a SystemLinearizer or an ADCodegenLinearizer, does not need to be thread-safe.
+ *
+ * By default, the continuous-time LQR is designed. If a sampling time is set, the linearization is discretized with
+ * a zero-order hold on the control and the discrete-time LQR is designed instead.
+ *
+ * @tparam STATE_DIM system state dimension
+ * @tparam CONTROL_DIM system control input dimension
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM>
+class GainScheduledLQR
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<double, STATE_DIM, STATE_DIM> state_matrix_t;
+    typedef Eigen::Matrix<double, CONTROL_DIM, CONTROL_DIM> control_matrix_t;
+    typedef Eigen::Matrix<double, STATE_DIM, CONTROL_DIM> control_gain_matrix_t;
+    typedef Eigen::Matrix<double, CONTROL_DIM, STATE_DIM> control_feedback_t;
+
+    typedef ct::core::LinearSystem<STATE_DIM, CONTROL_DIM, double> LinearSystem_t;
+    typedef GainScheduleTable<STATE_DIM, CONTROL_DIM, double> GainScheduleTable_t;
+    typedef ct::core::SensitivityApproximation<STATE_DIM, CONTROL_DIM> Discretizer_t;
+
+    /*!
+	 * @param linearSystem linearization of the system, cloned once per worker thread
+	 * @param Q state-weighting matrix
+	 * @param R control input weighting matrix
+	 * @param nThreads number of worker threads
+	 */
+    GainScheduledLQR(const std::shared_ptr<LinearSystem_t>& linearSystem,
+        const state_matrix_t& Q,
+        const control_matrix_t& R,
+        size_t nThreads = std::max(1u, std::thread::hardware_concurrency()));
+
+    //! design the discrete-time LQR for the given sampling time, or the continuous-time LQR if it is zero (default)
+    void setSamplingTime(double dt);
+
+    //! design the LQR for all entries of the table and store the feedback gains in it
+    /*!
+	 * @param table the table with the operating points set
+	 * @return true if the design succeeded for all entries. Failed entries are reported once all threads have
+	 * finished and their gain is set to zero.
+	 */
+    bool compute(GainScheduleTable_t& table) const;
+
+private:
+    //! design the LQR of a single entry
+    bool computeEntry(LinearSystem_t& linearSystem,
+        LQR<STATE_DIM, CONTROL_DIM>& lqr,
+        const Discretizer_t& discretizer,
+        GainScheduleTable_t& table,
+        size_t i) const;
+
+    std::shared_ptr<LinearSystem_t> linearSystem_;
+    state_matrix_t Q_;
+    control_matrix_t R_;
+    size_t nThreads_;
+    double dt_;
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -31,6 +31,32 @@ bool LQR<STATE_DIM, CONTROL_DIM>::compute(const state_matrix_t& Q,
     return success;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM>
+bool LQR<STATE_DIM, CONTROL_DIM>::computeDiscrete(const state_matrix_t& Q,
+    const control_matrix_t& R,
+    const state_matrix_t& A,
+    const control_gain_matrix_t& B,
+    control_feedback_t& K,
+    bool useDoubling)
+{
+    try
+    {
+        if (useDoubling)
+            dare_.computeSteadyStateRiccatiMatrixDoubling(Q, R, A, B, K);
+        else
+            dare_.computeSteadyStateRiccatiMatrix(Q, R, A, B, K);
+    } catch (std::exception& e)
+    {
+        std::cout << "LQR: " << e.what() << std::endl;
+        return false;
+    }
+
+    // the DARE returns the feedback for u = K x
+    K = -K;
+
+    return true;
+}
+
 #ifdef USE_MATLAB_CPP_INTERFACE
 template <size_t STATE_DIM, size_t CONTROL_DIM>
 bool LQR<STATE_DIM, CONTROL_DIM>::computeMatlab(const state_matrix_t& Q,
@@ -6,6 +6,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #pragma once
 
 #include "riccati/CARE.hpp"
+#include "riccati/DARE.hpp"
 
 #ifdef USE_MATLAB_CPP_INTERFACE
 #include <matlabCppInterface/Engine.hpp>
@@ -60,6 +61,25 @@ public:
         bool RisDiagonal = false,
         bool solveRiccatiIteratively = false);
 
+    //! design the discrete-time infinite-horizon LQR controller.
+    /*!
+	 * The resulting feedback law takes the same form as for the continuous-time design, u_fb = -K (x - x_ref).
+	 * @param Q state-weighting matrix
+	 * @param R control input weighting matrix
+	 * @param A discrete-time linear system dynamics matrix A
+	 * @param B discrete-time linear system dynamics matrix B
+	 * @param K control feedback matrix K (to be designed)
+	 * @param useDoubling
+	 * 	solve the discrete-time Riccati Equation with the doubling algorithm instead of iterating it step by step
+	 * @return success
+	 */
+    bool computeDiscrete(const state_matrix_t& Q,
+        const control_matrix_t& R,
+        const state_matrix_t& A,
+        const control_gain_matrix_t& B,
+        control_feedback_t& K,
+        bool useDoubling = true);
+
 #ifdef USE_MATLAB_CPP_INTERFACE
     //! design the LQR controller in MATLAB
     /*!
@@ -76,6 +96,7 @@ public:
 
 private:
     CARE<STATE_DIM, CONTROL_DIM> care_;  // continuous-time algebraic riccati equation
+    DARE<STATE_DIM, CONTROL_DIM> dare_;  // discrete-time algebraic riccati equation
 
 #ifdef USE_MATLAB_CPP_INTERFACE
     matlab::Engine matlabEngine_;
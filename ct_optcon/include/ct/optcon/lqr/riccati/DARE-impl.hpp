@@ -67,5 +67,67 @@ DARE<STATE_DIM, CONTROL_DIM, SCALAR>::computeSteadyStateRiccatiMatrix(const stat
     return P;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+typename DARE<STATE_DIM, CONTROL_DIM, SCALAR>::state_matrix_t
+DARE<STATE_DIM, CONTROL_DIM, SCALAR>::computeSteadyStateRiccatiMatrixDoubling(const state_matrix_t& Q,
+    const control_matrix_t& R,
+    const state_matrix_t& A,
+    const control_gain_matrix_t& B,
+    control_feedback_t& K,
+    bool verbose,
+    const SCALAR eps,
+    size_t maxIter)
+{
+    Eigen::LDLT<control_matrix_t> R_ldlt(R);
+    if (R_ldlt.info() != Eigen::Success || !R_ldlt.isPositive())
+        throw std::runtime_error("DARE : R needs to be positive definite.");
+
+    // A_k, G_k and H_k span 2^k steps of the Riccati recursion, H_k converges to P
+    state_matrix_t A_k = A;
+    state_matrix_t G_k = B * R_ldlt.solve(B.transpose());
+    state_matrix_t H_k = Q;
+
+    Eigen::Matrix<SCALAR, STATE_DIM, 2 * STATE_DIM> rhs;
+    Eigen::Matrix<SCALAR, STATE_DIM, 2 * STATE_DIM> W_inv_rhs;
+    size_t numIter = 0;
+    SCALAR diff = 1;
+
+    while (diff >= eps && numIter < maxIter)
+    {
+        // W = I + G_k H_k is invertible for positive semi-definite G_k and H_k
+        const state_matrix_t W = state_matrix_t::Identity() + G_k * H_k;
+        rhs << A_k, G_k;
+        W_inv_rhs = W.partialPivLu().solve(rhs);
+
+        const state_matrix_t H_next = H_k + A_k.transpose() * H_k * W_inv_rhs.template leftCols<STATE_DIM>();
+        G_k += A_k * W_inv_rhs.template rightCols<STATE_DIM>() * A_k.transpose();
+        A_k = (A_k * W_inv_rhs.template leftCols<STATE_DIM>()).eval();
+
+        // relative to the magnitude of the solution, the round-off of a large P would exceed an absolute tolerance
+        diff = (H_next - H_k).norm() / std::max(SCALAR(1.0), H_next.norm());
+        H_k = (H_next + H_next.transpose()) / 2.0;
+        G_k = (G_k + G_k.transpose()).eval() / 2.0;
+
+        if (!H_k.allFinite())
+            throw std::runtime_error("DARE : Failed to converge - doubling diverged.");
+        numIter++;
+    }
+
+    if (diff >= eps)
+        throw std::runtime_error("DARE : Failed to converge - maximum number of doubling iterations reached.");
+
+    const control_matrix_t H = R + B.transpose() * H_k * B;
+    K = -H.ldlt().solve(B.transpose() * H_k * A);
+
+    if (verbose)
+    {
+        std::cout << "DARE : doubling converged after " << numIter << " iterations out of a maximum of " << maxIter
+                  << std::endl;
+        std::cout << "Resulting K: " << K << std::endl;
+    }
+
+    return H_k;
+}
+
 }  // namespace optcon
 }  // namespace ct
@@ -74,6 +74,30 @@ public:
         const SCALAR eps = 1e-6,
         size_t maxIter = 1000);
 
+    /*! compute the discrete-time steady state Riccati-Matrix with the structure-preserving doubling algorithm
+     * Instead of one step per iteration, the k-th doubling iteration spans 2^k steps of the Riccati recursion, such that
+     * the solution converges quadratically, typically within a few tens of matrix operations.
+     * Requires a stabilizable and detectable system, A may be singular.
+     * @param Q state weight
+     * @param R control weight
+     * @param A discrete-time linear system matrix A
+     * @param B discrete-time linear system matrix B
+     * @param K the resulting feedback, with the same sign as computeSteadyStateRiccatiMatrix(), i.e. u = K x
+     * @param verbose print additional information
+     * @param eps relative treshold to stop iterating,
+     * i.e. \f$ \| H_{k+1} - H_k \| \leq \epsilon \max(1, \| H_{k+1} \|) \f$
+     * @param maxIter maximum number of doubling iterations
+     * @return steady state riccati matrix P
+     */
+    state_matrix_t computeSteadyStateRiccatiMatrixDoubling(const state_matrix_t& Q,
+        const control_matrix_t& R,
+        const state_matrix_t& A,
+        const control_gain_matrix_t& B,
+        control_feedback_t& K,
+        bool verbose = false,
+        const SCALAR eps = 1e-10,
+        size_t maxIter = 100);
+
 
 private:
     DynamicRiccatiEquation<STATE_DIM, CONTROL_DIM> dynamicRDE_;
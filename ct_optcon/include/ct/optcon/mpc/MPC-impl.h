@@ -22,7 +22,9 @@ MPC<OPTCON_SOLVER>::MPC(const OptConProblem_t& problem,
       forwardIntegrator_(dynamics_, mpcsettings.stateForwardIntegratorType_),
       firstRun_(true),
       runCallCounter_(0),
-      policyHandler_(new PolicyHandler<Policy_t, STATE_DIM, CONTROL_DIM, Scalar_t>())
+      policyHandler_(new PolicyHandler<Policy_t, STATE_DIM, CONTROL_DIM, Scalar_t>()),
+      defaultWarmStart_(false),
+      solverHoldsCurrentPolicy_(false)
 {
     checkSettings(mpcsettings);
 
@@ -43,6 +45,7 @@ MPC<OPTCON_SOLVER>::MPC(const OptConProblem_t& problem,
                 // default policy handler for standard discrete-time iLQG implementation
                 policyHandler_ = std::shared_ptr<PolicyHandler<Policy_t, STATE_DIM, CONTROL_DIM, Scalar_t>>(
                     new StateFeedbackPolicyHandler<STATE_DIM, CONTROL_DIM, Scalar_t>(solverSettings.dt));
+                defaultWarmStart_ = true;
             }
             else
             {
@@ -94,6 +97,7 @@ void MPC<OPTCON_SOLVER>::setInitialGuess(const Policy_t& initGuess)
     solver_.setInitialGuess(initGuess);
     policyHandler_->setPolicy(initGuess);
     currentPolicy_ = initGuess;
+    solverHoldsCurrentPolicy_ = false;
 }
 
 
@@ -155,6 +159,10 @@ void MPC<OPTCON_SOLVER>::prepareIteration(const Scalar_t& extTime)
     // update the Optimal Control Solver with new time horizon and state information
     solver_.changeTimeHorizon(newTimeHorizon);
 
+    // if the solver still holds the previous solution, it may shift it like the default warm start does
+    const bool shiftSolver =
+        defaultWarmStart_ && solverHoldsCurrentPolicy_ && solver_.getTimeHorizon() == currTimeHorizon;
+
 
     // Calculate new initial guess / warm-starting policy
     policyHandler_->designWarmStartingPolicy(t_forward_stop_, newTimeHorizon, currentPolicy_);
@@ -167,7 +175,10 @@ void MPC<OPTCON_SOLVER>::prepareIteration(const Scalar_t& extTime)
     /**
 	 * re-initialize the OptConSolver and solve the optimal control problem.
 	 */
-    solver_.setInitialGuess(currentPolicy_);
+    if (!shiftSolver || !solver_.shiftHorizon(t_forward_stop_))
+        solver_.setInitialGuess(currentPolicy_);
+
+    solverHoldsCurrentPolicy_ = false;
 
     solver_.prepareMPCIteration();
 }
@@ -205,6 +216,7 @@ bool MPC<OPTCON_SOLVER>::finishIteration(const core::StateVector<STATE_DIM, Scal
 
         // get optimized policy and state trajectory from OptConSolver
         currentPolicy_ = solver_.getSolution();
+        solverHoldsCurrentPolicy_ = true;
 
         // obtain the time which passed since the previous successful solve
         Scalar_t dtp = timeKeeper_.timeSincePreviousSuccessfulSolve(x_ts);
@@ -226,6 +238,7 @@ bool MPC<OPTCON_SOLVER>::finishIteration(const core::StateVector<STATE_DIM, Scal
                 Scalar_t dt_truncated_eff;
 
                 policyHandler_->truncateSolutionFront(dt_post_truncation, currentPolicy_, dt_truncated_eff);
+                solverHoldsCurrentPolicy_ = false;
 
                 // update policy timestamp with the truncated time
                 newPolicy_ts += dt_truncated_eff;
@@ -270,6 +283,7 @@ template <typename OPTCON_SOLVER>
 void MPC<OPTCON_SOLVER>::resetMpc(const Scalar_t& newTimeHorizon)
 {
     firstRun_ = true;
+    solverHoldsCurrentPolicy_ = false;
 
     runCallCounter_ = 0;
 
@@ -239,6 +239,12 @@ private:
     //! policy handler, which takes care of warm-starting
     std::shared_ptr<PolicyHandler<Policy_t, STATE_DIM, CONTROL_DIM, Scalar_t>> policyHandler_;
 
+    //! true if warm-starting with the default policy handler, which the solver can replicate by shifting its horizon
+    bool defaultWarmStart_;
+
+    //! true if the solver still holds the solution currentPolicy_ was obtained from
+    bool solverHoldsCurrentPolicy_;
+
     //! currently optimal policy, initial guess respectively
     Policy_t currentPolicy_;
 
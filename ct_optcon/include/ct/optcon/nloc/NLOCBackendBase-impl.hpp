@@ -37,6 +37,8 @@ NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOCB
       firstRollout_(true),
       settings_(settings),
       K_(0),
+      modeSequenceInStages_(false),
+      modeSequenceShift_(0),
       substepsX_(new StateSubsteps),
       substepsU_(new ControlSubsteps),
       d_norm_(0.0),
@@ -55,7 +57,10 @@ NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOCB
       inputBoxConstraints_(settings.nThreads + 1, nullptr),  // initialize constraints with null
       stateBoxConstraints_(settings.nThreads + 1, nullptr),  // initialize constraints with null
       generalConstraints_(settings.nThreads + 1, nullptr),   // initialize constraints with null
-      lqpCounter_(0)
+      generalConstraintsEval_(settings.nThreads + 1),
+      lqpCounter_(0),
+      lineSearchAborts_(0),
+      numReusedShots_(0)
 {
     Eigen::initParallel();
 
@@ -178,6 +183,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 
     t_ = TimeArray(settings_.dt, x_.size(), 0.0);
 
+    invalidateLinearization();
     reset();
 
     // compute costs of the initial guess trajectory
@@ -198,6 +204,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     K_ = numStages;
 
     t_ = TimeArray(settings_.dt, K_ + 1, 0.0);
+    precomputeCostActivations();
 
     x_.resize(K_ + 1);
     x_prev_.resize(K_ + 1);
@@ -205,12 +212,16 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     delta_x_.resize(K_ + 1);
     x_ref_lqr_.resize(K_ + 1);
     delta_x_ref_lqr_.resize(K_ + 1);
+    x_lin_.resize(K_ + 1);
 
     u_ff_.resize(K_);
     u_ff_prev_.resize(K_);
     delta_u_ff_.resize(K_);
     d_.resize(K_ + 1);
+    lambda_.resize(K_ + 1);
     L_.resize(K_);
+    u_lin_.resize(K_);
+    invalidateLinearization();
 
     substepsX_->resize(K_ + 1);
     substepsU_->resize(K_ + 1);
@@ -218,6 +229,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     resetDefects();
 
     systemInterface_->changeNumStages(K_);
+    updateShotGrid();
 
     lqocProblem_->changeNumStages(K_);
     lqocProblem_->setZero();
@@ -234,6 +246,68 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     changeTimeHorizon(settings_.computeK(tf));
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::shiftHorizon(int numStages)
+{
+    if (numStages < 0 || numStages >= K_)
+        throw std::runtime_error("NLOCBackendBase: can only shift about 0 to K-1 stages.");
+
+    x_.shiftFront(numStages);
+    xShot_.shiftFront(numStages);
+    lambda_.shiftFront(numStages);
+    u_ff_.shiftFront(numStages);
+    u_ff_prev_.shiftFront(numStages);
+    L_.shiftFront(numStages);
+
+    // the substeps are recorded into the arrays the pointers point to, hence they must not be duplicated
+    std::rotate(substepsX_->begin(), substepsX_->begin() + numStages, substepsX_->end());
+    std::rotate(substepsU_->begin(), substepsU_->begin() + numStages, substepsU_->end());
+
+    lqocProblem_->shiftStages(numStages);
+
+    x_lin_.shiftFront(numStages);
+    u_lin_.shiftFront(numStages);
+
+    // the mode sequence and hence the shots move along with the stages
+    const std::vector<size_t> stageModesPrevious = stageModes_;
+    const std::vector<int> nextShotStartPrevious = nextShotStart_;
+    modeSequenceShift_ += numStages;
+    updateShotGrid();
+
+    // the kept stages have to start the same shots and remain in the same modes
+    bool shotsAligned = true;
+    for (int k = 0; k < K_ - numStages; k++)
+    {
+        const int kPrevious = k + numStages;
+        const bool wasShotStart = (kPrevious == 0 || nextShotStartPrevious[kPrevious - 1] == kPrevious);
+        shotsAligned &= (isShotStart(k) == wasShotStart);
+        if (!stageModes_.empty())
+            shotsAligned &= (stageModes_[k] == stageModesPrevious[kPrevious]);
+    }
+
+    if (!shotsAligned || !settings_.reuseShiftedLinearization)
+    {
+        // the shots are no longer aligned with the stages, or the problem may depend on time
+        invalidateLinearization();
+    }
+    else
+    {
+        // the appended stages have not been linearized yet
+        for (int k = K_ - numStages; k <= K_; k++)
+        {
+            x_lin_[k].setConstant(std::numeric_limits<SCALAR>::quiet_NaN());
+            if (k < K_)
+                u_lin_[k].setConstant(std::numeric_limits<SCALAR>::quiet_NaN());
+        }
+    }
+
+    // same as for a new initial guess
+    x_prev_ = x_;
+    x_ref_lqr_ = x_;
+
+    reset();
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::changeInitialState(
     const core::StateVector<STATE_DIM, SCALAR>& x0)
@@ -260,6 +334,9 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         costFunctions_[i] = typename OptConProblem_t::CostFunctionPtr_t(cf->clone());
     }
 
+    precomputeCostActivations();
+    invalidateLinearization();
+
     // recompute cost if line search is active
     // TODO: this should be multi-threaded to save time
     if (iteration_ > 0 && (settings_.lineSearchSettings.type != LineSearchSettings::TYPE::NONE))
@@ -271,6 +348,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     const typename OptConProblem_t::DynamicsPtr_t& dyn)
 {
     systemInterface_->changeNonlinearSystem(dyn);
+    invalidateLinearization();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
@@ -333,6 +411,8 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         generalConstraints_[i] = typename OptConProblem_t::ConstraintPtr_t(con->clone());
     }
 
+    invalidateLinearization();
+
     // intermediate stages
     for (int i = 0; i < K_; i++)
     {
@@ -353,6 +433,10 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     lqocProblem_->d_lb_[K_].resize(lqocProblem_->ng_[K_], 1);
     lqocProblem_->d_ub_[K_].resize(lqocProblem_->ng_[K_], 1);
 
+    // size the evaluation buffers for the largest stage
+    for (auto& g : generalConstraintsEval_)
+        g.resize(*std::max_element(lqocProblem_->ng_.begin(), lqocProblem_->ng_.end()));
+
     lqocSolver_->setProblem(lqocProblem_);
 
     // TODO can we do this multi-threaded?
@@ -365,6 +449,10 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     const typename OptConProblem_t::LinearPtr_t& lin)
 {
     systemInterface_->changeLinearSystem(lin);
+    invalidateLinearization();
+
+    if (settings_.exactHessian && systemInterface_->hasNumericLinearization())
+        throw std::runtime_error("The exact Hessian requires an analytic or auto-diff linearization of the dynamics.");
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
@@ -414,6 +502,18 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     else
         throw std::runtime_error("Solver for Linear Quadratic Optimal Control Problem wrongly specified.");
 
+    if (settings.exactHessian && settings.lqocp_solver != NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER)
+        throw std::runtime_error("The exact Hessian may be indefinite and is only supported by the GNRiccatiSolver.");
+
+    // the curvature is obtained by differencing the linearization at perturbed setpoints, but the sensitivity
+    // integrator linearizes along the stored rollout of the shot and ignores the perturbation
+    if (settings.exactHessian && settings.useSensitivityIntegrator)
+        throw std::runtime_error("The exact Hessian is not supported with the sensitivity integrator.");
+
+    // differencing a numerical linearization amplifies its truncation error, the curvature would be meaningless
+    if (settings.exactHessian && systemInterface_->hasNumericLinearization())
+        throw std::runtime_error("The exact Hessian requires an analytic or auto-diff linearization of the dynamics.");
+
     // set number of Eigen Threads (requires -fopenmp)
     if (settings_.nThreadsEigen > 1)
     {
@@ -425,8 +525,33 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 
     lqocSolver_->configure(settings);
 
+    // (re-)open the binary log if its file changes, keep streaming to it otherwise
+    if (settings.logToBinary)
+    {
+        const std::string binaryLogFile = settings.loggingPrefix + "Log.ctlog";
+        if (!binaryLogger_ || binaryLogFile != binaryLogFile_)
+        {
+            binaryLogger_.reset(new ct::core::BinaryLogger());
+            for (const char* channel : {"x", "u_ff", "L", "t", "d", "xShot", "A", "B", "qv", "Q", "P", "rv", "R", "q",
+                     "intermediateCost", "finalCost", "totalCost", "merit", "defect_l1_norm", "defect_l2_norm",
+                     "e_box_norm", "e_gen_norm", "lx_norm", "lu_norm", "stepSize", "smallestEigenvalue"})
+                binaryLogger_->addChannel(channel);
+            binaryLogger_->open(binaryLogFile);
+            binaryLogFile_ = binaryLogFile;
+        }
+    }
+    else
+        binaryLogger_.reset();
+
+    const bool dtChanged = settings.dt != settings_.dt;
+
     settings_ = settings;
 
+    if (dtChanged)
+        precomputeCostActivations();
+
+    updateShotGrid();
+
     reset();
 
     configured_ = true;
@@ -455,9 +580,7 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     xShot[k] = x_local[k];  // initialize
 
     //! determine index where to stop at the latest
-    int K_stop = k + getNumStepsPerShot();
-    if (K_stop > K_local)
-        K_stop = K_local;
+    const int K_stop = getNextShotStart(k);
 
     // for each control step
     for (int i = (int)k; i < K_stop; i++)
@@ -537,7 +660,7 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     //! make sure all intermediate entries in the defect trajectory are zero
     d.setConstant(state_vector_t::Zero());
 
-    for (size_t k = firstIndex; k <= lastIndex; k = k + getNumStepsPerShot())
+    for (size_t k = firstIndex; k <= lastIndex; k = getNextShotStart(k))
     {
         // first rollout the shot
         bool dynamicsGood = rolloutSingleShot(
@@ -559,7 +682,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     StateVectorArray& d) const
 {
     //! compute the index where the next shot starts (respect total number of stages)
-    int k_next = std::min(K_, (int)k + settings_.K_shot);
+    int k_next = getNextShotStart(k);
 
     if (k_next < K_)
     {
@@ -568,6 +691,122 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     //! else ... all other entries of d remain zero.
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::isShotLinearizationValid(size_t k) const
+{
+    // in closed-loop shooting the shots depend on the feedback of the previous solution
+    if (settings_.closedLoopShooting())
+        return false;
+
+    //! the last shot is always recomputed since it also carries the terminal stage
+    const size_t k_next = getNextShotStart(k);
+    if (k_next >= (size_t)K_)
+        return false;
+
+    // the comparisons are written such that NaN entries fail
+    const SCALAR tol = settings_.linearizationReuseTolerance;
+    for (size_t i = k; i < k_next; i++)
+    {
+        if (!((u_ff_[i] - u_lin_[i]).template lpNorm<Eigen::Infinity>() <= tol))
+            return false;
+        if (!((x_[i] - x_lin_[i]).template lpNorm<Eigen::Infinity>() <= tol))
+            return false;
+    }
+
+    return true;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::rolloutShotsAndComputeLQApproximation(
+    size_t firstIndex,
+    size_t lastIndex)
+{
+    // consecutive shots which need to be recomputed are handed to the backend as one range
+    size_t rangeStart = firstIndex;
+    numReusedShots_ = 0;
+    for (size_t k = firstIndex; k <= lastIndex; k = getNextShotStart(k))
+    {
+        if (!isShotLinearizationValid(k))
+            continue;
+
+        numReusedShots_++;
+
+        if (rangeStart < k)
+        {
+            rolloutShots(rangeStart, k - 1);
+            computeLQApproximation(rangeStart, k - 1);
+        }
+        rangeStart = getNextShotStart(k);
+
+        // the rollout is kept, only the defect has to be restored
+        computeSingleDefect(k, x_, xShot_, d_);
+        for (size_t i = k; i < rangeStart; i++)
+            lqocProblem_->b_[i] = d_[i];
+    }
+
+    if (rangeStart <= lastIndex)
+    {
+        rolloutShots(rangeStart, lastIndex);
+        computeLQApproximation(rangeStart, lastIndex);
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::invalidateLinearization()
+{
+    x_lin_.setConstant(state_vector_t::Constant(std::numeric_limits<SCALAR>::quiet_NaN()));
+    u_lin_.setConstant(control_vector_t::Constant(std::numeric_limits<SCALAR>::quiet_NaN()));
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::precomputeCostActivations()
+{
+    // the stage times as passed to the cost functions, which may differ from t_ by round-off
+    TimeArray stageTimes(K_ + 1);
+    for (int k = 0; k <= K_; k++)
+        stageTimes[k] = settings_.dt * k;
+
+    for (auto& costFunction : costFunctions_)
+        costFunction->precomputeActivations(stageTimes);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::updateShotGrid()
+{
+    // each stage is in the mode active at its midpoint
+    stageModes_.clear();
+    if (modeSequence_.getNumPhases() > 0)
+    {
+        const double stageDuration = modeSequenceInStages_ ? 1.0 : (double)settings_.dt;
+        stageModes_.resize(K_);
+        for (int k = 0; k < K_; k++)
+            stageModes_[k] = modeSequence_.getPhaseFromTime((k + modeSequenceShift_ + 0.5) * stageDuration);
+    }
+
+    // shots of getNumStepsPerShot() stages, which are cut at the switches in multiple shooting
+    nextShotStart_.resize(K_);
+    for (int shotStart = 0; shotStart < K_;)
+    {
+        int shotEnd = std::min(K_, shotStart + getNumStepsPerShot());
+        if (!stageModes_.empty() && !settings_.isSingleShooting())
+        {
+            for (int k = shotStart + 1; k < shotEnd; k++)
+            {
+                if (stageModes_[k] != stageModes_[shotStart])
+                {
+                    shotEnd = k;
+                    break;
+                }
+            }
+        }
+
+        std::fill(nextShotStart_.begin() + shotStart, nextShotStart_.begin() + shotEnd, shotEnd);
+        shotStart = shotEnd;
+    }
+
+    systemInterface_->setStageModes(stageModes_);
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::computeCostsOfTrajectory(
     size_t threadId,
@@ -683,7 +922,8 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::executeLQApproximation(size_t threadId,
-    size_t k)
+    size_t k,
+    bool linearizeDynamics)
 {
     LQOCProblem_t& p = *lqocProblem_;
     const scalar_t& dt = settings_.dt;
@@ -697,12 +937,19 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 
     //! @warning it is important that the calculations are done with local variables x_ and u_ff_, they will only later be stored in the LQOCProblem
     // compute A_n and B_n
-    systemInterface_->setSubstepTrajectoryReference(substepsX_, substepsU_, threadId);
-    systemInterface_->getAandB(x_[k], u_ff_[k], xShot_[k], (int)k, settings_.K_sim, p.A_[k], p.B_[k], threadId);
+    if (linearizeDynamics)
+    {
+        systemInterface_->setSubstepTrajectoryReference(substepsX_, substepsU_, threadId);
+        systemInterface_->getAandB(x_[k], u_ff_[k], xShot_[k], (int)k, settings_.K_sim, p.A_[k], p.B_[k], threadId);
+    }
 
     // compute dynamics offset term b_n
     p.b_[k] = d_[k];
 
+    // remember the linearization point
+    x_lin_[k] = x_[k];
+    u_lin_[k] = u_ff_[k];
+
     // feed current state and control to cost function
     costFunctions_[threadId]->setCurrentStateAndControl(x_[k], u_ff_[k], dt * k);
 
@@ -800,13 +1047,20 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         // treat general constraints
         generalConstraints_[threadId]->setCurrentStateAndControl(x_[k], u_ff_[k], dt * k);
 
-        p.ng_[k] = generalConstraints_[threadId]->getIntermediateConstraintsCount();
-        if (p.ng_[k] > 0)
+        const int ng = generalConstraints_[threadId]->getIntermediateConstraintsCount();
+        p.ng_[k] = ng;
+        if (ng > 0)
         {
-            p.C_[k] = generalConstraints_[threadId]->jacobianStateIntermediate();
-            p.D_[k] = generalConstraints_[threadId]->jacobianInputIntermediate();
+            // no-ops unless the number of constraints changed since changeGeneralConstraints()
+            p.C_[k].resize(ng, STATE_DIM);
+            p.D_[k].resize(ng, CONTROL_DIM);
+            p.d_lb_[k].resize(ng, 1);
+            p.d_ub_[k].resize(ng, 1);
+            if (generalConstraintsEval_[threadId].rows() < ng)
+                generalConstraintsEval_[threadId].resize(ng);
 
-            Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> g_eval = generalConstraints_[threadId]->evaluateIntermediate();
+            auto g_eval = generalConstraintsEval_[threadId].head(ng);
+            generalConstraints_[threadId]->linearizeIntermediate(g_eval, p.C_[k], p.D_[k]);
 
             // rewrite constraint boundaries in relative coordinates as required by LQOC problem
             p.d_lb_[k] = generalConstraints_[threadId]->getLowerBoundsIntermediate() - g_eval;
@@ -815,6 +1069,26 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     }
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::computeDynamicsCurvature(
+    size_t threadId,
+    size_t k)
+{
+    LQOCProblem_t& p = *lqocProblem_;
+
+    typename systemInterface_t::state_matrix_t Hxx;
+    typename systemInterface_t::control_state_matrix_t Hux;
+    typename systemInterface_t::control_matrix_t Huu;
+
+    systemInterface_->setSubstepTrajectoryReference(substepsX_, substepsU_, threadId);
+    systemInterface_->getDynamicsCurvature(
+        x_[k], u_ff_[k], xShot_[k], (int)k, settings_.K_sim, lambda_[k + 1], Hxx, Hux, Huu, threadId);
+
+    p.Q_[k] += Hxx;
+    p.P_[k] += Hux;
+    p.R_[k] += Huu;
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::initializeCostToGo()
 {
@@ -831,14 +1105,19 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     // init terminal general constraints, if any
     if (generalConstraints_[settings_.nThreads] != nullptr)
     {
-        p.ng_[K_] = generalConstraints_[settings_.nThreads]->getTerminalConstraintsCount();
-        if (p.ng_[K_] > 0)
+        const int ng = generalConstraints_[settings_.nThreads]->getTerminalConstraintsCount();
+        p.ng_[K_] = ng;
+        if (ng > 0)
         {
-            p.C_[K_] = generalConstraints_[settings_.nThreads]->jacobianStateTerminal();
-            p.D_[K_] = generalConstraints_[settings_.nThreads]->jacobianInputTerminal();
+            p.C_[K_].resize(ng, STATE_DIM);
+            p.D_[K_].resize(ng, CONTROL_DIM);
+            p.d_lb_[K_].resize(ng, 1);
+            p.d_ub_[K_].resize(ng, 1);
+            if (generalConstraintsEval_[settings_.nThreads].rows() < ng)
+                generalConstraintsEval_[settings_.nThreads].resize(ng);
 
-            Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> g_eval =
-                generalConstraints_[settings_.nThreads]->evaluateTerminal();
+            auto g_eval = generalConstraintsEval_[settings_.nThreads].head(ng);
+            generalConstraints_[settings_.nThreads]->linearizeTerminal(g_eval, p.C_[K_], p.D_[K_]);
 
             p.d_lb_[K_] = generalConstraints_[settings_.nThreads]->getLowerBoundsTerminal() - g_eval;
             p.d_ub_[K_] = generalConstraints_[settings_.nThreads]->getUpperBoundsTerminal() - g_eval;
@@ -879,6 +1158,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     summaryAllIterations_.merits.push_back(totalMerit);
     summaryAllIterations_.stepSizes.push_back(alphaBest_);
     summaryAllIterations_.smallestEigenvalues.push_back(smallestEigenvalue);
+    summaryAllIterations_.lineSearchAborts.push_back(lineSearchAborts_);
 
     if (settings_.printSummary)
         summaryAllIterations_.printSummaryLastIteration();
@@ -942,6 +1222,41 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::logToBinary(const size_t& iteration)
+{
+    if (!binaryLogger_ || summaryAllIterations_.iterations.empty())
+        return;
+
+    ct::core::BinaryLogger& log = *binaryLogger_;
+    const LQOCProblem_t& p = *lqocProblem_;
+    const SummaryAllIterations<SCALAR>& s = summaryAllIterations_;
+
+    // in the order of the channels added in configure()
+    size_t c = 0;
+    log.logArray(c++, iteration, x_);
+    log.logArray(c++, iteration, u_ff_);
+    log.logArray(c++, iteration, L_);
+    log.logArray(c++, iteration, t_);
+    log.logArray(c++, iteration, d_);
+    log.logArray(c++, iteration, xShot_);
+
+    log.logArray(c++, iteration, p.A_);
+    log.logArray(c++, iteration, p.B_);
+    log.logArray(c++, iteration, p.qv_);
+    log.logArray(c++, iteration, p.Q_);
+    log.logArray(c++, iteration, p.P_);
+    log.logArray(c++, iteration, p.rv_);
+    log.logArray(c++, iteration, p.R_);
+    log.logArray(c++, iteration, p.q_);
+
+    for (const std::vector<SCALAR>* summary : {&s.intermediateCosts, &s.finalCosts, &s.totalCosts, &s.merits,
+             &s.defect_l1_norms, &s.defect_l2_norms, &s.e_box_norms, &s.e_gen_norms, &s.lx_norms, &s.lu_norms,
+             &s.stepSizes, &s.smallestEigenvalues})
+        log.log(c++, iteration, summary->back());
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::logInitToMatlab()
 {
@@ -1016,6 +1331,8 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     u_ff_prev_ = u_ff_;
     x_prev_ = x_;
 
+    lineSearchAborts_ = 0;
+
 
     if (settings_.lineSearchSettings.type == LineSearchSettings::TYPE::NONE)  // do full step updates
     {
@@ -1117,7 +1434,8 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     scalar_t& e_gen_norm,
     StateSubsteps& substepsX,
     ControlSubsteps& substepsU,
-    std::atomic_bool* terminationFlag) const
+    std::atomic_bool* terminationFlag,
+    const scalar_t meritBound) const
 {
     intermediateCost = std::numeric_limits<scalar_t>::max();
     finalCost = std::numeric_limits<scalar_t>::max();
@@ -1128,22 +1446,66 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     if (terminationFlag && *terminationFlag)
         return;
 
-    // update feedforward with weighting alpha
-    u_alpha = delta_u_ff_ * alpha + u_ff_prev_;
-
-    // update state decision variables with weighting alpha
-    x_alpha = delta_x_ * alpha + x_prev_;
-
-    // update x_lqr reference
-    ct::core::StateVectorArray<STATE_DIM, SCALAR> x_ref_lqr = delta_x_ref_lqr_ * alpha + x_prev_;
+    // update feedforward and state decision variables with weighting alpha, in place to reuse the candidate buffers
+    u_alpha.resize(K_);
+    x_alpha.resize(K_ + 1);
+    x_shot_alpha.resize(K_ + 1);
+    defects_recorded.resize(K_ + 1);
+    for (int k = 0; k < K_; k++)
+        u_alpha[k] = delta_u_ff_[k] * alpha + u_ff_prev_[k];
+    for (int k = 0; k < K_ + 1; k++)
+        x_alpha[k] = delta_x_[k] * alpha + x_prev_[k];
+
+    // the x_lqr reference is only required for closed-loop shooting
+    ct::core::StateVectorArray<STATE_DIM, SCALAR> x_ref_lqr;
+    if (settings_.closedLoopShooting())
+        x_ref_lqr = delta_x_ref_lqr_ * alpha + x_prev_;
+    const ct::core::StateVectorArray<STATE_DIM, SCALAR>& x_ref = settings_.closedLoopShooting() ? x_ref_lqr : x_prev_;
 
     if (terminationFlag && *terminationFlag)
         return;
 
-    bool dynamicsGood;
+    //! make sure all intermediate entries in the defect trajectory are zero
+    defects_recorded.setConstant(state_vector_t::Zero());
+
+    // rollout shot by shot, accumulating the intermediate cost and defect norm of every completed shot
+    bool dynamicsGood = true;
+    scalar_t intermediateCostSum = 0.0;
+    scalar_t defectNormSum = 0.0;
 
-    dynamicsGood = rolloutShotsSingleThreaded(threadId, 0 /*first index*/, K_ - 1 /*last index*/, u_alpha, x_alpha,
-        x_ref_lqr, x_shot_alpha, defects_recorded, substepsX, substepsU, terminationFlag);
+    for (int k = 0; k < K_; k = getNextShotStart(k))
+    {
+        dynamicsGood =
+            rolloutSingleShot(threadId, k, u_alpha, x_alpha, x_ref, x_shot_alpha, substepsX, substepsU, terminationFlag);
+
+        if (!dynamicsGood)
+            break;
+
+        computeSingleDefect(k, x_alpha, x_shot_alpha, defects_recorded);
+
+        const int K_stop = getNextShotStart(k);
+        for (int i = k; i < K_stop; i++)
+        {
+            costFunctions_[threadId]->setCurrentStateAndControl(x_alpha[i], u_alpha[i], settings_.dt * i);
+            intermediateCostSum += costFunctions_[threadId]->evaluateIntermediate();
+            defectNormSum += defects_recorded[i].template lpNorm<1>();
+        }
+
+        // with non-negative costs, the partial merit is a lower bound on the merit of the candidate
+        if (settings_.lineSearchSettings.abortOnMeritBound &&
+            intermediateCostSum * settings_.dt + settings_.meritFunctionRho * defectNormSum > meritBound)
+        {
+            lineSearchAborts_++;
+
+            if (settings_.debugPrint)
+            {
+                std::string msg = std::string("merit bound exceeded at stage ") + std::to_string(K_stop) +
+                                  std::string(", thread: ") + std::to_string(threadId);
+                std::cout << msg << std::endl;
+            }
+            return;
+        }
+    }
 
     if (terminationFlag && *terminationFlag)
         return;
@@ -1151,13 +1513,11 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     //! compute costs
     if (dynamicsGood)
     {
-        //! compute defects norm
-        defectNorm = computeDefectsNorm<1>(defects_recorded);
-
-        if (terminationFlag && *terminationFlag)
-            return;
+        defectNorm = defectNormSum;
+        intermediateCost = intermediateCostSum * settings_.dt;
 
-        computeCostsOfTrajectory(threadId, x_alpha, u_alpha, intermediateCost, finalCost);
+        costFunctions_[threadId]->setCurrentStateAndControl(x_alpha[K_], control_vector_t::Zero(), settings_.dt * K_);
+        finalCost = costFunctions_[threadId]->evaluateTerminal();
 
         if (terminationFlag && *terminationFlag)
             return;
@@ -1440,6 +1800,16 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         default:
             throw std::runtime_error("Unknown NLOC Algorithm type given in settings.");
     }
+
+    // the multipliers of the LQ problem are the costates for the exact Hessian of the next iteration
+    if (settings_.exactHessian)
+    {
+        if (settings_.nlocp_algorithm == NLOptConSettings::NLOCP_ALGORITHM::ILQR)
+            lqocSolver_->computeStatesAndControls();
+
+        lqocSolver_->computeCostates();
+        lambda_ = lqocSolver_->getSolutionCostate();
+    }
 }
 
 
@@ -1655,6 +2025,12 @@ int NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::g
     return K_;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+size_t NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getNumReusedShots() const
+{
+    return numReusedShots_;
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 int NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getNumStepsPerShot() const
 {
@@ -1664,6 +2040,52 @@ int NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::g
         return settings_.K_shot;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+int NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getNextShotStart(size_t k) const
+{
+    return nextShotStart_[k];
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::isShotStart(size_t k) const
+{
+    return k == 0 || nextShotStart_[k - 1] == (int)k;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::setModeSequence(
+    const core::ContinuousModeSequence& modeSequence)
+{
+    modeSequence_ = modeSequence;
+    modeSequenceInStages_ = false;
+    modeSequenceShift_ = 0;
+
+    updateShotGrid();
+    invalidateLinearization();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::setModeSequence(
+    const core::DiscreteModeSequence& modeSequence)
+{
+    modeSequence_ = core::ContinuousModeSequence(modeSequence.getStartTimeFromIdx(0));
+    for (size_t i = 0; i < modeSequence.getNumPhases(); i++)
+        modeSequence_.addPhase(modeSequence.getPhaseFromIdx(i),
+            modeSequence.getEndTimeFromIdx(i) - modeSequence.getStartTimeFromIdx(i));
+    modeSequenceInStages_ = true;
+    modeSequenceShift_ = 0;
+
+    updateShotGrid();
+    invalidateLinearization();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+const std::vector<size_t>& NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getStageModes()
+    const
+{
+    return stageModes_;
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 const typename NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::Settings_t&
 NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getSettings() const
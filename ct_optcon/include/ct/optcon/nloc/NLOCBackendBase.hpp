@@ -147,12 +147,54 @@ public:
     void changeTimeHorizon(const SCALAR& tf);
     void changeTimeHorizon(int numStages);
 
+    /*!
+     * \brief Shift the solution numStages stages to the front, e.g. to warm-start the next MPC iteration.
+     *
+     * The solution and the stage data (rollouts and LQ problem) are shifted in place and the last numStages stages are
+     * filled with copies of the last stage, like the default MPC warm start does with the policy.
+     *
+     * With settings.reuseShiftedLinearization, the shots whose rollout and linearization are still valid are then
+     * reused by rolloutShotsAndComputeLQApproximation(). As the MPC states the problem relative to the current time,
+     * a shifted stage k was linearized at time (k + numStages) dt, hence this requires that the cost function and the
+     * dynamics do not depend on time, e.g. through a time activation or a tracking reference.
+     */
+    void shiftHorizon(int numStages);
+
     SCALAR getTimeHorizon();
 
     int getNumSteps();
 
     int getNumStepsPerShot() const;
 
+    //! the stage at which the shot following stage k starts, or K if stage k is in the last shot
+    int getNextShotStart(size_t k) const;
+
+    //! true if a shot starts at stage k
+    bool isShotStart(size_t k) const;
+
+    //! the number of shots whose rollout and LQ approximation were reused by the last preparation of an MPC iteration
+    size_t getNumReusedShots() const;
+
+    /*!
+     * \brief Set the mode sequence of a switched system
+     *
+     * Each stage is assigned the mode active at its midpoint, i.e. the switching times are rounded to the closest
+     * stage. In multiple shooting, the shots are additionally cut at the switches, such that every shot lies within a
+     * single mode and the shots of all modes are rolled out and linearized in parallel. A
+     * core::SwitchedControlledSystem or core::SwitchedLinearSystem is then evaluated through the subsystem of the
+     * stage's mode directly, see OptconSystemInterface::setStageModes().
+     *
+     * The sequence is stated in the time of the optimal control problem and moves along with shiftHorizon(). It has
+     * to match the mode sequence of the switched system.
+     */
+    void setModeSequence(const core::ContinuousModeSequence& modeSequence);
+
+    //! set the mode sequence of a switched system, with the switches given as stage indices
+    void setModeSequence(const core::DiscreteModeSequence& modeSequence);
+
+    //! the mode of each stage, empty without a mode sequence
+    const std::vector<size_t>& getStageModes() const;
+
     /*!
      * \brief Change the initial state for the optimal control problem
      */
@@ -275,6 +317,14 @@ public:
     //! log the initial guess to Matlab
     void logInitToMatlab();
 
+    //! stream the current iteration to the binary log, if enabled by the settings
+    /*!
+      Copies the iterate, the feedback, the defects, the LQ problem and the summary of the iteration to the ring buffer
+      of a ct::core::BinaryLogger, which writes them to file on a background thread. Hence, unlike logToMatlab(), this
+      can stay enabled in production. Needs to be called after printSummary().
+    */
+    void logToBinary(const size_t& iteration);
+
     //! return the cost of the solution of the current iteration
     SCALAR getCost() const;
 
@@ -359,6 +409,15 @@ public:
     //! integrates the specified shots and computes the corresponding defects
     virtual void rolloutShots(size_t firstIndex, size_t lastIndex) = 0;
 
+    //! integrates the specified shots and builds their LQ approximation, reusing the shots which are still valid
+    /*!
+     * A shot keeps its rollout and LQ approximation if its states and controls deviate from the ones it was
+     * linearized at by no more than settings.linearizationReuseTolerance (infinity norm). The last shot is always
+     * recomputed, as is every shot of closed-loop shooting algorithms. After shiftHorizon(), the shots are only kept
+     * with settings.reuseShiftedLinearization.
+     */
+    void rolloutShotsAndComputeLQApproximation(size_t firstIndex, size_t lastIndex);
+
     //! do a single threaded rollout and defect computation of the shots - useful for line-search
     bool rolloutShotsSingleThreaded(size_t threadId,
         size_t firstIndex,
@@ -395,6 +454,19 @@ protected:
         std::atomic_bool* terminationFlag = nullptr) const;
 
 
+    //! checks if the rollout and LQ approximation of the shot starting at stage k can be reused
+    bool isShotLinearizationValid(size_t k) const;
+
+    //! marks the LQ approximation of all stages as invalid
+    void invalidateLinearization();
+
+    //! precomputes the activations of the cost terms at the stage times
+    void precomputeCostActivations();
+
+    //! assigns the stages to the modes and shots
+    void updateShotGrid();
+
+
     //! computes the defect between shot and trajectory
     /*!
      * @param k        index of the shot under consideration
@@ -416,8 +488,9 @@ protected:
 
       \param threadId the id of the worker thread
       \param k step k
+      \param linearizeDynamics if false, A and B are expected to be in the LQ problem already (see OptconSystemInterface::getAandBBatch())
     */
-    void executeLQApproximation(size_t threadId, size_t k);
+    void executeLQApproximation(size_t threadId, size_t k, bool linearizeDynamics = true);
 
 
     //! Computes the linearized general constraints at a specific point of the trajectory
@@ -432,6 +505,17 @@ protected:
     */
     void computeLinearizedConstraints(size_t threadId, size_t k);
 
+    //! Adds the curvature of the dynamics to the Hessian of the LQ problem
+    /*!
+      Adds the second derivatives of \f$ \lambda_{k+1}^T f(x_k, u_k) \f$ to Q, P and R at stage k, which turns the
+      Gauss-Newton approximation into the exact Hessian of the Lagrangian. The costates are the multipliers of the LQ
+      problem solved in the previous iteration, hence the first iteration is always Gauss-Newton.
+
+      \param threadId the id of the worker thread
+      \param k step k
+    */
+    void computeDynamicsCurvature(size_t threadId, size_t k);
+
     //! Initializes cost to go
     /*!
      * This function initializes the cost-to-go function at time K.
@@ -498,6 +582,12 @@ protected:
         scalar_t& e_tot) const;
 
     //! Check if controller with particular alpha is better
+    /*!
+     * The candidate is rolled out into the given buffers, which are resized only if the number of stages changed.
+     * If LineSearchSettings::abortOnMeritBound is set, the rollout is aborted as soon as the accumulated intermediate
+     * cost plus defect penalty exceeds meritBound. The costs of an aborted candidate remain at their maximum value,
+     * such that acceptStep() rejects it.
+     */
     void executeLineSearch(const size_t threadId,
         const scalar_t alpha,
         ct::core::StateVectorArray<STATE_DIM, SCALAR>& x_recorded,
@@ -511,7 +601,8 @@ protected:
         scalar_t& e_gen_norm,
         StateSubsteps& substepsX,
         ControlSubsteps& substepsU,
-        std::atomic_bool* terminationFlag = nullptr) const;
+        std::atomic_bool* terminationFlag = nullptr,
+        const scalar_t meritBound = std::numeric_limits<scalar_t>::max()) const;
 
 
     //! in case of line-search compute new merit and check if to accept step. Returns true if accept step
@@ -560,14 +651,23 @@ protected:
 
     int K_;                               //! the number of stages in the overall OptConProblem
     ct::core::tpl::TimeArray<SCALAR> t_;  //! the time trajectory
+
+    core::ContinuousModeSequence modeSequence_;  //! the mode sequence of a switched system, empty if not switched
+    bool modeSequenceInStages_;                  //! true if the switches of modeSequence_ are stage indices
+    int modeSequenceShift_;                      //! number of stages shifted since the mode sequence was set
+    std::vector<size_t> stageModes_;             //! the mode of each stage
+    std::vector<int> nextShotStart_;             //! the start of the shot following each stage
     StateVectorArray x_;                  //! state array variables
     StateVectorArray xShot_;              //! rolled-out state (at the end of a time step forward)
     StateVectorArray d_;                  //! defects in between end of rollouts and subsequent state decision vars
+    StateVectorArray lambda_;             //! costates of the dynamics, only used for the exact Hessian
     StateVectorArray x_prev_;             //! state array from previous iteration
     StateVectorArray x_ref_lqr_;          //! reference for lqr
+    StateVectorArray x_lin_;              //! states the LQ approximation was computed at, NaN if not valid
 
     ControlVectorArray u_ff_;       //! feed forward controls
     ControlVectorArray u_ff_prev_;  //! feed forward controls from previous iteration
+    ControlVectorArray u_lin_;      //! controls the LQ approximation was computed at, NaN if not valid
     FeedbackArray L_;               //! time-varying lqr feedback
 
     ControlVectorArray delta_u_ff_;     //! pointer to control increment
@@ -611,14 +711,28 @@ protected:
     std::vector<typename OptConProblem_t::ConstraintPtr_t> stateBoxConstraints_;
     std::vector<typename OptConProblem_t::ConstraintPtr_t> generalConstraints_;
 
+    //! per-thread buffers for the general constraint evaluation, sized in changeGeneralConstraints()
+    std::vector<Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>, Eigen::aligned_allocator<Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>>>
+        generalConstraintsEval_;
+
     //! a counter used to identify lqp problems in derived classes, i.e. for thread management in MP
     size_t lqpCounter_;
 
+    //! number of line search candidates aborted against the merit bound in the current iteration
+    mutable std::atomic<size_t> lineSearchAborts_;
+
+    //! number of shots reused by the last call to rolloutShotsAndComputeLQApproximation()
+    size_t numReusedShots_;
+
     //! The policy. currently only for returning the result, should eventually replace L_ and u_ff_ (todo)
     NLOCBackendBase::Policy_t policy_;
 
     SummaryAllIterations<SCALAR> summaryAllIterations_;
 
+    //! the binary log and its file, only opened if settings_.logToBinary is set
+    std::shared_ptr<ct::core::BinaryLogger> binaryLogger_;
+    std::string binaryLogFile_;
+
     //! if building with MATLAB support, include matfile
 #ifdef MATLAB
     matlab::MatFile matFile_;
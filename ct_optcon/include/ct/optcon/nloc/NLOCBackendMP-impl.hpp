@@ -229,6 +229,8 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::co
         this->executeLQApproximation(this->settings_.nThreads, firstIndex);
         if (this->generalConstraints_[this->settings_.nThreads] != nullptr)
             this->computeLinearizedConstraints(this->settings_.nThreads, firstIndex);
+        if (this->settings_.exactHessian && this->iteration_ > 0)
+            this->computeDynamicsCurvature(this->settings_.nThreads, firstIndex);
         return;
     }
 
@@ -303,6 +305,9 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::co
         if (this->generalConstraints_[threadId] != nullptr)
             this->computeLinearizedConstraints(threadId, KMax_ - k);  // linearize constraints backwards
 
+        if (this->settings_.exactHessian && this->iteration_ > 0)
+            this->computeDynamicsCurvature(threadId, KMax_ - k);
+
         kCompleted_++;
     }
 }
@@ -385,8 +390,7 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::ro
         }
 
         size_t kShot = (KMax_ - k);
-        if (kShot % ((size_t)this->getNumStepsPerShot()) ==
-            0)  //! only rollout when we're meeting the beginning of a shot
+        if (this->isShotStart(kShot))  //! only rollout when we're meeting the beginning of a shot
         {
 #ifdef DEBUG_PRINT_MP
             if ((k + 1) % 100 == 0)
@@ -418,6 +422,10 @@ SCALAR NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     alphaProcessed_.resize(this->settings_.lineSearchSettings.maxIterations, 0);
     lowestCostPrevious_ = this->lowestCost_;
 
+    lineSearchCandidates_.resize(this->settings_.nThreads);
+    for (LineSearchCandidate& candidate : lineSearchCandidates_)
+        candidate.resize(this->K_);
+
 #ifdef DEBUG_PRINT_MP
     std::cout << "[MP]: Waking up workers." << std::endl;
 #endif  //DEBUG_PRINT_MP
@@ -488,18 +496,12 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::li
         SCALAR defectNorm = std::numeric_limits<SCALAR>::max();
         SCALAR e_box_norm = std::numeric_limits<SCALAR>::max();
         SCALAR e_gen_norm = std::numeric_limits<SCALAR>::max();
-        ct::core::StateVectorArray<STATE_DIM, SCALAR> x_search(this->K_ + 1);
-        ct::core::StateVectorArray<STATE_DIM, SCALAR> x_shot_search(this->K_ + 1);
-        ct::core::StateVectorArray<STATE_DIM, SCALAR> defects_recorded(
-            this->K_ + 1, ct::core::StateVector<STATE_DIM, SCALAR>::Zero());
-        ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> u_recorded(this->K_);
-        typename Base::StateSubstepsPtr substepsX =
-            typename Base::StateSubstepsPtr(new typename Base::StateSubsteps(this->K_ + 1));
-        typename Base::ControlSubstepsPtr substepsU =
-            typename Base::ControlSubstepsPtr(new typename Base::ControlSubsteps(this->K_ + 1));
-
-        this->executeLineSearch(threadId, alpha, x_search, x_shot_search, defects_recorded, u_recorded,
-            intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm, *substepsX, *substepsU, &alphaBestFound_);
+
+        // roll out into the preallocated buffers of this thread, with the previous merit as bound for early abort
+        LineSearchCandidate& candidate = lineSearchCandidates_[threadId];
+        this->executeLineSearch(threadId, alpha, candidate.x, candidate.xShot, candidate.d, candidate.u,
+            intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm, *candidate.substepsX, *candidate.substepsU,
+            &alphaBestFound_, lowestCostPrevious_);
 
         lineSearchResultMutex_.lock();
         
@@ -509,8 +511,8 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::li
 
         if (stepAccepted)
         {
-            // make sure we do not alter an existing result
-            if (alphaBestFound_)
+            // make sure we do not alter an existing result, nor a larger step size accepted by another thread
+            if (alphaBestFound_ || alphaExp > alphaExpBest_)
             {
                 lineSearchResultMutex_.unlock();
                 break;
@@ -534,12 +536,12 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::li
             this->e_box_norm_ = e_box_norm;
             this->e_gen_norm_ = e_gen_norm;
             this->lowestCost_ = cost;
-            this->x_.swap(x_search);
-            this->xShot_.swap(x_shot_search);
-            this->u_ff_.swap(u_recorded);
-            this->d_.swap(defects_recorded);
-            this->substepsX_ = substepsX;
-            this->substepsU_ = substepsU;
+            this->x_.swap(candidate.x);
+            this->xShot_.swap(candidate.xShot);
+            this->u_ff_.swap(candidate.u);
+            this->d_.swap(candidate.d);
+            this->substepsX_.swap(candidate.substepsX);
+            this->substepsU_.swap(candidate.substepsU);
         }
         else
         {
@@ -106,6 +106,33 @@ private:
     //! wrapper method for nice debug printing
     void printString(const std::string& text);
 
+    //! preallocated trajectories of a line search candidate, swapped with the solution when the step is accepted
+    struct LineSearchCandidate
+    {
+        //! (re-)allocate the buffers for K stages, does nothing if they are already sized accordingly
+        void resize(int K)
+        {
+            x.resize(K + 1);
+            xShot.resize(K + 1);
+            d.resize(K + 1);
+            u.resize(K);
+
+            if (!substepsX)
+                substepsX = typename Base::StateSubstepsPtr(new typename Base::StateSubsteps(K + 1));
+            if (!substepsU)
+                substepsU = typename Base::ControlSubstepsPtr(new typename Base::ControlSubsteps(K + 1));
+            substepsX->resize(K + 1);
+            substepsU->resize(K + 1);
+        }
+
+        ct::core::StateVectorArray<STATE_DIM, SCALAR> x;
+        ct::core::StateVectorArray<STATE_DIM, SCALAR> xShot;
+        ct::core::StateVectorArray<STATE_DIM, SCALAR> d;
+        ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> u;
+        typename Base::StateSubstepsPtr substepsX;
+        typename Base::ControlSubstepsPtr substepsU;
+    };
+
     std::vector<std::thread> workerThreads_;
     std::atomic_bool workersActive_;
     std::atomic_int workerTask_;
@@ -137,6 +164,9 @@ private:
     size_t KMin_;
 
     SCALAR lowestCostPrevious_;
+
+    //! one line search candidate per worker thread
+    std::vector<LineSearchCandidate> lineSearchCandidates_;
 };
 
 
@@ -42,12 +42,21 @@ void NLOCBackendST<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::co
     if (lastIndex == static_cast<size_t>(this->K_) - 1)
         this->initializeCostToGo();
 
+    // linearize the dynamics of all stages at once, such that the discretization can run in parallel
+    this->systemInterface_->setSubstepTrajectoryReference(
+        this->substepsX_, this->substepsU_, this->settings_.nThreads);
+    this->systemInterface_->getAandBBatch(this->x_, this->u_ff_, this->xShot_, firstIndex, lastIndex,
+        this->settings_.K_sim, this->lqocProblem_->A_, this->lqocProblem_->B_, this->settings_.nThreads);
+
     for (size_t k = firstIndex; k <= lastIndex; k++)
     {
-        this->executeLQApproximation(this->settings_.nThreads, k);
+        this->executeLQApproximation(this->settings_.nThreads, k, false);
 
         if (this->generalConstraints_[this->settings_.nThreads] != nullptr)
             this->computeLinearizedConstraints(this->settings_.nThreads, k);
+
+        if (this->settings_.exactHessian && this->iteration_ > 0)
+            this->computeDynamicsCurvature(this->settings_.nThreads, k);
     }
 }
 
@@ -55,7 +64,7 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, type
 void NLOCBackendST<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::rolloutShots(size_t firstIndex,
     size_t lastIndex)
 {
-    for (size_t k = firstIndex; k <= lastIndex; k = k + this->getNumStepsPerShot())
+    for (size_t k = firstIndex; k <= lastIndex; k = this->getNextShotStart(k))
     {
         // rollout the shot
         this->rolloutSingleShot(this->settings_.nThreads, k, this->u_ff_, this->x_, this->x_ref_lqr_, this->xShot_,
@@ -77,6 +86,16 @@ SCALAR NLOCBackendST<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     this->lx_norm_ = 0.0;
     this->lu_norm_ = 0.0;
 
+    // candidate buffers, shared by all trials as the line search stops at the first accepted step
+    ct::core::StateVectorArray<STATE_DIM, SCALAR> x_search(this->K_ + 1);
+    ct::core::StateVectorArray<STATE_DIM, SCALAR> x_shot_search(this->K_ + 1);
+    ct::core::StateVectorArray<STATE_DIM, SCALAR> defects_recorded(this->K_ + 1);
+    ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> u_recorded(this->K_);
+
+    typename Base::StateSubstepsPtr substepsX =
+        typename Base::StateSubstepsPtr(new typename Base::StateSubsteps(this->K_ + 1));
+    typename Base::ControlSubstepsPtr substepsU =
+        typename Base::ControlSubstepsPtr(new typename Base::ControlSubsteps(this->K_ + 1));
 
     while (iterations < this->settings_.lineSearchSettings.maxIterations)
     {
@@ -93,20 +112,10 @@ SCALAR NLOCBackendST<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         SCALAR e_box_norm = std::numeric_limits<SCALAR>::max();
         SCALAR e_gen_norm = std::numeric_limits<SCALAR>::max();
 
-        ct::core::StateVectorArray<STATE_DIM, SCALAR> x_search(this->K_ + 1);
-        ct::core::StateVectorArray<STATE_DIM, SCALAR> x_shot_search(this->K_ + 1);
-        ct::core::StateVectorArray<STATE_DIM, SCALAR> defects_recorded(
-            this->K_ + 1, ct::core::StateVector<STATE_DIM, SCALAR>::Zero());
-        ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> u_recorded(this->K_);
-
-        typename Base::StateSubstepsPtr substepsX =
-            typename Base::StateSubstepsPtr(new typename Base::StateSubsteps(this->K_ + 1));
-        typename Base::ControlSubstepsPtr substepsU =
-            typename Base::ControlSubstepsPtr(new typename Base::ControlSubsteps(this->K_ + 1));
-
-
+        // candidates which provably cannot beat the current merit are aborted early
         this->executeLineSearch(this->settings_.nThreads, alpha, x_search, x_shot_search, defects_recorded, u_recorded,
-            intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm, *substepsX, *substepsU);
+            intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm, *substepsX, *substepsU, nullptr,
+            this->lowestCost_);
 
         // compute new merit and check for step acceptance
         bool stepAccepted =
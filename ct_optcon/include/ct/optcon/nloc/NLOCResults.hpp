@@ -42,6 +42,9 @@ struct SummaryAllIterations
     //! smallest eigenvalues
     std::vector<SCALAR> smallestEigenvalues;
 
+    //! number of line search candidates aborted early against the merit bound
+    std::vector<size_t> lineSearchAborts;
+
     //! print summary of the last iteration with desired numeric precision
     template <int NUM_PRECISION = 12>
     void printSummaryLastIteration()
@@ -84,6 +87,7 @@ struct SummaryAllIterations
         matFile_.put("merits", merits);
         matFile_.put("stepSizes", stepSizes);
         matFile_.put("smallestEigenvalues", smallestEigenvalues);
+        matFile_.put("lineSearchAborts", lineSearchAborts);
         matFile_.close();
 #endif
     }
@@ -51,7 +51,7 @@ void MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>:
     this->backend_->checkProblem();
 
     int K = this->backend_->getNumSteps();
-    int K_shot = this->backend_->getNumStepsPerShot();
+    int K_shot = this->backend_->getNextShotStart(0);  // the length of the first shot
 
     // if first iteration, compute shots and rollout and cost!
     if (this->backend_->iteration() == 0)
@@ -91,7 +91,7 @@ void MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>:
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 bool MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::finishIteration()
 {
-    int K_shot = this->backend_->getNumStepsPerShot();
+    int K_shot = this->backend_->getNextShotStart(0);  // the length of the first shot
 
     bool debugPrint = this->backend_->getSettings().debugPrint;
 
@@ -148,6 +148,7 @@ bool MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>:
 
 
     this->backend_->printSummary();
+    this->backend_->logToBinary(this->backend_->iteration());
 
 #ifdef MATLAB_FULL_LOG
     this->backend_->logToMatlab(this->backend_->iteration());
@@ -176,20 +177,19 @@ void MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>:
     this->backend_->checkProblem();
 
     int K = this->backend_->getNumSteps();
-    int K_shot = this->backend_->getNumStepsPerShot();
+    int K_shot = this->backend_->getNextShotStart(0);  // the length of the first shot
 
     this->backend_->resetDefects();
 
-    this->backend_->rolloutShots(K_shot, K - 1);
-
     auto start = std::chrono::steady_clock::now();
     this->backend_->setInputBoxConstraintsForLQOCProblem();
     this->backend_->setStateBoxConstraintsForLQOCProblem();
-    this->backend_->computeLQApproximation(K_shot, K - 1);
+    //! shots which are still valid after a horizon shift are not integrated and linearized again
+    this->backend_->rolloutShotsAndComputeLQApproximation(K_shot, K - 1);
     auto end = std::chrono::steady_clock::now();
     auto diff = end - start;
     if (debugPrint)
-        std::cout << "[MultipleShooting-MPC]: computing LQ approximation from index " << K_shot << " to N-1 took "
+        std::cout << "[MultipleShooting-MPC]: rollout and LQ approximation from index " << K_shot << " to N-1 took "
                   << std::chrono::duration<double, std::milli>(diff).count() << " ms" << std::endl;
 
     if (debugPrint)
@@ -216,7 +216,7 @@ void MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>:
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 bool MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::finishMPCIteration()
 {
-    int K_shot = this->backend_->getNumStepsPerShot();
+    int K_shot = this->backend_->getNextShotStart(0);  // the length of the first shot
 
     bool debugPrint = this->backend_->getSettings().debugPrint;
 
@@ -273,6 +273,7 @@ bool MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>:
     }
 
     this->backend_->printSummary();
+    this->backend_->logToBinary(this->backend_->iteration());
 
 #ifdef MATLAB_FULL_LOG
     this->backend_->logToMatlab(this->backend_->iteration());
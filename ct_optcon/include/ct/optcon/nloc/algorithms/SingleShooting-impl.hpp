@@ -122,6 +122,7 @@ bool SingleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::f
                   << std::chrono::duration<double, std::milli>(diff).count() << " ms" << std::endl;
 
     this->backend_->printSummary();
+    this->backend_->logToBinary(this->backend_->iteration());
 
 #ifdef MATLAB_FULL_LOG
     this->backend_->logToMatlab(this->backend_->iteration());
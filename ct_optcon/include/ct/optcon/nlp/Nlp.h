@@ -43,7 +43,7 @@ public:
     /**
      * @brief      Default constructor
      */
-    Nlp() = default;
+    Nlp() : hessianSparsityValid_(false) {}
     /**
      * @brief      Destructor
      */
@@ -179,15 +179,24 @@ public:
      * @param[out] jCol      The column indices of the location of the non zero
      *                       elements of the constraint jacobian
      */
-    void getSparsityPatternJacobian(const int nele_jac, MapVecXi& iRow, MapVecXi& jCol) const
+    void getSparsityPatternJacobian(const int nele_jac, MapVecXi& iRow, MapVecXi& jCol)
     {
         if (!constraints_)
             throw std::runtime_error("Error in getSparsityPatternJacobian. Constraints not initialized");
 
-        iRow.setZero();
-        jCol.setZero();
+        // the pattern only depends on the structure of the problem, hence it is generated once and reused by all
+        // subsequent solves
+        if (iRowJacobian_.rows() != nele_jac)
+        {
+            iRowJacobian_.setZero(nele_jac);
+            jColJacobian_.setZero(nele_jac);
+            MapVecXi iRowMap(iRowJacobian_.data(), nele_jac);
+            MapVecXi jColMap(jColJacobian_.data(), nele_jac);
+            constraints_->getSparsityPattern(iRowMap, jColMap, nele_jac);
+        }
 
-        constraints_->getSparsityPattern(iRow, jCol, nele_jac);
+        iRow = iRowJacobian_;
+        jCol = jColJacobian_;
     }
 
     /**
@@ -243,6 +252,9 @@ public:
     {
 #if EIGEN_VERSION_AT_LEAST(3, 3, 0)
 
+        if (hessianSparsityValid_)
+            return iRowHessian_.rows();
+
         // the sparse Eigen-matrices need to be resized properly, which happens in this step.
         // todo: need to assert that getNonZeroHessianCount() gets called before the first call to a Hessian evaluation.
         Hessian_eval_.resize(optVariables_->size(), optVariables_->size());
@@ -294,6 +306,8 @@ public:
         iRowHessian_ = Eigen::Map<Eigen::VectorXi>(iRowHessianStdVec.data(), iRowHessianStdVec.size(), 1);
         jColHessian_ = Eigen::Map<Eigen::VectorXi>(jColHessianStdVec.data(), jColHessianStdVec.size(), 1);
 
+        hessianSparsityValid_ = true;
+
         // the number of non-zero elements is equal to the number rows
         size_t nonZerosHessian = iRowHessian_.rows();
         return nonZerosHessian;
@@ -506,6 +520,11 @@ protected:
 
     //! combined Hessian sparsity pattern gets stored here
     Eigen::VectorXi iRowHessian_, jColHessian_;
+    //! the structure of the problem is fixed at construction, hence the Hessian sparsity pattern is generated once
+    bool hessianSparsityValid_;
+
+    //! cached sparsity pattern of the constraint Jacobian
+    Eigen::VectorXi iRowJacobian_, jColJacobian_;
 };
 }  // namespace tpl
 
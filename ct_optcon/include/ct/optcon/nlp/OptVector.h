@@ -63,6 +63,8 @@ public:
      */
     void resizeConstraintVars(size_t m)
     {
+        lambda_.resize(m);
+        lambda_.setZero();
         zMul_.resize(m + 1);
         zMul_.setZero();
         zState_.resize(m + 1);
@@ -152,6 +152,9 @@ private:
     std::shared_ptr<Ipopt::IpoptApplication> ipoptApp_; /*!< A pointer to ipopt*/
     Ipopt::ApplicationReturnStatus status_;             /*!< The return status of IPOPT*/
     IpoptSettings settings_;                            /*!< Contains the IPOPT settings*/
+    bool appInitialized_; /*!< Indicates whether the IPOPT application is initialized*/
+    bool hasSolved_;      /*!< Indicates whether IPOPT holds the data structures of a previous solve*/
+    bool warmStart_;      /*!< Indicates whether the next solve reuses the data structures of the previous one*/
 };
 
 #include "implementation/IpoptSolver-impl.h"
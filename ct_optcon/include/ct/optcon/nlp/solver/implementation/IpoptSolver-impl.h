@@ -10,7 +10,11 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 template <typename SCALAR>
 IpoptSolver<SCALAR>::IpoptSolver(std::shared_ptr<tpl::Nlp<SCALAR>> nlp, const NlpSolverSettings& settings)
-    : BASE(nlp, settings), settings_(BASE::settings_.ipoptSettings_)
+    : BASE(nlp, settings),
+      settings_(BASE::settings_.ipoptSettings_),
+      appInitialized_(false),
+      hasSolved_(false),
+      warmStart_(false)
 {
     //Constructor arguments
     //Argument 1: create console output
@@ -64,12 +68,21 @@ void IpoptSolver<SCALAR>::setSolverOptions()
 template <typename SCALAR>
 bool IpoptSolver<SCALAR>::solve()
 {
-    status_ = ipoptApp_->Initialize();
-    if (!(status_ == Ipopt::Solve_Succeeded) && !this->isInitialized_)
-        throw(std::runtime_error("NLP initialization failed"));
+    if (!appInitialized_)
+    {
+        status_ = ipoptApp_->Initialize();
+        if (!(status_ == Ipopt::Solve_Succeeded) && !this->isInitialized_)
+            throw(std::runtime_error("NLP initialization failed"));
+        appInitialized_ = true;
+    }
 
-    // Ask Ipopt to solve the problem
-    status_ = ipoptApp_->OptimizeTNLP(this);
+    // Ask Ipopt to solve the problem. When warm starting, the structure of the NLP is the same as in the previous
+    // solve, hence Ipopt reuses its data structures instead of setting them up again.
+    if (warmStart_ && hasSolved_)
+        status_ = ipoptApp_->ReOptimizeTNLP(this);
+    else
+        status_ = ipoptApp_->OptimizeTNLP(this);
+    hasSolved_ = true;
 
     if (status_ == Ipopt::Solve_Succeeded || status_ == Ipopt::Solved_To_Acceptable_Level)
     {
@@ -107,6 +120,7 @@ void IpoptSolver<SCALAR>::prepareWarmStart(size_t maxIterations)
     ipoptApp_->Options()->SetNumericValue("warm_start_mult_bound_push", 1e-9);
     ipoptApp_->Options()->SetIntegerValue("max_iter", (int)maxIterations);
     ipoptApp_->Options()->SetStringValue("derivative_test", "none");
+    warmStart_ = true;
 }
 
 template <typename SCALAR>
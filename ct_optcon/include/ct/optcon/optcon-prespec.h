@@ -41,6 +41,9 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "lqr/riccati/DARE.hpp"
 #include "lqr/FHDTLQR.hpp"
 #include "lqr/LQR.hpp"
+#include "lqr/GainScheduleTable.hpp"
+#include "lqr/GainScheduledLQR.hpp"
+#include "lqr/GainScheduledController.hpp"
 
 #include "dms/dms.h"
 
@@ -31,12 +31,17 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "solver/OptConSolver.h"
 #include "solver/lqp/HPIPMInterface.hpp"
 #include "solver/lqp/GNRiccatiSolver.hpp"
+#include "solver/qp/ActiveSetQPSolver.hpp"
+#include "solver/qp/HierarchicalQPSolver.hpp"
 #include "solver/NLOptConSolver.hpp"
 
 #include "lqr/riccati/CARE.hpp"
 #include "lqr/riccati/DARE.hpp"
 #include "lqr/FHDTLQR.hpp"
 #include "lqr/LQR.hpp"
+#include "lqr/GainScheduleTable.hpp"
+#include "lqr/GainScheduledLQR.hpp"
+#include "lqr/GainScheduledController.hpp"
 
 #include "dms/dms.h"
 
@@ -61,12 +66,15 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include "solver/lqp/GNRiccatiSolver-impl.hpp"
 #include "solver/lqp/HPIPMInterface-impl.hpp"
+#include "solver/qp/ActiveSetQPSolver-impl.hpp"
+#include "solver/qp/HierarchicalQPSolver-impl.hpp"
 #include "solver/NLOptConSolver-impl.hpp"
 
 #include "lqr/riccati/CARE-impl.hpp"
 #include "lqr/riccati/DARE-impl.hpp"
 #include "lqr/FHDTLQR-impl.hpp"
 #include "lqr/LQR-impl.hpp"
+#include "lqr/GainScheduledLQR-impl.hpp"
 
 #include "nloc/NLOCBackendBase-impl.hpp"
 #include "nloc/NLOCBackendST-impl.hpp"
@@ -88,6 +88,48 @@ void LQOCProblem<STATE_DIM, CONTROL_DIM, SCALAR>::changeNumStages(int N)
 }
 
 
+template <int STATE_DIM, int CONTROL_DIM, typename SCALAR>
+void LQOCProblem<STATE_DIM, CONTROL_DIM, SCALAR>::shiftStages(int N)
+{
+    if (N < 0)
+        throw std::runtime_error("LQOCProblem: cannot shift stages about a negative number.");
+
+    A_.shiftFront(N);
+    B_.shiftFront(N);
+    b_.shiftFront(N);
+
+    P_.shiftFront(N);
+    q_.shiftFront(N);
+    qv_.shiftFront(N);
+    Q_.shiftFront(N);
+
+    rv_.shiftFront(N);
+    R_.shiftFront(N);
+
+    x_lb_.shiftFront(N);
+    x_ub_.shiftFront(N);
+    x_I_.shiftFront(N);
+    u_lb_.shiftFront(N);
+    u_ub_.shiftFront(N);
+    u_I_.shiftFront(N);
+
+    d_lb_.shiftFront(N);
+    d_ub_.shiftFront(N);
+    C_.shiftFront(N);
+    D_.shiftFront(N);
+
+    // the constraint counts are plain std::vectors
+    for (std::vector<int>* counts : {&nbx_, &nbu_, &ng_})
+    {
+        if (counts->empty())
+            continue;
+        const size_t n = std::min((size_t)N, counts->size() - 1);
+        std::move(counts->begin() + n, counts->end(), counts->begin());
+        std::fill(counts->end() - n, counts->end(), *(counts->end() - n - 1));
+    }
+}
+
+
 template <int STATE_DIM, int CONTROL_DIM, typename SCALAR>
 void LQOCProblem<STATE_DIM, CONTROL_DIM, SCALAR>::setZero(const int& nGenConstr)
 {
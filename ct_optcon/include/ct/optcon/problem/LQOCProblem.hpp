@@ -90,6 +90,14 @@ public:
     //! change the number of discrete time steps in the LQOCP
     void changeNumStages(int N);
 
+    /*!
+     * @brief shift all stages N positions to the front, keeping the number of stages
+     *
+     * The last N stages are filled with copies of the terminal stage (or last intermediate stage respectively) and are
+     * meant to be overwritten.
+     */
+    void shiftStages(int N);
+
     /*!
      * @brief set all member variables to zero
      * @param nGenConstr by default, we resize the general constraint containers to zero
@@ -49,6 +49,7 @@ struct LineSearchSettings
           alpha_max(1.0),
           n_alpha(0.5),
           armijo_parameter(0.01),
+          abortOnMeritBound(false),
           debugPrint(false)
     {
     }
@@ -63,6 +64,8 @@ struct LineSearchSettings
     double
         n_alpha; /*!< Factor by which the step size alpha gets scaled after each iteration. Usually 0.5 is a good value. */
     double armijo_parameter; /*!< "Control Parameter" in Armijo line search condition. */
+    bool abortOnMeritBound;  /*!< Abort candidate rollouts as soon as their partial merit exceeds the merit to beat.
+                                  Only valid for non-negative intermediate and terminal costs. */
     bool debugPrint;         /*!< Print out debug information during line-search*/
 
 
@@ -78,6 +81,7 @@ struct LineSearchSettings
         std::cout << "alpha_max:\t" << alpha_max << std::endl;
         std::cout << "n_alpha:\t" << n_alpha << std::endl;
         std::cout << "armijo_parameter:\t" << armijo_parameter << std::endl;
+        std::cout << "abortOnMeritBound:\t" << abortOnMeritBound << std::endl;
         std::cout << "debugPrint:\t" << debugPrint << std::endl;
         std::cout << "              =======" << std::endl;
         std::cout << std::endl;
@@ -138,6 +142,13 @@ struct LineSearchSettings
         {
         }
 
+        try
+        {
+            abortOnMeritBound = pt.get<bool>(ns + ".abortOnMeritBound");
+        } catch (...)
+        {
+        }
+
         if (verbose)
         {
             std::cout << "Loaded line search settings from " << filename << ": " << std::endl;
@@ -242,13 +253,18 @@ public:
           max_iterations(100),
           fixedHessianCorrection(false),
           recordSmallestEigenvalue(false),
+          exactHessian(false),
           nThreads(4),
           nThreadsEigen(4),
+          nThreadsDiscretization(1),
+          reuseShiftedLinearization(false),
+          linearizationReuseTolerance(0.0),
           lineSearchSettings(),
           debugPrint(false),
           printSummary(true),
           useSensitivityIntegrator(false),
-          logToMatlab(false)
+          logToMatlab(false),
+          logToBinary(false)
     {
     }
 
@@ -269,15 +285,20 @@ public:
     int max_iterations;  //! the maximum admissible number of NLOptCon main iterations \warning make sure to select this number high enough allow for convergence
     bool fixedHessianCorrection;    //! perform Hessian regularization by incrementing the eigenvalues by epsilon.
     bool recordSmallestEigenvalue;  //! save the smallest eigenvalue of the Hessian
+    bool exactHessian;  //! add the curvature of the dynamics to the Hessian of the LQ problem (SQP), requires GNRiccati
     int nThreads;                   //! number of threads, for MP version
     size_t
         nThreadsEigen;  //! number of threads for eigen parallelization (applies both to MP and ST) Note. in order to activate Eigen parallelization, compile with '-fopenmp'
+    size_t nThreadsDiscretization;  //! number of threads discretizing the linearizations in the ST version (BACKWARD_EULER, TUSTIN, MATRIX_EXPONENTIAL)
+    bool reuseShiftedLinearization;      //! keep the linearization of shifted MPC shots, for time-invariant problems
+    double linearizationReuseTolerance;  //! max. deviation (inf-norm) for which a shifted MPC shot keeps its linearization
     LineSearchSettings lineSearchSettings;  //! the line search settings
     LQOCSolverSettings lqoc_solver_settings;
     bool debugPrint;
     bool printSummary;
     bool useSensitivityIntegrator;
     bool logToMatlab;  //! log to matlab (true/false)
+    bool logToBinary;  //! stream every iteration asynchronously to the binary log <loggingPrefix>Log.ctlog (true/false)
 
 
     //! compute the number of discrete time steps for an arbitrary input time interval
@@ -325,14 +346,19 @@ public:
         std::cout << "merit function rho constraints:\t" << meritFunctionRhoConstraints << std::endl;
         std::cout << "fixedHessianCorrection:\t" << fixedHessianCorrection << std::endl;
         std::cout << "recordSmallestEigenvalue:\t" << recordSmallestEigenvalue << std::endl;
+        std::cout << "exactHessian:\t" << exactHessian << std::endl;
         std::cout << "epsilon:\t" << epsilon << std::endl;
         std::cout << "nThreads:\t" << nThreads << std::endl;
         std::cout << "nThreadsEigen:\t" << nThreadsEigen << std::endl;
+        std::cout << "nThreadsDiscretization:\t" << nThreadsDiscretization << std::endl;
+        std::cout << "reuseShiftedLinearization:\t" << reuseShiftedLinearization << std::endl;
+        std::cout << "linearizationReuseTolerance:\t" << linearizationReuseTolerance << std::endl;
         std::cout << "loggingPrefix:\t" << loggingPrefix << std::endl;
         std::cout << "debugPrint:\t" << debugPrint << std::endl;
         std::cout << "printSummary:\t" << printSummary << std::endl;
         std::cout << "useSensitivityIntegrator:\t" << useSensitivityIntegrator << std::endl;
         std::cout << "logToMatlab:\t" << logToMatlab << std::endl;
+        std::cout << "logToBinary:\t" << logToBinary << std::endl;
         std::cout << std::endl;
 
         lineSearchSettings.print();
@@ -377,11 +403,18 @@ public:
             return false;
         }
 
-        if (nThreads > 100 || nThreadsEigen > 100)
+        if (nThreads > 100 || nThreadsEigen > 100 || nThreadsDiscretization > 100)
         {
             std::cout << "Number of threads should not exceed 100." << std::endl;
             return false;
         }
+
+        if (linearizationReuseTolerance < 0)
+        {
+            std::cout << "Invalid parameter linearizationReuseTolerance in NLOptConSettings, needs to be >= 0."
+                      << std::endl;
+            return false;
+        }
         return (lineSearchSettings.parametersOk());
     }
 
@@ -480,6 +513,12 @@ public:
         {
         }
         try
+        {
+            logToBinary = pt.get<bool>(ns + ".logToBinary");
+        } catch (...)
+        {
+        }
+        try
         {
             dt = pt.get<double>(ns + ".dt");
         } catch (...)
@@ -504,6 +543,24 @@ public:
         {
         }
         try
+        {
+            nThreadsDiscretization = pt.get<size_t>(ns + ".nThreadsDiscretization");
+        } catch (...)
+        {
+        }
+        try
+        {
+            reuseShiftedLinearization = pt.get<bool>(ns + ".reuseShiftedLinearization");
+        } catch (...)
+        {
+        }
+        try
+        {
+            linearizationReuseTolerance = pt.get<double>(ns + ".linearizationReuseTolerance");
+        } catch (...)
+        {
+        }
+        try
         {
             recordSmallestEigenvalue = pt.get<bool>(ns + ".recordSmallestEigenvalue");
         } catch (...)
@@ -515,6 +572,12 @@ public:
         } catch (...)
         {
         }
+        try
+        {
+            exactHessian = pt.get<bool>(ns + ".exactHessian");
+        } catch (...)
+        {
+        }
 
         try
         {
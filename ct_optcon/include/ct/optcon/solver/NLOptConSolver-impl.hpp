@@ -122,6 +122,22 @@ void NLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::s
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+bool NLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::shiftHorizon(const SCALAR& dt_shift)
+{
+    // same number of stages as the default policy handler shifts: the greatest one with t <= dt_shift, at most K-1
+    const core::tpl::TimeArray<SCALAR>& t = nlocBackend_->getTimeArray();
+    const int K = nlocBackend_->getNumSteps();
+
+    int numStages = 0;
+    while (numStages < K - 1 && t[numStages + 1] <= dt_shift)
+        numStages++;
+
+    nlocBackend_->shiftHorizon(numStages);
+    return true;
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 bool NLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::solve()
 {
@@ -120,6 +120,12 @@ public:
 	 */
     void setInitialGuess(const Policy_t& initialGuess) override;
 
+    /**
+	 * shift the current solution about the stages contained in dt_shift and keep the still valid rollouts and LQ
+	 * approximations of the backend
+	 */
+    virtual bool shiftHorizon(const SCALAR& dt_shift) override;
+
     /**
 	 * solve the optimal control problem
 	 * */
@@ -147,6 +147,16 @@ public:
     virtual void setInitialGuess(const Policy_t& initialGuess) = 0;
 
 
+    /*!
+	 * \brief Shift the current solution about dt_shift to the front, as warm start for the next MPC iteration.
+	 *
+	 * Solvers which support it reuse as much of the previous iteration as possible. The shifted solution corresponds to
+	 * the one of the default MPC policy handler.
+	 * @return false if not supported by the solver, then an initial guess has to be set instead.
+	 */
+    virtual bool shiftHorizon(const SCALAR& dt_shift) { return false; }
+
+
     /*!
 	 * \brief Get the time horizon the solver currently operates on.
 	 *
@@ -48,6 +48,11 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::solveSingleStage(int N)
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::configure(const NLOptConSettings& settings)
 {
+    // the fixed correction relies on a Cholesky factorization, which fails for an indefinite exact Hessian
+    if (settings.exactHessian && settings.fixedHessianCorrection)
+        throw std::runtime_error(
+            "GNRiccatiSolver: the exact Hessian requires the eigenvalue correction, disable fixedHessianCorrection.");
+
     settings_ = settings;
     H_corrFix_ = settings_.epsilon * ControlMatrix::Identity();
 }
@@ -79,6 +84,17 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::compute_lv()
 { /*no action required, already computed in backward pass*/
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeCostates()
+{
+    //! the multipliers are the gradient of the cost-to-go along the solution
+    for (int k = 0; k <= this->lqocProblem_->getNumberOfStages(); k++)
+    {
+        this->lambda_[k] = sv_[k];
+        this->lambda_[k].noalias() += S_[k] * this->x_sol_[k];
+    }
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 SCALAR GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::getSmallestEigenvalue()
 {
@@ -119,6 +135,7 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::changeNumberOfStages(int N
     this->L_.resize(N);
 
     this->x_sol_.resize(N + 1);
+    this->lambda_.resize(N + 1);
     this->u_sol_.resize(N);
 
     sv_.resize(N + 1);
@@ -148,15 +165,25 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeCostToGo(size_t k)
 {
     LQOCProblem_t& p = *this->lqocProblem_;
 
-    S_[k] = p.Q_[k];
-    S_[k].noalias() += p.A_[k].transpose() * S_[k + 1] * p.A_[k];
-    S_[k].noalias() -= this->L_[k].transpose() * Hi_[k] * this->L_[k];
+    // reuses S_{k+1} A_k from designController(k), and L^T Hi L = -L^T G. Since the cost-to-go is symmetric, only the
+    // lower triangle is computed and mirrored.
+    S_[k].template triangularView<Eigen::Lower>() = 0.5 * (p.Q_[k] + p.Q_[k].transpose());
+    S_[k].template triangularView<Eigen::Lower>() += p.A_[k].transpose() * SA_;
+    S_[k].template triangularView<Eigen::Lower>() += this->L_[k].transpose() * G_[k];
+    S_[k].template triangularView<Eigen::StrictlyUpper>() = S_[k].transpose();
 
-    S_[k] = 0.5 * (S_[k] + S_[k].transpose()).eval();
+    // the exact Hessian may be indefinite, regularize by clipping negative eigenvalues of the cost-to-go
+    if (settings_.exactHessian)
+    {
+        costToGoEigenSolver_.compute(S_[k]);
+        S_[k].noalias() = costToGoEigenSolver_.eigenvectors() *
+                          costToGoEigenSolver_.eigenvalues().cwiseMax(SCALAR(0.0)).asDiagonal() *
+                          costToGoEigenSolver_.eigenvectors().transpose();
+    }
 
     sv_[k] = p.qv_[k];
     sv_[k].noalias() += p.A_[k].transpose() * sv_[k + 1];
-    sv_[k].noalias() += p.A_[k].transpose() * S_[k + 1] * p.b_[k];
+    sv_[k].noalias() += SA_.transpose() * p.b_[k];
     sv_[k].noalias() += G_[k].transpose() * this->lv_[k];
 }
 
@@ -166,17 +193,19 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designController(size_t k)
 {
     LQOCProblem_t& p = *this->lqocProblem_;
 
+    // the products with the cost-to-go are shared by all terms of the stage
+    SA_.noalias() = S_[k + 1] * p.A_[k];
+    SB_.noalias() = S_[k + 1] * p.B_[k];
+
     gv_[k] = p.rv_[k];
     gv_[k].noalias() += p.B_[k].transpose() * sv_[k + 1];
-    gv_[k].noalias() += p.B_[k].transpose() * S_[k + 1].template selfadjointView<Eigen::Lower>() * p.b_[k];
+    gv_[k].noalias() += SB_.transpose() * p.b_[k];
 
     G_[k] = p.P_[k];
-    //G_[k].noalias() += B_[k].transpose() * S_[k+1] * A_[k];
-    G_[k].noalias() += p.B_[k].transpose() * S_[k + 1].template selfadjointView<Eigen::Lower>() * p.A_[k];
+    G_[k].noalias() += SB_.transpose() * p.A_[k];
 
     H_[k] = p.R_[k];
-    //H_[k].noalias() += B_[k].transpose() * S_[k+1] * B_[k];
-    H_[k].noalias() += p.B_[k].transpose() * S_[k + 1].template selfadjointView<Eigen::Lower>() * p.B_[k];
+    H_[k].noalias() += SB_.transpose() * p.B_[k];
 
     if (settings_.fixedHessianCorrection)
     {
@@ -185,6 +214,15 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designController(size_t k)
         else
             Hi_[k] = H_[k];
 
+        // solve for the gains with the Cholesky factor, without forming the inverse
+        HiCholesky_.compute(Hi_[k]);
+
+        // calculate FB gain update
+        this->L_[k] = -HiCholesky_.solve(G_[k]);
+
+        // calculate FF update
+        this->lv_[k] = -HiCholesky_.solve(gv_[k]);
+
         if (settings_.recordSmallestEigenvalue)
         {
             // compute eigenvalues with eigenvectors enabled
@@ -199,31 +237,25 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designController(size_t k)
             // make D positive semi-definite (as described in IV. B.)
             D.diagonal() = lambda.cwiseMax(settings_.epsilon);
 
-            // reconstruct H
-            ControlMatrix Hi_regular = V * D * V.transpose();
-
             // invert D
             ControlMatrix D_inverse = ControlMatrix::Zero();
             // eigenvalue-wise inversion
             D_inverse.diagonal() = -1.0 * D.diagonal().cwiseInverse();
-            ControlMatrix Hi_inverse_regular = V * D_inverse * V.transpose();
+            const ControlMatrix Hi_inverse_eigen = V * D_inverse * V.transpose();
 
-            if (!Hi_inverse_[k].isApprox(Hi_inverse_regular, 1e-4))
+            if (!this->L_[k].isApprox(Hi_inverse_eigen * G_[k], 1e-4))
             {
-                std::cout << "warning, inverses not identical at " << k << std::endl;
-                std::cout << "Hi_inverse_fixed - Hi_inverse_regular: " << std::endl
-                          << Hi_inverse_[k] - Hi_inverse_regular << std::endl
+                std::cout << "warning, gains of fixed and eigenvalue correction not identical at " << k << std::endl;
+                std::cout << "L_fixed - L_regular: " << std::endl
+                          << this->L_[k] - Hi_inverse_eigen * G_[k] << std::endl
                           << std::endl;
             }
         }
 
-        Hi_inverse_[k] = -Hi_[k].template selfadjointView<Eigen::Lower>().llt().solve(ControlMatrix::Identity());
-
-        // calculate FB gain update
-        this->L_[k].noalias() = Hi_inverse_[k].template selfadjointView<Eigen::Lower>() * G_[k];
-
-        // calculate FF update
-        this->lv_[k].noalias() = Hi_inverse_[k].template selfadjointView<Eigen::Lower>() * gv_[k];
+#ifdef MATLAB_FULL_LOG
+        // the gains do not require the inverse, it is only formed for the log
+        Hi_inverse_[k] = -HiCholesky_.solve(ControlMatrix::Identity());
+#endif
     }
     else
     {
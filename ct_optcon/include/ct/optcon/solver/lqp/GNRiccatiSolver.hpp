@@ -58,6 +58,8 @@ public:
 
     virtual void compute_lv() override;
 
+    virtual void computeCostates() override;
+
     virtual SCALAR getSmallestEigenvalue() override;
 
 protected:
@@ -90,12 +92,20 @@ protected:
     StateVectorArray sv_;
     StateMatrixArray S_;
 
+    //! products of the cost-to-go with the dynamics of the current stage, shared by designController and computeCostToGo
+    StateMatrix SA_;
+    Eigen::Matrix<SCALAR, STATE_DIM, CONTROL_DIM> SB_;
+
+    //! Cholesky factorization of the Hessian, used with the fixed Hessian correction
+    Eigen::LLT<Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM>> HiCholesky_;
+
     int N_;
 
     SCALAR smallestEigenvalue_;
 
     //! Eigenvalue solver, used for inverting the Hessian and for regularization
     Eigen::SelfAdjointEigenSolver<Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM>> eigenvalueSolver_;
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM>> costToGoEigenSolver_;
 
 //! if building with MATLAB support, include matfile
 #ifdef MATLAB_FULL_LOG
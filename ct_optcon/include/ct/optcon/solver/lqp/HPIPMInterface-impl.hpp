@@ -15,10 +15,16 @@ HPIPMInterface<STATE_DIM, CONTROL_DIM>::HPIPMInterface()
     : N_(-1),
       settings_(NLOptConSettings()),
       dim_mem_(nullptr),
+      dim_capacity_(0),
       qp_mem_(nullptr),
+      qp_capacity_(0),
       qp_sol_mem_(nullptr),
+      qp_sol_capacity_(0),
       ipm_arg_mem_(nullptr),
-      ipm_mem_(nullptr)
+      ipm_arg_capacity_(0),
+      ipm_mem_(nullptr),
+      ipm_capacity_(0),
+      nReallocations_(0)
 {
     hb0_.setZero();
     hr0_.setZero();
@@ -35,8 +41,6 @@ HPIPMInterface<STATE_DIM, CONTROL_DIM>::~HPIPMInterface()
 template <int STATE_DIM, int CONTROL_DIM>
 void HPIPMInterface<STATE_DIM, CONTROL_DIM>::initializeAndAllocate()
 {
-    freeHpipmMemory();
-
     if (settings_.lqoc_solver_settings.lqoc_debug_print)
     {
         std::cout << "HPIPM allocating memory for QP with time horizon: " << N_ << std::endl;
@@ -47,40 +51,46 @@ void HPIPMInterface<STATE_DIM, CONTROL_DIM>::initializeAndAllocate()
         }
     }
 
-    // allocate ocp dimensions
+    // the memory is only re-allocated if it is too small for the new dimensions, otherwise the HPIPM structures
+    // are re-created in place
+    bool reallocated = false;
+
+    // ocp dimensions
     dim_size_ = d_ocp_qp_dim_memsize(N_);
-    dim_mem_ = malloc(dim_size_);
+    reallocated |= reserveHpipmMemory(dim_mem_, dim_capacity_, dim_size_);
     d_ocp_qp_dim_create(N_, &dim_, dim_mem_);
     d_ocp_qp_dim_set_all(
         nx_.data(), nu_.data(), nbx_.data(), nbu_.data(), ng_.data(), nsbx_.data(), nsbu_.data(), nsg_.data(), &dim_);
 
-    // allocate ocp qp
+    // ocp qp
     int qp_size = ::d_ocp_qp_memsize(&dim_);
-    qp_mem_ = malloc(qp_size);
+    reallocated |= reserveHpipmMemory(qp_mem_, qp_capacity_, qp_size);
     ::d_ocp_qp_create(&dim_, &qp_, qp_mem_);
     ::d_ocp_qp_set_all(hA_.data(), hB_.data(), hb_.data(), hQ_.data(), hS_.data(), hR_.data(), hq_.data(), hr_.data(),
         hidxbx_.data(), hlbx_.data(), hubx_.data(), hidxbu_.data(), hlbu_.data(), hubu_.data(),  // box constraints
         hC_.data(), hD_.data(), hlg_.data(), hug_.data(),                                        // gen constraints
         hZl_.data(), hZu_.data(), hzl_.data(), hzu_.data(), hidxs_.data(), hlls_.data(), hlus_.data(), &qp_);
 
-    // allocation for solution
+    // solution
     int qp_sol_size = ::d_ocp_qp_sol_memsize(&dim_);
-    qp_sol_mem_ = malloc(qp_sol_size);
+    reallocated |= reserveHpipmMemory(qp_sol_mem_, qp_sol_capacity_, qp_sol_size);
     ::d_ocp_qp_sol_create(&dim_, &qp_sol_, qp_sol_mem_);
 
     // ipm arg
     int ipm_arg_size = ::d_ocp_qp_ipm_arg_memsize(&dim_);
-    ipm_arg_mem_ = malloc(ipm_arg_size);
+    reallocated |= reserveHpipmMemory(ipm_arg_mem_, ipm_arg_capacity_, ipm_arg_size);
     ::d_ocp_qp_ipm_arg_create(&dim_, &arg_, ipm_arg_mem_);
 
     ::d_ocp_qp_ipm_arg_set_default(mode_, &arg_);
     ::d_ocp_qp_ipm_arg_set_iter_max(&settings_.lqoc_solver_settings.num_lqoc_iterations, &arg_);
 
-    // create workspace
+    // workspace
     int ipm_size = ::d_ocp_qp_ipm_ws_memsize(&dim_, &arg_);
-    ipm_mem_ = malloc(ipm_size);
+    reallocated |= reserveHpipmMemory(ipm_mem_, ipm_capacity_, ipm_size);
     ::d_ocp_qp_ipm_ws_create(&dim_, &arg_, &workspace_, ipm_mem_);
 
+    if (reallocated)
+        nReallocations_++;
 
     if (settings_.lqoc_solver_settings.lqoc_debug_print)
     {
@@ -88,9 +98,64 @@ void HPIPMInterface<STATE_DIM, CONTROL_DIM>::initializeAndAllocate()
         std::cout << "HPIPM qp_sol_size: " << qp_sol_size << std::endl;
         std::cout << "HPIPM ipm_arg_size: " << ipm_arg_size << std::endl;
         std::cout << "HPIPM ipm_size: " << ipm_size << std::endl;
+        std::cout << "HPIPM memory re-allocations: " << nReallocations_ << std::endl;
     }
 }
 
+template <int STATE_DIM, int CONTROL_DIM>
+void HPIPMInterface<STATE_DIM, CONTROL_DIM>::reserve(const int N, const int ngMax)
+{
+    // dimensions of the fully constrained problem
+    std::vector<int> nx(N + 1, STATE_DIM), nu(N + 1, CONTROL_DIM), nbx(N + 1, STATE_DIM), nbu(N + 1, CONTROL_DIM),
+        ng(N + 1, ngMax), ns(N + 1, 0);
+    nx[0] = 0;
+    nbx[0] = 0;
+    nu[N] = 0;
+    nbu[N] = 0;
+
+    std::vector<char> dim_mem(d_ocp_qp_dim_memsize(N));
+    struct d_ocp_qp_dim dim;
+    d_ocp_qp_dim_create(N, &dim, dim_mem.data());
+    d_ocp_qp_dim_set_all(nx.data(), nu.data(), nbx.data(), nbu.data(), ng.data(), ns.data(), ns.data(), ns.data(), &dim);
+
+    std::vector<char> arg_mem(::d_ocp_qp_ipm_arg_memsize(&dim));
+    struct d_ocp_qp_ipm_arg arg;
+    ::d_ocp_qp_ipm_arg_create(&dim, &arg, arg_mem.data());
+    ::d_ocp_qp_ipm_arg_set_default(mode_, &arg);
+
+    bool reallocated = false;
+    reallocated |= reserveHpipmMemory(dim_mem_, dim_capacity_, d_ocp_qp_dim_memsize(N));
+    reallocated |= reserveHpipmMemory(qp_mem_, qp_capacity_, ::d_ocp_qp_memsize(&dim));
+    reallocated |= reserveHpipmMemory(qp_sol_mem_, qp_sol_capacity_, ::d_ocp_qp_sol_memsize(&dim));
+    reallocated |= reserveHpipmMemory(ipm_arg_mem_, ipm_arg_capacity_, ::d_ocp_qp_ipm_arg_memsize(&dim));
+    reallocated |= reserveHpipmMemory(ipm_mem_, ipm_capacity_, ::d_ocp_qp_ipm_ws_memsize(&dim, &arg));
+
+    if (reallocated)
+        nReallocations_++;
+
+    // the HPIPM structures need to be re-created on the new memory
+    if (reallocated && N_ > 0)
+        initializeAndAllocate();
+}
+
+template <int STATE_DIM, int CONTROL_DIM>
+size_t HPIPMInterface<STATE_DIM, CONTROL_DIM>::getNumberOfReallocations() const
+{
+    return nReallocations_;
+}
+
+template <int STATE_DIM, int CONTROL_DIM>
+bool HPIPMInterface<STATE_DIM, CONTROL_DIM>::reserveHpipmMemory(void*& memory, int& capacity, const int size)
+{
+    if (size <= capacity)
+        return false;
+
+    free(memory);
+    memory = malloc(size);
+    capacity = size;
+    return true;
+}
+
 template <int STATE_DIM, int CONTROL_DIM>
 void HPIPMInterface<STATE_DIM, CONTROL_DIM>::freeHpipmMemory()
 {
@@ -104,6 +169,11 @@ void HPIPMInterface<STATE_DIM, CONTROL_DIM>::freeHpipmMemory()
     qp_sol_mem_ = nullptr;
     ipm_arg_mem_ = nullptr;
     ipm_mem_ = nullptr;
+    dim_capacity_ = 0;
+    qp_capacity_ = 0;
+    qp_sol_capacity_ = 0;
+    ipm_arg_capacity_ = 0;
+    ipm_capacity_ = 0;
 }
 
 
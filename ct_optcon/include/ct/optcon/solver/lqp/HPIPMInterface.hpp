@@ -100,9 +100,26 @@ public:
      *  - the number of stages changes
      *  - the box constraint configuration changes
      *  - the general constraint configuration changes
+     *
+     * The memory only grows: if the new dimensions fit into the memory allocated before, the HPIPM structures are
+     * re-created in place without allocating.
      */
     virtual void initializeAndAllocate() override;
 
+    /*!
+     * @brief allocate memory for the largest problem expected
+     *
+     * Sizes the HPIPM memory for N stages with box constraints on all states and inputs and ngMax general constraints
+     * per stage, such that later changes of the horizon or constraint configuration up to this size do not allocate.
+     *
+     * @param N maximum number of stages
+     * @param ngMax maximum number of general constraints per stage
+     */
+    void reserve(const int N, const int ngMax = 0);
+
+    //! the number of times the HPIPM memory had to be (re-)allocated
+    size_t getNumberOfReallocations() const;
+
     //! override this method to catch corner case with lv being incompatible with constraints
     virtual const ct::core::ControlVectorArray<CONTROL_DIM>& get_lv() override;
 
@@ -161,6 +178,9 @@ private:
     //! frees memory allocated for the HPIPM data structures
     void freeHpipmMemory();
 
+    //! makes sure the memory block holds at least size bytes, returns true if it had to be re-allocated
+    bool reserveHpipmMemory(void*& memory, int& capacity, const int size);
+
     //! horizon length
     int N_;
 
@@ -219,20 +239,27 @@ private:
     //! ocp qp dimensions
     int dim_size_;
     void* dim_mem_;
+    int dim_capacity_;
     struct d_ocp_qp_dim dim_;
 
     void* qp_mem_;
+    int qp_capacity_;
     struct d_ocp_qp qp_;
 
     void* qp_sol_mem_;
+    int qp_sol_capacity_;
     struct d_ocp_qp_sol qp_sol_;
 
     void* ipm_arg_mem_;
+    int ipm_arg_capacity_;
     struct d_ocp_qp_ipm_arg arg_;
 
     // workspace
     void* ipm_mem_;
+    int ipm_capacity_;
     struct d_ocp_qp_ipm_ws workspace_;
+
+    size_t nReallocations_;  //! number of (re-)allocations of the HPIPM memory
     int hpipm_status_;  // status code after solving
 
     // todo make this a setting
@@ -94,6 +94,14 @@ public:
     //! return iLQR-style feedforward lv
     virtual const ct::core::ControlVectorArray<CONTROL_DIM, SCALAR>& get_lv() { return lv_; }
 
+    //! compute the multipliers of the dynamics constraints, requires computeStatesAndControls()
+    virtual void computeCostates()
+    {
+        throw std::runtime_error("computeCostates not available for this solver.");
+    }
+    //! return the multipliers of the dynamics constraints
+    const ct::core::StateVectorArray<STATE_DIM, SCALAR>& getSolutionCostate() { return lambda_; }
+
     //! return the smallest eigenvalue
     virtual SCALAR getSmallestEigenvalue()
     {
@@ -110,6 +118,7 @@ protected:
     core::ControlVectorArray<CONTROL_DIM, SCALAR> u_sol_;        // solution in u
     ct::core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR> L_;  // solution feedback
     ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> lv_;       // feedforward increment (iLQR-style)
+    core::StateVectorArray<STATE_DIM, SCALAR> lambda_;           // multipliers of the dynamics constraints
 };
 
 }  // namespace optcon
@@ -0,0 +1,223 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <typename SCALAR>
+ActiveSetQPSolver<SCALAR>::ActiveSetQPSolver(size_t maxIterations, SCALAR tolerance)
+    : maxIterations_(maxIterations), tolerance_(tolerance), iterations_(0)
+{
+}
+
+template <typename SCALAR>
+bool ActiveSetQPSolver<SCALAR>::solve(const MatrixXs& H,
+    const VectorXs& g,
+    const MatrixXs& E,
+    const VectorXs& e,
+    const MatrixXs& G,
+    const VectorXs& h,
+    VectorXs& y)
+{
+    const int n = H.rows();
+    const size_t nE = E.rows();
+    const size_t nG = G.rows();
+
+    if (H.cols() != n || g.size() != n || y.size() != n || E.cols() != n || G.cols() != n ||
+        (size_t)e.size() != nE || (size_t)h.size() != nG)
+        throw std::runtime_error("ActiveSetQPSolver: inconsistent problem dimensions.");
+
+    if (!isFeasible(G, h, y))
+        throw std::runtime_error("ActiveSetQPSolver: the initial guess violates the inequality constraints.");
+
+    VectorXs p(n);
+    VectorXs rW;
+    bool atMinimizer = false;  // y is the minimizer on the working set, up to round-off errors
+
+    // warm start from the minimizer on the previous working set if it is feasible, otherwise keep the constraints of
+    // the previous working set which are active at the initial guess. The previous working set may be empty, if no
+    // inequality was active at the last solution.
+    workingSet_.erase(std::remove_if(workingSet_.begin(), workingSet_.end(), [nG](size_t i) { return i >= nG; }),
+        workingSet_.end());
+
+    rW.resize(workingSet_.size());
+    for (size_t j = 0; j < workingSet_.size(); j++)
+        rW(j) = h(workingSet_[j]) - G.row(workingSet_[j]).dot(y);
+    solveEqualityConstrained(H, E, G, H * y + g, e - E * y, rW, p);
+
+    if (isFeasible(G, h, y + p))
+    {
+        y += p;
+        atMinimizer = true;
+    }
+    else
+        workingSet_.erase(std::remove_if(workingSet_.begin(), workingSet_.end(),
+                              [&](size_t i) { return std::abs(h(i) - G.row(i).dot(y)) > tolerance_; }),
+            workingSet_.end());
+
+    std::vector<bool> inWorkingSet(nG, false);
+    for (size_t i : workingSet_)
+        inWorkingSet[i] = true;
+
+    bool converged = false;
+    for (iterations_ = 0; iterations_ < maxIterations_; iterations_++)
+    {
+        rW.resize(workingSet_.size());
+        for (size_t j = 0; j < workingSet_.size(); j++)
+            rW(j) = h(workingSet_[j]) - G.row(workingSet_[j]).dot(y);
+
+        solveEqualityConstrained(H, E, G, H * y + g, e - E * y, rW, p);
+
+        const SCALAR stepTolerance = tolerance_ * (1.0 + y.template lpNorm<Eigen::Infinity>());
+        if (atMinimizer || p.template lpNorm<Eigen::Infinity>() <= stepTolerance)
+        {
+            y += p;
+            atMinimizer = false;
+
+            // optimal if all multipliers of the working set are non-negative, else drop the most negative one
+            int drop = -1;
+            SCALAR minMultiplier = -tolerance_;
+            for (size_t j = 0; j < workingSet_.size(); j++)
+            {
+                if (mu_(nE + j) < minMultiplier)
+                {
+                    minMultiplier = mu_(nE + j);
+                    drop = j;
+                }
+            }
+
+            if (drop < 0)
+            {
+                converged = true;
+                break;
+            }
+
+            inWorkingSet[workingSet_[drop]] = false;
+            workingSet_.erase(workingSet_.begin() + drop);
+        }
+        else
+        {
+            // step as far as possible along p, limited by the first blocking inequality
+            SCALAR alpha = 1.0;
+            int blocking = -1;
+            for (size_t i = 0; i < nG; i++)
+            {
+                if (inWorkingSet[i])
+                    continue;
+
+                const SCALAR Gp = G.row(i).dot(p);
+                if (Gp > tolerance_)
+                {
+                    const SCALAR alpha_i = std::max(SCALAR(0.0), (h(i) - G.row(i).dot(y)) / Gp);
+                    if (alpha_i < alpha)
+                    {
+                        alpha = alpha_i;
+                        blocking = i;
+                    }
+                }
+            }
+
+            y += alpha * p;
+
+            if (blocking >= 0)
+            {
+                inWorkingSet[blocking] = true;
+                workingSet_.push_back(blocking);
+            }
+            else
+                atMinimizer = true;
+        }
+    }
+
+    muE_ = mu_.head(nE);
+    muG_.setZero(nG);
+    for (size_t j = 0; j < workingSet_.size() && nE + j < (size_t)mu_.size(); j++)
+        muG_(workingSet_[j]) = mu_(nE + j);
+
+    return converged;
+}
+
+template <typename SCALAR>
+void ActiveSetQPSolver<SCALAR>::solveEqualityConstrained(const MatrixXs& H,
+    const MatrixXs& E,
+    const MatrixXs& G,
+    const VectorXs& c,
+    const VectorXs& rE,
+    const VectorXs& rW,
+    VectorXs& p)
+{
+    const size_t n = c.size();
+    const size_t nE = E.rows();
+    const size_t nA = nE + workingSet_.size();
+
+    At_.resize(n, nA);
+    At_.leftCols(nE) = E.transpose();
+    for (size_t j = 0; j < workingSet_.size(); j++)
+        At_.col(nE + j) = G.row(workingSet_[j]).transpose();
+
+    VectorXs r(nA);
+    r << rE, rW;
+
+    // A^T P = Q R with rank r, the first r columns of Q span the range of A^T and the others its null space Z
+    size_t rank = 0;
+    p.setZero(n);
+    if (nA > 0)
+    {
+        AtQR_.compute(At_);
+        rank = AtQR_.rank();
+        Q_ = AtQR_.householderQ();
+
+        // particular solution of A p = r in the range of A^T, redundant constraints are assumed to be consistent
+        const VectorXs rPermuted = AtQR_.colsPermutation().transpose() * r;
+        p = Q_.leftCols(rank) * AtQR_.matrixR()
+                                    .topLeftCorner(rank, rank)
+                                    .template triangularView<Eigen::Upper>()
+                                    .transpose()
+                                    .solve(rPermuted.head(rank));
+    }
+
+    // minimize over the null space of A
+    if (nA == 0)
+    {
+        reducedHessianLLT_.compute(H);
+        if (reducedHessianLLT_.info() != Eigen::Success)
+            throw std::runtime_error("ActiveSetQPSolver: the Hessian is not positive definite.");
+        p = -reducedHessianLLT_.solve(c);
+    }
+    else if (rank < n)
+    {
+        const auto Z = Q_.rightCols(n - rank);
+        reducedHessian_.noalias() = Z.transpose() * H * Z;
+        reducedHessianLLT_.compute(reducedHessian_);
+        if (reducedHessianLLT_.info() != Eigen::Success)
+            throw std::runtime_error("ActiveSetQPSolver: the Hessian is not positive definite.");
+        p -= Z * reducedHessianLLT_.solve(Z.transpose() * (c + H * p));
+    }
+
+    // the multipliers satisfy A^T mu = -(H p + c), the multipliers of redundant constraints are set to zero
+    mu_.setZero(nA);
+    if (rank > 0)
+    {
+        VectorXs muPermuted = VectorXs::Zero(nA);
+        muPermuted.head(rank) = -AtQR_.matrixR()
+                                     .topLeftCorner(rank, rank)
+                                     .template triangularView<Eigen::Upper>()
+                                     .solve(Q_.leftCols(rank).transpose() * (H * p + c));
+        mu_ = AtQR_.colsPermutation() * muPermuted;
+    }
+}
+
+template <typename SCALAR>
+bool ActiveSetQPSolver<SCALAR>::isFeasible(const MatrixXs& G, const VectorXs& h, const VectorXs& y) const
+{
+    if (G.rows() == 0)
+        return true;
+    return ((G * y - h).array() <= tolerance_ * (1.0 + h.array().abs())).all();
+}
+
+}  // namespace optcon
+}  // namespace ct
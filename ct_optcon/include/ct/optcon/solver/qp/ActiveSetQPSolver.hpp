@@ -0,0 +1,113 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \brief Warm-started primal active-set solver for small dense quadratic programs
+ *
+ * Solves the strictly convex quadratic program
+ * \f[
+ * \min_y \frac{1}{2} y^\top H y + g^\top y \quad \text{s.t.} \quad E y = e, \quad G y \leq h
+ * \f]
+ * with positive definite H, starting from a feasible point. Every iteration solves the equality-constrained problem
+ * on the current working set of active inequalities with the null-space method, based on a rank-revealing QR
+ * decomposition of the active constraints. It only requires H to be positive definite on the null space of the
+ * active constraints, stays accurate for badly conditioned H and handles linearly dependent constraints.
+ *
+ * The working set of the last solve is kept as warm start: the next solve first computes the minimizer on this working
+ * set and starts from it if it is feasible, such that a sequence of similar problems, e.g. in a controller running at
+ * a high rate, typically converges in zero or one iteration.
+ */
+template <typename SCALAR = double>
+class ActiveSetQPSolver
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, Eigen::Dynamic> MatrixXs;
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> VectorXs;
+
+    /*!
+	 * @param maxIterations maximum number of active-set iterations per solve
+	 * @param tolerance tolerance on constraint violations, multipliers and step sizes
+	 */
+    ActiveSetQPSolver(size_t maxIterations = 100, SCALAR tolerance = 1e-10);
+
+    /*!
+	 * \brief solve the quadratic program
+	 * @param H positive definite Hessian
+	 * @param g gradient
+	 * @param E equality constraint matrix with n columns, may have zero rows
+	 * @param e equality constraint right-hand side
+	 * @param G inequality constraint matrix with n columns, may have zero rows
+	 * @param h inequality constraint right-hand side
+	 * @param y feasible initial guess on input, solution on output
+	 * @return true if converged within the maximum number of iterations
+	 */
+    bool solve(const MatrixXs& H,
+        const VectorXs& g,
+        const MatrixXs& E,
+        const VectorXs& e,
+        const MatrixXs& G,
+        const VectorXs& h,
+        VectorXs& y);
+
+    //! indices of the inequalities active at the last solution, used as warm start for the next solve
+    const std::vector<size_t>& workingSet() const { return workingSet_; }
+    //! set the working set used as warm start for the next solve
+    void setWorkingSet(const std::vector<size_t>& workingSet) { workingSet_ = workingSet; }
+    //! solve the next problem without warm start
+    void resetWorkingSet() { workingSet_.clear(); }
+    //! multipliers of the equality constraints at the last solution
+    const VectorXs& equalityMultipliers() const { return muE_; }
+    //! multipliers of the inequality constraints at the last solution, zero for inactive inequalities
+    const VectorXs& inequalityMultipliers() const { return muG_; }
+    //! number of iterations of the last solve
+    size_t iterations() const { return iterations_; }
+    void setMaxIterations(size_t maxIterations) { maxIterations_ = maxIterations; }
+    void setTolerance(SCALAR tolerance) { tolerance_ = tolerance; }
+
+private:
+    /*!
+	 * solve the problem min 0.5 p^T H p + c^T p s.t. E p = r_E, G_W p = r_W for the current working set W
+	 * and store the multipliers of E and G_W
+	 */
+    void solveEqualityConstrained(const MatrixXs& H,
+        const MatrixXs& E,
+        const MatrixXs& G,
+        const VectorXs& c,
+        const VectorXs& rE,
+        const VectorXs& rW,
+        VectorXs& p);
+
+    //! check G y <= h, with tolerance
+    bool isFeasible(const MatrixXs& G, const VectorXs& h, const VectorXs& y) const;
+
+    size_t maxIterations_;
+    SCALAR tolerance_;
+
+    std::vector<size_t> workingSet_;
+    size_t iterations_;
+
+    MatrixXs At_;  //!< transposed stacked equalities and working set
+    Eigen::ColPivHouseholderQR<MatrixXs> AtQR_;
+    MatrixXs Q_;
+    MatrixXs reducedHessian_;
+    Eigen::LLT<MatrixXs> reducedHessianLLT_;
+
+    VectorXs mu_;  //!< multipliers of the equalities and the working set
+    VectorXs muE_;
+    VectorXs muG_;
+};
+
+}  // namespace optcon
+}  // namespace ct
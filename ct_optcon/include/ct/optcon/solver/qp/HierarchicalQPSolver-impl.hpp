@@ -0,0 +1,122 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <typename SCALAR>
+HierarchicalQPSolver<SCALAR>::HierarchicalQPSolver(size_t nVariables, SCALAR regularization)
+    : nVariables_(nVariables), regularization_(regularization)
+{
+}
+
+template <typename SCALAR>
+bool HierarchicalQPSolver<SCALAR>::solve(const std::vector<Task>& tasks, VectorXs& z)
+{
+    const size_t n = nVariables_;
+
+    for (const Task& task : tasks)
+    {
+        if ((task.A.rows() > 0 && (size_t)task.A.cols() != n) || task.b.size() != task.A.rows() ||
+            (task.C.rows() > 0 && (size_t)task.C.cols() != n) || task.d.size() != task.C.rows())
+            throw std::runtime_error("HierarchicalQPSolver: inconsistent task dimensions.");
+    }
+
+    if ((size_t)z.size() != n)
+        z.setZero(n);
+
+    solvers_.resize(tasks.size());
+    slacks_.resize(tasks.size());
+
+    // equalities and inequalities fixed by the levels solved so far, in the variables z, allocated for all levels
+    size_t nEqualities = 0;
+    size_t nInequalities = 0;
+    for (const Task& task : tasks)
+    {
+        nEqualities += task.A.rows();
+        nInequalities += task.C.rows();
+    }
+    Efixed_.resize(nEqualities, n);
+    eFixed_.resize(nEqualities);
+    Gfixed_.resize(nInequalities, n);
+    hFixed_.resize(nInequalities);
+
+    size_t nE = 0;  // number of fixed equalities
+    size_t nG = 0;  // number of fixed inequalities
+
+    bool converged = true;
+    for (size_t k = 0; k < tasks.size(); k++)
+    {
+        const Task& task = tasks[k];
+        const size_t nW = task.C.rows();
+        const size_t nY = n + nW;
+
+        H_.setZero(nY, nY);
+        H_.topLeftCorner(n, n).setIdentity();
+        H_.topLeftCorner(n, n) *= regularization_;
+        if (task.A.rows() > 0)
+            H_.topLeftCorner(n, n).noalias() += task.A.transpose() * task.A;
+        H_.bottomRightCorner(nW, nW).setIdentity();
+
+        g_.setZero(nY);
+        if (task.A.rows() > 0)
+            g_.head(n).noalias() = -task.A.transpose() * task.b;
+
+        E_.setZero(nE, nY);
+        E_.leftCols(n) = Efixed_.topRows(nE);
+        e_ = eFixed_.head(nE);
+
+        G_.setZero(nG + nW, nY);
+        G_.topLeftCorner(nG, n) = Gfixed_.topRows(nG);
+        h_.resize(nG + nW);
+        // the fixed inequalities hold for the solution of the previous level up to round-off errors
+        h_.head(nG) = hFixed_.head(nG).cwiseMax(Gfixed_.topRows(nG) * z);
+
+        // the solution of the previous level with the smallest feasible slack is a feasible initial guess
+        y_.resize(nY);
+        y_.head(n) = z;
+
+        if (nW > 0)
+        {
+            G_.bottomLeftCorner(nW, n) = task.C;
+            G_.bottomRightCorner(nW, nW) = -MatrixXs::Identity(nW, nW);
+            h_.tail(nW) = task.d;
+            y_.tail(nW) = (task.C * z - task.d).cwiseMax(SCALAR(0.0));
+        }
+
+        converged &= solvers_[k].solve(H_, g_, E_, e_, G_, h_, y_);
+
+        z = y_.head(n);
+        slacks_[k] = y_.tail(nW);
+
+        // fix the solution of this level for all levels of lower priority
+        if (task.A.rows() > 0)
+        {
+            Efixed_.middleRows(nE, task.A.rows()) = task.A;
+            eFixed_.segment(nE, task.A.rows()).noalias() = task.A * z;
+            nE += task.A.rows();
+        }
+        if (nW > 0)
+        {
+            Gfixed_.middleRows(nG, nW) = task.C;
+            hFixed_.segment(nG, nW) = task.d + slacks_[k].cwiseMax(SCALAR(0.0));
+            nG += nW;
+        }
+    }
+
+    return converged;
+}
+
+template <typename SCALAR>
+void HierarchicalQPSolver<SCALAR>::resetWarmStart()
+{
+    for (ActiveSetQPSolver<SCALAR>& solver : solvers_)
+        solver.resetWorkingSet();
+}
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,101 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "ActiveSetQPSolver.hpp"
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \brief Solver for a strict hierarchy of least-squares tasks with inequalities
+ *
+ * Every level k of the hierarchy is a task
+ * \f[
+ * A_k z = b_k, \quad C_k z \leq d_k
+ * \f]
+ * which is satisfied in the least-squares sense, subject to not degrading the solution of any level of higher
+ * priority. Level k is solved as the quadratic program
+ * \f[
+ * \min_{z, w} \frac{1}{2} \Vert A_k z - b_k \Vert^2 + \frac{1}{2} \Vert w \Vert^2 + \frac{\epsilon}{2} \Vert z \Vert^2
+ * \f]
+ * \f[
+ * \text{s.t.} \quad C_k z - w \leq d_k, \quad A_j z = A_j z_j^*, \quad C_j z \leq d_j + w_j^* \quad \forall j < k
+ * \f]
+ * where the slack w softens the inequalities of level k and z_j^*, w_j^* is the solution of level j. The solution of
+ * level k - 1 with the slack of its inequalities is a feasible initial guess, hence every level is solved with
+ * ActiveSetQPSolver, which keeps its working set to warm start the next solve of the hierarchy.
+ *
+ * Hard constraints are modelled as the task of highest priority. If they can be satisfied, the equalities and
+ * inequalities of level 0 hold for the solution.
+ */
+template <typename SCALAR = double>
+class HierarchicalQPSolver
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, Eigen::Dynamic> MatrixXs;
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> VectorXs;
+
+    //! a level of the hierarchy, every matrix may have zero rows
+    struct Task
+    {
+        MatrixXs A;  //!< equality task matrix
+        VectorXs b;  //!< equality task target
+        MatrixXs C;  //!< inequality task matrix
+        VectorXs d;  //!< inequality task bound
+    };
+
+    /*!
+	 * @param nVariables number of optimization variables
+	 * @param regularization weight epsilon of the damping term, keeping the Hessian of each level positive definite
+	 */
+    HierarchicalQPSolver(size_t nVariables, SCALAR regularization = 1e-9);
+
+    /*!
+	 * \brief solve the hierarchy, the first task has the highest priority
+	 * @param tasks the levels of the hierarchy
+	 * @param z the solution
+	 * @return true if all levels converged
+	 */
+    bool solve(const std::vector<Task>& tasks, VectorXs& z);
+
+    //! slack of the inequalities of a level at the last solution, zero if they are satisfied
+    const VectorXs& slack(size_t level) const { return slacks_.at(level); }
+    //! the active-set solver of a level, e.g. to access its multipliers or iterations
+    const ActiveSetQPSolver<SCALAR>& levelSolver(size_t level) const { return solvers_.at(level); }
+    //! solve the next hierarchy without warm start, e.g. if its structure changes
+    void resetWarmStart();
+
+    size_t nVariables() const { return nVariables_; }
+private:
+    size_t nVariables_;
+    SCALAR regularization_;
+
+    std::vector<ActiveSetQPSolver<SCALAR>, Eigen::aligned_allocator<ActiveSetQPSolver<SCALAR>>> solvers_;
+    std::vector<VectorXs, Eigen::aligned_allocator<VectorXs>> slacks_;
+
+    // the equalities and inequalities fixed by the levels solved so far
+    MatrixXs Efixed_;
+    VectorXs eFixed_;
+    MatrixXs Gfixed_;
+    VectorXs hFixed_;
+
+    // the problem of the current level, with variables (z, w)
+    MatrixXs H_;
+    VectorXs g_;
+    MatrixXs E_;
+    VectorXs e_;
+    MatrixXs G_;
+    VectorXs h_;
+    VectorXs y_;
+};
+
+}  // namespace optcon
+}  // namespace ct
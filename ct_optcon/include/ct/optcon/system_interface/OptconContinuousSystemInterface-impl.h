@@ -37,6 +37,8 @@ void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALA
             this->systems_.at(i), this->settings_.dt, this->settings_.integrator, this->settings_.K_sim));
         discretizers_.at(i)->initialize();
     }
+
+    setupModeDispatch();
 }
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
 void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::changeLinearSystem(
@@ -50,6 +52,28 @@ void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALA
         this->linearSystems_.at(i) = typename optConProblem_t::LinearPtr_t(lin->clone());
         sensitivity_.at(i)->setLinearSystem(this->linearSystems_.at(i));
     }
+
+    setupModeDispatch();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
+bool OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::hasNumericLinearization() const
+{
+    typedef ct::core::SystemLinearizer<STATE_DIM, CONTROL_DIM, SCALAR> Linearizer_t;
+    typedef ct::core::SwitchedLinearSystem<STATE_DIM, CONTROL_DIM, SCALAR> SwitchedLinearSystem_t;
+
+    if (std::dynamic_pointer_cast<Linearizer_t>(this->linearSystems_.front()))
+        return true;
+
+    // the modes of a switched linear system are linearized independently
+    if (auto switchedLinearSystem = std::dynamic_pointer_cast<SwitchedLinearSystem_t>(this->linearSystems_.front()))
+    {
+        for (const auto& subsystem : switchedLinearSystem->getSwitchedLinearSystems())
+            if (std::dynamic_pointer_cast<Linearizer_t>(subsystem))
+                return true;
+    }
+
+    return false;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
@@ -59,6 +83,7 @@ void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALA
     this->linearSystems_.resize(this->settings_.nThreads + 1);
     discretizers_.resize(this->settings_.nThreads + 1);
     sensitivity_.resize(this->settings_.nThreads + 1);
+    activeDiscretizers_.resize(this->settings_.nThreads + 1);
 
     for (int i = 0; i < this->settings_.nThreads + 1; i++)
     {
@@ -74,29 +99,131 @@ void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALA
             this->systems_.at(i), this->settings_.dt, this->settings_.integrator, this->settings_.K_sim));
         discretizers_.at(i)->initialize();
 
-        if (this->settings_.useSensitivityIntegrator)
+        sensitivity_.at(i) = createSensitivity(this->linearSystems_.at(i), i);
+    }
+
+    setupModeDispatch();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
+typename OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::SensitivityPtr
+OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::createSensitivity(
+    const typename optConProblem_t::LinearPtr_t& linearSystem,
+    const size_t threadId) const
+{
+    if (this->settings_.useSensitivityIntegrator)
+    {
+        if (this->settings_.integrator != ct::core::IntegrationType::EULER &&
+            this->settings_.integrator != ct::core::IntegrationType::EULERCT &&
+            this->settings_.integrator != ct::core::IntegrationType::RK4 &&
+            this->settings_.integrator != ct::core::IntegrationType::RK4CT &&
+            this->settings_.integrator != ct::core::IntegrationType::EULER_SYM)
+            throw std::runtime_error("sensitivity integrator only available for Euler and RK4 integrators");
+
+        return SensitivityPtr(
+            new ct::core::SensitivityIntegrator<STATE_DIM, CONTROL_DIM, STATE_DIM / 2, STATE_DIM / 2, SCALAR>(
+                this->settings_.getSimulationTimestep(), linearSystem, this->controller_.at(threadId),
+                this->settings_.integrator, this->settings_.timeVaryingDiscretization));
+    }
+    else
+    {
+        return SensitivityPtr(
+            new ct::core::SensitivityApproximation<STATE_DIM, CONTROL_DIM, STATE_DIM / 2, STATE_DIM / 2, SCALAR>(
+                this->settings_.dt, linearSystem, this->settings_.discretization));
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
+void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::setStageModes(
+    const std::vector<size_t>& stageModes)
+{
+    // the instances per mode cover all modes of the switched systems, hence they are only created once
+    const bool rebuild = this->stageModes_.empty() || stageModes.empty();
+    Base::setStageModes(stageModes);
+
+    if (rebuild)
+        setupModeDispatch();
+    else
+    {
+        const size_t numModes = *std::max_element(stageModes.begin(), stageModes.end()) + 1;
+        if ((!modeDiscretizers_.empty() && modeDiscretizers_.front().size() < numModes) ||
+            (!modeSensitivities_.empty() && modeSensitivities_.front().size() < numModes))
+            throw std::runtime_error("OptconContinuousSystemInterface: switched system has too few modes.");
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
+void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::setupModeDispatch()
+{
+    typedef ct::core::SwitchedControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR> SwitchedSystem_t;
+    typedef ct::core::SwitchedLinearSystem<STATE_DIM, CONTROL_DIM, SCALAR> SwitchedLinearSystem_t;
+
+    modeDiscretizers_.clear();
+    modeSensitivities_.clear();
+    std::copy(discretizers_.begin(), discretizers_.end(), activeDiscretizers_.begin());
+
+    if (this->stageModes_.empty() || this->systems_.empty())
+        return;
+
+    const size_t numModes = *std::max_element(this->stageModes_.begin(), this->stageModes_.end()) + 1;
+
+    // the subsystems of each thread's switched system are deep copies already, hence they are used directly
+    if (std::dynamic_pointer_cast<SwitchedSystem_t>(this->systems_.front()))
+    {
+        modeDiscretizers_.resize(this->settings_.nThreads + 1);
+        for (int i = 0; i < this->settings_.nThreads + 1; i++)
         {
-            if (this->settings_.integrator != ct::core::IntegrationType::EULER &&
-                this->settings_.integrator != ct::core::IntegrationType::EULERCT &&
-                this->settings_.integrator != ct::core::IntegrationType::RK4 &&
-                this->settings_.integrator != ct::core::IntegrationType::RK4CT &&
-                this->settings_.integrator != ct::core::IntegrationType::EULER_SYM)
-                throw std::runtime_error("sensitivity integrator only available for Euler and RK4 integrators");
-
-            sensitivity_.at(i) = SensitivityPtr(
-                new ct::core::SensitivityIntegrator<STATE_DIM, CONTROL_DIM, STATE_DIM / 2, STATE_DIM / 2, SCALAR>(
-                    this->settings_.getSimulationTimestep(), this->linearSystems_.at(i), this->controller_.at(i),
-                    this->settings_.integrator, this->settings_.timeVaryingDiscretization));
+            const auto& subsystems =
+                std::static_pointer_cast<SwitchedSystem_t>(this->systems_.at(i))->getSwitchedSystems();
+            if (subsystems.size() < numModes)
+                throw std::runtime_error("OptconContinuousSystemInterface: switched system has too few modes.");
+
+            for (const auto& subsystem : subsystems)
+            {
+                subsystem->setController(this->controller_.at(i));
+                modeDiscretizers_[i].push_back(system_discretizer_ptr_t(new discretizer_t(
+                    subsystem, this->settings_.dt, this->settings_.integrator, this->settings_.K_sim)));
+                modeDiscretizers_[i].back()->initialize();
+            }
         }
-        else
+    }
+
+    if (std::dynamic_pointer_cast<SwitchedLinearSystem_t>(this->linearSystems_.front()))
+    {
+        modeSensitivities_.resize(this->settings_.nThreads + 1);
+        for (int i = 0; i < this->settings_.nThreads + 1; i++)
         {
-            sensitivity_.at(i) = SensitivityPtr(
-                new ct::core::SensitivityApproximation<STATE_DIM, CONTROL_DIM, STATE_DIM / 2, STATE_DIM / 2, SCALAR>(
-                    this->settings_.dt, this->linearSystems_.at(i), this->settings_.discretization));
+            const auto& subsystems = std::static_pointer_cast<SwitchedLinearSystem_t>(this->linearSystems_.at(i))
+                                         ->getSwitchedLinearSystems();
+            if (subsystems.size() < numModes)
+                throw std::runtime_error("OptconContinuousSystemInterface: switched linear system has too few modes.");
+
+            for (const auto& subsystem : subsystems)
+                modeSensitivities_[i].push_back(createSensitivity(subsystem, i));
         }
     }
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
+const typename OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::system_discretizer_ptr_t&
+OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::getDiscretizer(const int n,
+    const size_t threadId) const
+{
+    if (modeDiscretizers_.empty())
+        return discretizers_[threadId];
+    return modeDiscretizers_[threadId][this->getStageMode(n)];
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
+const typename OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::SensitivityPtr&
+OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::getSensitivity(const int n,
+    const size_t threadId) const
+{
+    if (modeSensitivities_.empty())
+        return sensitivity_[threadId];
+    return modeSensitivities_[threadId][this->getStageMode(n)];
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
 void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::configure(
     const settings_t& settings)
@@ -116,14 +243,25 @@ void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALA
         if (!sensitivity_[i])
             break;
 
-        sensitivity_[i]->setApproximation(settings.discretization);
+        SensitivityArray sensitivities(1, sensitivity_[i]);
+        DiscretizerArray discretizers(1, discretizers_[i]);
+        if (!modeSensitivities_.empty())
+            sensitivities.insert(sensitivities.end(), modeSensitivities_[i].begin(), modeSensitivities_[i].end());
+        if (!modeDiscretizers_.empty())
+            discretizers.insert(discretizers.end(), modeDiscretizers_[i].begin(), modeDiscretizers_[i].end());
 
-        if (settings.useSensitivityIntegrator)
-            sensitivity_[i]->setTimeDiscretization(settings.getSimulationTimestep());
-        else
-            sensitivity_[i]->setTimeDiscretization(settings.dt);
+        for (const SensitivityPtr& sensitivity : sensitivities)
+        {
+            sensitivity->setApproximation(settings.discretization);
 
-        discretizers_[i]->setParameters(settings.dt, settings.K_sim);
+            if (settings.useSensitivityIntegrator)
+                sensitivity->setTimeDiscretization(settings.getSimulationTimestep());
+            else
+                sensitivity->setTimeDiscretization(settings.dt);
+        }
+
+        for (const system_discretizer_ptr_t& discretizer : discretizers)
+            discretizer->setParameters(settings.dt, settings.K_sim);
     }
 
     this->settings_ = settings;
@@ -138,7 +276,8 @@ void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALA
     const size_t threadId)
 {
     this->controller_[threadId]->setControl(control);
-    discretizers_[threadId]->propagateControlledDynamics(state, n, control, stateNext);
+    activeDiscretizers_[threadId] = getDiscretizer(n, threadId);
+    activeDiscretizers_[threadId]->propagateControlledDynamics(state, n, control, stateNext);
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
@@ -146,7 +285,7 @@ void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALA
     StateVectorArrayPtr& subStepsX,
     const size_t threadId)
 {
-    subStepsX = discretizers_[threadId]->getSubstates();
+    subStepsX = activeDiscretizers_[threadId]->getSubstates();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
@@ -154,7 +293,7 @@ void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALA
     ControlVectorArrayPtr& subStepsU,
     const size_t threadId)
 {
-    subStepsU = discretizers_[threadId]->getSubcontrols();
+    subStepsU = activeDiscretizers_[threadId]->getSubcontrols();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
@@ -164,6 +303,11 @@ void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALA
     const size_t threadId)
 {
     sensitivity_[threadId]->setSubstepTrajectoryReference(xSubsteps.get(), uSubsteps.get());
+    if (!modeSensitivities_.empty())
+    {
+        for (const SensitivityPtr& sensitivity : modeSensitivities_[threadId])
+            sensitivity->setSubstepTrajectoryReference(xSubsteps.get(), uSubsteps.get());
+    }
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
@@ -176,7 +320,43 @@ void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALA
     state_control_matrix_t& B,
     const size_t threadId)
 {
-    sensitivity_[threadId]->getAandB(x, u, x_next, n, subSteps, A, B);
+    getSensitivity(n, threadId)->getAandB(x, u, x_next, n, subSteps, A, B);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
+void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::getAandBBatch(
+    const StateVectorArray& x,
+    const ControlVectorArray& u,
+    const StateVectorArray& x_next,
+    const size_t firstIndex,
+    const size_t lastIndex,
+    size_t subSteps,
+    StateMatrixArray& A,
+    StateControlMatrixArray& B,
+    const size_t threadId)
+{
+    // discretize batches of stages with the same sensitivity
+    for (size_t batchStart = firstIndex; batchStart <= lastIndex;)
+    {
+        size_t batchEnd = lastIndex;
+        if (!modeSensitivities_.empty())
+        {
+            batchEnd = batchStart;
+            while (batchEnd < lastIndex && this->getStageMode(batchEnd + 1) == this->getStageMode(batchStart))
+                batchEnd++;
+        }
+
+        std::shared_ptr<SensitivityApproximation_t> approximation =
+            std::dynamic_pointer_cast<SensitivityApproximation_t>(getSensitivity(batchStart, threadId));
+
+        if (!approximation)
+            Base::getAandBBatch(x, u, x_next, batchStart, batchEnd, subSteps, A, B, threadId);
+        else
+            approximation->getAandBBatch(
+                x, u, x_next, batchStart, batchEnd, A, B, this->settings_.nThreadsDiscretization);
+
+        batchStart = batchEnd + 1;
+    }
 }
 
 }  // namespace optcon
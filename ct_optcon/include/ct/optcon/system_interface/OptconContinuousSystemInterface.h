@@ -49,6 +49,13 @@ public:
 
     typedef ct::core::Sensitivity<STATE_DIM, CONTROL_DIM, SCALAR> Sensitivity_t;
     typedef std::shared_ptr<Sensitivity_t> SensitivityPtr;
+    typedef ct::core::SensitivityApproximation<STATE_DIM, CONTROL_DIM, STATE_DIM / 2, STATE_DIM / 2, SCALAR>
+        SensitivityApproximation_t;
+
+    typedef typename Base::StateVectorArray StateVectorArray;
+    typedef typename Base::ControlVectorArray ControlVectorArray;
+    typedef typename Base::StateMatrixArray StateMatrixArray;
+    typedef typename Base::StateControlMatrixArray StateControlMatrixArray;
 
     typedef typename Base::StateVectorArrayPtr StateVectorArrayPtr;
     typedef typename Base::StateSubstepsPtr StateSubstepsPtr;
@@ -87,6 +94,23 @@ public:
         state_control_matrix_t& B,
         const size_t threadId) override;
 
+    //! retrieve discrete-time linear system matrices A and B for a range of stages.
+    /*!
+     * Without sensitivity integrator, the linearizations are discretized in parallel by
+     * SensitivityApproximation::getAandBBatch(), using settings.nThreadsDiscretization threads. With modes set by
+     * setStageModes(), the range is discretized in batches of equal mode.
+     * See OptconSystemInterface::getAandBBatch() for the parameters.
+     */
+    virtual void getAandBBatch(const StateVectorArray& x,
+        const ControlVectorArray& u,
+        const StateVectorArray& x_next,
+        const size_t firstIndex,
+        const size_t lastIndex,
+        size_t subSteps,
+        StateMatrixArray& A,
+        StateControlMatrixArray& B,
+        const size_t threadId) override;
+
     //! propagate discrete-time dynamics
     /*!
      * @param state start state to propagate from
@@ -104,6 +128,8 @@ public:
     virtual void changeNonlinearSystem(const typename optConProblem_t::DynamicsPtr_t& dyn) override;
     virtual void changeLinearSystem(const typename optConProblem_t::LinearPtr_t& lin) override;
 
+    virtual bool hasNumericLinearization() const override;
+
     //! set the number of stages/time steps
     virtual void changeNumStages(const int numStages) override;
 
@@ -114,12 +140,40 @@ public:
         const ControlSubstepsPtr& uSubsteps,
         const size_t threadId) override;
 
+    //! set the mode of every stage
+    /*!
+     * If the system is a core::SwitchedControlledSystem or the linear system a core::SwitchedLinearSystem, every
+     * thread gets a discretizer and a sensitivity for each mode, which operate on the subsystem of that mode only.
+     * See OptconSystemInterface::setStageModes().
+     */
+    virtual void setStageModes(const std::vector<size_t>& stageModes) override;
+
 private:
-    std::vector<system_discretizer_ptr_t, Eigen::aligned_allocator<system_discretizer_ptr_t>>
-        discretizers_;  //! system discretizers
+    typedef std::vector<system_discretizer_ptr_t, Eigen::aligned_allocator<system_discretizer_ptr_t>>
+        DiscretizerArray;
+    typedef std::vector<SensitivityPtr, Eigen::aligned_allocator<SensitivityPtr>> SensitivityArray;
+
+    //! create the sensitivity for a linear system according to the settings
+    SensitivityPtr createSensitivity(const typename optConProblem_t::LinearPtr_t& linearSystem,
+        const size_t threadId) const;
+
+    //! (re-)create the per-mode discretizers and sensitivities for switched systems
+    void setupModeDispatch();
+
+    //! the discretizer for stage n
+    const system_discretizer_ptr_t& getDiscretizer(const int n, const size_t threadId) const;
+
+    //! the sensitivity for stage n
+    const SensitivityPtr& getSensitivity(const int n, const size_t threadId) const;
+
+    DiscretizerArray discretizers_;  //! system discretizers
+
+    SensitivityArray sensitivity_;  //! the ct sensitivity integrators
+
+    std::vector<DiscretizerArray> modeDiscretizers_;  //! discretizers of the subsystems per thread and mode
+    std::vector<SensitivityArray> modeSensitivities_;  //! sensitivities of the linear subsystems per thread and mode
 
-    std::vector<SensitivityPtr, Eigen::aligned_allocator<SensitivityPtr>>
-        sensitivity_;  //! the ct sensitivity integrators
+    DiscretizerArray activeDiscretizers_;  //! the discretizer of the last propagation per thread, for the substeps
 };
 
 }  // namespace optcon
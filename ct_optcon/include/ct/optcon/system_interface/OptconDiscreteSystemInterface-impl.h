@@ -26,7 +26,10 @@ void OptconDiscreteSystemInterface<STATE_DIM, CONTROL_DIM, SCALAR>::getAandB(con
     state_control_matrix_t& B,
     const size_t threadId)
 {
-    this->linearSystems_[threadId]->getAandB(x, u, x_next, n, subSteps, A, B);
+    if (modeLinearSystems_.empty())
+        this->linearSystems_[threadId]->getAandB(x, u, x_next, n, subSteps, A, B);
+    else
+        modeLinearSystems_[threadId][this->getStageMode(n)]->getAandB(x, u, x_next, n, subSteps, A, B);
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
@@ -38,7 +41,10 @@ void OptconDiscreteSystemInterface<STATE_DIM, CONTROL_DIM, SCALAR>::propagateCon
     const size_t threadId)
 {
     this->controller_[threadId]->setControl(control);
-    this->systems_[threadId]->propagateControlledDynamics(state, n, control, stateNext);
+    if (modeSystems_.empty())
+        this->systems_[threadId]->propagateControlledDynamics(state, n, control, stateNext);
+    else
+        modeSystems_[threadId][this->getStageMode(n)]->propagateControlledDynamics(state, n, control, stateNext);
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
@@ -53,6 +59,8 @@ void OptconDiscreteSystemInterface<STATE_DIM, CONTROL_DIM, SCALAR>::changeNonlin
         this->systems_.at(i) = typename optConProblem_t::DynamicsPtr_t(dyn->clone());
         this->systems_.at(i)->setController(this->controller_.at(i));
     }
+
+    setupModeDispatch();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
@@ -66,6 +74,28 @@ void OptconDiscreteSystemInterface<STATE_DIM, CONTROL_DIM, SCALAR>::changeLinear
     {
         this->linearSystems_.at(i) = typename optConProblem_t::LinearPtr_t(lin->clone());
     }
+
+    setupModeDispatch();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+bool OptconDiscreteSystemInterface<STATE_DIM, CONTROL_DIM, SCALAR>::hasNumericLinearization() const
+{
+    typedef ct::core::DiscreteSystemLinearizer<STATE_DIM, CONTROL_DIM, SCALAR> Linearizer_t;
+    typedef ct::core::SwitchedDiscreteLinearSystem<STATE_DIM, CONTROL_DIM, SCALAR> SwitchedLinearSystem_t;
+
+    if (std::dynamic_pointer_cast<Linearizer_t>(this->linearSystems_.front()))
+        return true;
+
+    // the modes of a switched linear system are linearized independently
+    if (auto switchedLinearSystem = std::dynamic_pointer_cast<SwitchedLinearSystem_t>(this->linearSystems_.front()))
+    {
+        for (const auto& subsystem : switchedLinearSystem->getSwitchedLinearSystems())
+            if (std::dynamic_pointer_cast<Linearizer_t>(subsystem))
+                return true;
+    }
+
+    return false;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
@@ -84,6 +114,74 @@ void OptconDiscreteSystemInterface<STATE_DIM, CONTROL_DIM, SCALAR>::initialize()
         this->linearSystems_.at(i) =
             typename optConProblem_t::LinearPtr_t(this->optConProblem_.getLinearSystem()->clone());
     }
+
+    setupModeDispatch();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void OptconDiscreteSystemInterface<STATE_DIM, CONTROL_DIM, SCALAR>::setStageModes(const std::vector<size_t>& stageModes)
+{
+    // the subsystems of all modes are collected at once
+    const bool rebuild = this->stageModes_.empty() || stageModes.empty();
+    Base::setStageModes(stageModes);
+
+    if (rebuild)
+        setupModeDispatch();
+    else
+    {
+        const size_t numModes = *std::max_element(stageModes.begin(), stageModes.end()) + 1;
+        if ((!modeSystems_.empty() && modeSystems_.front().size() < numModes) ||
+            (!modeLinearSystems_.empty() && modeLinearSystems_.front().size() < numModes))
+            throw std::runtime_error("OptconDiscreteSystemInterface: switched system has too few modes.");
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void OptconDiscreteSystemInterface<STATE_DIM, CONTROL_DIM, SCALAR>::setupModeDispatch()
+{
+    typedef ct::core::SwitchedDiscreteControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR> SwitchedSystem_t;
+    typedef ct::core::SwitchedDiscreteLinearSystem<STATE_DIM, CONTROL_DIM, SCALAR> SwitchedLinearSystem_t;
+
+    modeSystems_.clear();
+    modeLinearSystems_.clear();
+
+    if (this->stageModes_.empty() || this->systems_.empty())
+        return;
+
+    const size_t numModes = *std::max_element(this->stageModes_.begin(), this->stageModes_.end()) + 1;
+
+    // the subsystems of each thread's switched system are deep copies already, hence they are used directly
+    if (std::dynamic_pointer_cast<SwitchedSystem_t>(this->systems_.front()))
+    {
+        modeSystems_.resize(this->settings_.nThreads + 1);
+        for (int i = 0; i < this->settings_.nThreads + 1; i++)
+        {
+            const auto& subsystems =
+                std::static_pointer_cast<SwitchedSystem_t>(this->systems_.at(i))->getSwitchedSystems();
+            if (subsystems.size() < numModes)
+                throw std::runtime_error("OptconDiscreteSystemInterface: switched system has too few modes.");
+
+            for (const auto& subsystem : subsystems)
+            {
+                subsystem->setController(this->controller_.at(i));
+                modeSystems_[i].push_back(subsystem);
+            }
+        }
+    }
+
+    if (std::dynamic_pointer_cast<SwitchedLinearSystem_t>(this->linearSystems_.front()))
+    {
+        modeLinearSystems_.resize(this->settings_.nThreads + 1);
+        for (int i = 0; i < this->settings_.nThreads + 1; i++)
+        {
+            const auto& subsystems = std::static_pointer_cast<SwitchedLinearSystem_t>(this->linearSystems_.at(i))
+                                         ->getSwitchedLinearSystems();
+            if (subsystems.size() < numModes)
+                throw std::runtime_error("OptconDiscreteSystemInterface: switched linear system has too few modes.");
+
+            modeLinearSystems_[i].assign(subsystems.begin(), subsystems.end());
+        }
+    }
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
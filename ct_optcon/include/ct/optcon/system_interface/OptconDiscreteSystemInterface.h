@@ -87,6 +87,24 @@ public:
 
     virtual void changeNonlinearSystem(const typename optConProblem_t::DynamicsPtr_t& dyn) override;
     virtual void changeLinearSystem(const typename optConProblem_t::LinearPtr_t& lin) override;
+
+    virtual bool hasNumericLinearization() const override;
+
+    //! set the mode of every stage
+    /*!
+     * If the system is a core::SwitchedDiscreteControlledSystem or the linear system a
+     * core::SwitchedDiscreteLinearSystem, each stage is evaluated by the subsystem of its mode directly.
+     * See OptconSystemInterface::setStageModes().
+     */
+    virtual void setStageModes(const std::vector<size_t>& stageModes) override;
+
+private:
+    //! collect the subsystems of each thread's switched systems
+    void setupModeDispatch();
+
+    std::vector<std::vector<typename optConProblem_t::DynamicsPtr_t>> modeSystems_;  //! subsystems per thread and mode
+    std::vector<std::vector<typename optConProblem_t::LinearPtr_t>>
+        modeLinearSystems_;  //! linear subsystems per thread and mode
 };
 
 }  // namespace optcon
@@ -5,6 +5,11 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include <ct/optcon/solver/NLOptConSettings.hpp>
 
 namespace ct {
@@ -31,12 +36,17 @@ public:
     typedef ct::core::StateVector<STATE_DIM, SCALAR> state_vector_t;
     typedef ct::core::StateMatrix<STATE_DIM, SCALAR> state_matrix_t;
     typedef ct::core::StateControlMatrix<STATE_DIM, CONTROL_DIM, SCALAR> state_control_matrix_t;
+    typedef ct::core::ControlMatrix<CONTROL_DIM, SCALAR> control_matrix_t;
+    typedef ct::core::FeedbackMatrix<STATE_DIM, CONTROL_DIM, SCALAR> control_state_matrix_t;
 
     typedef ct::core::StateVectorArray<STATE_DIM, SCALAR> StateVectorArray;
     typedef std::shared_ptr<StateVectorArray> StateVectorArrayPtr;
     typedef std::vector<StateVectorArrayPtr, Eigen::aligned_allocator<StateVectorArrayPtr>> StateSubsteps;
     typedef std::shared_ptr<StateSubsteps> StateSubstepsPtr;
 
+    typedef ct::core::StateMatrixArray<STATE_DIM, SCALAR> StateMatrixArray;
+    typedef ct::core::StateControlMatrixArray<STATE_DIM, CONTROL_DIM, SCALAR> StateControlMatrixArray;
+
     typedef ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> ControlVectorArray;
     typedef std::shared_ptr<ControlVectorArray> ControlVectorArrayPtr;
     typedef std::vector<ControlVectorArrayPtr, Eigen::aligned_allocator<ControlVectorArrayPtr>> ControlSubsteps;
@@ -81,6 +91,109 @@ public:
         state_control_matrix_t& B,
         const size_t threadId) = 0;
 
+    //! retrieve discrete-time linear system matrices A and B for a range of stages.
+    /*!
+     * Writes A[k] and B[k] for k = firstIndex, ..., lastIndex. The default implementation calls getAandB() per stage,
+     * interfaces which can discretize several stages at once (e.g. in parallel) can override it.
+     *
+     * @param x	the state trajectory
+     * @param u the control trajectory
+     * @param x_next the next states, i.e. the end states of the intervals
+     * @param firstIndex first stage
+     * @param lastIndex last stage
+     * @param subSteps number of substeps of trajectory for which to get the sensitivity for
+     * @param A the resulting linear system matrices A
+     * @param B the resulting linear system matrices B
+     * @param threadId which thread specific instantiations to use
+     */
+    virtual void getAandBBatch(const StateVectorArray& x,
+        const ControlVectorArray& u,
+        const StateVectorArray& x_next,
+        const size_t firstIndex,
+        const size_t lastIndex,
+        size_t subSteps,
+        StateMatrixArray& A,
+        StateControlMatrixArray& B,
+        const size_t threadId)
+    {
+        for (size_t k = firstIndex; k <= lastIndex; k++)
+            getAandB(x[k], u[k], x_next[k], (int)k, subSteps, A[k], B[k], threadId);
+    }
+
+    //! retrieve the curvature of the discrete-time dynamics weighted by the costate, i.e. the Hessian of lambda^T f(x,u)
+    /*!
+     * Required by the exact-Hessian mode of the NLOC algorithms. The default implementation differentiates the
+     * gradient [A B]^T lambda by central finite differences of getAandB(). This costs 2 * (STATE_DIM + CONTROL_DIM)
+     * linearizations per stage on top of the Gauss-Newton approximation. The linearization needs to be exact, i.e.
+     * analytic or auto-diff, since differencing a numerical linearization (see hasNumericLinearization()) amplifies
+     * its truncation error. This also excludes the sensitivity integrator, which linearizes along the stored rollout
+     * and ignores the perturbation. Interfaces with access to second-order derivatives (e.g. auto-diff Hessian
+     * kernels) can override it.
+     *
+     * @param x	the state setpoint
+     * @param u the control setpoint
+     * @param x_next the next state
+     * @param n the time setpoint
+     * @param subSteps number of substeps of trajectory for which to get the sensitivity for
+     * @param lambda the costate weighting the components of the dynamics
+     * @param Hxx the resulting second derivative w.r.t. the state
+     * @param Hux the resulting mixed second derivative
+     * @param Huu the resulting second derivative w.r.t. the control
+     * @param threadId which thread specific instantiations to use
+     */
+    virtual void getDynamicsCurvature(const state_vector_t& x,
+        const control_vector_t& u,
+        const state_vector_t& x_next,
+        const int n,
+        size_t subSteps,
+        const state_vector_t& lambda,
+        state_matrix_t& Hxx,
+        control_state_matrix_t& Hux,
+        control_matrix_t& Huu,
+        const size_t threadId)
+    {
+        const SCALAR eps = std::cbrt(std::numeric_limits<SCALAR>::epsilon());
+
+        state_matrix_t A_plus, A_minus;
+        state_control_matrix_t B_plus, B_minus;
+        Eigen::Matrix<SCALAR, STATE_DIM + CONTROL_DIM, STATE_DIM + CONTROL_DIM> H;
+
+        for (size_t j = 0; j < STATE_DIM + CONTROL_DIM; j++)
+        {
+            state_vector_t x_plus = x, x_minus = x;
+            control_vector_t u_plus = u, u_minus = u;
+
+            SCALAR h;
+            if (j < STATE_DIM)
+            {
+                h = eps * std::max(SCALAR(1.0), std::abs(x(j)));
+                x_plus(j) += h;
+                x_minus(j) -= h;
+            }
+            else
+            {
+                h = eps * std::max(SCALAR(1.0), std::abs(u(j - STATE_DIM)));
+                u_plus(j - STATE_DIM) += h;
+                u_minus(j - STATE_DIM) -= h;
+            }
+
+            getAandB(x_plus, u_plus, x_next, n, subSteps, A_plus, B_plus, threadId);
+            getAandB(x_minus, u_minus, x_next, n, subSteps, A_minus, B_minus, threadId);
+
+            H.col(j).template head<STATE_DIM>() = (A_plus - A_minus).transpose() * lambda / (2.0 * h);
+            H.col(j).template tail<CONTROL_DIM>() = (B_plus - B_minus).transpose() * lambda / (2.0 * h);
+        }
+
+        H = 0.5 * (H + H.transpose()).eval();
+
+        Hxx = H.template topLeftCorner<STATE_DIM, STATE_DIM>();
+        Hux = H.template bottomLeftCorner<CONTROL_DIM, STATE_DIM>();
+        Huu = H.template bottomRightCorner<CONTROL_DIM, CONTROL_DIM>();
+    }
+
+
+    //! whether the linear systems differentiate the dynamics numerically, which rules out getDynamicsCurvature()
+    virtual bool hasNumericLinearization() const { return false; }
 
     //! propagate discrete-time dynamics
     /*!
@@ -110,7 +223,21 @@ public:
         const ControlSubstepsPtr& uSubsteps,
         const size_t threadId){};
 
+    //! set the mode of every stage of a switched system
+    /*!
+     * Switched systems are then evaluated through the subsystem of the stage's mode directly, instead of looking up
+     * the mode in every call. The modes must match the mode sequence of the system. An empty vector disables the
+     * dispatch, systems which are not switched are not affected.
+     * @param stageModes the mode of each stage
+     */
+    virtual void setStageModes(const std::vector<size_t>& stageModes) { stageModes_ = stageModes; }
 protected:
+    //! the mode of stage n, stages beyond the horizon are in the last mode
+    size_t getStageMode(const int n) const
+    {
+        return stageModes_[std::min(std::max(n, 0), (int)stageModes_.size() - 1)];
+    }
+
     /*!
      * of the following objects, we have nThreads+1 instantiations in form of a vector.
      * Every instantiation is dedicated to a certain thread in the multi-thread implementation
@@ -125,6 +252,8 @@ protected:
     optConProblem_t optConProblem_;  //! instance of the optconProblem
 
     settings_t settings_;  //! instance of the optcon Settings
+
+    std::vector<size_t> stageModes_;  //! the mode of each stage, empty if not dispatched by mode
 };
 
 }  // namespace optcon
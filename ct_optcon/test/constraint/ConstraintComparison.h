@@ -214,6 +214,15 @@ TEST(ConstraintComparison, comparisonAnalyticAD)
 
     ASSERT_TRUE(D_an.isApprox(D_ad));
 
+    // the output-parameter API of the AD container evaluates the sparse jacobian only once
+    Eigen::VectorXd g_lin(g1_ad.rows());
+    Eigen::MatrixXd C_lin(C_ad.rows(), state_dim), D_lin(D_ad.rows(), control_dim);
+    constraintAD->linearizeIntermediate(g_lin, C_lin, D_lin);
+
+    ASSERT_TRUE(g_lin.isApprox(g1_ad));
+    ASSERT_TRUE(C_lin.isApprox(C_ad));
+    ASSERT_TRUE(D_lin.isApprox(D_ad));
+
     ASSERT_TRUE(1.0);
 }
 
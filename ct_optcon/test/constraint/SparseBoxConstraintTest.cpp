@@ -109,6 +109,22 @@ TEST(SparseBoxConstraintTest, HardcodedPatternTest)
     ASSERT_EQ(iRows(1), 1);
     ASSERT_EQ(jCols(0), 1);
     ASSERT_EQ(jCols(1), 4);
+
+    // the output-parameter API writes the same values into preallocated buffers
+    StateVector<state_dim> x = StateVector<state_dim>::Random();
+    ControlVector<control_dim> u = ControlVector<control_dim>::Random();
+    constraints->setCurrentStateAndControl(x, u, 0.0);
+
+    Eigen::VectorXd g(4 + 2);
+    Eigen::MatrixXd C(4 + 2, state_dim);
+    Eigen::MatrixXd D(4 + 2, control_dim);
+    const double* buffers[3] = {g.data(), C.data(), D.data()};
+    constraints->linearizeIntermediate(g, C, D);
+
+    ASSERT_TRUE(g.isApprox(constraints->evaluateIntermediate()));
+    ASSERT_TRUE(C.isApprox(constraints->jacobianStateIntermediate()));
+    ASSERT_TRUE(D.isApprox(constraints->jacobianInputIntermediate()));
+    ASSERT_TRUE(g.data() == buffers[0] && C.data() == buffers[1] && D.data() == buffers[2]);
 }
 
 
@@ -338,6 +338,115 @@ TEST(CostFunctionTest, TrackingTermTest)
     ASSERT_TRUE(costFunction->controlDerivativeIntermediateTest());
 }
 
+/*!
+ * Test that precomputing the term activations at the stage times does not change the cost function, neither at the
+ * stage times nor in between, after shifting the time or after adding terms
+ */
+TEST(CostFunctionTest, PrecomputedActivationTest)
+{
+    const size_t state_dim = 12;
+    const size_t control_dim = 4;
+
+    const double dt = 0.01;
+    const size_t K = 100;
+
+    std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunction(
+        new CostFunctionAnalytical<state_dim, control_dim>());
+
+    // waypoint terms which are active during short time windows only
+    for (size_t i = 0; i < 20; i++)
+    {
+        Eigen::Matrix<double, state_dim, state_dim> Q = core::StateVector<state_dim>::Random().cwiseAbs().asDiagonal();
+        Eigen::Matrix<double, control_dim, control_dim> R =
+            core::ControlVector<control_dim>::Random().cwiseAbs().asDiagonal();
+        std::shared_ptr<TermQuadratic<state_dim, control_dim>> waypoint(new TermQuadratic<state_dim, control_dim>(
+            Q, R, core::StateVector<state_dim>::Random(), core::ControlVector<control_dim>::Zero()));
+        waypoint->setTimeActivation(std::shared_ptr<core::tpl::ActivationBase<double>>(
+            new core::tpl::SingleActivation<double>(i * 0.05, i * 0.05 + 0.02)));
+        costFunction->addIntermediateTerm(waypoint);
+    }
+
+    // terms with non-trivial activations
+    Eigen::Matrix<double, state_dim, state_dim> Q = Eigen::Matrix<double, state_dim, state_dim>::Identity();
+    Eigen::Matrix<double, control_dim, control_dim> R = Eigen::Matrix<double, control_dim, control_dim>::Identity();
+    std::shared_ptr<TermQuadratic<state_dim, control_dim>> rbfTerm(new TermQuadratic<state_dim, control_dim>(Q, R));
+    rbfTerm->setTimeActivation(std::shared_ptr<core::tpl::ActivationBase<double>>(
+        new core::tpl::RBFGaussActivation<double>(0.5, 0.2)));
+    costFunction->addIntermediateTerm(rbfTerm);
+
+    std::shared_ptr<TermQuadratic<state_dim, control_dim>> periodicTerm(
+        new TermQuadratic<state_dim, control_dim>(Q, R));
+    periodicTerm->setTimeActivation(std::shared_ptr<core::tpl::ActivationBase<double>>(
+        new core::tpl::PeriodicActivation<double>(0.5, 0.1, 0.0, 0.0)));
+    costFunction->addIntermediateTerm(periodicTerm);
+
+    costFunction->addFinalTerm(std::shared_ptr<TermQuadratic<state_dim, control_dim>>(
+        new TermQuadratic<state_dim, control_dim>(Q, R)));
+
+    core::tpl::TimeArray<double> stageTimes(K + 1);
+    for (size_t k = 0; k <= K; k++)
+        stageTimes[k] = dt * k;
+
+    std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunctionPrecomputed(costFunction->clone());
+    costFunctionPrecomputed->precomputeActivations(stageTimes);
+
+    // clones keep the precomputed activations
+    std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunctionClone(
+        costFunctionPrecomputed->clone());
+
+    auto compareAtStages = [&](double timeOffset) {
+        for (size_t k = 0; k <= K; k++)
+        {
+            core::StateVector<state_dim> x = core::StateVector<state_dim>::Random();
+            core::ControlVector<control_dim> u = core::ControlVector<control_dim>::Random();
+
+            costFunction->setCurrentStateAndControl(x, u, dt * k + timeOffset);
+            costFunctionPrecomputed->setCurrentStateAndControl(x, u, dt * k + timeOffset);
+            costFunctionClone->setCurrentStateAndControl(x, u, dt * k + timeOffset);
+
+            compareCostFunctionOutput(*costFunction, *costFunctionPrecomputed);
+            compareCostFunctionOutput(*costFunction, *costFunctionClone);
+        }
+    };
+
+    // evaluated in order, in reverse order, and in between the stages
+    compareAtStages(0.0);
+    for (int k = K; k >= 0; k--)
+    {
+        core::StateVector<state_dim> x = core::StateVector<state_dim>::Random();
+        core::ControlVector<control_dim> u = core::ControlVector<control_dim>::Random();
+        costFunction->setCurrentStateAndControl(x, u, dt * k);
+        costFunctionPrecomputed->setCurrentStateAndControl(x, u, dt * k);
+        compareCostFunctionOutput(*costFunction, *costFunctionPrecomputed);
+    }
+    compareAtStages(0.5 * dt);
+
+    // the activations scale the derivatives of the cost
+    costFunctionPrecomputed->setCurrentStateAndControl(
+        core::StateVector<state_dim>::Random(), core::ControlVector<control_dim>::Random(), 0.4);
+    ASSERT_TRUE(costFunctionPrecomputed->stateDerivativeIntermediateTest());
+    ASSERT_TRUE(costFunctionPrecomputed->controlDerivativeIntermediateTest());
+
+    // shifting the time shifts the precomputed activations
+    costFunction->shiftTime(0.33);
+    costFunctionPrecomputed->shiftTime(0.33);
+    costFunctionClone->shiftTime(0.33);
+    compareAtStages(0.0);
+
+    // adding terms updates the precomputed activations
+    std::shared_ptr<TermQuadratic<state_dim, control_dim>> lateTerm(new TermQuadratic<state_dim, control_dim>(Q, R));
+    lateTerm->setTimeActivation(std::shared_ptr<core::tpl::ActivationBase<double>>(
+        new core::tpl::SingleActivation<double>(0.5, 0.7)));
+    costFunction->addIntermediateTerm(lateTerm);
+    costFunctionPrecomputed->addIntermediateTerm(lateTerm);
+    costFunctionClone->addIntermediateTerm(lateTerm);
+    compareAtStages(0.0);
+
+    // stage times need to be sorted
+    std::reverse(stageTimes.begin(), stageTimes.end());
+    ASSERT_THROW(costFunctionPrecomputed->precomputeActivations(stageTimes), std::runtime_error);
+}
+
 /*!
  * Test the TermSmoothAbs term for first and second order derivatives
  */
@@ -0,0 +1,115 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * This file provides a small oscillator dms problem for the unit tests which do not depend on the nlp solver.
+ * \example oscDMSProblem.h
+ */
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+namespace example {
+
+typedef ContinuousOptConProblem<2, 1> OscProblem;
+typedef DmsDimensions<2, 1> OscDimensions;
+
+//! dms settings with a single thread, zero order hold inputs and simple cost evaluation
+inline DmsSettings createSettings(size_t N, double T, double dt_sim)
+{
+    DmsSettings settings;
+    settings.N_ = N;
+    settings.T_ = T;
+    settings.nThreads_ = 1;
+    settings.splineType_ = DmsSettings::ZERO_ORDER_HOLD;
+    settings.costEvaluationType_ = DmsSettings::SIMPLE;
+    settings.integrationType_ = DmsSettings::RK4;
+    settings.dt_sim_ = dt_sim;
+    return settings;
+}
+
+//! the oscillator all problems are based on
+inline std::shared_ptr<ct::core::SecondOrderSystem> createOscillator()
+{
+    return std::shared_ptr<ct::core::SecondOrderSystem>(new ct::core::SecondOrderSystem(2.5, 0.1));
+}
+
+//! the final state all problems steer to
+inline OscDimensions::state_vector_t finalState()
+{
+    OscDimensions::state_vector_t x_final;
+    x_final << 2.0, -1.0;
+    return x_final;
+}
+
+//! a quadratic cost towards the final state
+inline std::shared_ptr<CostFunctionQuadratic<2, 1>> createCostFunction()
+{
+    OscDimensions::state_matrix_t Q = OscDimensions::state_matrix_t::Identity();
+    OscDimensions::control_matrix_t R = OscDimensions::control_matrix_t::Identity();
+    OscDimensions::control_vector_t u_des = OscDimensions::control_vector_t::Zero();
+    return std::shared_ptr<CostFunctionQuadratic<2, 1>>(
+        new CostFunctionQuadraticSimple<2, 1>(Q, R, finalState(), u_des, finalState(), Q));
+}
+
+//! the unconstrained optimal control problem, as input to the DmsSolver
+inline OscProblem createOptConProblem(const DmsSettings& settings, const OscDimensions::state_vector_t& x0)
+{
+    OscProblem optProblem(createOscillator(), createCostFunction());
+    optProblem.setInitialState(x0);
+    optProblem.setTimeHorizon(settings.T_);
+    return optProblem;
+}
+
+/*!
+ * Creates the dms problem of the oscillator with a quadratic cost towards the final state
+ * @param settings the dms settings
+ * @param x0 the initial state
+ * @param constrained adds an input constraint at every pair and a terminal constraint
+ */
+inline std::shared_ptr<DmsProblem<2, 1>> createDmsProblem(const DmsSettings& settings,
+    const OscDimensions::state_vector_t& x0 = OscDimensions::state_vector_t::Zero(),
+    bool constrained = false)
+{
+    std::shared_ptr<ct::core::SecondOrderSystem> oscillator = createOscillator();
+    std::shared_ptr<CostFunctionQuadratic<2, 1>> costFunction = createCostFunction();
+
+    std::vector<OscProblem::DynamicsPtr_t> systems;
+    std::vector<OscProblem::LinearPtr_t> linearSystems;
+    std::vector<OscProblem::CostFunctionPtr_t> costFunctions;
+    for (size_t i = 0; i < settings.N_; i++)
+    {
+        systems.push_back(OscProblem::DynamicsPtr_t(oscillator->clone()));
+        linearSystems.push_back(OscProblem::LinearPtr_t(new ct::core::SystemLinearizer<2, 1>(
+            std::shared_ptr<ct::core::SecondOrderSystem>(oscillator->clone()))));
+        costFunctions.push_back(OscProblem::CostFunctionPtr_t(costFunction->clone()));
+    }
+
+    std::vector<OscProblem::ConstraintPtr_t> noConstraints;
+    std::vector<OscProblem::ConstraintPtr_t> constraints;
+
+    if (constrained)
+    {
+        std::shared_ptr<ConstraintContainerAnalytical<2, 1>> generalConstraints(
+            new ConstraintContainerAnalytical<2, 1>());
+        OscDimensions::control_vector_t u_max;
+        u_max << 10.0;
+        std::shared_ptr<ControlInputConstraint<2, 1>> inputConstraint(
+            new ControlInputConstraint<2, 1>(-u_max, u_max));
+        generalConstraints->addIntermediateConstraint(inputConstraint, false);
+        std::shared_ptr<TerminalConstraint<2, 1>> termConstraint(new TerminalConstraint<2, 1>(finalState()));
+        generalConstraints->addTerminalConstraint(termConstraint, false);
+        generalConstraints->initialize();
+        constraints.push_back(generalConstraints);
+    }
+
+    return std::shared_ptr<DmsProblem<2, 1>>(new DmsProblem<2, 1>(
+        settings, systems, linearSystems, costFunctions, noConstraints, noConstraints, constraints, x0));
+}
+
+}  // namespace example
+}  // namespace optcon
+}  // namespace ct
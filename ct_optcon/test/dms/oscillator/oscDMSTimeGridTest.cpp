@@ -0,0 +1,147 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * This file tests the derivatives of the dms problem with an optimized time grid against finite differences, which
+ * does not depend on the nlp solver.
+ * \example oscDMSTimeGridTest.cpp
+ */
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+#include "oscDMSProblem.h"
+
+namespace ct {
+namespace optcon {
+namespace example {
+
+Eigen::VectorXd evaluateConstraints(DmsProblem<2, 1>& dmsProblem, const Eigen::VectorXd& w)
+{
+    Eigen::Map<const Eigen::VectorXd> wMap(w.data(), w.size());
+    dmsProblem.extractOptimizationVars(wMap, true);
+
+    Eigen::VectorXd g(dmsProblem.getConstraintsCount());
+    Eigen::Map<Eigen::VectorXd> gMap(g.data(), g.size());
+    dmsProblem.evaluateConstraints(gMap);
+    return g;
+}
+
+double evaluateCost(DmsProblem<2, 1>& dmsProblem, const Eigen::VectorXd& w)
+{
+    Eigen::Map<const Eigen::VectorXd> wMap(w.data(), w.size());
+    dmsProblem.extractOptimizationVars(wMap, true);
+    return dmsProblem.evaluateCostFun();
+}
+
+void checkDerivatives(const DmsSettings& settings)
+{
+    std::shared_ptr<DmsProblem<2, 1>> dmsProblem = createDmsProblem(settings);
+    const size_t n = dmsProblem->getVarCount();
+    const size_t m = dmsProblem->getConstraintsCount();
+    const size_t N = settings.N_;
+
+    // the shot durations follow the pairs, the horizon constraint follows the continuity constraints
+    ASSERT_EQ(n, (N + 1) * 3 + N);
+    ASSERT_EQ(m, 2 + 2 * N + 1);
+
+    Eigen::VectorXd w = Eigen::VectorXd::Random(n);
+    w.tail(N) = Eigen::VectorXd::Constant(N, settings.T_ / N) + 0.1 * Eigen::VectorXd::Random(N);
+
+    const Eigen::VectorXd g = evaluateConstraints(*dmsProblem, w);
+    ASSERT_NEAR(g(m - 1), w.tail(N).sum() - settings.T_, 1e-12);
+
+    // analytical derivatives
+    const size_t nnz = dmsProblem->getNonZeroJacobianCount();
+    Eigen::VectorXi iRow(nnz), jCol(nnz);
+    Eigen::Map<Eigen::VectorXi> iRowMap(iRow.data(), nnz), jColMap(jCol.data(), nnz);
+    dmsProblem->getSparsityPatternJacobian(nnz, iRowMap, jColMap);
+
+    Eigen::VectorXd jacValues(nnz);
+    Eigen::Map<Eigen::VectorXd> jacMap(jacValues.data(), nnz);
+    dmsProblem->evaluateConstraintJacobian(nnz, jacMap);
+
+    Eigen::MatrixXd jac = Eigen::MatrixXd::Zero(m, n);
+    for (size_t i = 0; i < nnz; i++)
+        jac(iRow(i), jCol(i)) += jacValues(i);
+
+    Eigen::VectorXd grad(n);
+    Eigen::Map<Eigen::VectorXd> gradMap(grad.data(), n);
+    evaluateCost(*dmsProblem, w);
+    dmsProblem->evaluateCostGradient(n, gradMap);
+
+    // central finite differences
+    const double eps = 1e-6;
+    Eigen::MatrixXd jacFd(m, n);
+    Eigen::VectorXd gradFd(n);
+    for (size_t j = 0; j < n; j++)
+    {
+        Eigen::VectorXd wPlus = w, wMinus = w;
+        wPlus(j) += eps;
+        wMinus(j) -= eps;
+        jacFd.col(j) = (evaluateConstraints(*dmsProblem, wPlus) - evaluateConstraints(*dmsProblem, wMinus)) / (2 * eps);
+        gradFd(j) = (evaluateCost(*dmsProblem, wPlus) - evaluateCost(*dmsProblem, wMinus)) / (2 * eps);
+    }
+
+    ASSERT_LT((jac - jacFd).cwiseAbs().maxCoeff(), 1e-6 * std::max(1.0, jacFd.cwiseAbs().maxCoeff()));
+    ASSERT_LT((grad - gradFd).cwiseAbs().maxCoeff(), 1e-6 * std::max(1.0, gradFd.cwiseAbs().maxCoeff()));
+
+    // the durations enter the continuity constraints
+    ASSERT_GT(jac.block(2, (N + 1) * 3, 2 * N, N).norm(), 1e-3);
+}
+
+TEST(DmsTimeGridTest, DerivativesMatchFiniteDifferences)
+{
+    DmsSettings settings = createSettings(3, 1.5, 0.05);
+    settings.objectiveType_ = DmsSettings::OPTIMIZE_GRID;
+    settings.h_min_ = 0.1;
+
+    for (auto splineType : {DmsSettings::ZERO_ORDER_HOLD, DmsSettings::PIECEWISE_LINEAR})
+        for (auto costEvaluationType : {DmsSettings::SIMPLE, DmsSettings::FULL})
+            for (auto integrationType : {DmsSettings::EULER, DmsSettings::RK4})
+            {
+                settings.splineType_ = splineType;
+                settings.costEvaluationType_ = costEvaluationType;
+                settings.integrationType_ = integrationType;
+                checkDerivatives(settings);
+            }
+}
+
+TEST(DmsTimeGridTest, ShotDurationsUpdateTimeGrid)
+{
+    DmsSettings settings = createSettings(3, 1.5, 0.05);
+    settings.objectiveType_ = DmsSettings::OPTIMIZE_GRID;
+
+    std::shared_ptr<DmsProblem<2, 1>> dmsProblem = createDmsProblem(settings);
+    const size_t n = dmsProblem->getVarCount();
+
+    // the durations start from the uniform grid and are bounded by h_min
+    Eigen::VectorXd xInit(n), lb(n), ub(n);
+    Eigen::Map<Eigen::VectorXd> xInitMap(xInit.data(), n), lbMap(lb.data(), n), ubMap(ub.data(), n);
+    dmsProblem->getInitialGuess(n, xInitMap);
+    dmsProblem->getVariableBounds(lbMap, ubMap, n);
+    ASSERT_TRUE(xInit.tail<3>().isApprox(Eigen::Vector3d::Constant(0.5)));
+    ASSERT_TRUE(lb.tail<3>().isApprox(Eigen::Vector3d::Constant(settings.h_min_)));
+
+    Eigen::VectorXd w = Eigen::VectorXd::Zero(n);
+    w.tail<3>() << 0.2, 0.3, 0.4;
+    evaluateConstraints(*dmsProblem, w);
+
+    const auto& t = dmsProblem->getTimeSolution();
+    ASSERT_NEAR(t[1], 0.2, 1e-12);
+    ASSERT_NEAR(t[2], 0.5, 1e-12);
+    ASSERT_NEAR(t[3], 0.9, 1e-12);
+}
+
+}  // namespace example
+}  // namespace optcon
+}  // namespace ct
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
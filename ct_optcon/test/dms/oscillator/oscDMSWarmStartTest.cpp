@@ -0,0 +1,154 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * This file tests the warm start of repeated dms solves, which does not depend on the nlp solver.
+ * \example oscDMSWarmStartTest.cpp
+ */
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+#include "oscDMSProblem.h"
+
+namespace ct {
+namespace optcon {
+namespace example {
+
+TEST(DmsWarmStartTest, ShiftSolution)
+{
+    const DmsSettings settings = createSettings(4, 2.0, 0.01);
+    const size_t N = settings.N_;
+    const size_t pairSize = 3;
+
+    std::shared_ptr<DmsProblem<2, 1>> dmsProblem = createDmsProblem(settings, OscDimensions::state_vector_t::Zero(), true);
+
+    // initial state, continuity, input constraint at every pair, terminal constraint
+    const size_t n = dmsProblem->getVarCount();
+    const size_t m = dmsProblem->getConstraintsCount();
+    ASSERT_EQ(n, (N + 1) * pairSize);
+    ASSERT_EQ(m, 2 + 2 * N + (N + 1) + 2);
+
+    // a fake solution with distinguishable entries
+    Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(n, 1.0, n);
+    Eigen::VectorXd zL = -x;
+    Eigen::VectorXd zU = 2.0 * x;
+    Eigen::VectorXd lambda = Eigen::VectorXd::LinSpaced(m, 1.0, m);
+    Eigen::Map<const Eigen::VectorXd> xMap(x.data(), n), zLMap(zL.data(), n), zUMap(zU.data(), n),
+        lambdaMap(lambda.data(), m);
+    dmsProblem->extractIpoptSolution(xMap, zLMap, zUMap, lambdaMap);
+
+    dmsProblem->shiftSolution(1);
+
+    Eigen::VectorXd xInit(n), zLInit(n), zUInit(n), lambdaInit(m);
+    Eigen::Map<Eigen::VectorXd> xInitMap(xInit.data(), n), zLInitMap(zLInit.data(), n), zUInitMap(zUInit.data(), n),
+        lambdaInitMap(lambdaInit.data(), m);
+    dmsProblem->getInitialGuess(n, xInitMap);
+    dmsProblem->getBoundMultipliers(n, zLInitMap, zUInitMap);
+    dmsProblem->getLambdaVars(m, lambdaInitMap);
+
+    // the pairs move one shot to the front, the last one is repeated
+    for (size_t i = 0; i < N + 1; i++)
+    {
+        const size_t source = std::min(i + 1, N);
+        ASSERT_TRUE(xInit.segment(i * pairSize, pairSize).isApprox(x.segment(source * pairSize, pairSize)));
+        ASSERT_TRUE(zLInit.segment(i * pairSize, pairSize).isApprox(zL.segment(source * pairSize, pairSize)));
+        ASSERT_TRUE(zUInit.segment(i * pairSize, pairSize).isApprox(zU.segment(source * pairSize, pairSize)));
+    }
+
+    // the initial state constraint takes over the multiplier of the first continuity constraint
+    ASSERT_TRUE(lambdaInit.segment(0, 2).isApprox(lambda.segment(2, 2)));
+    for (size_t i = 0; i < N; i++)
+    {
+        const size_t source = std::min(i + 1, N - 1);
+        ASSERT_TRUE(lambdaInit.segment(2 + 2 * i, 2).isApprox(lambda.segment(2 + 2 * source, 2)));
+    }
+    for (size_t i = 0; i < N + 1; i++)
+        ASSERT_EQ(lambdaInit(2 + 2 * N + i), lambda(2 + 2 * N + std::min(i + 1, N)));
+
+    // the terminal constraint keeps its multiplier
+    ASSERT_TRUE(lambdaInit.tail(2).isApprox(lambda.tail(2)));
+}
+
+TEST(DmsWarmStartTest, ChangeInitialState)
+{
+    const DmsSettings settings = createSettings(4, 2.0, 0.01);
+    std::shared_ptr<DmsProblem<2, 1>> dmsProblem = createDmsProblem(settings, OscDimensions::state_vector_t::Zero(), true);
+
+    const size_t n = dmsProblem->getVarCount();
+    const size_t m = dmsProblem->getConstraintsCount();
+
+    OscDimensions::state_vector_t x0;
+    x0 << 0.5, -0.3;
+    dmsProblem->changeInitialState(x0);
+
+    // the initial guess starts at the new initial state
+    Eigen::VectorXd xInit(n);
+    Eigen::Map<Eigen::VectorXd> xInitMap(xInit.data(), n);
+    dmsProblem->getInitialGuess(n, xInitMap);
+    ASSERT_TRUE(xInit.head<2>().isApprox(x0));
+
+    // and the initial state constraint is updated
+    Eigen::VectorXd w = Eigen::VectorXd::Ones(n);
+    Eigen::Map<const Eigen::VectorXd> wMap(w.data(), n);
+    dmsProblem->extractOptimizationVars(wMap, true);
+
+    Eigen::VectorXd g(m);
+    Eigen::Map<Eigen::VectorXd> gMap(g.data(), m);
+    dmsProblem->evaluateConstraints(gMap);
+    ASSERT_TRUE(g.head<2>().isApprox(w.head<2>() - x0));
+}
+
+#ifdef BUILD_WITH_IPOPT_SUPPORT
+TEST(DmsWarmStartTest, ReOptimize)
+{
+    DmsSettings settings = createSettings(4, 2.0, 0.01);
+    settings.solverSettings_.solverType_ = NlpSolverType::IPOPT;
+
+    DmsPolicy<2, 1> initialGuess;
+    initialGuess.xSolution_.resize(settings.N_ + 1, OscDimensions::state_vector_t::Zero());
+    initialGuess.uSolution_.resize(settings.N_ + 1, OscDimensions::control_vector_t::Zero());
+
+    OscDimensions::state_vector_t x0;
+    x0 << 1.0, 0.0;
+    DmsSolver<2, 1> warmSolver(createOptConProblem(settings, x0), settings);
+    warmSolver.setInitialGuess(initialGuess);
+    ASSERT_TRUE(warmSolver.solve());
+
+    // only shifts by whole shots within the horizon are supported
+    ASSERT_FALSE(warmSolver.shiftHorizon(0.25));
+    ASSERT_FALSE(warmSolver.shiftHorizon(settings.T_));
+
+    // the second solve starts from the shifted solution and reuses the structure of the nlp
+    const OscDimensions::state_vector_t x1 = warmSolver.getSolution().xSolution_[1];
+    ASSERT_TRUE(warmSolver.shiftHorizon(0.5));
+    warmSolver.changeInitialState(x1);
+    ASSERT_TRUE(warmSolver.solve());
+    const DmsPolicy<2, 1> warmSolution = warmSolver.getSolution();
+
+    // and finds the same solution as a cold start
+    DmsSolver<2, 1> coldSolver(createOptConProblem(settings, x1), settings);
+    coldSolver.setInitialGuess(initialGuess);
+    ASSERT_TRUE(coldSolver.solve());
+    const DmsPolicy<2, 1> coldSolution = coldSolver.getSolution();
+
+    for (size_t i = 0; i < settings.N_ + 1; i++)
+    {
+        ASSERT_LT((warmSolution.xSolution_[i] - coldSolution.xSolution_[i]).norm(), 1e-5);
+        ASSERT_LT((warmSolution.uSolution_[i] - coldSolution.uSolution_[i]).norm(), 1e-5);
+    }
+}
+#endif  // BUILD_WITH_IPOPT_SUPPORT
+
+}  // namespace example
+}  // namespace optcon
+}  // namespace ct
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,118 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * This unit test checks the moving horizon estimator against the extended Kalman filter.
+ * For linear systems, the unconstrained MHE with EKF arrival cost update must reproduce the EKF estimate.
+ */
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+using namespace ct::optcon;
+
+const size_t state_dim = 2;
+const size_t control_dim = 1;
+const size_t output_dim = 1;
+
+//! a discrete-time linear oscillator model
+class LinearOscillatorModel : public SystemModelBase<state_dim, control_dim>
+{
+public:
+    LinearOscillatorModel()
+    {
+        A_ << 1.0, 0.01, -0.5, 0.99;
+        B_ << 0.0, 0.01;
+    }
+
+    state_vector_t computeDynamics(const state_vector_t& state,
+        const control_vector_t& control,
+        const Time_t dt,
+        Time_t t) override
+    {
+        return A_ * state + B_ * control;
+    }
+
+    state_matrix_t computeDerivativeState(const state_vector_t& state,
+        const control_vector_t& control,
+        const Time_t dt,
+        Time_t t) override
+    {
+        return A_;
+    }
+
+    state_matrix_t computeDerivativeNoise(const state_vector_t& state,
+        const control_vector_t& control,
+        const Time_t dt,
+        Time_t t) override
+    {
+        return state_matrix_t::Identity();
+    }
+
+private:
+    state_matrix_t A_;
+    Eigen::Matrix<double, state_dim, control_dim> B_;
+};
+
+TEST(MovingHorizonEstimatorTest, LinearSystemMatchesEKF)
+{
+    std::shared_ptr<LinearOscillatorModel> sysModel(new LinearOscillatorModel());
+
+    // we only measure the position
+    OutputStateMatrix<output_dim, state_dim> C;
+    C << 1.0, 0.0;
+    OutputMatrix<output_dim> dHdw = OutputMatrix<output_dim>::Identity();
+    std::shared_ptr<LTIMeasurementModel<output_dim, state_dim>> measModel(
+        new LTIMeasurementModel<output_dim, state_dim>(C, dHdw));
+
+    StateMatrix<state_dim> Q;
+    Q << 0.1, 0.0, 0.0, 1.0;
+    OutputMatrix<output_dim> R;
+    R << 0.05;
+
+    MovingHorizonEstimatorSettings<state_dim> mheSettings;
+    mheSettings.x0 << 0.5, -0.2;
+    mheSettings.P0 = StateMatrix<state_dim>::Identity();
+    mheSettings.horizonLength = 5;
+
+    ExtendedKalmanFilter<state_dim, control_dim, output_dim> ekf(
+        sysModel, measModel, Q, R, mheSettings.x0, mheSettings.P0);
+    MovingHorizonEstimator<state_dim, control_dim, output_dim> mhe(sysModel, measModel, Q, R, mheSettings);
+
+    const double dt = 0.01;
+    StateVector<state_dim> x;
+    x << 1.0, 0.0;
+    GaussianNoise measurementNoise(0.0, 0.05);
+
+    for (size_t i = 1; i < 30; i++)
+    {
+        ControlVector<control_dim> u;
+        u << std::sin(0.3 * i);
+        x = sysModel->computeDynamics(x, u, dt, i * dt);
+
+        OutputVector<output_dim> y = C * x;
+        measurementNoise.noisify(y(0));
+
+        ekf.predict(u, dt, i * dt);
+        mhe.predict(u, dt, i * dt);
+
+        const StateVector<state_dim> x_ekf = ekf.update(y, dt, i * dt);
+        const StateVector<state_dim> x_mhe = mhe.update(y, dt, i * dt);
+
+        ASSERT_LT((x_ekf - x_mhe).cwiseAbs().maxCoeff(), 1e-7);
+        ASSERT_LE(mhe.getStateTrajectory().size(), mheSettings.horizonLength + 1);
+    }
+
+    // the window is full and the arrival cost remains well-defined
+    ASSERT_EQ(mhe.getStateTrajectory().size(), mheSettings.horizonLength + 1);
+    ASSERT_TRUE(mhe.getArrivalCovariance().allFinite());
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -46,6 +46,73 @@ TEST(LQRTest, DARETest)
     Eigen::Matrix<double, stateDim, stateDim> P_test;
     P_test << 6.932484752255643, 4.332273119899151, 4.332273119899151, 4.55195134961773;
     ASSERT_LT((P - P_test).array().abs().maxCoeff(), 1e-12);
+
+    Eigen::Matrix<double, controlDim, stateDim> K_doubling;
+    P = dare.computeSteadyStateRiccatiMatrixDoubling(Q, R, A, B, K_doubling, true);
+
+    // P_test is the result of the iteration stopped at eps = 1e-6, the doubling solution is exact
+    ASSERT_LT((P - P_test).array().abs().maxCoeff(), 1e-4);
+    ASSERT_LT((K - K_doubling).array().abs().maxCoeff(), 1e-4);
+    Eigen::Matrix<double, stateDim, stateDim> residual =
+        Q + A.transpose() * P * A - P -
+        A.transpose() * P * B * (R + B.transpose() * P * B).inverse() * B.transpose() * P * A;
+    ASSERT_LT(residual.array().abs().maxCoeff(), 1e-12);
+}
+
+
+TEST(LQRTest, DAREDoublingTest)
+{
+    const size_t stateDim = 4;
+    const size_t controlDim = 1;
+
+    typedef Eigen::Matrix<double, stateDim, stateDim> state_matrix_t;
+    typedef Eigen::Matrix<double, stateDim, controlDim> control_gain_matrix_t;
+    typedef Eigen::Matrix<double, controlDim, controlDim> control_matrix_t;
+    typedef Eigen::Matrix<double, controlDim, stateDim> control_feedback_t;
+
+    // two lightly damped oscillators, discretized with dt = 0.01, of which only the first one is actuated directly
+    const double dt = 0.01;
+    state_matrix_t A_c;
+    A_c << 0, 1, 0, 0, -4, -0.01, 1, 0, 0, 0, 0, 1, 1, 0, -9, -0.02;
+    control_gain_matrix_t B_c;
+    B_c << 0, 1, 0, 0;
+
+    const state_matrix_t A = state_matrix_t::Identity() + dt * A_c;
+    const control_gain_matrix_t B = dt * B_c;
+    const state_matrix_t Q = dt * state_matrix_t::Identity();
+    const control_matrix_t R = dt * control_matrix_t::Identity();
+
+    ct::optcon::DARE<stateDim, controlDim> dare;
+
+    control_feedback_t K_iterative, K_doubling;
+    state_matrix_t P_iterative = dare.computeSteadyStateRiccatiMatrix(Q, R, A, B, K_iterative, false, 1e-12, 1000000);
+    state_matrix_t P_doubling = dare.computeSteadyStateRiccatiMatrixDoubling(Q, R, A, B, K_doubling);
+
+    // the doubling solution satisfies the DARE to machine precision, whereas the fixed-point iteration converges slowly
+    auto residual = [&](const state_matrix_t& P) {
+        const state_matrix_t res = Q + A.transpose() * P * A - P -
+                                   A.transpose() * P * B * (R + B.transpose() * P * B).inverse() * B.transpose() * P * A;
+        return res.cwiseAbs().maxCoeff();
+    };
+    ASSERT_LT(residual(P_doubling), 1e-12 * P_doubling.cwiseAbs().maxCoeff());
+    ASSERT_LT(residual(P_doubling), residual(P_iterative));
+
+    ASSERT_LT((P_doubling - P_iterative).cwiseAbs().maxCoeff(), 1e-3 * P_doubling.cwiseAbs().maxCoeff());
+    ASSERT_LT((K_doubling - K_iterative).cwiseAbs().maxCoeff(), 1e-3 * K_doubling.cwiseAbs().maxCoeff());
+
+    // the LQR returns the same feedback with the sign convention u = -K x
+    ct::optcon::LQR<stateDim, controlDim> lqr;
+    control_feedback_t K_lqr;
+    ASSERT_TRUE(lqr.computeDiscrete(Q, R, A, B, K_lqr));
+    ASSERT_LT((K_lqr + K_doubling).cwiseAbs().maxCoeff(), 1e-12);
+
+    // the stopping criterion is relative, such that large Riccati matrices converge despite round-off
+    const double scale = 1e12;
+    control_feedback_t K_scaled;
+    state_matrix_t P_scaled;
+    ASSERT_NO_THROW(P_scaled = dare.computeSteadyStateRiccatiMatrixDoubling(scale * Q, scale * R, A, B, K_scaled));
+    ASSERT_LT((P_scaled - scale * P_doubling).cwiseAbs().maxCoeff(), 1e-9 * P_scaled.cwiseAbs().maxCoeff());
+    ASSERT_LT((K_scaled - K_doubling).cwiseAbs().maxCoeff(), 1e-9 * K_doubling.cwiseAbs().maxCoeff());
 }
 
 
@@ -124,6 +191,159 @@ TEST(LQRTest, quadTest)
               << std::endl;
 }
 
+
+//! linearization of a torque-controlled pendulum, theta_dot = omega, omega_dot = -g sin(theta) + u
+class PendulumLinearization : public ct::core::LinearSystem<2, 1>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    PendulumLinearization()
+    {
+        A_.setZero();
+        A_(0, 1) = 1.0;
+        B_ << 0.0, 1.0;
+    }
+
+    PendulumLinearization* clone() const override { return new PendulumLinearization(*this); }
+    const state_matrix_t& getDerivativeState(const state_vector_t& x,
+        const control_vector_t& u,
+        const double t = 0.0) override
+    {
+        A_(1, 0) = -9.81 * std::cos(x(0));
+        return A_;
+    }
+
+    const state_control_matrix_t& getDerivativeControl(const state_vector_t& x,
+        const control_vector_t& u,
+        const double t = 0.0) override
+    {
+        return B_;
+    }
+
+private:
+    state_matrix_t A_;
+    state_control_matrix_t B_;
+};
+
+TEST(LQRTest, GainScheduleTest)
+{
+    typedef GainScheduleTable<2, 1> Table;
+    typedef GainScheduledController<2, 1> Controller;
+
+    // operating points: the pendulum held at the angles of the grid
+    std::vector<std::vector<double>> axes(1);
+    for (int i = 0; i <= 20; i++)
+        axes[0].push_back(-1.0 + 0.1 * i);
+
+    std::shared_ptr<Table> table(new Table(axes));
+    ASSERT_EQ(table->size(), 21u);
+    for (size_t i = 0; i < table->size(); i++)
+    {
+        table->x(i) << table->schedule(i)(0), 0.0;
+        table->u(i) << 9.81 * std::sin(table->schedule(i)(0));
+    }
+
+    Eigen::Matrix2d Q = Eigen::Matrix2d::Identity();
+    Eigen::Matrix<double, 1, 1> R = Eigen::Matrix<double, 1, 1>::Identity();
+    std::shared_ptr<PendulumLinearization> linearization(new PendulumLinearization);
+
+    // the parallel design equals the serial one and the LQR at every operating point
+    Table serialTable = *table;
+    GainScheduledLQR<2, 1> parallelDesign(linearization, Q, R, 4);
+    GainScheduledLQR<2, 1> serialDesign(linearization, Q, R, 1);
+    ASSERT_TRUE(parallelDesign.compute(*table));
+    ASSERT_TRUE(serialDesign.compute(serialTable));
+
+    LQR<2, 1> lqr;
+    for (size_t i = 0; i < table->size(); i++)
+    {
+        Eigen::Matrix<double, 1, 2> K;
+        ASSERT_TRUE(lqr.compute(Q, R, linearization->getDerivativeState(table->x(i), table->u(i)),
+            linearization->getDerivativeControl(table->x(i), table->u(i)), K));
+        ASSERT_EQ(table->K(i), serialTable.K(i));
+        ASSERT_LT((table->K(i) + K).cwiseAbs().maxCoeff(), 1e-10);
+    }
+
+    // the file round trip restores the table
+    const std::string filename = "gainScheduleTest.bin";
+    table->save(filename);
+    Table loadedTable;
+    loadedTable.load(filename);
+    ASSERT_TRUE(loadedTable.isGrid());
+    ASSERT_EQ(loadedTable.axes(), table->axes());
+    for (size_t i = 0; i < table->size(); i++)
+    {
+        ASSERT_EQ(loadedTable.x(i), table->x(i));
+        ASSERT_EQ(loadedTable.u(i), table->u(i));
+        ASSERT_EQ(loadedTable.K(i), table->K(i));
+    }
+    std::remove(filename.c_str());
+
+    // schedule on the angle
+    Controller::selection_matrix_t S(1, 2);
+    S << 1.0, 0.0;
+
+    Controller multilinear(table, S, Controller::MULTILINEAR);
+    Controller nearest(table, S, Controller::NEAREST);
+    Controller rbf(table, S, Controller::RBF, 1e-3);
+
+    auto entryControl = [&](size_t i, const ct::core::StateVector<2>& x) {
+        return ct::core::ControlVector<1>(table->u(i) + table->K(i) * (x - table->x(i)));
+    };
+
+    ct::core::StateVector<2> x;
+    ct::core::ControlVector<1> u_multilinear, u_nearest, u_rbf;
+
+    // at an operating point, all controllers apply its feedback law
+    x << 0.3, 0.2;
+    multilinear.computeControl(x, 0.0, u_multilinear);
+    nearest.computeControl(x, 0.0, u_nearest);
+    rbf.computeControl(x, 0.0, u_rbf);
+    ASSERT_LT((u_multilinear - entryControl(13, x)).norm(), 1e-10);
+    ASSERT_LT((u_nearest - entryControl(13, x)).norm(), 1e-10);
+    ASSERT_LT((u_rbf - entryControl(13, x)).norm(), 1e-10);
+
+    // in between, the laws are blended linearly or the nearest one is chosen
+    x << 0.325, -0.1;
+    multilinear.computeControl(x, 0.0, u_multilinear);
+    nearest.computeControl(x, 0.0, u_nearest);
+    ASSERT_LT((u_multilinear - 0.75 * entryControl(13, x) - 0.25 * entryControl(14, x)).norm(), 1e-10);
+    ASSERT_LT((u_nearest - entryControl(13, x)).norm(), 1e-10);
+
+    // outside the grid, the closest law is applied
+    x << 2.0, 0.0;
+    multilinear.computeControl(x, 0.0, u_multilinear);
+    ASSERT_LT((u_multilinear - entryControl(20, x)).norm(), 1e-10);
+
+    // scattered points are looked up by their distance
+    std::vector<Table::schedule_vector_t, Eigen::aligned_allocator<Table::schedule_vector_t>> points;
+    for (size_t i : {0, 10, 20})
+        points.push_back(table->schedule(i));
+    std::shared_ptr<Table> scattered(new Table(points));
+    ASSERT_FALSE(scattered->isGrid());
+    for (size_t i = 0; i < 3; i++)
+    {
+        scattered->x(i) = table->x(10 * i);
+        scattered->u(i) = table->u(10 * i);
+    }
+    ASSERT_TRUE(parallelDesign.compute(*scattered));
+    ASSERT_THROW(Controller(scattered, S, Controller::MULTILINEAR), std::runtime_error);
+
+    Controller nearestScattered(scattered, S, Controller::NEAREST);
+    x << 0.7, 0.0;
+    nearestScattered.computeControl(x, 0.0, u_nearest);
+    ASSERT_LT((u_nearest - entryControl(20, x)).norm(), 1e-10);
+
+    // a sampling time selects the discrete-time design, which converges to the continuous-time one
+    GainScheduledLQR<2, 1> discreteDesign(linearization, Q * 1e-4, R * 1e-4);
+    discreteDesign.setSamplingTime(1e-4);
+    Table discreteTable = *table;
+    ASSERT_TRUE(discreteDesign.compute(discreteTable));
+    for (size_t i = 0; i < table->size(); i++)
+        ASSERT_LT((discreteTable.K(i) - table->K(i)).cwiseAbs().maxCoeff(), 1e-2 * table->K(i).cwiseAbs().maxCoeff());
+}
+
 #ifdef MATLAB
 TEST(LQRTest, matlabTest)
 {
@@ -156,6 +156,147 @@ TEST(MPCTestA, ForwardIntegratorTest)
 }
 
 
+/**
+ * Shift the horizon inside one solver, warm-start a second solver with the shifted policy and check that both find the
+ * same solution in the next MPC iteration
+ * @param costFunction cost function of the linear oscillator problem
+ * @param reuseShiftedLinearization whether the shifting solver keeps the linearization of the shifted shots
+ * @param expectedReusedShots number of shots the shifting solver is expected to reuse
+ */
+void compareShiftWithWarmStart(const shared_ptr<CostFunctionQuadratic<state_dim, control_dim>>& costFunction,
+    const bool reuseShiftedLinearization,
+    const size_t expectedReusedShots)
+{
+    typedef tpl::LinearOscillator<double> LinearOscillator;
+    typedef tpl::LinearOscillatorLinear<double> LinearOscillatorLinear;
+
+    StateVector<state_dim> x0;
+    x0.setRandom();
+
+    const double timeHorizon = 1.0;
+
+    shared_ptr<ControlledSystem<state_dim, control_dim>> system(new LinearOscillator);
+    shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearOscillatorLinear);
+
+    ContinuousOptConProblem<state_dim, control_dim> optConProblem(system, costFunction, analyticLinearSystem);
+    optConProblem.setTimeHorizon(timeHorizon);
+    optConProblem.setInitialState(x0);
+
+    NLOptConSettings nloc_settings;
+    nloc_settings.dt = 0.01;
+    nloc_settings.K_sim = 1;
+    nloc_settings.K_shot = 2;
+    nloc_settings.max_iterations = 5;
+    nloc_settings.min_cost_improvement = 1e-10;
+    nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    nloc_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+    nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    nloc_settings.integrator = ct::core::IntegrationType::EULER;
+    nloc_settings.nThreads = 1;
+    nloc_settings.nThreadsEigen = 1;
+    nloc_settings.printSummary = false;
+
+    const int K = nloc_settings.computeK(timeHorizon);
+
+    FeedbackArray<state_dim, control_dim> u0_fb(K, FeedbackMatrix<state_dim, control_dim>::Zero());
+    ControlVectorArray<control_dim> u0_ff(K, ControlVector<control_dim>::Zero());
+    StateVectorArray<state_dim> x_ref(K + 1, x0);
+    ct::core::StateFeedbackController<state_dim, control_dim> initController(x_ref, u0_ff, u0_fb, nloc_settings.dt);
+
+    // the first solver shifts its converged shots, the second one recomputes everything
+    NLOptConSettings nloc_settings_shift = nloc_settings;
+    nloc_settings_shift.reuseShiftedLinearization = reuseShiftedLinearization;
+    nloc_settings_shift.linearizationReuseTolerance = 1e-6;
+
+    NLOptConSolver<state_dim, control_dim> shiftSolver(optConProblem, nloc_settings_shift);
+    NLOptConSolver<state_dim, control_dim> warmStartSolver(optConProblem, nloc_settings);
+
+    shiftSolver.setInitialGuess(initController);
+    warmStartSolver.setInitialGuess(initController);
+    shiftSolver.solve();
+    warmStartSolver.solve();
+
+    // shift about 10 stages, which is a multiple of the shot length
+    const double delay = 0.105;
+    ct::core::StateFeedbackController<state_dim, control_dim> policy = warmStartSolver.getSolution();
+    StateFeedbackPolicyHandler<state_dim, control_dim, double> policyHandler(nloc_settings.dt);
+    policyHandler.designWarmStartingPolicy(delay, timeHorizon, policy);
+
+    ASSERT_TRUE(shiftSolver.shiftHorizon(delay));
+    warmStartSolver.setInitialGuess(policy);
+
+    const StateVector<state_dim> x_start = policy.getReferenceStateTrajectory().front();
+    for (auto* solver : {&shiftSolver, &warmStartSolver})
+    {
+        solver->prepareMPCIteration();
+        solver->changeInitialState(x_start);
+        solver->finishMPCIteration();
+    }
+
+    ASSERT_EQ(shiftSolver.getBackend()->getNumReusedShots(), expectedReusedShots);
+    ASSERT_EQ(warmStartSolver.getBackend()->getNumReusedShots(), 0u);
+
+    const ct::core::StateVectorArray<state_dim>& x_shift = shiftSolver.getSolution().x_ref();
+    const ct::core::StateVectorArray<state_dim>& x_warm = warmStartSolver.getSolution().x_ref();
+    const ct::core::ControlVectorArray<control_dim>& u_shift = shiftSolver.getSolution().uff();
+    const ct::core::ControlVectorArray<control_dim>& u_warm = warmStartSolver.getSolution().uff();
+
+    ASSERT_EQ(x_shift.size(), x_warm.size());
+    ASSERT_EQ(u_shift.size(), u_warm.size());
+    for (size_t k = 0; k < u_warm.size(); k++)
+    {
+        ASSERT_LT((x_shift[k] - x_warm[k]).norm(), 1e-5);
+        ASSERT_LT((u_shift[k] - u_warm[k]).norm(), 1e-5);
+    }
+}
+
+
+/**
+ * Test that shifting the horizon inside the solver is equivalent to warm-starting it with the shifted policy
+ */
+TEST(MPCTestA, ShiftHorizonTest)
+{
+    Eigen::Vector2d x_final;
+    x_final << 20, 0;
+
+    // the MPC iteration prepares the 49 shots after the first one. Of these, the 5 appended shots are recomputed and
+    // the 44 shifted ones are reused.
+    compareShiftWithWarmStart(tpl::createCostFunctionLinearOscillator<double>(x_final), true, 44u);
+
+    // by default, all shots are recomputed
+    compareShiftWithWarmStart(tpl::createCostFunctionLinearOscillator<double>(x_final), false, 0u);
+}
+
+
+/**
+ * Test that shifting the horizon is equivalent to warm-starting for a cost function which depends on time
+ */
+TEST(MPCTestA, ShiftHorizonTimeVaryingCostTest)
+{
+    Eigen::Vector2d x_final;
+    x_final << 20, 0;
+
+    // a waypoint in the middle of the horizon, which becomes active at an earlier stage after the shift
+    Eigen::Matrix2d Q_waypoint = 100.0 * Eigen::Matrix2d::Identity();
+    Eigen::Matrix<double, 1, 1> R_waypoint = Eigen::Matrix<double, 1, 1>::Zero();
+    Eigen::Vector2d x_waypoint;
+    x_waypoint << 5, 0;
+
+    shared_ptr<TermQuadratic<state_dim, control_dim>> waypoint(new TermQuadratic<state_dim, control_dim>(
+        Q_waypoint, R_waypoint, x_waypoint, ControlVector<control_dim>::Zero()));
+    waypoint->setTimeActivation(
+        shared_ptr<core::tpl::ActivationBase<double>>(new core::tpl::SingleActivation<double>(0.3, 0.5)));
+
+    shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+        tpl::createCostFunctionLinearOscillator<double>(x_final);
+    costFunction->addIntermediateTerm(waypoint);
+    costFunction->initialize();
+
+    // reusing the shifted shots would keep the waypoint at the stages before the shift
+    compareShiftWithWarmStart(costFunction, false, 0u);
+}
+
+
 TEST(MPCTestB, NLOC_MPC_DoublePrecision)
 {
     typedef tpl::LinearOscillator<double> LinearOscillator;
@@ -171,6 +171,217 @@ TEST(LinearSystemsTest, NLOCSolverTest)
 }  // end TEST
 
 
+TEST(LinearSystemsTest, BinaryLogTest)
+{
+    typedef NLOptConSolver<state_dim, control_dim, state_dim / 2, state_dim / 2> NLOptConSolver;
+
+    Eigen::Vector2d x_final;
+    x_final << 20, 0;
+
+    StateVector<state_dim> initState;
+    initState.setZero();
+    initState(1) = 1.0;
+
+    NLOptConSettings nloc_settings;
+    nloc_settings.dt = 0.01;
+    nloc_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+    nloc_settings.printSummary = false;
+    nloc_settings.logToBinary = true;
+    nloc_settings.loggingPrefix = "binaryLogTest";
+
+    shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(new LinearOscillator());
+    shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearOscillatorLinear());
+    shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+        tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+    ct::core::Time tf = 1.0;
+    size_t nSteps = nloc_settings.computeK(tf);
+
+    StateVectorArray<state_dim> x0(nSteps + 1, initState);
+    ControlVector<control_dim> uff;
+    uff << kStiffness * initState(0);
+    ControlVectorArray<control_dim> u0(nSteps, uff);
+    FeedbackArray<state_dim, control_dim> u0_fb(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero());
+    NLOptConSolver::Policy_t initController(x0, u0, u0_fb, nloc_settings.dt);
+
+    ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+        tf, x0[0], nonlinearSystem, costFunction, analyticLinearSystem);
+
+    StateVectorArray<state_dim> x_solution;
+    SummaryAllIterations<double> summary;
+    {
+        NLOptConSolver solver(optConProblem, nloc_settings);
+        solver.setInitialGuess(initController);
+        solver.runIteration();
+        solver.runIteration();
+
+        x_solution = solver.getBackend()->getStateTrajectory().getDataArray();
+        summary = solver.getBackend()->getSummary();
+    }  // closes the log
+
+    const std::string filename = nloc_settings.loggingPrefix + "Log.ctlog";
+    ct::core::BinaryLogReader reader(filename);
+
+    // one record per iteration and channel
+    for (const std::string& channel : reader.channels())
+        ASSERT_EQ(reader.records(channel).size(), 2u);
+
+    const ct::core::BinaryLogReader::Record& x = reader.records("x").back();
+    ASSERT_EQ(x.iteration, 1u);
+    ASSERT_EQ(x.data.rows(), (int)state_dim);
+    ASSERT_EQ(x.data.cols(), (int)nSteps + 1);
+    for (size_t k = 0; k <= nSteps; k++)
+        ASSERT_EQ(x.data.col(k), x_solution[k]);
+
+    ASSERT_EQ(reader.records("A").back().data.rows(), (int)(state_dim * state_dim));
+    for (size_t i = 0; i < 2; i++)
+    {
+        ASSERT_EQ(reader.records("lx_norm")[i].data(0, 0), summary.lx_norms[i]);
+        ASSERT_EQ(reader.records("totalCost")[i].data(0, 0), summary.totalCosts[i]);
+    }
+
+    std::remove(filename.c_str());
+}
+
+
+//! a linear oscillator with configurable stiffness and damping, one mode of a switched system
+class OscillatorMode : public LinearSystem<state_dim, control_dim>
+{
+public:
+    OscillatorMode(double stiffness, double damping)
+    {
+        A_ << 0.0, 1.0, -stiffness, -damping;
+        B_ << 0.0, 1.0;
+    }
+
+    const StateMatrix<state_dim>& getDerivativeState(const StateVector<state_dim>& x,
+        const ControlVector<control_dim>& u,
+        const double t = 0.0) override
+    {
+        return A_;
+    }
+
+    const StateControlMatrix<state_dim, control_dim>& getDerivativeControl(const StateVector<state_dim>& x,
+        const ControlVector<control_dim>& u,
+        const double t = 0.0) override
+    {
+        return B_;
+    }
+
+    OscillatorMode* clone() const override { return new OscillatorMode(*this); }
+private:
+    StateMatrix<state_dim> A_;
+    StateControlMatrix<state_dim, control_dim> B_;
+};
+
+/*!
+ * Solves a problem with a switched linear system once with the mode sequence handed to NLOC, which cuts the shots at
+ * the switch and dispatches each stage to the dynamics of its mode, and once with the mode looked up by the switched
+ * system. Both have to converge to the same solution. The switch is exactly representable on the time grid.
+ */
+TEST(LinearSystemsTest, SwitchedSystemTest)
+{
+    typedef NLOptConSolver<state_dim, control_dim, state_dim / 2, state_dim / 2> NLOptConSolver;
+    typedef SwitchedControlledSystem<state_dim, control_dim> SwitchedSystem;
+    typedef SwitchedLinearSystem<state_dim, control_dim> SwitchedLinearSystem;
+
+    Eigen::Vector2d x_final;
+    x_final << 20, 0;
+
+    StateVector<state_dim> initState;
+    initState.setZero();
+    initState(1) = 1.0;
+
+    NLOptConSettings nloc_settings;
+    nloc_settings.epsilon = 0.0;
+    nloc_settings.fixedHessianCorrection = false;
+    nloc_settings.dt = 1.0 / 64.0;
+    nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    nloc_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+    nloc_settings.K_shot = 8;
+    nloc_settings.integrator = ct::core::IntegrationType::EULERCT;
+    nloc_settings.printSummary = false;
+
+    // two modes with different stiffness and damping, switching at stage 20
+    std::shared_ptr<OscillatorMode> mode1(new OscillatorMode(kStiffness, 0.0));
+    std::shared_ptr<OscillatorMode> mode2(new OscillatorMode(2.0 * kStiffness, 1.0));
+
+    ContinuousModeSequence modeSequence;
+    modeSequence.addPhase(0, 20 * nloc_settings.dt);
+    modeSequence.addPhase(1, 1.0);
+
+    std::shared_ptr<SwitchedSystem> switchedSystem(new SwitchedSystem({mode1, mode2}, modeSequence));
+    std::shared_ptr<SwitchedLinearSystem> switchedLinearSystem(
+        new SwitchedLinearSystem({mode1, mode2}, modeSequence));
+    shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+        tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+    ct::core::Time tf = 1.0;
+    size_t nSteps = nloc_settings.computeK(tf);
+
+    StateVectorArray<state_dim> x0(nSteps + 1, initState);
+    ControlVectorArray<control_dim> u0(nSteps, ControlVector<control_dim>::Zero());
+    FeedbackArray<state_dim, control_dim> u0_fb(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero());
+    NLOptConSolver::Policy_t initController(x0, u0, u0_fb, nloc_settings.dt);
+
+    ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+        tf, x0[0], switchedSystem, costFunction, switchedLinearSystem);
+
+    // toggle between single and multi-threading
+    for (size_t nThreads = 1; nThreads < 5; nThreads = nThreads + 3)
+    {
+        nloc_settings.nThreads = nThreads;
+
+        NLOptConSolver switchedSolver(optConProblem, nloc_settings);
+        switchedSolver.getBackend()->setModeSequence(modeSequence);
+        switchedSolver.setInitialGuess(initController);
+
+        // the shots are cut at the switch
+        const auto& backend = switchedSolver.getBackend();
+        ASSERT_EQ(backend->getStageModes().size(), nSteps);
+        ASSERT_EQ(backend->getStageModes()[19], 0u);
+        ASSERT_EQ(backend->getStageModes()[20], 1u);
+        ASSERT_EQ(backend->getNextShotStart(16), 20);
+        ASSERT_EQ(backend->getNextShotStart(20), 28);
+        ASSERT_TRUE(backend->isShotStart(20));
+        ASSERT_FALSE(backend->isShotStart(24));
+
+        NLOptConSolver lookupSolver(optConProblem, nloc_settings);
+        lookupSolver.setInitialGuess(initController);
+        ASSERT_TRUE(lookupSolver.getBackend()->getStageModes().empty());
+        ASSERT_EQ(lookupSolver.getBackend()->getNextShotStart(16), 24);
+
+        for (size_t i = 0; i < 2; i++)
+        {
+            switchedSolver.runIteration();
+            lookupSolver.runIteration();
+        }
+
+        const SummaryAllIterations<double>& summary = backend->getSummary();
+        ASSERT_LT(summary.lx_norms.back(), 1e-10);
+        ASSERT_LT(summary.defect_l1_norms.back(), 1e-10);
+
+        const StateVectorArray<state_dim> x_switched = backend->getStateTrajectory().getDataArray();
+        const StateVectorArray<state_dim> x_lookup = lookupSolver.getBackend()->getStateTrajectory().getDataArray();
+        const ControlVectorArray<control_dim> u_switched = backend->getControlTrajectory().getDataArray();
+        const ControlVectorArray<control_dim> u_lookup =
+            lookupSolver.getBackend()->getControlTrajectory().getDataArray();
+        for (size_t k = 0; k < nSteps; k++)
+        {
+            ASSERT_LT((x_switched[k] - x_lookup[k]).norm(), 1e-8);
+            ASSERT_LT((u_switched[k] - u_lookup[k]).norm(), 1e-8);
+        }
+
+        // the shots move along with the mode sequence, shifting by a whole shot keeps them aligned
+        backend->shiftHorizon(8);
+        ASSERT_EQ(backend->getStageModes()[11], 0u);
+        ASSERT_EQ(backend->getStageModes()[12], 1u);
+        ASSERT_EQ(backend->getNextShotStart(8), 12);
+        ASSERT_EQ(backend->getNextShotStart(12), 20);
+    }
+}
+
+
 }  // namespace example
 }  // namespace optcon
 }  // namespace ct
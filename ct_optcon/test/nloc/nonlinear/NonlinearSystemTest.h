@@ -5,6 +5,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <chrono>
 #include <fenv.h>
+#include <numeric>
 
 #include <gtest/gtest.h>
 
@@ -116,6 +117,233 @@ TEST(NLOCTest, NonlinearSystemAlgorithmComparison)
         ASSERT_NEAR(uRollout_gnms[i](0), uRollout_ilqr[i](0), 1e-4);
     }
 }
+
+TEST(NLOCTest, LineSearchMeritBoundAbort)
+{
+    typedef NLOptConSolver<state_dim, control_dim, 1, 0> NLOptConSolver;
+
+    std::string configFile = std::string(NLOC_TEST_DIR) + "/nonlinear/solver.info";
+    std::string costFunctionFile = std::string(NLOC_TEST_DIR) + "/nonlinear/cost.info";
+
+    Eigen::Matrix<double, 1, 1> x_0;
+    ct::core::loadMatrix(costFunctionFile, "x_0", x_0);
+
+    std::shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(new Dynamics);
+    std::shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearizedSystem);
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction(
+        new CostFunctionAnalytical<state_dim, control_dim>(costFunctionFile));
+
+    ct::core::Time tf = 3.0;
+    ct::core::loadScalar(configFile, "timeHorizon", tf);
+
+    // the line search of the single- and multi-threaded backends needs to give the same result with and without abort
+    for (size_t nThreads : {1, 3})
+    {
+        NLOptConSettings settings;
+        settings.load(configFile, false, "gnms");
+        settings.nThreads = nThreads;
+        settings.lineSearchSettings.type = LineSearchSettings::TYPE::SIMPLE;
+        settings.lineSearchSettings.maxIterations = 20;
+
+        size_t nSteps = settings.computeK(tf);
+
+        // a poor initial guess, such that the line search needs to backtrack
+        ControlVectorArray<control_dim> u0(nSteps, ControlVector<control_dim>::Constant(-2.0 * (x_0(0) + 1) * x_0(0)));
+        StateVectorArray<state_dim> x0(nSteps + 1, x_0);
+        FeedbackArray<state_dim, control_dim> u0_fb(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero());
+        NLOptConSolver::Policy_t initController(x0, u0, u0_fb, settings.dt);
+
+        std::vector<StateTrajectory<state_dim>> xSolutions;
+        std::vector<ControlTrajectory<control_dim>> uSolutions;
+
+        for (bool abortOnMeritBound : {false, true})
+        {
+            settings.lineSearchSettings.abortOnMeritBound = abortOnMeritBound;
+
+            ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+                tf, x0[0], nonlinearSystem, costFunction, analyticLinearSystem);
+
+            NLOptConSolver solver(optConProblem, settings);
+            solver.configure(settings);
+            solver.setInitialGuess(initController);
+            solver.solve();
+
+            xSolutions.push_back(solver.getStateTrajectory());
+            uSolutions.push_back(solver.getControlTrajectory());
+
+            // the poor initial guess makes at least one candidate exceed the merit bound
+            const std::vector<size_t>& aborts = solver.getBackend()->getSummary().lineSearchAborts;
+            const size_t nAborts = std::accumulate(aborts.begin(), aborts.end(), size_t(0));
+            if (abortOnMeritBound)
+            {
+                ASSERT_GT(nAborts, 0u);
+            }
+            else
+            {
+                ASSERT_EQ(nAborts, 0u);
+            }
+        }
+
+        for (size_t i = 0; i < xSolutions[0].size(); i++)
+            ASSERT_NEAR(xSolutions[0][i](0), xSolutions[1][i](0), 1e-10);
+
+        for (size_t i = 0; i < uSolutions[0].size(); i++)
+            ASSERT_NEAR(uSolutions[0][i](0), uSolutions[1][i](0), 1e-10);
+    }
+}
+
+TEST(NLOCTest, ParallelDiscretization)
+{
+    typedef NLOptConSolver<state_dim, control_dim, 1, 0> NLOptConSolver;
+
+    std::string configFile = std::string(NLOC_TEST_DIR) + "/nonlinear/solver.info";
+    std::string costFunctionFile = std::string(NLOC_TEST_DIR) + "/nonlinear/cost.info";
+
+    Eigen::Matrix<double, 1, 1> x_0;
+    ct::core::loadMatrix(costFunctionFile, "x_0", x_0);
+
+    std::shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(new Dynamics);
+    std::shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearizedSystem);
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction(
+        new CostFunctionAnalytical<state_dim, control_dim>(costFunctionFile));
+
+    ct::core::Time tf = 3.0;
+    ct::core::loadScalar(configFile, "timeHorizon", tf);
+
+    std::vector<StateTrajectory<state_dim>> xSolutions;
+    std::vector<ControlTrajectory<control_dim>> uSolutions;
+
+    // the discretization threads of the single-threaded backend are kept over all iterations and give the same result
+    for (size_t nThreadsDiscretization : {1, 3})
+    {
+        NLOptConSettings settings;
+        settings.load(configFile, false, "gnms");
+        settings.nThreads = 1;
+        settings.useSensitivityIntegrator = false;
+        settings.discretization = NLOptConSettings::APPROXIMATION::MATRIX_EXPONENTIAL;
+        settings.nThreadsDiscretization = nThreadsDiscretization;
+
+        size_t nSteps = settings.computeK(tf);
+
+        ControlVectorArray<control_dim> u0(nSteps, ControlVector<control_dim>::Constant(-(x_0(0) + 1) * x_0(0)));
+        StateVectorArray<state_dim> x0(nSteps + 1, x_0);
+        FeedbackArray<state_dim, control_dim> u0_fb(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero());
+        NLOptConSolver::Policy_t initController(x0, u0, u0_fb, settings.dt);
+
+        ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+            tf, x0[0], nonlinearSystem, costFunction, analyticLinearSystem);
+
+        NLOptConSolver solver(optConProblem, settings);
+        solver.setInitialGuess(initController);
+        solver.solve();
+
+        xSolutions.push_back(solver.getStateTrajectory());
+        uSolutions.push_back(solver.getControlTrajectory());
+    }
+
+    for (size_t i = 0; i < xSolutions[0].size(); i++)
+        ASSERT_EQ(xSolutions[0][i](0), xSolutions[1][i](0));
+
+    for (size_t i = 0; i < uSolutions[0].size(); i++)
+        ASSERT_EQ(uSolutions[0][i](0), uSolutions[1][i](0));
+}
+
+TEST(NLOCTest, ExactHessian)
+{
+    typedef NLOptConSolver<state_dim, control_dim, 1, 0> NLOptConSolver;
+
+    std::string configFile = std::string(NLOC_TEST_DIR) + "/nonlinear/solver.info";
+    std::string costFunctionFile = std::string(NLOC_TEST_DIR) + "/nonlinear/cost.info";
+
+    Eigen::Matrix<double, 1, 1> x_0;
+    ct::core::loadMatrix(costFunctionFile, "x_0", x_0);
+
+    std::shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(new Dynamics);
+    std::shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearizedSystem);
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction(
+        new CostFunctionAnalytical<state_dim, control_dim>(costFunctionFile));
+
+    ct::core::Time tf = 3.0;
+    ct::core::loadScalar(configFile, "timeHorizon", tf);
+
+    std::vector<StateTrajectory<state_dim>> xSolutions;
+    std::vector<ControlTrajectory<control_dim>> uSolutions;
+    std::vector<size_t> iterations;
+
+    // the Gauss-Newton and the exact Hessian iterations need to converge to the same solution
+    for (size_t nThreads : {1, 3})
+    {
+        for (bool exactHessian : {false, true})
+        {
+            NLOptConSettings settings;
+            settings.load(configFile, false, "gnms");
+            settings.nThreads = nThreads;
+            settings.useSensitivityIntegrator = false;
+            settings.max_iterations = 20;
+            settings.exactHessian = exactHessian;
+
+            size_t nSteps = settings.computeK(tf);
+
+            ControlVectorArray<control_dim> u0(nSteps, ControlVector<control_dim>::Constant(-(x_0(0) + 1) * x_0(0)));
+            StateVectorArray<state_dim> x0(nSteps + 1, x_0);
+            FeedbackArray<state_dim, control_dim> u0_fb(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero());
+            NLOptConSolver::Policy_t initController(x0, u0, u0_fb, settings.dt);
+
+            ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+                tf, x0[0], nonlinearSystem, costFunction, analyticLinearSystem);
+
+            NLOptConSolver solver(optConProblem, settings);
+            solver.configure(settings);
+            solver.setInitialGuess(initController);
+            solver.solve();
+
+            xSolutions.push_back(solver.getStateTrajectory());
+            uSolutions.push_back(solver.getControlTrajectory());
+            iterations.push_back(solver.getBackend()->iteration());
+        }
+
+        // close to the solution, the exact Hessian converges quadratically
+        ASSERT_LT(iterations[iterations.size() - 1], iterations[iterations.size() - 2]);
+    }
+
+    for (size_t j = 1; j < xSolutions.size(); j++)
+    {
+        for (size_t i = 0; i < xSolutions[0].size(); i++)
+            ASSERT_NEAR(xSolutions[0][i](0), xSolutions[j][i](0), 1e-4);
+
+        for (size_t i = 0; i < uSolutions[0].size(); i++)
+            ASSERT_NEAR(uSolutions[0][i](0), uSolutions[j][i](0), 1e-4);
+    }
+
+    // the exact Hessian requires the Riccati solver
+    NLOptConSettings settings;
+    settings.load(configFile, false, "gnms");
+    settings.exactHessian = true;
+    settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::HPIPM_SOLVER;
+    ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+        tf, x_0, nonlinearSystem, costFunction, analyticLinearSystem);
+    ASSERT_ANY_THROW(NLOptConSolver solver(optConProblem, settings));
+
+    // and cannot be obtained from the sensitivity integrator
+    settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    settings.useSensitivityIntegrator = true;
+    ASSERT_ANY_THROW(NLOptConSolver solver(optConProblem, settings));
+
+    // nor from a numerical linearization, which is the default without a linear system
+    settings.useSensitivityIntegrator = false;
+    ContinuousOptConProblem<state_dim, control_dim> numDiffProblem(tf, x_0, nonlinearSystem, costFunction);
+    ASSERT_ANY_THROW(NLOptConSolver solver(numDiffProblem, settings));
+
+    std::shared_ptr<LinearSystem<state_dim, control_dim>> numDiffLinearSystem(
+        new SystemLinearizer<state_dim, control_dim>(nonlinearSystem));
+    NLOptConSolver solver(optConProblem, settings);
+    ASSERT_ANY_THROW(solver.changeLinearSystem(numDiffLinearSystem));
+
+    // and the fixed Hessian correction cannot handle an indefinite Hessian
+    settings.fixedHessianCorrection = true;
+    ASSERT_ANY_THROW(NLOptConSolver solver(optConProblem, settings));
+}
+
 }  // namespace example
 }  // namespace optcon
 }  // namespace ct
@@ -0,0 +1,114 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+using namespace ct;
+using namespace ct::optcon;
+
+const size_t state_dim = 5;
+const size_t control_dim = 2;
+const int N = 8;
+
+//! creates a random, strictly convex LQ problem
+std::shared_ptr<LQOCProblem<state_dim, control_dim>> createRandomProblem()
+{
+    std::shared_ptr<LQOCProblem<state_dim, control_dim>> p(new LQOCProblem<state_dim, control_dim>(N));
+
+    for (int k = 0; k <= N; k++)
+    {
+        Eigen::Matrix<double, state_dim, state_dim> M = Eigen::Matrix<double, state_dim, state_dim>::Random();
+        p->Q_[k] = M * M.transpose() + Eigen::Matrix<double, state_dim, state_dim>::Identity();
+        p->qv_[k].setRandom();
+
+        if (k == N)
+            break;
+
+        Eigen::Matrix<double, control_dim, control_dim> W = Eigen::Matrix<double, control_dim, control_dim>::Random();
+        p->R_[k] = W * W.transpose() + Eigen::Matrix<double, control_dim, control_dim>::Identity();
+        p->rv_[k].setRandom();
+        p->P_[k] = 0.1 * ct::core::FeedbackMatrix<state_dim, control_dim>::Random();
+
+        p->A_[k] = ct::core::StateMatrix<state_dim>::Identity() + 0.1 * ct::core::StateMatrix<state_dim>::Random();
+        p->B_[k].setRandom();
+        p->b_[k].setRandom();
+    }
+
+    return p;
+}
+
+//! solves the LQ problem by condensing it into a dense QP in the controls
+Eigen::VectorXd solveCondensed(const LQOCProblem<state_dim, control_dim>& p)
+{
+    const int nx = (N + 1) * state_dim;
+    const int nu = N * control_dim;
+
+    // the states are an affine function of the controls, x = Su * u + sc, with x_0 = 0
+    Eigen::MatrixXd Su = Eigen::MatrixXd::Zero(nx, nu);
+    Eigen::VectorXd sc = Eigen::VectorXd::Zero(nx);
+    for (int k = 0; k < N; k++)
+    {
+        Su.middleRows<state_dim>((k + 1) * state_dim) = p.A_[k] * Su.middleRows<state_dim>(k * state_dim);
+        Su.block<state_dim, control_dim>((k + 1) * state_dim, k * control_dim) = p.B_[k];
+        sc.segment<state_dim>((k + 1) * state_dim) = p.A_[k] * sc.segment<state_dim>(k * state_dim) + p.b_[k];
+    }
+
+    Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(nx, nx);
+    Eigen::VectorXd q(nx);
+    Eigen::MatrixXd R = Eigen::MatrixXd::Zero(nu, nu);
+    Eigen::VectorXd r(nu);
+    Eigen::MatrixXd P = Eigen::MatrixXd::Zero(nu, nx);
+    for (int k = 0; k <= N; k++)
+    {
+        Q.block<state_dim, state_dim>(k * state_dim, k * state_dim) = p.Q_[k];
+        q.segment<state_dim>(k * state_dim) = p.qv_[k];
+        if (k < N)
+        {
+            R.block<control_dim, control_dim>(k * control_dim, k * control_dim) = p.R_[k];
+            r.segment<control_dim>(k * control_dim) = p.rv_[k];
+            P.block<control_dim, state_dim>(k * control_dim, k * state_dim) = p.P_[k];
+        }
+    }
+
+    const Eigen::MatrixXd H = Su.transpose() * Q * Su + R + P * Su + Su.transpose() * P.transpose();
+    const Eigen::VectorXd g = Su.transpose() * (Q * sc + q) + r + P * sc;
+
+    return H.ldlt().solve(-g);
+}
+
+
+TEST(GNRiccatiSolverTest, CompareToCondensedSolution)
+{
+    for (int trial = 0; trial < 10; trial++)
+    {
+        std::shared_ptr<LQOCProblem<state_dim, control_dim>> problem = createRandomProblem();
+        const Eigen::VectorXd u_ref = solveCondensed(*problem);
+
+        for (bool fixedHessianCorrection : {true, false})
+        {
+            NLOptConSettings settings;
+            settings.fixedHessianCorrection = fixedHessianCorrection;
+            settings.epsilon = 0.0;
+
+            GNRiccatiSolver<state_dim, control_dim> solver;
+            solver.configure(settings);
+            solver.setProblem(problem);
+            solver.solve();
+            solver.computeStatesAndControls();
+
+            const ct::core::ControlVectorArray<control_dim>& u = solver.getSolutionControl();
+            for (int k = 0; k < N; k++)
+                ASSERT_LT((u[k] - u_ref.segment<control_dim>(k * control_dim)).norm(), 1e-8);
+        }
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
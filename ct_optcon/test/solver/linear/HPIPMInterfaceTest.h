@@ -113,3 +113,76 @@ TEST(HPIPMInterfaceTest, compareSolvers)
         ASSERT_LT((lv_sol_hpipm[i] - lv_sol_gnriccati[i]).array().abs().maxCoeff(), 1e-6);
     }
 }
+
+
+TEST(HPIPMInterfaceTest, reuseMemory)
+{
+    const size_t state_dim = 8;
+    const size_t control_dim = 3;
+
+    double dt = 0.5;
+
+    typedef ct::optcon::LQOCProblem<state_dim, control_dim> LQOCProblem_t;
+
+    StateVector<state_dim> stateOffset;
+    stateOffset.setConstant(0.1);
+    ControlVector<control_dim> u0;
+    u0.setZero();
+
+    StateMatrix<state_dim> Q;
+    Q.setIdentity();
+    ControlMatrix<control_dim> R;
+    R.setIdentity();
+
+    ct::optcon::CostFunctionQuadraticSimple<state_dim, control_dim> costFunction(
+        Q, R, -stateOffset, u0, -stateOffset, Q);
+
+    std::shared_ptr<ct::core::LinearSystem<state_dim, control_dim>> system(new LinkedMasses());
+    ct::core::SensitivityApproximation<state_dim, control_dim> discretizedSystem(
+        dt, system, ct::optcon::NLOptConSettings::APPROXIMATION::MATRIX_EXPONENTIAL);
+
+    // size the memory once for the largest problem
+    ct::optcon::HPIPMInterface<state_dim, control_dim> hpipm;
+    hpipm.reserve(10);
+    ASSERT_EQ(hpipm.getNumberOfReallocations(), 1u);
+
+    for (int N : {5, 10, 8})
+    {
+        for (bool boxConstrained : {false, true})
+        {
+            std::shared_ptr<LQOCProblem_t> lqocProblem_hpipm(new LQOCProblem_t(N));
+            std::shared_ptr<LQOCProblem_t> lqocProblem_gnriccati(new LQOCProblem_t(N));
+            lqocProblem_hpipm->setFromTimeInvariantLinearQuadraticProblem(
+                discretizedSystem, costFunction, stateOffset, dt);
+            lqocProblem_gnriccati->setFromTimeInvariantLinearQuadraticProblem(
+                discretizedSystem, costFunction, stateOffset, dt);
+
+            // inactive input bounds, which change the problem dimensions but not the solution
+            if (boxConstrained)
+            {
+                Eigen::VectorXi sp(control_dim);
+                sp << 0, 1, 2;
+                Eigen::VectorXd u_lb = Eigen::VectorXd::Constant(control_dim, -1e3);
+                Eigen::VectorXd u_ub = Eigen::VectorXd::Constant(control_dim, 1e3);
+                lqocProblem_hpipm->setInputBoxConstraints(
+                    control_dim, u_lb, u_ub, sp, ct::core::ControlVectorArray<control_dim>(N, u0));
+            }
+
+            hpipm.setProblem(lqocProblem_hpipm);
+            hpipm.solve();
+            hpipm.computeStatesAndControls();
+
+            ct::optcon::GNRiccatiSolver<state_dim, control_dim> gnriccati;
+            gnriccati.setProblem(lqocProblem_gnriccati);
+            gnriccati.solve();
+            gnriccati.computeStatesAndControls();
+
+            for (int i = 0; i < N; i++)
+                ASSERT_LT((hpipm.getSolutionControl()[i] - gnriccati.getSolutionControl()[i]).array().abs().maxCoeff(),
+                    1e-6);
+        }
+    }
+
+    // none of the problems required more memory than reserved
+    ASSERT_EQ(hpipm.getNumberOfReallocations(), 1u);
+}
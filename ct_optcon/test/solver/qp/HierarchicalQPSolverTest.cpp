@@ -0,0 +1,191 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+using namespace ct;
+using namespace ct::optcon;
+
+typedef ActiveSetQPSolver<>::MatrixXs MatrixXs;
+typedef ActiveSetQPSolver<>::VectorXs VectorXs;
+typedef HierarchicalQPSolver<>::Task Task;
+
+//! check the KKT conditions of a convex quadratic program
+void assertKKT(const MatrixXs& H,
+    const VectorXs& g,
+    const MatrixXs& E,
+    const VectorXs& e,
+    const MatrixXs& G,
+    const VectorXs& h,
+    const VectorXs& y,
+    const ActiveSetQPSolver<>& solver)
+{
+    const double tol = 1e-7;
+    const VectorXs& muE = solver.equalityMultipliers();
+    const VectorXs& muG = solver.inequalityMultipliers();
+
+    ASSERT_LT((H * y + g + E.transpose() * muE + G.transpose() * muG).lpNorm<Eigen::Infinity>(), tol);
+    ASSERT_LT((E * y - e).lpNorm<Eigen::Infinity>(), tol);
+    ASSERT_LT((G * y - h).maxCoeff(), tol);
+    ASSERT_GT(muG.minCoeff(), -tol);
+    ASSERT_LT(muG.cwiseProduct(G * y - h).cwiseAbs().maxCoeff(), tol);
+}
+
+TEST(ActiveSetQPSolverTest, RandomProblemTest)
+{
+    const int n = 10;
+    const int nE = 3;
+    const int nG = 20;
+
+    ActiveSetQPSolver<> solver;
+
+    for (size_t trial = 0; trial < 20; trial++)
+    {
+        MatrixXs M = MatrixXs::Random(n, n);
+        MatrixXs H = M * M.transpose() + MatrixXs::Identity(n, n);
+        VectorXs g = 10 * VectorXs::Random(n);
+        MatrixXs E = MatrixXs::Random(nE, n);
+        MatrixXs G = MatrixXs::Random(nG, n);
+
+        // the initial guess is feasible by construction
+        VectorXs y0 = VectorXs::Random(n);
+        VectorXs e = E * y0;
+        VectorXs h = G * y0 + VectorXs::Random(nG).cwiseAbs();
+
+        solver.resetWorkingSet();
+        VectorXs y = y0;
+        ASSERT_TRUE(solver.solve(H, g, E, e, G, h, y));
+        assertKKT(H, g, E, e, G, h, y, solver);
+        ASSERT_FALSE(solver.workingSet().empty());
+
+        // a slightly perturbed problem converges quickly from the previous working set
+        const size_t coldIterations = solver.iterations();
+        VectorXs yWarm = y0;
+        VectorXs gPerturbed = g + 1e-4 * VectorXs::Random(n);
+        ASSERT_TRUE(solver.solve(H, gPerturbed, E, e, G, h, yWarm));
+        assertKKT(H, gPerturbed, E, e, G, h, yWarm, solver);
+        ASSERT_LE(solver.iterations(), 1u);
+        ASSERT_LE(solver.iterations(), coldIterations);
+        ASSERT_LT((yWarm - y).norm(), 1e-2);
+
+        // redundant equalities are handled
+        MatrixXs E2(2 * nE, n);
+        E2 << E, E;
+        VectorXs e2(2 * nE);
+        e2 << e, e;
+        VectorXs y2 = y0;
+        solver.resetWorkingSet();
+        ASSERT_TRUE(solver.solve(H, g, E2, e2, G, h, y2));
+        ASSERT_LT((y2 - y).lpNorm<Eigen::Infinity>(), 1e-8);
+    }
+
+    // an infeasible initial guess and an indefinite Hessian are rejected
+    VectorXs y = VectorXs::Zero(2);
+    MatrixXs G = MatrixXs::Identity(2, 2);
+    ASSERT_THROW(solver.solve(MatrixXs::Identity(2, 2), VectorXs::Zero(2), MatrixXs(0, 2), VectorXs(0), G,
+                     -VectorXs::Ones(2), y),
+        std::runtime_error);
+    ASSERT_THROW(solver.solve(-MatrixXs::Identity(2, 2), VectorXs::Zero(2), MatrixXs(0, 2), VectorXs(0), G,
+                     VectorXs::Ones(2), y),
+        std::runtime_error);
+}
+
+TEST(HierarchicalQPSolverTest, PriorityTest)
+{
+    HierarchicalQPSolver<> solver(3);
+    std::vector<Task> tasks(3);
+
+    // level 0: z0 + z1 <= 1
+    tasks[0].C = MatrixXs::Zero(1, 3);
+    tasks[0].C << 1, 1, 0;
+    tasks[0].d = VectorXs::Ones(1);
+
+    // level 1: z0 = z1 = 2, only possible up to the constraint of level 0
+    tasks[1].A = MatrixXs::Zero(2, 3);
+    tasks[1].A << 1, 0, 0, 0, 1, 0;
+    tasks[1].b = 2 * VectorXs::Ones(2);
+
+    // level 2: z0 = 1, conflicts with level 1, and z2 = 3
+    tasks[2].A = MatrixXs::Zero(2, 3);
+    tasks[2].A << 1, 0, 0, 0, 0, 1;
+    tasks[2].b = VectorXs::Zero(2);
+    tasks[2].b << 1, 3;
+
+    VectorXs z;
+    ASSERT_TRUE(solver.solve(tasks, z));
+    ASSERT_NEAR(z(0), 0.5, 1e-6);
+    ASSERT_NEAR(z(1), 0.5, 1e-6);
+    ASSERT_NEAR(z(2), 3.0, 1e-6);
+    ASSERT_EQ(solver.slack(0).size(), 1);
+    ASSERT_NEAR(solver.slack(0)(0), 0.0, 1e-9);
+
+    // conflicting inequalities of one level are violated equally
+    tasks[0].C = MatrixXs::Zero(2, 3);
+    tasks[0].C << 1, 0, 0, -1, 0, 0;
+    tasks[0].d = VectorXs::Zero(2);
+    tasks[0].d << 1, -2;
+    solver.resetWarmStart();
+    ASSERT_TRUE(solver.solve(tasks, z));
+    ASSERT_NEAR(z(0), 1.5, 1e-6);
+    ASSERT_NEAR(solver.slack(0)(0), 0.5, 1e-6);
+    ASSERT_NEAR(solver.slack(0)(1), 0.5, 1e-6);
+    ASSERT_NEAR(z(1), 2.0, 1e-6);
+    ASSERT_NEAR(z(2), 3.0, 1e-6);
+
+    tasks[1].A = MatrixXs::Zero(2, 2);
+    ASSERT_THROW(solver.solve(tasks, z), std::runtime_error);
+}
+
+TEST(HierarchicalQPSolverTest, RandomHierarchyTest)
+{
+    const size_t n = 12;
+    const size_t nLevels = 4;
+
+    for (size_t trial = 0; trial < 10; trial++)
+    {
+        std::vector<Task> tasks(nLevels);
+        for (size_t k = 0; k < nLevels; k++)
+        {
+            tasks[k].A = MatrixXs::Random(3, n);
+            tasks[k].b = VectorXs::Random(3);
+            tasks[k].C = MatrixXs::Random(4, n);
+            tasks[k].d = VectorXs::Random(4);
+        }
+
+        HierarchicalQPSolver<> solver(n);
+        VectorXs z;
+        ASSERT_TRUE(solver.solve(tasks, z));
+
+        // the feasible tasks of level 0 are satisfied exactly
+        ASSERT_LT((tasks[0].A * z - tasks[0].b).norm(), 1e-6);
+        ASSERT_LT((tasks[0].C * z - tasks[0].d).maxCoeff(), 1e-6);
+
+        // lower levels do not degrade the solution of higher levels
+        for (size_t k = 1; k < nLevels; k++)
+        {
+            std::vector<Task> truncated(tasks.begin(), tasks.begin() + k);
+            HierarchicalQPSolver<> truncatedSolver(n);
+            VectorXs zTruncated;
+            ASSERT_TRUE(truncatedSolver.solve(truncated, zTruncated));
+            const Task& last = tasks[k - 1];
+            ASSERT_NEAR((last.A * z - last.b).squaredNorm() + solver.slack(k - 1).squaredNorm(),
+                (last.A * zTruncated - last.b).squaredNorm() + truncatedSolver.slack(k - 1).squaredNorm(), 1e-6);
+        }
+
+        // warm start: resolving the same hierarchy takes no iterations on any level
+        VectorXs zWarm = z;
+        ASSERT_TRUE(solver.solve(tasks, zWarm));
+        for (size_t k = 0; k < nLevels; k++)
+            ASSERT_EQ(solver.levelSolver(k).iterations(), 0u);
+        ASSERT_LT((zWarm - z).norm(), 1e-6);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,6 +1,7 @@
 # cmake-onfig file for the ct_rbd package
 
 find_package(ct_optcon REQUIRED)
+find_package(OpenMP REQUIRED)
 
 include(${CMAKE_CURRENT_LIST_DIR}/ct_rbd_export.cmake)
 
@@ -146,24 +146,46 @@ public:
 	 */
     EEForcesLinear computeContactForces(const RBDState<NJOINTS, SCALAR>& state)
     {
-        EEForcesLinear eeForces;
+        // base orientation and velocities are shared by all end-effectors
+        const Matrix3s R_WB = state.basePose().getRotationMatrix().toImplementation();
+        const Vector3s B_v_base = state.base().velocities().getTranslationalVelocity().toImplementation();
+        const Vector3s B_omega_base = state.base().velocities().getRotationalVelocity().toImplementation();
 
+        // forward kinematics of all active end-effectors in one sweep, positions are reused for the velocities below
+        EEVectors B_p_EE = EEVectors::Zero();
         for (size_t i = 0; i < NUM_EE; i++)
-        {
             if (EEactive_[i])
-            {
-                Vector3s eePenetration = computePenetration(i, state.basePose(), state.jointPositions());
-
-                if (eeInContact(eePenetration))
-                {
-                    Velocity3S eeVelocity = kinematics_->getEEVelocityInWorld(i, state);
-                    eeForces[i] = computeEEForce(eePenetration, eeVelocity);
-                }
-                else
-                {
-                    eeForces[i].setZero();
-                }
-            }
+                B_p_EE.col(i) = kinematics_->getEEPositionInBase(i, state.jointPositions()).toImplementation();
+
+        // we currently assume flat ground at height zero, penetration is only z height
+        const EEScalars penetration =
+            ((R_WB.row(2) * B_p_EE).array() + state.basePose().position().toImplementation()(2)).matrix();
+
+        // end-effector velocities, only required for end-effectors in contact
+        ActiveMap inContact;
+        EEVectors B_v_EE = EEVectors::Zero();
+        for (size_t i = 0; i < NUM_EE; i++)
+        {
+            inContact[i] = EEactive_[i] && eeInContact(penetration(i));
+
+            if (inContact[i])
+                B_v_EE.col(i) = (kinematics_->getJacobianBaseEEbyId(i, state) * state.jointVelocities())
+                                    .template bottomRows<3>() +
+                                B_v_base + B_omega_base.cross(B_p_EE.col(i));
+        }
+
+        // the contact law, evaluated for all end-effectors at once on packed 3 x NUM_EE matrices
+        EEVectors forces = computeDamperForces(R_WB * B_v_EE);
+        smoothForces(forces, penetration);
+        addNormalSpringForces(forces, penetration);
+
+        EEForcesLinear eeForces;
+        for (size_t i = 0; i < NUM_EE; i++)
+        {
+            if (inContact[i])
+                eeForces[i] = forces.col(i);
+            else
+                eeForces[i].setZero();
         }
 
         return eeForces;
@@ -177,79 +199,57 @@ public:
     VELOCITY_SMOOTHING& smoothing() { return smoothing_; }
 
 private:
+    typedef Eigen::Matrix<SCALAR, 3, 3> Matrix3s;
+    typedef Eigen::Matrix<SCALAR, 3, NUM_EE> EEVectors;  //!< one column per end-effector
+    typedef Eigen::Matrix<SCALAR, 1, NUM_EE> EEScalars;  //!< one entry per end-effector
+
     /**
 	 * \brief Checks if end-effector is in contact. Currently assumes this is the case for negative z
-	 * @param eePenetration The surface penetration of the end-effector
+	 * @param eePenetration The surface penetration (z height) of the end-effector
 	 * @return flag if the end-effector is in contact
 	 */
-    bool eeInContact(const Vector3s& eePenetration)
+    bool eeInContact(const SCALAR& eePenetration)
     {
-        if (smoothing_ == NONE && eePenetration(2) > 0.0)
+        if (smoothing_ == NONE && eePenetration > 0.0)
             return false;
         else
             return true;
     }
 
-
-    /**
-	 * \brief Computes the surface penetration. Currently assumes the surface is at height z = 0.
-	 * @param eeId ID of the end-effector
-	 * @param basePose Position of the robot base
-	 * @param jointPosition Joint position of the robot
-	 * @return Penetration in world coordinates
-	 */
-    Vector3s computePenetration(const size_t& eeId,
-        const tpl::RigidBodyPose<SCALAR>& basePose,
-        const typename JointState<NJOINTS, SCALAR>::Position& jointPosition)
-    {
-        Position3S pos = kinematics_->getEEPositionInWorld(eeId, basePose, jointPosition);
-
-        // we currently assume flat ground at height zero penetration is only z height
-        Vector3s penetration;
-        penetration << SCALAR(0.0), SCALAR(0.0), pos.z();
-
-        return penetration;
-    }
-
     /*!
-	 * \brief Compute the endeffector force based on penetration and velocity
-	 * @param eePenetration end-effector penetration
-	 * @param eeVelocity end-effector velocity
-	 * @return resulting force vecttor
+	 * \brief computes the damper forces \f$ \lambda = - d \dot{x} \f$ of all end-effectors
+	 * @param eeVelocities end-effector velocities in world coordinates
 	 */
-    EEForceLinear computeEEForce(const Vector3s& eePenetration, const Velocity3S& eeVelocity)
-    {
-        EEForceLinear eeForce;
-
-        computeDamperForce(eeForce, eePenetration, eeVelocity);
-
-        smoothEEForce(eeForce, eePenetration);
-
-        computeNormalSpring(eeForce, eePenetration(2) - zOffset_, eeVelocity.toImplementation()(2));
-
-        return eeForce;
-    }
-
+    EEVectors computeDamperForces(const EEVectors& eeVelocities) { return -d_ * eeVelocities; }
     /*!
 	 * \brief Smoothes out the endeffector forces
-	 * @param eeForce endeffector force to modify
-	 * @param eePenetration penetration of the surface
+	 * @param forces endeffector forces to modify
+	 * @param penetration penetration of the surface
 	 */
-    void smoothEEForce(EEForceLinear& eeForce, const Vector3s& eePenetration)
+    void smoothForces(EEVectors& forces, const EEScalars& penetration)
     {
+        // element-wise transcendental functions go through the trait to remain auto-diffable
+        auto expOp = [](const SCALAR& x) { return TRAIT::exp(x); };
+        auto tanhOp = [](const SCALAR& x) { return TRAIT::tanh(x); };
+        auto fabsOp = [](const SCALAR& x) { return TRAIT::fabs(x); };
+
+        const Eigen::Array<SCALAR, 1, NUM_EE> alphaPenetration = alpha_ * penetration.array();
+
         switch (smoothing_)
         {
             case NONE:
                 return;
             case SIGMOID:
-                eeForce *= 1. / (1. + TRAIT::exp(eePenetration(2) * alpha_));
+                forces.array().rowwise() *= (SCALAR(1.0) + alphaPenetration.unaryExpr(expOp)).inverse();
                 return;
             case TANH:
                 // same as sigmoid, maybe cheaper / more expensive to compute?
-                eeForce *= 0.5 * TRAIT::tanh(-0.5 * eePenetration(2) * alpha_) + 0.5;
+                forces.array().rowwise() *=
+                    SCALAR(0.5) * (SCALAR(-0.5) * alphaPenetration).unaryExpr(tanhOp) + SCALAR(0.5);
                 return;
             case ABS:
-                eeForce *= 0.5 * -eePenetration(2) * alpha_ / (1. + TRAIT::fabs(-eePenetration(2) * alpha_)) + 0.5;
+                forces.array().rowwise() *=
+                    SCALAR(-0.5) * alphaPenetration / (SCALAR(1.0) + alphaPenetration.unaryExpr(fabsOp)) + SCALAR(0.5);
                 return;
             default:
                 throw std::runtime_error("undefined smoothing function");
@@ -257,25 +257,24 @@ private:
     }
 
     /*!
-	 * \brief computes the damper force \f$ \lambda = d \dot{x} \f$
-	 * @param force force to be computed
-	 * @param eePenetration endeffector penetration of the surface
-	 * @param eeVelocity endeffector velocity
+	 * \brief adds the normal spring forces to all end-effector forces
+	 * @param forces endeffector forces to modify
+	 * @param penetration penetration of the surface
 	 */
-    void computeDamperForce(EEForceLinear& force, const Vector3s& eePenetration, const Velocity3S& eeVelocity)
+    void addNormalSpringForces(EEVectors& forces, const EEScalars& penetration)
     {
-        force = -d_ * eeVelocity.toImplementation();
-    }
+        const EEScalars p_N = (penetration.array() - zOffset_).matrix();
 
-    void computeNormalSpring(EEForceLinear& force, const SCALAR& p_N, const SCALAR& p_dot_N)
-    {
         if (alpha_n_ > SCALAR(0))
         {
-            force(2) += k_ * TRAIT::exp(-alpha_n_ * p_N);
+            auto expOp = [](const SCALAR& x) { return TRAIT::exp(x); };
+            forces.row(2) += k_ * (-alpha_n_ * p_N).unaryExpr(expOp);
         }
-        else if (p_N <= SCALAR(0))
+        else
         {
-            force(2) -= k_ * p_N;
+            for (size_t i = 0; i < NUM_EE; i++)
+                if (p_N(i) <= SCALAR(0))
+                    forces(2, i) -= k_ * p_N(i);
         }
     }
 
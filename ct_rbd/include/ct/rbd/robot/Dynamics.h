@@ -63,6 +63,8 @@ public:
     typedef Eigen::Matrix<SCALAR, NSTATE, 1> state_vector_t;
     typedef Eigen::Matrix<SCALAR, 6, 1> Vector6d_t;
     typedef Vector6d_t ForceVector_t;
+    typedef Eigen::Matrix<SCALAR, 6 + NJOINTS, 6 + NJOINTS> InertiaMatrix_t;
+    typedef Eigen::Matrix<SCALAR, 6 + NJOINTS, 1> GeneralizedForce_t;
 
     typedef RBDState<NJOINTS, SCALAR> RBDState_t;
     typedef RBDAcceleration<NJOINTS, SCALAR> RBDAcceleration_t;
@@ -187,6 +189,16 @@ public:
         control_vector_t& u);
 
 
+    /**
+	 * @brief Computes the terms of the equations of motion of a floating-base system
+	 * \f$ M(q) \ddot{q} + h(q, \dot{q}) = S^\top \tau + J_c^\top \lambda \f$
+	 * in the coordinates of RBDState::toCoordinateVelocity(), e.g. to set up a whole-body controller once per state
+	 * @param[in]	x		The RBDState
+	 * @param[out]	M		The joint space inertia matrix
+	 * @param[out]	h		The Coriolis, centrifugal and gravity forces
+	 */
+    ENABLE_FLOAT_BASE FloatingBaseDynamicsTerms(const RBDState_t& x, InertiaMatrix_t& M, GeneralizedForce_t& h);
+
     /**
 	 * @brief Computes Projected Forward Dynamics of a floating-base system with contact constraints
 	 * @param[in]	ee_contact	the EE contact configuration (EEDataMap<bool>)
@@ -319,6 +331,23 @@ ENABLE_FLOAT_BASE_IMPL Dynamics<RBD, NEE>::FloatingBaseFullyActuatedID(const RBD
         qdd.getAcceleration(), l_forces);
 }
 
+template <class RBD, size_t NEE>
+ENABLE_FLOAT_BASE_IMPL Dynamics<RBD, NEE>::FloatingBaseDynamicsTerms(const RBDState_t& x,
+    InertiaMatrix_t& M,
+    GeneralizedForce_t& h)
+{
+    ForceVector_t base_w, base_w_gravity;
+    control_vector_t jForces, jForces_gravity;
+
+    kinematics_->robcogen().inverseDynamics().C_terms_fully_actuated(
+        base_w, jForces, x.baseVelocities().getVector(), x.joints().getPositions(), x.joints().getVelocities());
+    kinematics_->robcogen().inverseDynamics().G_terms_fully_actuated(
+        base_w_gravity, jForces_gravity, x.basePose().computeGravityB6D(), x.joints().getPositions());
+
+    M = kinematics_->robcogen().jSim().update(x.joints().getPositions());
+    h << base_w + base_w_gravity, jForces + jForces_gravity;
+}
+
 #undef ENABLE_FIX_BASE
 #undef ENABLE_FIX_BASE_IMPL
 #undef ENABLE_FLOAT_BASE
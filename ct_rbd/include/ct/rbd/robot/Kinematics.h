@@ -13,6 +13,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "kinematics/EndEffector.h"
 #include "kinematics/FloatingBaseTransforms.h"
 #include "kinematics/InverseKinematicsBase.h"
+#include "kinematics/KinematicsCache.h"
 
 namespace ct {
 namespace rbd {
@@ -21,7 +22,12 @@ namespace rbd {
  * \brief A general class for computing Kinematic properties
  *
  * This class implements useful Kinematic quantities. It wraps RobCoGen to
- * have access to efficient transforms and jacobians.
+ * have access to efficient transforms and jacobians. The end-effector transforms
+ * and Jacobians as well as the link force transforms are cached for the last
+ * joint positions, see KinematicsCache. Consumers sharing an instance of this
+ * class hence share the forward kinematics of the same state. Copies and clones
+ * create their own RobCoGen container and cache, such that consumers which should
+ * share the cache need to hold the same instance, e.g. through a Ptr_t.
  */
 template <class RBD, size_t N_EE>
 class Kinematics
@@ -30,13 +36,16 @@ public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
     Kinematics(std::shared_ptr<RBD> rbdContainer = std::shared_ptr<RBD>(new RBD()))
-        : rbdContainer_(rbdContainer), floatingBaseTransforms_(rbdContainer_)
+        : rbdContainer_(rbdContainer), floatingBaseTransforms_(rbdContainer_), cache_(rbdContainer_)
     {
         initEndeffectors(endEffectors_);
     }
 
     Kinematics(const Kinematics<RBD, N_EE>& other)
-        : rbdContainer_(new RBD()), endEffectors_(other.endEffectors_), floatingBaseTransforms_(rbdContainer_)
+        : rbdContainer_(new RBD()),
+          endEffectors_(other.endEffectors_),
+          floatingBaseTransforms_(rbdContainer_),
+          cache_(rbdContainer_)
     {
     }
 
@@ -66,6 +75,7 @@ public:
     using EEForce = SpatialForceVector<SCALAR>;
     using EEForceLinear = Vector3Tpl;
     using JointState_t = JointState<NJOINTS, SCALAR>;
+    using Cache_t = KinematicsCache<RBD, N_EE>;
 
     void initEndeffectors(std::array<EndEffector<NJOINTS, SCALAR>, NUM_EE>& endeffectors)
     {
@@ -90,9 +100,19 @@ public:
 
     Jacobian getJacobianBaseEEbyId(size_t eeId, const RBDState<NJOINTS, SCALAR>& rbdState)
     {
-        return robcogen().getJacobianBaseEEbyId(eeId, rbdState.jointPositions());
+        return cache_.getJacobianBaseEE(eeId, rbdState.jointPositions());
     }
 
+    //! get the end-effector transform from the cache, see RobCoGenContainer::getHomogeneousTransformBaseEEById()
+    HomogeneousTransform getHomogeneousTransformBaseEEById(size_t eeId,
+        const typename JointState_t::Position& jointPosition)
+    {
+        return cache_.getHomogeneousTransformBaseEE(eeId, jointPosition);
+    }
+
+    //! the cache of the forward kinematics
+    Cache_t& cache() { return cache_; }
+
     FloatingBaseTransforms<RBD>& floatingBaseTransforms()
     {
         throw std::runtime_error("floating base transforms not implemented");
@@ -113,7 +133,7 @@ public:
     {
         Velocity3Tpl eeVelocityBase;
         eeVelocityBase.toImplementation() =
-            (robcogen().getJacobianBaseEEbyId(eeId, rbdState.jointPositions()) * rbdState.jointVelocities())
+            (cache_.getJacobianBaseEE(eeId, rbdState.jointPositions()) * rbdState.jointVelocities())
                 .template bottomRows<3>();
 
         // add translational velocity induced by linear base motion
@@ -144,7 +164,8 @@ public:
      */
     Position3Tpl getEEPositionInBase(size_t eeID, const typename JointState_t::Position& jointPosition)
     {
-        return robcogen().getEEPositionInBase(eeID, jointPosition);
+        return Position3Tpl(
+            cache_.getHomogeneousTransformBaseEE(eeID, jointPosition).template topRightCorner<3, 1>().eval());
     }
 
     /*!
@@ -156,7 +177,7 @@ public:
      */
     RigidBodyPoseTpl getEEPoseInBase(size_t eeID, const typename JointState_t::Position& jointPosition)
     {
-        return robcogen().getEEPoseInBase(eeID, jointPosition);
+        return RigidBodyPoseTpl(cache_.getHomogeneousTransformBaseEE(eeID, jointPosition), RigidBodyPoseTpl::EULER);
     }
 
     /*!
@@ -164,7 +185,7 @@ public:
      */
     Matrix3Tpl getEERotInBase(size_t eeID, const typename JointState_t::Position& jointPosition)
     {
-        return robcogen().getEERotInBase(eeID, jointPosition);
+        return cache_.getHomogeneousTransformBaseEE(eeID, jointPosition).template topLeftCorner<3, 3>();
     }
 
     /*!
@@ -310,7 +331,7 @@ public:
                            basePose.template rotateInertiaToBase<Vector3Tpl>(W_force.torque());
 
         // transform force to link on which endeffector sits on
-        return EEForce(robcogen().getForceTransformLinkBaseById(linkId, jointPosition) * B_force);
+        return EEForce(cache_.getForceTransformLinkBase(linkId, jointPosition) * B_force);
     }
 
     /**
@@ -354,7 +375,7 @@ public:
             B_x_EE.cross(B_force.force()) + T_B_EE.template rotateBaseToInertia<Vector3Tpl>(EE_force.torque());
 
         // transform force to link on which endeffector sits on
-        return EEForce(robcogen().getForceTransformLinkBaseById(linkId, jointPosition) * B_force);
+        return EEForce(cache_.getForceTransformLinkBase(linkId, jointPosition) * B_force);
     };
 
     RBD& robcogen() { return *rbdContainer_; }
@@ -362,6 +383,7 @@ private:
     std::shared_ptr<RBD> rbdContainer_;
     std::array<EndEffector<NJOINTS, SCALAR>, N_EE> endEffectors_;
     FloatingBaseTransforms<RBD> floatingBaseTransforms_;
+    Cache_t cache_;
 
     std::unordered_map<size_t, std::shared_ptr<InverseKinematicsBase<NJOINTS, SCALAR>>> ikSolvers_;
 };
@@ -187,7 +187,7 @@ private:
 template <class RBD, size_t NEE>
 ProjectedDynamics<RBD, NEE>::ProjectedDynamics(const std::shared_ptr<Kinematics<RBD, NEE>> kyn,
     const EE_in_contact_t ee_inc /*= EE_in_Contact_t(false)*/)
-    : kinematics_(kyn), ee_in_contact_(ee_inc)
+    : kinematics_(kyn), ee_in_contact_(ee_inc), Jc_(kyn)
 {
     setContactConfiguration(ee_inc);
 }
@@ -0,0 +1,194 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace rbd {
+
+template <class RBD, size_t NEE>
+HierarchicalWholeBodyController<RBD, NEE>::HierarchicalWholeBodyController(const std::shared_ptr<Dynamics_t>& dynamics,
+    const control_vector_t& torqueLimits,
+    double frictionCoefficient)
+    : dynamics_(dynamics),
+      Jc_(dynamics_->kinematicsPtr()),
+      eeInContact_(false),
+      torqueLimits_(torqueLimits),
+      frictionCoefficient_(frictionCoefficient),
+      solver_(NVARIABLES),
+      qpTasks_(1),
+      z_(Eigen::VectorXd::Zero(NVARIABLES))
+{
+    setContactConfiguration(eeInContact_);
+}
+
+template <class RBD, size_t NEE>
+HierarchicalWholeBodyController<RBD, NEE>::HierarchicalWholeBodyController(const HierarchicalWholeBodyController& other)
+    : ct::core::Controller<STATE_DIM, NJOINTS>(other),
+      dynamics_(new Dynamics_t(*other.dynamics_)),
+      Jc_(dynamics_->kinematicsPtr()),
+      eeInContact_(other.eeInContact_),
+      torqueLimits_(other.torqueLimits_),
+      frictionCoefficient_(other.frictionCoefficient_),
+      tasks_(other.tasks_),
+      solver_(NVARIABLES),
+      qpTasks_(other.qpTasks_),
+      z_(other.z_)
+{
+    setContactConfiguration(eeInContact_);
+}
+
+template <class RBD, size_t NEE>
+HierarchicalWholeBodyController<RBD, NEE>* HierarchicalWholeBodyController<RBD, NEE>::clone() const
+{
+    return new HierarchicalWholeBodyController<RBD, NEE>(*this);
+}
+
+template <class RBD, size_t NEE>
+void HierarchicalWholeBodyController<RBD, NEE>::computeControl(const core::StateVector<STATE_DIM>& state,
+    const core::Time& t,
+    core::ControlVector<NJOINTS>& control)
+{
+    RBDState_t x;
+    x.fromStateVectorEulerXyz(state);
+
+    control_vector_t u;
+    computeTorque(x, t, u);
+    control = u;
+}
+
+template <class RBD, size_t NEE>
+bool HierarchicalWholeBodyController<RBD, NEE>::computeTorque(const RBDState_t& x,
+    const core::Time& t,
+    control_vector_t& u)
+{
+    qpTasks_.resize(tasks_.size() + 1);
+
+    setupConstraintLevel(x);
+
+    // stack the tasks of equal priority
+    for (size_t priority = 0; priority < tasks_.size(); priority++)
+    {
+        QPTask_t& level = qpTasks_[priority + 1];
+
+        size_t nRows = 0;
+        for (const Task_ptr& task : tasks_[priority])
+            nRows += task->size();
+
+        level.A.setZero(nRows, NVARIABLES);
+        level.b.resize(nRows);
+
+        size_t row = 0;
+        for (const Task_ptr& task : tasks_[priority])
+        {
+            task->computeTask(x, t, taskJacobian_, taskTarget_);
+            level.A.block(row, 0, task->size(), NDOF) = taskJacobian_;
+            level.b.segment(row, task->size()) = taskTarget_;
+            row += task->size();
+        }
+    }
+
+    const bool converged = solver_.solve(qpTasks_, z_);
+
+    u = z_.template tail<NJOINTS>();
+    return converged;
+}
+
+template <class RBD, size_t NEE>
+void HierarchicalWholeBodyController<RBD, NEE>::addTask(const Task_ptr& task, size_t priority)
+{
+    if (tasks_.size() <= priority)
+        tasks_.resize(priority + 1);
+    tasks_[priority].push_back(task);
+
+    // the structure of the hierarchy changed
+    solver_.resetWarmStart();
+}
+
+template <class RBD, size_t NEE>
+void HierarchicalWholeBodyController<RBD, NEE>::setContactConfiguration(const EE_in_contact_t& eeInContact)
+{
+    eeInContact_ = eeInContact;
+
+    Jc_.ee_indices_.clear();
+    Jc_.c_size_ = 0;
+    for (size_t ee = 0; ee < NEE; ee++)
+    {
+        Jc_.eeInContact_[ee] = eeInContact_[ee];
+        if (eeInContact_[ee])
+        {
+            Jc_.ee_indices_.push_back(ee);
+            Jc_.c_size_ += 3;
+        }
+    }
+
+    // the friction constraints change, hence the active constraints of the last solution are meaningless
+    solver_.resetWarmStart();
+}
+
+template <class RBD, size_t NEE>
+void HierarchicalWholeBodyController<RBD, NEE>::setupConstraintLevel(const RBDState_t& x)
+{
+    QPTask_t& level = qpTasks_[0];
+
+    const size_t nContacts = Jc_.ee_indices_.size();
+    const size_t LAMBDA = NDOF;
+    const size_t TAU = NDOF + 3 * NEE;
+
+    dynamics_->FloatingBaseDynamicsTerms(x, M_, h_);
+
+    Jc_.updateState(x);
+    const Eigen::Matrix<double, NDOF, 1> qd = x.toCoordinateVelocity();
+
+    // equations of motion and contact constraints
+    level.A.setZero(NDOF + 3 * NEE, NVARIABLES);
+    level.b.setZero(NDOF + 3 * NEE);
+
+    level.A.template block<NDOF, NDOF>(0, 0) = M_;
+    level.A.template block<NDOF, 3 * NEE>(0, LAMBDA) = -Jc_.J().transpose();
+    level.A.template block<NJOINTS, NJOINTS>(6, TAU) = -Eigen::Matrix<double, NJOINTS, NJOINTS>::Identity();
+    level.b.template head<NDOF>() = -h_;
+
+    for (size_t ee = 0; ee < NEE; ee++)
+    {
+        if (eeInContact_[ee])
+        {
+            level.A.template block<3, NDOF>(NDOF + 3 * ee, 0) = Jc_.J().template block<3, NDOF>(3 * ee, 0);
+            level.b.template segment<3>(NDOF + 3 * ee) =
+                -Jc_.dJdt().template block<3, NDOF>(3 * ee, 0) * qd -
+                x.baseLocalAngularVelocity().toImplementation().cross(
+                    dynamics_->kinematics().getEEVelocityInBase(ee, x).toImplementation());
+        }
+        else
+            level.A.template block<3, 3>(NDOF + 3 * ee, LAMBDA + 3 * ee).setIdentity();
+    }
+
+    // torque limits and friction pyramids, with the ground normal and tangents in the base frame
+    level.C.setZero(2 * NJOINTS + 5 * nContacts, NVARIABLES);
+    level.d.setZero(2 * NJOINTS + 5 * nContacts);
+
+    level.C.template block<NJOINTS, NJOINTS>(0, TAU).setIdentity();
+    level.C.template block<NJOINTS, NJOINTS>(NJOINTS, TAU) = -Eigen::Matrix<double, NJOINTS, NJOINTS>::Identity();
+    level.d.template head<NJOINTS>() = torqueLimits_;
+    level.d.template segment<NJOINTS>(NJOINTS) = torqueLimits_;
+
+    const Eigen::Vector3d n = x.basePose().rotateInertiaToBase(Eigen::Vector3d(Eigen::Vector3d::UnitZ()));
+    const Eigen::Vector3d t1 = x.basePose().rotateInertiaToBase(Eigen::Vector3d(Eigen::Vector3d::UnitX()));
+    const Eigen::Vector3d t2 = x.basePose().rotateInertiaToBase(Eigen::Vector3d(Eigen::Vector3d::UnitY()));
+    const double mu = frictionCoefficient_ / std::sqrt(2.0);
+
+    size_t row = 2 * NJOINTS;
+    for (size_t ee : Jc_.ee_indices_)
+    {
+        level.C.template block<1, 3>(row++, LAMBDA + 3 * ee) = (t1 - mu * n).transpose();
+        level.C.template block<1, 3>(row++, LAMBDA + 3 * ee) = (-t1 - mu * n).transpose();
+        level.C.template block<1, 3>(row++, LAMBDA + 3 * ee) = (t2 - mu * n).transpose();
+        level.C.template block<1, 3>(row++, LAMBDA + 3 * ee) = (-t2 - mu * n).transpose();
+        level.C.template block<1, 3>(row++, LAMBDA + 3 * ee) = -n.transpose();
+    }
+}
+
+}  // namespace rbd
+}  // namespace ct
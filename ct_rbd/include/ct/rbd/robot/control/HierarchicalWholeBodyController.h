@@ -0,0 +1,134 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ct/optcon/optcon.h>
+
+#include <ct/rbd/robot/Dynamics.h>
+#include <ct/rbd/robot/jacobian/ConstraintJacobian.h>
+#include "WholeBodyTask.h"
+
+namespace ct {
+namespace rbd {
+
+/**
+ * @brief Whole-body inverse dynamics controller for floating-base robots based on a hierarchy of quadratic programs
+ *
+ * The controller optimizes the generalized accelerations, the contact forces of all end-effectors and the joint
+ * torques \f$ z = [\ddot{q}, \lambda, \tau] \f$. The highest priority level enforces the physics:
+ * - the equations of motion \f$ M \ddot{q} + h = S^\top \tau + J_c^\top \lambda \f$,
+ * - no acceleration of the end-effectors in contact, \f$ J_c \ddot{q} + \dot{J}_c \dot{q} = 0 \f$,
+ * - zero forces at the end-effectors not in contact,
+ * - the torque limits and a friction pyramid with non-negative normal forces for the end-effectors in contact.
+ *
+ * The tasks, e.g. OperationalSpaceTask, follow on the levels below, ordered by their priority. Tasks with the same
+ * priority are weighted equally. The hierarchy is solved with ct::optcon::HierarchicalQPSolver, which is warm started
+ * from the active constraints of the last control step. The mass matrix and the bias forces are computed once per
+ * control step with Dynamics::FloatingBaseDynamicsTerms().
+ *
+ * Forces, friction cone and contact Jacobians are expressed in the base frame, the friction cone assumes a horizontal
+ * ground.
+ *
+ * @tparam RBD  The rbd container class
+ * @tparam NEE  The number of endeffectors
+ */
+template <class RBD, size_t NEE>
+class HierarchicalWholeBodyController : public ct::core::Controller<2 * 6 + 2 * RBD::NJOINTS, RBD::NJOINTS>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    static const size_t NJOINTS = RBD::NJOINTS;
+    static const size_t NDOF = 6 + NJOINTS;
+    static const size_t STATE_DIM = 2 * NDOF;
+    //! number of optimization variables
+    static const size_t NVARIABLES = NDOF + 3 * NEE + NJOINTS;
+
+    typedef Dynamics<RBD, NEE> Dynamics_t;
+    typedef typename Dynamics_t::RBDState_t RBDState_t;
+    typedef typename Dynamics_t::control_vector_t control_vector_t;
+    typedef typename Dynamics_t::EE_in_contact_t EE_in_contact_t;
+    typedef typename Dynamics_t::Kinematics_t Kinematics_t;
+    typedef typename WholeBodyTask<NJOINTS>::Ptr Task_ptr;
+    typedef typename optcon::HierarchicalQPSolver<double>::Task QPTask_t;
+
+    /**
+	 * @brief The constructor
+	 * @param[in]	dynamics			The dynamics of the robot
+	 * @param[in]	torqueLimits		The symmetric joint torque limits
+	 * @param[in]	frictionCoefficient	The friction coefficient of the contacts
+	 */
+    HierarchicalWholeBodyController(const std::shared_ptr<Dynamics_t>& dynamics,
+        const control_vector_t& torqueLimits,
+        double frictionCoefficient = 0.7);
+
+    HierarchicalWholeBodyController(const HierarchicalWholeBodyController& other);
+
+    virtual ~HierarchicalWholeBodyController() {}
+    //! the clone owns a copy of the dynamics and shares the tasks
+    virtual HierarchicalWholeBodyController<RBD, NEE>* clone() const override;
+
+    virtual void computeControl(const core::StateVector<STATE_DIM>& state,
+        const core::Time& t,
+        core::ControlVector<NJOINTS>& control) override;
+
+    /**
+	 * @brief compute the joint torques
+	 * @param[in]	x	The RBD state
+	 * @param[in]	t	The current time
+	 * @param[out]	u	The joint torques
+	 * @return true if all levels of the hierarchy converged
+	 */
+    bool computeTorque(const RBDState_t& x, const core::Time& t, control_vector_t& u);
+
+    /**
+	 * @brief add a task below the physical constraints
+	 * @param[in]	task		The task
+	 * @param[in]	priority	The priority of the task, 0 is the highest
+	 */
+    void addTask(const Task_ptr& task, size_t priority);
+
+    //! set the end-effectors in contact
+    void setContactConfiguration(const EE_in_contact_t& eeInContact);
+
+    void setTorqueLimits(const control_vector_t& torqueLimits) { torqueLimits_ = torqueLimits; }
+    void setFrictionCoefficient(double frictionCoefficient) { frictionCoefficient_ = frictionCoefficient; }
+    //! the generalized accelerations of the last solution
+    Eigen::Matrix<double, NDOF, 1> getAccelerations() const { return z_.template head<NDOF>(); }
+    //! the contact force of an end-effector in the base frame of the last solution
+    Eigen::Vector3d getContactForce(size_t eeId) const { return z_.template segment<3>(NDOF + 3 * eeId); }
+    //! the slack of the torque limits and friction cones of the last solution, zero if they are satisfied
+    const Eigen::VectorXd& getConstraintViolation() const { return solver_.slack(0); }
+    const optcon::HierarchicalQPSolver<double>& getSolver() const { return solver_; }
+private:
+    //! set up the highest priority level from the equations of motion, the contacts and the limits
+    void setupConstraintLevel(const RBDState_t& x);
+
+    std::shared_ptr<Dynamics_t> dynamics_;
+    //! the contact Jacobian, sharing the kinematics and hence the forward kinematics with the dynamics
+    tpl::ConstraintJacobian<Kinematics_t, 3 * NEE, NJOINTS, double> Jc_;
+
+    EE_in_contact_t eeInContact_;
+    control_vector_t torqueLimits_;
+    double frictionCoefficient_;
+
+    std::vector<std::vector<Task_ptr>> tasks_;  //!< the tasks, sorted by priority
+
+    typename Dynamics_t::InertiaMatrix_t M_;
+    typename Dynamics_t::GeneralizedForce_t h_;
+
+    optcon::HierarchicalQPSolver<double> solver_;
+    std::vector<QPTask_t> qpTasks_;
+    Eigen::VectorXd z_;  //!< the last solution
+
+    Eigen::MatrixXd taskJacobian_;
+    Eigen::VectorXd taskTarget_;
+};
+
+}  // namespace rbd
+}  // namespace ct
@@ -0,0 +1,122 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ct/rbd/state/RBDState.h>
+#include <ct/rbd/robot/jacobian/OperationalJacobianBase.h>
+#include <ct/rbd/operationalSpace/coordinate/CoordinateBase.h>
+
+namespace ct {
+namespace rbd {
+
+/**
+ * @brief A task of the HierarchicalWholeBodyController
+ *
+ * A task is a linear equation in the generalized accelerations \f$ J \ddot{q} = b \f$, in the coordinates of
+ * RBDState::toCoordinateVelocity(), which the controller satisfies in the least-squares sense according to its
+ * priority.
+ */
+template <size_t NJOINTS>
+class WholeBodyTask
+{
+public:
+    typedef std::shared_ptr<WholeBodyTask<NJOINTS>> Ptr;
+    typedef RBDState<NJOINTS> RBDState_t;
+
+    virtual ~WholeBodyTask() {}
+    //! number of task equations
+    virtual size_t size() const = 0;
+
+    /**
+	 * @brief compute the task equations at the current state
+	 * @param[in]	x	The RBD state
+	 * @param[in]	t	The current time
+	 * @param[out]	J	The task matrix with size() rows and 6 + NJOINTS columns
+	 * @param[out]	b	The task target
+	 */
+    virtual void computeTask(const RBDState_t& x, const core::Time& t, Eigen::MatrixXd& J, Eigen::VectorXd& b) = 0;
+};
+
+/**
+ * @brief An operational space task, tracking a reference acceleration with PD feedback
+ *
+ * Uses the Jacobian and coordinate classes of the operational space model, see OperationalModelBase, and commands
+ * the operational space acceleration
+ * \f$ \ddot{x}_{cmd} = \ddot{x}_{ref} + K_d (\dot{x}_{ref} - J \dot{q}) + K_p (x_{ref} - x) \f$
+ * such that the task reads \f$ J \ddot{q} = \ddot{x}_{cmd} - \dot{J} \dot{q} \f$.
+ * Without a coordinate class, the position feedback is disabled.
+ */
+template <size_t NUM_OUTPUTS, size_t NJOINTS>
+class OperationalSpaceTask : public WholeBodyTask<NJOINTS>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef typename WholeBodyTask<NJOINTS>::RBDState_t RBDState_t;
+    typedef typename OperationalJacobianBase<NUM_OUTPUTS, NJOINTS>::ptr jacobian_class_ptr_t;
+    typedef typename CoordinateBase<NUM_OUTPUTS, NJOINTS>::ptr coordinate_class_ptr_t;
+    typedef Eigen::Matrix<double, NUM_OUTPUTS, 1> output_vector_t;
+
+    OperationalSpaceTask(const jacobian_class_ptr_t& jacobian,
+        const coordinate_class_ptr_t& coordinate = nullptr,
+        const output_vector_t& Kp = output_vector_t::Zero(),
+        const output_vector_t& Kd = output_vector_t::Zero())
+        : jacobian_(jacobian),
+          coordinate_(coordinate),
+          Kp_(Kp),
+          Kd_(Kd),
+          xRef_(output_vector_t::Zero()),
+          xdRef_(output_vector_t::Zero()),
+          xddRef_(output_vector_t::Zero())
+    {
+    }
+
+    virtual ~OperationalSpaceTask() {}
+    //! set the reference position, velocity and acceleration in operational space
+    void setReference(const output_vector_t& xRef, const output_vector_t& xdRef, const output_vector_t& xddRef)
+    {
+        xRef_ = xRef;
+        xdRef_ = xdRef;
+        xddRef_ = xddRef;
+    }
+
+    void setGains(const output_vector_t& Kp, const output_vector_t& Kd)
+    {
+        Kp_ = Kp;
+        Kd_ = Kd;
+    }
+
+    virtual size_t size() const override { return NUM_OUTPUTS; }
+    virtual void computeTask(const RBDState_t& x, const core::Time& t, Eigen::MatrixXd& J, Eigen::VectorXd& b) override
+    {
+        const typename RBDState_t::coordinate_vector_t qd = x.toCoordinateVelocity();
+
+        jacobian_->updateState(x);
+        J = jacobian_->J();
+
+        output_vector_t xddCmd = xddRef_ + Kd_.cwiseProduct(xdRef_ - jacobian_->J() * qd);
+        if (coordinate_)
+            xddCmd += Kp_.cwiseProduct(xRef_ - coordinate_->getCoordinate(x));
+
+        b = xddCmd - jacobian_->dJdt() * qd;
+    }
+
+private:
+    jacobian_class_ptr_t jacobian_;
+    coordinate_class_ptr_t coordinate_;
+
+    output_vector_t Kp_;
+    output_vector_t Kd_;
+
+    output_vector_t xRef_;
+    output_vector_t xdRef_;
+    output_vector_t xddRef_;
+};
+
+}  // namespace rbd
+}  // namespace ct
@@ -5,6 +5,8 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #pragma once
 
+#include <memory>
+
 #include <ct/rbd/robot/jacobian/OperationalJacobianBase.h>
 #include <ct/rbd/state/RBDState.h>
 
@@ -27,7 +29,10 @@ public:
     typedef typename OperationalJacobianBase<OUTPUTS, NJOINTS, SCALAR>::jacobian_t jacobian_t;
     typedef Eigen::Matrix<SCALAR, 3, 3> Matrix3s;
 
-    ConstraintJacobian(){};
+    //! constructor, the Jacobian evaluates the kinematics on its own
+    ConstraintJacobian() : kinematics_(new Kinematics()) {}
+    //! constructor sharing the kinematics and hence the cached forward kinematics, e.g. with the robot dynamics
+    ConstraintJacobian(const std::shared_ptr<Kinematics>& kinematics) : kinematics_(kinematics) {}
 
     virtual ~ConstraintJacobian(){};
 
@@ -91,8 +96,7 @@ public:
             if (eeInContact_[ee_indices_[ee]])
             {
                 // Collect current contact Jacobians
-                Jc_geometric =
-                    kinematics_.robcogen().getJacobianBaseEEbyId(ee_indices_[ee], state.joints().getPositions());
+                Jc_geometric = kinematics_->cache().getJacobianBaseEE(ee_indices_[ee], state.joints().getPositions());
                 Jc_Rotational = Jc_geometric.template topRows<3>();
                 Jc_Translational = Jc_geometric.template bottomRows<3>();
 
@@ -141,10 +145,10 @@ public:
             {
                 Eigen::Matrix<SCALAR, 3, NJOINTS + 6> J_eeId;
                 kindr::Position<SCALAR, 3> eePosition =
-                    kinematics_.getEEPositionInBase(ee_indices_[ee], state.joints().getPositions());
+                    kinematics_->getEEPositionInBase(ee_indices_[ee], state.joints().getPositions());
                 Eigen::Matrix<SCALAR, 3, NJOINTS> J_single =
-                    kinematics_.robcogen()
-                        .getJacobianBaseEEbyId(ee_indices_[ee], state.joints().getPositions())
+                    kinematics_->cache()
+                        .getJacobianBaseEE(ee_indices_[ee], state.joints().getPositions())
                         .template bottomRows<3>();
                 FrameJacobian<NJOINTS, SCALAR>::FromBaseJacToInertiaJacTranslation(
                     Matrix3s::Identity(), eePosition.toImplementation(), J_single, J_eeId);
@@ -155,7 +159,7 @@ public:
 
 
 private:
-    Kinematics kinematics_;
+    std::shared_ptr<Kinematics> kinematics_;
 };
 
 }  // namespace tpl
@@ -0,0 +1,274 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <ct/core/common/Timer.h>
+
+#include "InverseKinematicsBase.h"
+
+namespace ct {
+namespace rbd {
+
+//! settings for the BatchInverseKinematics
+struct BatchInverseKinematicsSettings
+{
+    BatchInverseKinematicsSettings()
+        : nThreads(std::max(1u, std::thread::hardware_concurrency())),
+          chunkSize(16),
+          warmStartWindow(32),
+          orientationWeight(0.1)
+    {
+    }
+
+    size_t nThreads;           //!< number of OpenMP threads, each with its own solver instance
+    size_t chunkSize;          //!< number of (neighbouring) queries a thread takes at once
+    size_t warmStartWindow;    //!< number of recent solutions per thread searched for the nearest neighbour
+    double orientationWeight;  //!< weight of the angular distance [m/rad] in the pose distance
+};
+
+
+/*!
+ * \brief Solves batches of inverse kinematics queries in parallel
+ *
+ * The queries are solved in an OpenMP parallel loop. Every thread owns a separate solver instance, created through the
+ * factory passed on construction, such that solvers which are not thread-safe (e.g. the Ipopt based IKNLPSolverIpopt)
+ * can be used. Without OpenMP, the queries are solved sequentially by the first solver.
+ *
+ * The queries are sorted along a space filling curve (Morton order of the target positions) and handed to the threads
+ * in chunks of neighbouring targets. Every query is seeded with the solution of the nearest query the same thread
+ * solved before, through InverseKinematicsBase::setInitialGuess() and computeInverseKinematicsCloseTo(). Iterative
+ * solvers are hence warm-started, while analytical solvers return the solution branch consistent with the neighbour.
+ */
+template <size_t NJOINTS, typename SCALAR = double>
+class BatchInverseKinematics
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    using IKSolver_t = InverseKinematicsBase<NJOINTS, SCALAR>;
+    using JointPosition_t = typename IKSolver_t::JointPosition_t;
+    using JointPositionsVector_t = typename IKSolver_t::JointPositionsVector_t;
+    using RigidBodyPoseTpl = typename IKSolver_t::RigidBodyPoseTpl;
+    using RigidBodyPoseVector_t = std::vector<RigidBodyPoseTpl, Eigen::aligned_allocator<RigidBodyPoseTpl>>;
+
+    using SolverFactory_t = std::function<std::shared_ptr<IKSolver_t>()>;
+
+    //! solutions and timing statistics of a batch
+    struct Result
+    {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        JointPositionsVector_t solutions;  //!< one solution per query, only valid if the query was successful
+        std::vector<bool> success;         //!< flags which queries were solved
+        std::vector<double> solveTimes;    //!< solve time per query [s]
+        size_t nSolved = 0;                //!< number of successful queries
+        double wallTime = 0.0;             //!< wall clock time for the whole batch [s]
+        double meanSolveTime = 0.0;        //!< mean solve time per query [s]
+        double maxSolveTime = 0.0;         //!< maximum solve time of a query [s]
+    };
+
+    /*!
+     * @brief constructor
+     * @param solverFactory creates a solver instance, called once per thread
+     * @param settings batch settings
+     */
+    BatchInverseKinematics(const SolverFactory_t& solverFactory,
+        const BatchInverseKinematicsSettings& settings = BatchInverseKinematicsSettings())
+        : settings_(settings)
+    {
+        if (settings_.nThreads < 1 || settings_.chunkSize < 1)
+            throw std::runtime_error("BatchInverseKinematics: number of threads and chunk size need to be positive.");
+
+        for (size_t i = 0; i < settings_.nThreads; i++)
+        {
+            solvers_.push_back(solverFactory());
+            if (!solvers_.back())
+                throw std::runtime_error("BatchInverseKinematics: solver factory returned a nullptr.");
+        }
+    }
+
+    /*!
+     * @brief solve a batch of inverse kinematics queries
+     * @param eeBasePoses target end-effector poses in base coordinates
+     * @param initialGuess joint positions used to seed the first query of every thread
+     * @param freeJoints vector of indices of the free joints, passed on to the solvers
+     * @return the solutions and timing statistics, in the order of the queries
+     */
+    Result solve(const RigidBodyPoseVector_t& eeBasePoses,
+        const JointPosition_t& initialGuess,
+        const std::vector<size_t>& freeJoints = std::vector<size_t>())
+    {
+        const size_t nQueries = eeBasePoses.size();
+
+        Result result;
+        result.solutions.assign(nQueries, initialGuess);
+        result.success.assign(nQueries, false);
+        result.solveTimes.assign(nQueries, 0.0);
+
+        ct::core::Timer wallTimer;
+        wallTimer.start();
+
+        const std::vector<size_t> order = computeSpatialOrder(eeBasePoses);
+
+        std::vector<unsigned char> success(nQueries, 0);  // std::vector<bool> must not be written concurrently
+
+#pragma omp parallel num_threads(solvers_.size())
+        {
+            solveQueries(*solvers_[threadIndex()], eeBasePoses, order, initialGuess, freeJoints, success, result);
+        }
+
+        wallTimer.stop();
+
+        for (size_t i = 0; i < nQueries; i++)
+        {
+            result.success[i] = (success[i] != 0);
+            result.nSolved += success[i];
+            result.maxSolveTime = std::max(result.maxSolveTime, result.solveTimes[i]);
+        }
+
+        result.wallTime = wallTimer.getElapsedTime();
+        if (nQueries > 0)
+            result.meanSolveTime = std::accumulate(result.solveTimes.begin(), result.solveTimes.end(), 0.0) / nQueries;
+
+        return result;
+    }
+
+    const BatchInverseKinematicsSettings& getSettings() const { return settings_; }
+private:
+    //! a solved query, remembered by a thread for warm-starting
+    struct SolvedQuery
+    {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        size_t index;
+        JointPosition_t solution;
+    };
+
+    //! index of the calling thread in the OpenMP team, selects its solver
+    static size_t threadIndex()
+    {
+#ifdef _OPENMP
+        return omp_get_thread_num();
+#else
+        return 0;
+#endif
+    }
+
+    //! solve the share of the calling thread, needs to be called from within the parallel region
+    void solveQueries(IKSolver_t& solver,
+        const RigidBodyPoseVector_t& poses,
+        const std::vector<size_t>& order,
+        const JointPosition_t& initialGuess,
+        const std::vector<size_t>& freeJoints,
+        std::vector<unsigned char>& success,
+        Result& result)
+    {
+        std::deque<SolvedQuery, Eigen::aligned_allocator<SolvedQuery>> recent;
+        ct::core::Timer timer;
+
+#pragma omp for schedule(dynamic, settings_.chunkSize)
+        for (size_t k = 0; k < order.size(); k++)
+        {
+            const size_t i = order[k];
+
+            // seed with the solution of the nearest query solved by this thread
+            JointPosition_t seed = initialGuess;
+            double minDistance = std::numeric_limits<double>::max();
+            for (const SolvedQuery& solved : recent)
+            {
+                const double distance = poseDistance(poses[i], poses[solved.index]);
+                if (distance < minDistance)
+                {
+                    minDistance = distance;
+                    seed = solved.solution;
+                }
+            }
+
+            timer.start();
+            solver.setInitialGuess(seed);
+            const bool solved = solver.computeInverseKinematicsCloseTo(result.solutions[i], poses[i], seed, freeJoints);
+            timer.stop();
+
+            result.solveTimes[i] = timer.getElapsedTime();
+            success[i] = solved;
+
+            if (solved)
+            {
+                recent.push_back(SolvedQuery{i, result.solutions[i]});
+                if (recent.size() > settings_.warmStartWindow)
+                    recent.pop_front();
+            }
+        }
+    }
+
+    //! distance between two poses, translational distance plus weighted angular distance
+    double poseDistance(const RigidBodyPoseTpl& a, const RigidBodyPoseTpl& b) const
+    {
+        const double angle = a.getRotationQuaternion().toImplementation().angularDistance(
+            b.getRotationQuaternion().toImplementation());
+        return (a.position().toImplementation() - b.position().toImplementation()).norm() +
+               settings_.orientationWeight * angle;
+    }
+
+    //! order of the queries along a Morton (z-order) curve through the target positions
+    std::vector<size_t> computeSpatialOrder(const RigidBodyPoseVector_t& poses) const
+    {
+        std::vector<size_t> order(poses.size());
+        std::iota(order.begin(), order.end(), 0);
+
+        if (poses.empty())
+            return order;
+
+        Eigen::Vector3d lower = Eigen::Vector3d::Constant(std::numeric_limits<double>::max());
+        Eigen::Vector3d upper = -lower;
+        for (const auto& pose : poses)
+        {
+            lower = lower.cwiseMin(pose.position().toImplementation().template cast<double>());
+            upper = upper.cwiseMax(pose.position().toImplementation().template cast<double>());
+        }
+        const Eigen::Vector3d scale = (upper - lower).cwiseMax(1e-12).cwiseInverse() * 1023.0;
+
+        std::vector<uint32_t> codes(poses.size());
+        for (size_t i = 0; i < poses.size(); i++)
+        {
+            const Eigen::Vector3d cell =
+                (poses[i].position().toImplementation().template cast<double>() - lower).cwiseProduct(scale);
+
+            // interleave the bits of the 10 bit cell coordinates
+            uint32_t code = 0;
+            for (int bit = 0; bit < 10; bit++)
+                for (int dim = 0; dim < 3; dim++)
+                    code |= ((static_cast<uint32_t>(cell(dim)) >> bit) & 1u) << (3 * bit + dim);
+            codes[i] = code;
+        }
+
+        std::stable_sort(order.begin(), order.end(), [&codes](size_t a, size_t b) { return codes[a] < codes[b]; });
+
+        return order;
+    }
+
+    BatchInverseKinematicsSettings settings_;
+
+    //! one solver instance per thread
+    std::vector<std::shared_ptr<IKSolver_t>> solvers_;
+};
+
+} /* namespace rbd */
+} /* namespace ct */
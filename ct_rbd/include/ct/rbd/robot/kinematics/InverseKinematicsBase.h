@@ -119,6 +119,14 @@ public:
             ikSolution, eeBasePose, identityWorldPose, queryJointPositions, freeJoints);
     }
 
+    /*!
+     * @brief set the initial guess of iterative solvers for the next solve
+     *
+     * Does nothing by default, e.g. for analytical solvers which return all solutions.
+     * @param q_init initial guess for the joint positions
+     */
+    virtual void setInitialGuess(const JointPosition_t& q_init) {}
+
     const InverseKinematicsSettings& getSettings() const { return settings_; }
     void updateSettings(const InverseKinematicsSettings& settings) { settings_ = settings; }
 protected:
@@ -0,0 +1,133 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <ct/rbd/state/JointState.h>
+
+namespace ct {
+namespace rbd {
+
+/**
+ * \brief Lazily evaluated forward kinematics of a single joint configuration
+ *
+ * Every quantity is computed on its first request and reused for all further requests with the same joint positions,
+ * such that consumers requesting the same end-effector transform or Jacobian several times per state, e.g. a cost
+ * term in its evaluation and its derivatives, traverse the kinematic tree only once. Requesting a quantity for other
+ * joint positions invalidates all cached quantities in constant time.
+ *
+ * Caching requires comparing joint positions, hence it is only enabled for arithmetic scalar types. For auto-diff
+ * scalars, every quantity is recomputed on request such that it is recorded correctly.
+ *
+ * \tparam RBD the RobCoGenContainer of the robot
+ * \tparam N_EE number of end-effectors
+ */
+template <class RBD, size_t N_EE>
+class KinematicsCache
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    static const size_t NJOINTS = RBD::NJOINTS;
+    static const size_t NLINKS = RBD::NLINKS;
+
+    using SCALAR = typename RBD::SCALAR;
+    using HomogeneousTransform = typename RBD::HomogeneousTransform;
+    using ForceTransform = typename RBD::ForceTransform;
+    using Jacobian = typename RBD::Jacobian;
+    using JointPosition = typename JointState<NJOINTS, SCALAR>::Position;
+
+    //! whether quantities are cached, only for arithmetic scalar types
+    static const bool CACHING = std::is_arithmetic<SCALAR>::value;
+
+    KinematicsCache(std::shared_ptr<RBD> rbdContainer) : rbdContainer_(rbdContainer), qValid_(false), stamp_(1) {}
+    //! get the homogeneous transform from the end-effector to the base frame
+    const HomogeneousTransform& getHomogeneousTransformBaseEE(size_t eeId, const JointPosition& q)
+    {
+        if (!isCached(eeTransformStamps_, eeId, q))
+            eeTransforms_[eeId] = rbdContainer_->getHomogeneousTransformBaseEEById(eeId, q);
+        return eeTransforms_[eeId];
+    }
+
+    //! get the end-effector Jacobian expressed in the base frame
+    const Jacobian& getJacobianBaseEE(size_t eeId, const JointPosition& q)
+    {
+        if (!isCached(eeJacobianStamps_, eeId, q))
+            eeJacobians_[eeId] = rbdContainer_->getJacobianBaseEEbyId(eeId, q);
+        return eeJacobians_[eeId];
+    }
+
+    //! get the homogeneous transform from a link to the base frame
+    const HomogeneousTransform& getHomogeneousTransformBaseLink(size_t linkId, const JointPosition& q)
+    {
+        if (!isCached(linkTransformStamps_, linkId, q))
+            linkTransforms_[linkId] = rbdContainer_->getHomogeneousTransformBaseLinkById(linkId, q);
+        return linkTransforms_[linkId];
+    }
+
+    //! get the force transform from the base to a link frame
+    const ForceTransform& getForceTransformLinkBase(size_t linkId, const JointPosition& q)
+    {
+        if (!isCached(forceTransformStamps_, linkId, q))
+            forceTransforms_[linkId] = rbdContainer_->getForceTransformLinkBaseById(linkId, q);
+        return forceTransforms_[linkId];
+    }
+
+    //! discard all cached quantities, e.g. if the robot model has been modified
+    void invalidate() { qValid_ = false; }
+
+private:
+    //! check whether the quantity with the given index is cached for the joint positions, and mark it as cached if not
+    template <size_t N>
+    bool isCached(std::array<size_t, N>& stamps, size_t index, const JointPosition& q)
+    {
+        if (index >= N)
+            throw std::runtime_error("KinematicsCache: index " + std::to_string(index) + " out of range.");
+
+        if (!CACHING)
+            return false;
+
+        // new joint positions invalidate all quantities at once
+        if (!qValid_ || !(q.array() == q_.array()).all())
+        {
+            q_ = q;
+            qValid_ = true;
+            stamp_++;
+        }
+
+        if (stamps[index] == stamp_)
+            return true;
+
+        stamps[index] = stamp_;
+        return false;
+    }
+
+    std::shared_ptr<RBD> rbdContainer_;
+
+    //! joint positions of the cached quantities
+    JointPosition q_;
+    bool qValid_;
+    //! quantities with a stamp different from the current one are outdated
+    size_t stamp_;
+
+    std::array<HomogeneousTransform, N_EE> eeTransforms_;
+    std::array<Jacobian, N_EE> eeJacobians_;
+    std::array<HomogeneousTransform, NLINKS + 1> linkTransforms_;
+    std::array<ForceTransform, NLINKS + 1> forceTransforms_;
+
+    std::array<size_t, N_EE> eeTransformStamps_{};
+    std::array<size_t, N_EE> eeJacobianStamps_{};
+    std::array<size_t, NLINKS + 1> linkTransformStamps_{};
+    std::array<size_t, NLINKS + 1> forceTransformStamps_{};
+};
+
+}  // namespace rbd
+}  // namespace ct
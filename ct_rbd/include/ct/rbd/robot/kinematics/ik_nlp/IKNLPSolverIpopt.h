@@ -61,7 +61,7 @@ public:
         this->updateSettings(ikSettings);
     }
 
-    void setInitialGuess(const JointPosition_t& q_init)
+    void setInitialGuess(const JointPosition_t& q_init) override
     {
         if (iknlp_)
             iknlp_->setInitialGuess(q_init);
@@ -171,7 +171,7 @@ public:
         throw(std::runtime_error("Error - IPOPT interface not compiled."));
     }
 
-    void setInitialGuess(const JointPosition_t& q_init) {}
+    void setInitialGuess(const JointPosition_t& q_init) override {}
     bool computeInverseKinematics(JointPositionsVector_t& ikSolutions,
         const RigidBodyPoseTpl& ee_W_base,
         const std::vector<size_t>& freeJoints = std::vector<size_t>()) override
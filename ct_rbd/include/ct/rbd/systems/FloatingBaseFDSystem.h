@@ -47,7 +47,7 @@ public:
 
     FloatingBaseFDSystem() : Base(), dynamics_(), eeContactModel_(nullptr) {}
     FloatingBaseFDSystem(const FloatingBaseFDSystem<RBDDynamics, QUAT_INTEGRATION, EE_ARE_CONTROL_INPUTS>& other)
-        : Base(other), dynamics_(other.dynamics_), eeContactModel_(other.eeContactModel_->clone())
+        : Base(other), dynamics_(other.dynamics_), eeContactModel_(other.eeContactModel_ ? other.eeContactModel_->clone() : nullptr)
     {
     }
 
@@ -60,6 +60,7 @@ public:
     virtual RBDDynamics& dynamics() override { return dynamics_; }
     virtual const RBDDynamics& dynamics() const override { return dynamics_; }
     void setContactModel(const std::shared_ptr<ContactModel>& contactModel) { eeContactModel_ = contactModel; }
+    const std::shared_ptr<ContactModel>& getContactModel() const { return eeContactModel_; }
     virtual void computePdot(const StateVector& x,
         const core::StateVector<RBDDynamics::NSTATE / 2, SCALAR>& v,
         const ControlVector& control,
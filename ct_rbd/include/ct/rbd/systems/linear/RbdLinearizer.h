@@ -8,13 +8,16 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
  *
  *  \warning this Linearizer is different to the standard system linearizer
  *  in ct_core. It takes care of additional terms arising from floating-base
- *  systems. If the system is fixed-base, the standard ct_core linearizer
- *  is called.
+ *  systems. The acceleration derivatives are obtained from finite differences of the
+ *  inverse dynamics and the joint space inertia matrix instead of differentiating the
+ *  forward dynamics. The derivatives are numerical, not analytical RNEA derivatives.
  *
  */
 
 #pragma once
 
+#include <cmath>
+#include <limits>
 #include <memory>
 
 #pragma GCC diagnostic push
@@ -62,8 +65,16 @@ public:
     typedef ct::core::StateControlMatrix<STATE_DIM, CONTROL_DIM, SCALAR> state_control_matrix_t;
 
 
+    /*!
+     * @param RBDSystem the rigid body system to linearize
+     * @param doubleSidedDerivative if true, the inverse dynamics are differentiated with central differences,
+     * otherwise with forward differences, which require one instead of two RNEA passes per state
+     */
     RbdLinearizer(std::shared_ptr<SYSTEM> RBDSystem, bool doubleSidedDerivative = false)
-        : Base(RBDSystem, doubleSidedDerivative), RBDSystem_(RBDSystem)
+        : Base(RBDSystem, doubleSidedDerivative),
+          RBDSystem_(RBDSystem),
+          factorizationValid_(false),
+          doubleSidedDerivative_(doubleSidedDerivative)
     {
         // check if a non-floating base system is a second order system
         if (!FLOATING_BASE && (this->getType() != ct::core::SYSTEM_TYPE::SECOND_ORDER))
@@ -82,22 +93,84 @@ public:
         this->dFdu_.template topRows<STATE_DIM / 2>().setZero();
     }
 
-    RbdLinearizer(const RbdLinearizer& arg) : Base(arg), RBDSystem_(std::shared_ptr<SYSTEM>(arg.RBDSystem_->clone())) {}
+    RbdLinearizer(const RbdLinearizer& arg)
+        : Base(arg),
+          RBDSystem_(std::shared_ptr<SYSTEM>(arg.RBDSystem_->clone())),
+          factorizationValid_(false),
+          doubleSidedDerivative_(arg.doubleSidedDerivative_)
+    {
+    }
     virtual ~RbdLinearizer() override {}
     RbdLinearizer<SYSTEM>* clone() const override { return new RbdLinearizer<SYSTEM>(*this); }
+    /*!
+     * \brief Computes the state Jacobian.
+     *
+     * The bottom rows (the derivative of the generalized accelerations) are obtained from the inverse dynamics instead
+     * of differentiating through the forward dynamics. With the inverse dynamics
+     * \f$ \tau_{ID}(x, \ddot q) = M(q) \ddot q + h(x) - J_c^T f_c(x) \f$ and \f$ \tau_{ID}(x, FD(x, u)) = S^T u \f$,
+     * the derivative of the forward dynamics is
+     * \f[
+     * \frac{\partial FD}{\partial x} = - M^{-1}(q) \frac{\partial \tau_{ID}}{\partial x} \bigg|_{\ddot q = FD(x, u)}
+     * \f]
+     * The derivative of the inverse dynamics is approximated by finite differences, since the generated dynamics do
+     * not expose the RNEA recursion for analytical derivatives. Every column requires one (forward differences) or two
+     * (central differences) RNEA passes, hence the total complexity is \f$ O(n^2) \f$ without any AD or JIT
+     * compilation, whereas finite differences of the forward dynamics solve with \f$ M(q) \f$ for every column.
+     * The inverse dynamics are quadratic in the velocities, such that the central differences wrt. the velocities are
+     * exact as long as no (velocity dependent) contact model is set.
+     * The factorization of \f$ M(q) \f$ is shared with getDerivativeControl().
+     */
     const state_matrix_t& getDerivativeState(const state_vector_t& x,
         const control_vector_t& u,
         const SCALAR t = 0.0) override
     {
-        if (!FLOATING_BASE)
+        // the generalized accelerations at the linearization point
+        state_vector_t xd;
+        RBDSystem_->computeControlledDynamics(x, t, u, xd);
+        const coordinate_vector_t qdd = xd.template bottomRows<STATE_DIM / 2>();
+
+        if (doubleSidedDerivative_)
         {
-            // call standard ct_core linearizer
-            return Base::getDerivativeState(x, u, t);
+            const bool velocityQuadratic = !hasContactModel();
+
+            for (size_t i = 0; i < STATE_DIM; i++)
+            {
+                const bool isVelocity = (i >= STATE_DIM / 2);
+                const SCALAR h = (isVelocity && velocityQuadratic)
+                                     ? SCALAR(1.0)
+                                     : centralStepSize_ * std::max(SCALAR(1.0), std::abs(x(i)));
+
+                state_vector_t xPerturbed = x;
+                xPerturbed(i) += h;
+                const coordinate_vector_t tauPlus = inverseDynamics(xPerturbed, qdd);
+                xPerturbed(i) = x(i) - h;
+                const coordinate_vector_t tauMinus = inverseDynamics(xPerturbed, qdd);
+
+                dTauDx_.col(i) = (tauPlus - tauMinus) / (SCALAR(2.0) * h);
+            }
         }
         else
         {
-            Base::getDerivativeState(x, u, t);
+            // the generalized forces at the linearization point, i.e. S^T u up to round-off
+            const coordinate_vector_t tauRef = inverseDynamics(x, qdd);
+
+            for (size_t i = 0; i < STATE_DIM; i++)
+            {
+                const SCALAR h = forwardStepSize_ * std::max(SCALAR(1.0), std::abs(x(i)));
+
+                state_vector_t xPerturbed = x;
+                xPerturbed(i) += h;
+
+                dTauDx_.col(i) = (inverseDynamics(xPerturbed, qdd) - tauRef) / h;
+            }
+        }
+
+        factorizeMassMatrix(x);
+
+        this->dFdx_.template bottomRows<STATE_DIM / 2>() = -llt_.solve(dTauDx_);
 
+        if (FLOATING_BASE)
+        {
             // since we express base pose in world but base twist in body coordinates, we have to modify the top part
             kindr::EulerAnglesXyz<SCALAR> eulerXyz(x.template topRows<3>());
             kindr::RotationMatrix<SCALAR> R_WB_kindr(eulerXyz);
@@ -106,7 +179,6 @@ public:
                 jacobianOfAngularVelocityMapping(x.template topRows<3>(), x.template segment<3>(STATE_DIM / 2))
                     .transpose();
 
-            //this->dFdx_.template block<3,3>(0,0) = -R_WB_kindr.toImplementation() * JacobianOfRotationMultiplyVector( x.template topRows<3>(), R_WB_kindr.toImplementation()*(x.template segment<3>(STATE_DIM/2) ));
             this->dFdx_.template block<3, 3>(0, 0) = jacAngVel.template block<3, 3>(0, 0);
 
             this->dFdx_.template block<3, 3>(3, 0) =
@@ -114,7 +186,6 @@ public:
                 JacobianOfRotationMultiplyVector(x.template topRows<3>(),
                     R_WB_kindr.toImplementation() * (x.template segment<3>(STATE_DIM / 2 + 3)));
 
-
             // Derivative Top Row
             // This is the derivative of the orientation with respect to local angular velocity. This is NOT the rotation matrix
             this->dFdx_.template block<3, 3>(0, STATE_DIM / 2) = jacAngVel.template block<3, 3>(0, 3);
@@ -123,44 +194,32 @@ public:
 
             // This is the derivative of the position with respect to linear velocity. This is simply the rotation matrix
             this->dFdx_.template block<3, 3>(3, STATE_DIM / 2 + 3) = R_WB_kindr.toImplementation();
-
-            return this->dFdx_;
         }
+
+        return this->dFdx_;
     }
 
     const state_control_matrix_t& getDerivativeControl(const state_vector_t& x,
         const control_vector_t& u,
         const SCALAR t = 0.0) override
     {
-        const jsim_t& M = RBDSystem_->dynamics().kinematics().robcogen().jSim().update(
-            x.template segment<NJOINTS>(FLOATING_BASE * 6));
-
-        llt_.compute(M);
-
-        const typename jsim_t::MatrixType& M_inv = llt_.solve(jsim_t::Identity());
+        factorizeMassMatrix(x);
 
 #ifdef DEBUG
-        typename jsim_t::MatrixType Meigen = M;
-        if (!Meigen.inverse().isApprox(M_inv))
+        const typename jsim_t::MatrixType M_inv = llt_.solve(jsim_t::MatrixType::Identity());
+        if (!M_.inverse().isApprox(M_inv))
         {
-            Eigen::SelfAdjointEigenSolver<typename jsim_t::MatrixType> eigensolver(M);
+            Eigen::SelfAdjointEigenSolver<typename jsim_t::MatrixType> eigensolver(M_);
             std::cout << "The eigenvalues of M are:\n" << eigensolver.eigenvalues().transpose() << std::endl;
             std::cout << "M inverse incorrect" << std::endl;
-            std::cout << "M.inverse: " << std::endl << Meigen.inverse() << std::endl;
+            std::cout << "M.inverse: " << std::endl << M_.inverse() << std::endl;
             std::cout << "M_inv: " << std::endl << M_inv << std::endl;
-
-            // Marco's LLT version
-            jsim_t M_temp = M;
-            M_temp.computeL();
-            M_temp.computeInverse();
-            auto M_inv_robcogen = M_temp.getInverse();
-            std::cout << "M_inv_robcogen: " << std::endl << M_inv_robcogen << std::endl;
         }
 #endif  //DEBUG
 
         auto& S = RBDSystem_->dynamics().S();
 
-        this->dFdu_.template block<STATE_DIM / 2, CONTROL_DIM>(STATE_DIM / 2, 0) = M_inv * S.transpose();
+        this->dFdu_.template block<STATE_DIM / 2, CONTROL_DIM>(STATE_DIM / 2, 0) = llt_.solve(S.transpose());
 
         return this->dFdu_;
     }
@@ -168,10 +227,97 @@ public:
 
 protected:
     typedef typename SYSTEM::Dynamics::ROBCOGEN::JSIM jsim_t;
+    typedef Eigen::Matrix<SCALAR, STATE_DIM / 2, 1> coordinate_vector_t;
+    typedef Eigen::Matrix<SCALAR, NJOINTS, 1> joint_vector_t;
+
+    //! factorize the joint space inertia matrix, unless it has been factorized for the same configuration before
+    void factorizeMassMatrix(const state_vector_t& x)
+    {
+        const joint_vector_t q = x.template segment<NJOINTS>(FLOATING_BASE * 6);
+
+        if (factorizationValid_ && q == qFactorized_)
+            return;
+
+        M_ = RBDSystem_->dynamics().kinematics().robcogen().jSim().update(q);
+        llt_.compute(M_);
+
+        qFactorized_ = q;
+        factorizationValid_ = true;
+    }
+
+    //! generalized forces required to achieve the generalized accelerations qdd in state x
+    coordinate_vector_t inverseDynamics(const state_vector_t& x, const coordinate_vector_t& qdd)
+    {
+        return inverseDynamicsImpl<FLOATING_BASE>(x, qdd);
+    }
+
+    template <bool FB>
+    typename std::enable_if<!FB, coordinate_vector_t>::type inverseDynamicsImpl(const state_vector_t& x,
+        const coordinate_vector_t& qdd)
+    {
+        control_vector_t tau;
+        RBDSystem_->dynamics().FixBaseID(typename SYSTEM::Dynamics::JointState_t(x),
+            typename SYSTEM::Dynamics::JointAcceleration_t(qdd), tau);
+        return tau;
+    }
+
+    template <bool FB>
+    typename std::enable_if<FB, coordinate_vector_t>::type inverseDynamicsImpl(const state_vector_t& x,
+        const coordinate_vector_t& qdd)
+    {
+        typename SYSTEM::Dynamics::RBDState_t state = RBDSystem_->RBDStateFromVector(x);
+
+        // contact forces are part of the inverse dynamics, such that their derivatives are taken into account
+        typename SYSTEM::Dynamics::ExtLinkForces_t linkForces(Eigen::Matrix<SCALAR, 6, 1>::Zero());
+        if (RBDSystem_->getContactModel())
+            RBDSystem_->mapEndeffectorForcesToLinkForces(
+                state, RBDSystem_->getContactModel()->computeContactForces(state), linkForces);
+
+        typename SYSTEM::Dynamics::ForceVector_t baseWrench;
+        control_vector_t tau;
+        RBDSystem_->dynamics().kinematics().robcogen().inverseDynamics().id_fully_actuated(baseWrench, tau,
+            state.basePose().computeGravityB6D(), state.baseVelocities().getVector(),
+            typename SYSTEM::Dynamics::Vector6d_t(qdd.template head<6>()), state.joints().getPositions(),
+            state.joints().getVelocities(), joint_vector_t(qdd.template tail<NJOINTS>()), linkForces);
+
+        coordinate_vector_t generalizedForces;
+        generalizedForces << baseWrench, tau;
+        return generalizedForces;
+    }
+
+    bool hasContactModel() const { return hasContactModelImpl<FLOATING_BASE>(); }
+
+    template <bool FB>
+    typename std::enable_if<!FB, bool>::type hasContactModelImpl() const
+    {
+        return false;
+    }
+
+    template <bool FB>
+    typename std::enable_if<FB, bool>::type hasContactModelImpl() const
+    {
+        return RBDSystem_->getContactModel() != nullptr;
+    }
 
     std::shared_ptr<SYSTEM> RBDSystem_;
 
+    //! joint space inertia matrix and its factorization, valid for configuration qFactorized_
+    typename jsim_t::MatrixType M_;
     Eigen::LLT<typename jsim_t::MatrixType> llt_;
+    joint_vector_t qFactorized_;
+    bool factorizationValid_;
+
+    //! derivative of the inverse dynamics wrt. the state
+    Eigen::Matrix<SCALAR, STATE_DIM / 2, STATE_DIM> dTauDx_;
+
+    //! use central instead of forward differences for the inverse dynamics derivative
+    bool doubleSidedDerivative_;
+
+    //! step size for the central differences of the inverse dynamics wrt. the configuration
+    const SCALAR centralStepSize_ = std::cbrt(std::numeric_limits<SCALAR>::epsilon());
+
+    //! step size for the forward differences of the inverse dynamics
+    const SCALAR forwardStepSize_ = std::sqrt(std::numeric_limits<SCALAR>::epsilon());
 
 private:
     // auto generated code
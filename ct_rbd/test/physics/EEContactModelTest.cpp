@@ -43,6 +43,65 @@ TEST(EEContactModelTest, basicTest)
 }
 
 
+TEST(EEContactModelTest, perEndEffectorReference)
+{
+    typedef TestHyQ::Kinematics HyqKinematics;
+    typedef EEContactModel<HyqKinematics> ContactModel;
+
+    std::shared_ptr<HyqKinematics> kinematics(new HyqKinematics());
+
+    const double k = 5000.0;
+    const double d = 1000.0;
+    const double alpha = 100.0;
+    const double zOffset = -0.02;
+
+    for (auto smoothing : {ContactModel::NONE, ContactModel::SIGMOID, ContactModel::TANH, ContactModel::ABS})
+    {
+        for (double alpha_n : {-1.0, 100.0})
+        {
+            ContactModel eeContactModel(k, d, alpha, alpha_n, zOffset, smoothing, kinematics);
+
+            for (size_t n = 0; n < 100; n++)
+            {
+                // keep the base close to the ground, such that some feet are in contact
+                RBDState<HyqKinematics::NJOINTS> state;
+                state.setRandom();
+                double& baseHeight = state.basePose().position().toImplementation()(2);
+                baseHeight = 0.6 + 0.3 * baseHeight;
+
+                ContactModel::EEForcesLinear forces = eeContactModel.computeContactForces(state);
+
+                // evaluate the contact law separately for every end-effector
+                for (size_t i = 0; i < HyqKinematics::NUM_EE; i++)
+                {
+                    const double z = kinematics->getEEPositionInWorld(i, state.basePose(), state.jointPositions())
+                                         .toImplementation()(2);
+
+                    Eigen::Vector3d force = Eigen::Vector3d::Zero();
+                    if (smoothing != ContactModel::NONE || z <= 0.0)
+                    {
+                        force = -d * kinematics->getEEVelocityInWorld(i, state).toImplementation();
+
+                        if (smoothing == ContactModel::SIGMOID)
+                            force *= 1.0 / (1.0 + std::exp(z * alpha));
+                        else if (smoothing == ContactModel::TANH)
+                            force *= 0.5 * std::tanh(-0.5 * z * alpha) + 0.5;
+                        else if (smoothing == ContactModel::ABS)
+                            force *= 0.5 * -z * alpha / (1.0 + std::fabs(-z * alpha)) + 0.5;
+
+                        if (alpha_n > 0.0)
+                            force(2) += k * std::exp(-alpha_n * (z - zOffset));
+                        else if (z - zOffset <= 0.0)
+                            force(2) -= k * (z - zOffset);
+                    }
+
+                    ASSERT_TRUE(forces[i].isApprox(force, 1e-10) || (forces[i] - force).norm() < 1e-8);
+                }
+            }
+        }
+    }
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
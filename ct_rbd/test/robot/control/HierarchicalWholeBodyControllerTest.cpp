@@ -0,0 +1,140 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wunused-value"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+
+#include <ct/rbd/rbd.h>
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "../../models/testhyq/RobCoGenTestHyQ.h"
+
+using namespace ct;
+using namespace ct::rbd;
+
+typedef HierarchicalWholeBodyController<TestHyQ::RobCoGenContainer, 4> Controller;
+typedef Controller::Dynamics_t Dynamics_t;
+
+const size_t NJOINTS = Controller::NJOINTS;
+const size_t NDOF = Controller::NDOF;
+const size_t NEE = 4;
+
+//! hold the base, i.e. no base acceleration
+class BaseTask : public WholeBodyTask<NJOINTS>
+{
+public:
+    size_t size() const override { return 6; }
+    void computeTask(const RBDState_t& x, const core::Time& t, Eigen::MatrixXd& J, Eigen::VectorXd& b) override
+    {
+        J.setZero(6, NDOF);
+        J.leftCols<6>().setIdentity();
+        b.setZero(6);
+    }
+};
+
+//! hold the posture, i.e. no joint acceleration
+class PostureTask : public WholeBodyTask<NJOINTS>
+{
+public:
+    size_t size() const override { return NJOINTS; }
+    void computeTask(const RBDState_t& x, const core::Time& t, Eigen::MatrixXd& J, Eigen::VectorXd& b) override
+    {
+        J.setZero(NJOINTS, NDOF);
+        J.rightCols<NJOINTS>().setIdentity();
+        b.setZero(NJOINTS);
+    }
+};
+
+//! TestHyQ standing on all four feet
+Controller::RBDState_t standingState()
+{
+    Controller::RBDState_t x;
+    x.setZero();
+    x.basePose().position().toImplementation() << 0.0, 0.0, 0.6;
+    x.jointPositions() << -0.2, 0.7, -1.4, -0.2, 0.7, -1.4, -0.2, -0.7, 1.4, -0.2, -0.7, 1.4;
+    return x;
+}
+
+
+TEST(HierarchicalWholeBodyControllerTest, StandingHyQ)
+{
+    const double mu = 0.7;
+
+    std::shared_ptr<Dynamics_t> dynamics(new Dynamics_t);
+    Controller controller(dynamics, Controller::control_vector_t::Constant(300.0), mu);
+    controller.setContactConfiguration(Controller::EE_in_contact_t(true));
+    controller.addTask(std::make_shared<BaseTask>(), 0);
+    controller.addTask(std::make_shared<PostureTask>(), 1);
+
+    const Controller::RBDState_t x = standingState();
+
+    Controller::control_vector_t tau;
+    ASSERT_TRUE(controller.computeTorque(x, 0.0, tau));
+
+    const Eigen::Matrix<double, NDOF, 1> qdd = controller.getAccelerations();
+
+    // reference terms of the equations of motion from a separate model
+    Dynamics_t reference;
+    Dynamics_t::InertiaMatrix_t M;
+    Dynamics_t::GeneralizedForce_t h;
+    reference.FloatingBaseDynamicsTerms(x, M, h);
+
+    ConstraintJacobian<Dynamics_t::Kinematics_t, 3 * NEE, NJOINTS> Jc;
+    for (size_t ee = 0; ee < NEE; ee++)
+    {
+        Jc.eeInContact_[ee] = true;
+        Jc.ee_indices_.push_back(ee);
+    }
+    Jc.c_size_ = 3 * NEE;
+    Jc.updateState(x);
+
+    Eigen::Matrix<double, 3 * NEE, 1> lambda;
+    for (size_t ee = 0; ee < NEE; ee++)
+        lambda.segment<3>(3 * ee) = controller.getContactForce(ee);
+
+    // the equations of motion hold
+    Dynamics_t::GeneralizedForce_t generalizedForce = Jc.J().transpose() * lambda;
+    generalizedForce.tail<NJOINTS>() += tau;
+    ASSERT_LT((M * qdd + h - generalizedForce).norm(), 1e-6 * h.norm());
+
+    // the feet do not accelerate, the state has no velocity
+    ASSERT_LT((Jc.J() * qdd).norm(), 1e-6);
+
+    // the base task is feasible, the feet carry the weight of the robot up to the regularization of the hierarchy
+    ASSERT_LT(qdd.head<6>().norm(), 1e-4);
+
+    // the contact forces lie in the friction pyramid, the base is level such that its frame is aligned with the world
+    for (size_t ee = 0; ee < NEE; ee++)
+    {
+        const Eigen::Vector3d f = controller.getContactForce(ee);
+        ASSERT_GT(f.z(), 0.0);
+        ASSERT_LE(std::abs(f.x()), mu / std::sqrt(2.0) * f.z() + 1e-6);
+        ASSERT_LE(std::abs(f.y()), mu / std::sqrt(2.0) * f.z() + 1e-6);
+    }
+    ASSERT_LT(controller.getConstraintViolation().norm(), 1e-6);
+
+    // repeating the control step with the same state is warm started from the active constraints of the last step
+    Controller::control_vector_t tauRepeated;
+    ASSERT_TRUE(controller.computeTorque(x, 0.0, tauRepeated));
+    for (size_t level = 0; level < 3; level++)
+    {
+        ASSERT_EQ(controller.getSolver().levelSolver(level).iterations(), 0u);
+    }
+    ASSERT_LT((tauRepeated - tau).norm(), 1e-6 * tau.norm());
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,159 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wunused-value"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+
+#include <ct/rbd/rbd.h>
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "../../models/testhyq/RobCoGenTestHyQ.h"
+
+using namespace ct;
+using namespace rbd;
+
+//! the TestHyQ RobCoGen container, counting the forward kinematics evaluations
+class CountingHyQContainer : public TestHyQ::RobCoGenContainer
+{
+public:
+    using BASE = TestHyQ::RobCoGenContainer;
+    using JointPosition = typename JointState<NJOINTS, SCALAR>::Position;
+
+    HomogeneousTransform getHomogeneousTransformBaseEEById(size_t eeId, const JointPosition& jointPosition)
+    {
+        nTransforms++;
+        return BASE::getHomogeneousTransformBaseEEById(eeId, jointPosition);
+    }
+
+    Jacobian getJacobianBaseEEbyId(size_t eeId, const JointPosition& jointPosition)
+    {
+        nJacobians++;
+        return BASE::getJacobianBaseEEbyId(eeId, jointPosition);
+    }
+
+    size_t nTransforms = 0;
+    size_t nJacobians = 0;
+};
+
+using CountingKinematics = Kinematics<CountingHyQContainer, TestHyQ::Kinematics::NUM_EE>;
+using JointPosition = CountingHyQContainer::JointPosition;
+
+
+TEST(KinematicsCacheTest, HitsAndMisses)
+{
+    std::shared_ptr<CountingHyQContainer> container(new CountingHyQContainer);
+    CountingKinematics kinematics(container);
+    TestHyQ::RobCoGenContainer reference;
+
+    JointPosition q1 = JointPosition::Random();
+    JointPosition q2 = JointPosition::Random();
+
+    // the first request evaluates the kinematics, further requests for the same state hit the cache
+    auto T = kinematics.getHomogeneousTransformBaseEEById(0, q1);
+    ASSERT_EQ(container->nTransforms, 1u);
+    ASSERT_TRUE(T.isApprox(reference.getHomogeneousTransformBaseEEById(0, q1)));
+
+    kinematics.getHomogeneousTransformBaseEEById(0, q1);
+    kinematics.getEEPositionInBase(0, q1);
+    kinematics.getEERotInBase(0, q1);
+    ASSERT_EQ(container->nTransforms, 1u);
+
+    // other end-effectors and quantities are cached separately
+    kinematics.getHomogeneousTransformBaseEEById(1, q1);
+    ASSERT_EQ(container->nTransforms, 2u);
+
+    auto J = kinematics.cache().getJacobianBaseEE(0, q1);
+    kinematics.cache().getJacobianBaseEE(0, q1);
+    ASSERT_EQ(container->nJacobians, 1u);
+    ASSERT_TRUE(J.isApprox(reference.getJacobianBaseEEbyId(0, q1)));
+
+    // new joint positions invalidate all quantities
+    T = kinematics.getHomogeneousTransformBaseEEById(0, q2);
+    ASSERT_EQ(container->nTransforms, 3u);
+    ASSERT_TRUE(T.isApprox(reference.getHomogeneousTransformBaseEEById(0, q2)));
+
+    J = kinematics.cache().getJacobianBaseEE(0, q2);
+    ASSERT_EQ(container->nJacobians, 2u);
+    ASSERT_TRUE(J.isApprox(reference.getJacobianBaseEEbyId(0, q2)));
+
+    // only the last joint positions are cached
+    T = kinematics.getHomogeneousTransformBaseEEById(0, q1);
+    ASSERT_EQ(container->nTransforms, 4u);
+    ASSERT_TRUE(T.isApprox(reference.getHomogeneousTransformBaseEEById(0, q1)));
+
+    // invalidating forces a re-evaluation for the same joint positions
+    kinematics.cache().invalidate();
+    T = kinematics.getHomogeneousTransformBaseEEById(0, q1);
+    ASSERT_EQ(container->nTransforms, 5u);
+    ASSERT_TRUE(T.isApprox(reference.getHomogeneousTransformBaseEEById(0, q1)));
+}
+
+TEST(KinematicsCacheTest, CompareWithRobCoGen)
+{
+    CountingKinematics kinematics;
+    TestHyQ::RobCoGenContainer reference;
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        JointPosition q = JointPosition::Random();
+
+        // request every quantity twice, once evaluated and once from the cache
+        for (size_t j = 0; j < 2; j++)
+        {
+            for (size_t ee = 0; ee < CountingKinematics::NUM_EE; ee++)
+            {
+                ASSERT_TRUE(kinematics.getHomogeneousTransformBaseEEById(ee, q).isApprox(
+                    reference.getHomogeneousTransformBaseEEById(ee, q)));
+                ASSERT_TRUE(kinematics.cache().getJacobianBaseEE(ee, q).isApprox(
+                    reference.getJacobianBaseEEbyId(ee, q)));
+            }
+
+            for (size_t link = 0; link < CountingKinematics::NLINKS; link++)
+            {
+                ASSERT_TRUE(kinematics.cache().getHomogeneousTransformBaseLink(link, q).isApprox(
+                    reference.getHomogeneousTransformBaseLinkById(link, q)));
+                ASSERT_TRUE(kinematics.cache().getForceTransformLinkBase(link, q).isApprox(
+                    reference.getForceTransformLinkBaseById(link, q)));
+            }
+        }
+
+        ASSERT_EQ(kinematics.robcogen().nTransforms, (i + 1) * CountingKinematics::NUM_EE);
+        ASSERT_EQ(kinematics.robcogen().nJacobians, (i + 1) * CountingKinematics::NUM_EE);
+    }
+}
+
+TEST(KinematicsCacheTest, SharedInstance)
+{
+    CountingKinematics::Ptr_t kinematics(new CountingKinematics);
+    CountingKinematics::Ptr_t consumer1 = kinematics;
+    CountingKinematics::Ptr_t consumer2 = kinematics;
+
+    JointPosition q = JointPosition::Random();
+
+    // consumers holding the same instance share the forward kinematics
+    consumer1->getHomogeneousTransformBaseEEById(0, q);
+    consumer2->getHomogeneousTransformBaseEEById(0, q);
+    ASSERT_EQ(kinematics->robcogen().nTransforms, 1u);
+
+    // a clone has its own container and cache
+    std::unique_ptr<CountingKinematics> clone(kinematics->clone());
+    clone->getHomogeneousTransformBaseEEById(0, q);
+    ASSERT_EQ(clone->robcogen().nTransforms, 1u);
+    ASSERT_EQ(kinematics->robcogen().nTransforms, 1u);
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#pragma GCC diagnostic pop
@@ -38,6 +38,7 @@ TEST(RBDLinearizerTest, NumDiffComparisonFixedBase)
     std::shared_ptr<IrbSystem> irbSystem2(new IrbSystem);
 
     RbdLinearizer<IrbSystem> rbdLinearizer(irbSystem, true);
+    RbdLinearizer<IrbSystem> rbdLinearizerForward(std::shared_ptr<IrbSystem>(new IrbSystem), false);
     core::SystemLinearizer<STATE_DIM, CONTROL_DIM> systemLinearizer(irbSystem2, true);
 
     core::StateVector<STATE_DIM> x;
@@ -63,9 +64,15 @@ TEST(RBDLinearizerTest, NumDiffComparisonFixedBase)
         //		std::cout << "B_system" << std::endl << B_system 		<< std::endl << std::endl;
         //		std::cout << "Diff:" 	<< std::endl << B_rbd-B_system 	<< std::endl << std::endl;
 
-        ASSERT_LT((A_rbd - A_system).array().abs().maxCoeff(), 1e-5);
+        // the numerical reference differences the forward dynamics and is the less accurate of the two
+        ASSERT_LT((A_rbd - A_system).array().abs().maxCoeff(), 1e-5 * std::max(1.0, A_system.array().abs().maxCoeff()));
 
         ASSERT_LT((B_rbd - B_system).array().abs().maxCoeff(), 1e-4);
+
+        // forward differences of the inverse dynamics are less accurate
+        auto A_forward = rbdLinearizerForward.getDerivativeState(x, u, 0.0);
+        ASSERT_LT((A_forward - A_system).array().abs().maxCoeff(),
+            1e-4 * std::max(1.0, A_system.array().abs().maxCoeff()));
     }
 }
 
@@ -112,6 +119,55 @@ TEST(RBDLinearizerTest, NumDiffComparisonFloatingBase)
     }
 }
 
+TEST(RBDLinearizerTest, NumDiffComparisonFloatingBaseContactModel)
+{
+    typedef FloatingBaseFDSystem<TestHyQ::Dynamics, false, false> HyQSystem;
+    typedef HyQSystem::ContactModel ContactModel;
+
+    const size_t STATE_DIM = HyQSystem::STATE_DIM;
+    const size_t CONTROL_DIM = HyQSystem::CONTROL_DIM;
+
+    std::shared_ptr<HyQSystem> hyqSystem(new HyQSystem);
+    std::shared_ptr<HyQSystem> hyqSystem2(new HyQSystem);
+
+    for (auto& system : {hyqSystem, hyqSystem2})
+    {
+        std::shared_ptr<ContactModel> contactModel(new ContactModel(5000.0, 1000.0, 100.0, 10.0, -0.02,
+            ContactModel::VELOCITY_SMOOTHING::SIGMOID, system->dynamics().kinematicsPtr()));
+        system->setContactModel(contactModel);
+    }
+
+    RbdLinearizer<HyQSystem> rbdLinearizer(hyqSystem, true);
+    core::SystemLinearizer<STATE_DIM, CONTROL_DIM> systemLinearizer(hyqSystem2, true);
+
+    core::StateVector<STATE_DIM> x;
+    core::ControlVector<CONTROL_DIM> u;
+
+    size_t nTests = 100;
+    for (size_t i = 0; i < nTests; i++)
+    {
+        // small base heights and orientations, such that some feet are in contact
+        x.setRandom();
+        x.template head<3>() *= 0.1;
+        x(5) = 0.3 * x(5) + 0.6;
+        u.setRandom();
+
+        auto A_rbd = rbdLinearizer.getDerivativeState(x, u, 0.0);
+        auto B_rbd = rbdLinearizer.getDerivativeControl(x, u, 0.0);
+
+        auto A_system = systemLinearizer.getDerivativeState(x, u, 0.0);
+        auto B_system = systemLinearizer.getDerivativeControl(x, u, 0.0);
+
+        // the contact model is stiff, hence compare relative to the magnitude of the derivatives
+        ASSERT_LT((A_rbd - A_system).array().abs().maxCoeff(), 1e-5 * std::max(1.0, A_system.array().abs().maxCoeff()));
+
+        // B does not depend on the contact forces, but the round-off of the numerical reference grows with them
+        core::StateVector<STATE_DIM> xd;
+        hyqSystem2->computeControlledDynamics(x, 0.0, u, xd);
+        ASSERT_LT((B_rbd - B_system).array().abs().maxCoeff(), 1e-4 + 1e-7 * xd.array().abs().maxCoeff());
+    }
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);